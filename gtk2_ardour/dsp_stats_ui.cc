@@ -81,6 +81,20 @@ DspStatisticsGUI::DspStatisticsGUI ()
 	table.attach (*labels[AudioEngine::NTT + Session::OverallProcess], 2, 3, row, row+1, Gtk::FILL, Gtk::SHRINK, 2, 0);
 	row++;
 
+	Label* right_angle_text3 = manage (new Label ("\xe2\x94\x94", ALIGN_END, ALIGN_CENTER));
+
+	table.attach (*manage (new Gtk::Label (_("Lua Scripts: "), ALIGN_END, ALIGN_CENTER)), 1, 2, row, row+1, Gtk::FILL, Gtk::SHRINK, 2, 0);
+	table.attach (*right_angle_text3, 0, 1, row, row+1, Gtk::FILL, Gtk::SHRINK, 2, 0);
+	table.attach (*labels[AudioEngine::NTT + Session::LuaScripts], 2, 3, row, row+1, Gtk::FILL, Gtk::SHRINK, 2, 0);
+	row++;
+
+	Label* right_angle_text4 = manage (new Label ("\xe2\x94\x94", ALIGN_END, ALIGN_CENTER));
+
+	table.attach (*manage (new Gtk::Label (_("Lua GC: "), ALIGN_END, ALIGN_CENTER)), 1, 2, row, row+1, Gtk::FILL, Gtk::SHRINK, 2, 0);
+	table.attach (*right_angle_text4, 0, 1, row, row+1, Gtk::FILL, Gtk::SHRINK, 2, 0);
+	table.attach (*labels[AudioEngine::NTT + Session::LuaGC], 2, 3, row, row+1, Gtk::FILL, Gtk::SHRINK, 2, 0);
+	row++;
+
 	HBox* hbox2 = manage (new HBox);
 	hbox2->pack_start (reset_button, true, true);
 
@@ -263,6 +277,34 @@ DspStatisticsGUI::update ()
 
 		ArdourWidgets::set_tooltip (labels[AudioEngine::ProcessCallback], buf);
 
+		/* Session scripts and Lua garbage collection, part of the session's process time */
+		for (int t = Session::LuaScripts; t <= Session::LuaGC; ++t) {
+			Label* l = labels[AudioEngine::NTT + t];
+
+			if (!_session->dsp_stats[t].get_stats (smin, smax, savg, sdev)) {
+				l->set_text (not_measured_string);
+				ArdourWidgets::set_tooltip (l, "");
+				continue;
+			}
+
+			if (smax > 1000) {
+				double maxf = smax / 1000.0;
+				snprintf (buf, sizeof (buf), "%7.2f %s %5.2f%%", maxf, str_msec, (100.0 * maxf) / bufsize_msecs);
+			} else {
+				snprintf (buf, sizeof (buf), "%" PRId64 " %s %5.2f%%", smax, str_usec, (100.0 * smax) / bufsize_usecs);
+			}
+			l->set_text (buf);
+
+			if (smax > 1000) {
+				devf = sdev / 1000.0;
+				avgf = savg / 1000.0;
+				snprintf (buf, sizeof (buf), "%s: %7.2f %s %5.2f%% (%s. %5.2f)", str_average, avgf, str_msec, (100.0 * avgf) / bufsize_msecs, str_std_dev, devf);
+			} else {
+				snprintf (buf, sizeof (buf), "%s: %7.2f %s %5.2f%% (%s. %5.2f)", str_average, savg, str_usec, (100.0 * savg) / bufsize_usecs, str_std_dev, sdev);
+			}
+			ArdourWidgets::set_tooltip (l, buf);
+		}
+
 	} else {
 
 		if (max > 1000) {
@@ -286,6 +328,11 @@ DspStatisticsGUI::update ()
 
 		labels[AudioEngine::NTT + Session::OverallProcess]->set_text (_("No session loaded"));
 		ArdourWidgets::set_tooltip (labels[AudioEngine::NTT + Session::OverallProcess], "");
+
+		for (int t = Session::LuaScripts; t <= Session::LuaGC; ++t) {
+			labels[AudioEngine::NTT + t]->set_text (not_measured_string);
+			ArdourWidgets::set_tooltip (labels[AudioEngine::NTT + t], "");
+		}
 	}
 }
 
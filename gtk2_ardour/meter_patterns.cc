@@ -115,6 +115,12 @@ ArdourMeter::meter_type_string (ARDOUR::MeterType mt)
 		case MeterVU:
 			return _("VU");
 			break;
+		case MeterTruePeak:
+			return _("True Peak");
+			break;
+		case MeterLUFS:
+			return _("LUFS");
+			break;
 		default:
 			assert(0);
 			return _("???");
@@ -791,6 +791,7 @@ RecorderUI::update_meters ()
 	for (PortManager::AudioInputPorts::const_iterator i = aip.begin (); i != aip.end (); ++i) {
 		InputPortMap::iterator im = _input_ports.find (i->first);
 		if (im != _input_ports.end()) {
+			im->second->set_meter (i->second.meter);
 			im->second->update (*(i->second.scope));
 		}
 	}
@@ -801,6 +802,7 @@ RecorderUI::update_meters ()
 			for (auto i = aip.begin (); i != aip.end (); ++i) {
 				InputPortMap::iterator im = _input_ports.find (i->first);
 				if (im != _input_ports.end()) {
+					im->second->set_meter (i->second.meter);
 					im->second->update (*(i->second.scope));
 				}
 			}
@@ -814,7 +816,8 @@ RecorderUI::update_meters ()
 	for (PortManager::AudioInputPorts::const_iterator i = aip.begin (); i != aip.end (); ++i) {
 		InputPortMap::iterator im = _input_ports.find (i->first);
 		if (im != _input_ports.end()) {
-			im->second->update (accurate_coefficient_to_dB (i->second.meter->level), accurate_coefficient_to_dB (i->second.meter->peak));
+			PortManager::DPM::Reading const r (i->second.meter->read ());
+			im->second->update (accurate_coefficient_to_dB (r.level), accurate_coefficient_to_dB (std::max (r.peak, r.true_peak)));
 		}
 	}
 
@@ -834,7 +837,8 @@ RecorderUI::update_meters ()
 			for (auto i = aip.begin (); i != aip.end (); ++i) {
 				InputPortMap::iterator im = _input_ports.find (i->first);
 				if (im != _input_ports.end()) {
-					im->second->update (accurate_coefficient_to_dB (i->second.meter->level), accurate_coefficient_to_dB (i->second.meter->peak));
+					PortManager::DPM::Reading const r (i->second.meter->read ());
+					im->second->update (accurate_coefficient_to_dB (r.level), accurate_coefficient_to_dB (std::max (r.peak, r.true_peak)));
 				}
 			}
 			for (PortManager::MIDIInputPorts::const_iterator i = mip.begin (); i != mip.end (); ++i) {
@@ -1384,6 +1388,7 @@ RecorderUI::InputPort::InputPort (string const& name, DataType dt, RecorderUI* p
 	, _port_name (name)
 	, _ioplug (ioplug)
 	, _solo_release (0)
+	, _subscribed (false)
 {
 	if (!_size_groups_initialized) {
 		_size_groups_initialized = true;
@@ -1494,9 +1499,54 @@ RecorderUI::InputPort::InputPort (string const& name, DataType dt, RecorderUI* p
 
 RecorderUI::InputPort::~InputPort ()
 {
+	set_subscribed (false);
 	delete _solo_release;
 }
 
+void
+RecorderUI::InputPort::on_map ()
+{
+	EventBox::on_map ();
+	set_subscribed (true);
+}
+
+void
+RecorderUI::InputPort::on_unmap ()
+{
+	set_subscribed (false);
+	EventBox::on_unmap ();
+}
+
+void
+RecorderUI::InputPort::set_meter (PortManager::AudioPortMeter const& m)
+{
+	if (_meter == m) {
+		return;
+	}
+	bool const subscribed = _subscribed;
+	set_subscribed (false);
+	_meter = m;
+	set_subscribed (subscribed);
+}
+
+/* the engine only computes meters that are subscribed to,
+ * which are the meters of ports that are visible.
+ */
+void
+RecorderUI::InputPort::set_subscribed (bool yn)
+{
+	if (yn == _subscribed || !_meter) {
+		_subscribed = yn;
+		return;
+	}
+	if (yn) {
+		_meter->subscribe ();
+	} else {
+		_meter->unsubscribe ();
+	}
+	_subscribed = yn;
+}
+
 void
 RecorderUI::InputPort::clear ()
 {
@@ -32,6 +32,7 @@
 
 #include "ardour/session_handle.h"
 #include "ardour/circular_buffer.h"
+#include "ardour/port_manager.h"
 #include "ardour/types.h"
 
 #include "gtkmm2ext/bindings.h"
@@ -207,6 +208,8 @@ private:
 			bool ioplug () const { return _ioplug; }
 			std::string const& name () const;
 
+			void set_meter (ARDOUR::PortManager::AudioPortMeter const&);
+
 			void update (float, float); // FastMeter
 			void update (float const*); // EventMeter
 			void update (ARDOUR::CircularSampleBuffer&); // InputScope
@@ -223,8 +226,13 @@ private:
 				return _dt < (uint32_t) o._dt;
 			}
 
+		protected:
+			void on_map ();
+			void on_unmap ();
+
 		private:
 			void rename_port ();
+			void set_subscribed (bool);
 			bool monitor_press (GdkEventButton*);
 			bool monitor_release (GdkEventButton*);
 
@@ -242,6 +250,9 @@ private:
 			ARDOUR::WeakRouteList       _connected_routes;
 			ARDOUR::SoloMuteRelease*    _solo_release;
 
+			ARDOUR::PortManager::AudioPortMeter _meter;
+			bool                                _subscribed;
+
 			static bool                         _size_groups_initialized;
 			static Glib::RefPtr<Gtk::SizeGroup> _name_size_group;
 			static Glib::RefPtr<Gtk::SizeGroup> _ctrl_size_group;
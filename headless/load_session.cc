@@ -132,6 +132,19 @@ print_version ()
 	    << endl;
 }
 
+static void
+print_load_times (Session const* s, int64_t total)
+{
+	Session::LoadTimes const& lt (s->load_times ());
+
+	cout << "Session loaded in " << total / 1000 << " ms\n"
+	     << "  parse:       " << lt.parse / 1000 << " ms\n"
+	     << "  routes:      " << lt.routes / 1000 << " ms\n"
+	     << "  plugins:     " << lt.plugins / 1000 << " ms ("
+	     << lt.n_plugins << " plugins, " << lt.n_preloaded << " instantiated concurrently)\n"
+	     << "  connections: " << lt.connect / 1000 << " ms\n";
+}
+
 static void
 print_help ()
 {
@@ -235,6 +248,8 @@ main (int argc, char* argv[])
 
 	Session* s = 0;
 
+	const int64_t load_start_time = g_get_monotonic_time ();
+
 	try {
 		s = load_session (argv[optind], argv[optind + 1]);
 	} catch (failed_constructor& e) {
@@ -251,6 +266,10 @@ main (int argc, char* argv[])
 		exit (EXIT_FAILURE);
 	}
 
+	if (s) {
+		print_load_times (s, g_get_monotonic_time () - load_start_time);
+	}
+
 	/* allow signal propagation, callback/thread-pool setup, etc
 	 * similar to to GUI "first idle"
 	 */
@@ -169,23 +169,35 @@ public:
 	/** Accumulate (add) \p len samples from the start of \p src into self at \p dst_offset
 	 * using a linear gain ramp from \p initial to \p target .
 	 */
-	void accumulate_with_ramped_gain_from (const Sample* src, samplecnt_t len, gain_t initial, gain_t target, sampleoffset_t dst_offset = 0)
+	void accumulate_with_ramped_gain_from (const AudioBuffer& src, samplecnt_t len, gain_t initial, gain_t target, sampleoffset_t dst_offset = 0)
 	{
 		assert (_capacity > 0);
 		assert (len <= _capacity);
 
-		if (initial == 0 && target == 0) {
+		if (src.silent () || (initial == 0 && target == 0)) {
 			return;
 		}
 
-		Sample* dst        = _data + dst_offset;
-		gain_t  gain_delta = (target - initial) / len;
+		mix_buffers_with_ramp (_data + dst_offset, src.data (), len, initial, target);
 
-		for (samplecnt_t n = 0; n < len; ++n) {
-			*dst++ += (*src++ * initial);
-			initial += gain_delta;
+		_silent  = (src.silent () && _silent);
+		_written = true;
+	}
+
+	/** Accumulate (add) \p len samples from the start of \p src into self at \p dst_offset
+	 * using a linear gain ramp from \p initial to \p target .
+	 */
+	void accumulate_with_ramped_gain_from (const Sample* src, samplecnt_t len, gain_t initial, gain_t target, sampleoffset_t dst_offset = 0)
+	{
+		assert (_capacity > 0);
+		assert (len <= _capacity);
+
+		if (initial == 0 && target == 0) {
+			return;
 		}
 
+		mix_buffers_with_ramp (_data + dst_offset, src, len, initial, target);
+
 		_silent  = (_silent && initial == 0 && target == 0);
 		_written = true;
 	}
@@ -62,6 +62,7 @@ class Playlist;
 class Session;
 class Filter;
 class AudioSource;
+class RegionFxCache;
 class RegionFxPlugin;
 class PlugInsertBase;
 
@@ -281,6 +282,13 @@ class LIBARDOUR_API AudioRegion : public Region, public AudioReadable
 	mutable samplecnt_t          _cache_tail;
 	mutable std::atomic<bool>    _invalidated;
 
+	/* rendered output of region FX, used with _cache_lock held */
+	RegionFxCache* fx_render_cache () const;
+	void copy_from_readcache (Sample*, uint32_t chan_n, samplecnt_t) const;
+
+	mutable std::unique_ptr<RegionFxCache> _fx_render_cache;
+	mutable bool                           _fx_render_cache_faded;
+
   protected:
 	/* default constructor for derived (compound) types */
 
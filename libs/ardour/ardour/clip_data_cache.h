@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <glibmm/threads.h>
+
+#include "pbd/id.h"
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace ARDOUR {
+
+class AudioRegion;
+
+/** Process-wide cache of audio clip data.
+ *
+ * Clips that use the same part of the same sources (e.g. a loop that is
+ * used in many scenes or in several TriggerBoxes) share a single, read-only
+ * copy of the data.
+ *
+ * Entries are reference-counted, the cache holds a reference itself so that
+ * data can be re-used when a clip is loaded again. Entries that are only
+ * referenced by the cache are "unused", the least recently used ones are
+ * evicted when unused data exceeds the given limit.
+ *
+ * Since the cache holds a reference to every entry that it knows about,
+ * users can drop their reference in realtime context, data is only ever
+ * freed by ::evict() or ::clear().
+ */
+class LIBARDOUR_API ClipDataCache
+{
+public:
+	struct LIBARDOUR_API Entry {
+		Entry (uint32_t n_chans, samplecnt_t capacity);
+		~Entry ();
+
+		size_t bytes () const { return data.size () * capacity * sizeof (Sample); }
+
+		std::vector<Sample*> data;
+		samplecnt_t length;   ///< length of the clip
+		samplecnt_t capacity; ///< samples held in memory, <= length
+
+	private:
+		Entry (Entry const&);
+	};
+
+	typedef std::shared_ptr<Entry const> EntryPtr;
+
+	struct LIBARDOUR_API Stats {
+		Stats () : hits (0), misses (0), evictions (0), entries (0), unused (0), bytes (0), unused_bytes (0) {}
+
+		uint64_t hits;
+		uint64_t misses;
+		uint64_t evictions;
+		size_t   entries;
+		size_t   unused;
+		size_t   bytes;        ///< total size of all cached data, including data that was superseded
+		size_t   unused_bytes; ///< size of data that is not used by any clip
+	};
+
+	static ClipDataCache& instance ();
+
+	/** Look up the data of the given region, or read it from disk.
+	 * This is not realtime safe.
+	 *
+	 * @param ar the region to read
+	 * @param capacity number of samples to read, at most the region's length.
+	 * Cached data is used if it holds at least as many samples.
+	 * @return the data, or a null pointer if it cannot be read
+	 */
+	EntryPtr get (std::shared_ptr<AudioRegion const> ar, samplecnt_t capacity);
+
+	/** Free least recently used entries until the size of unused data
+	 * is at most @a max_unused bytes.
+	 */
+	void evict (size_t max_unused);
+
+	/** Free all unused entries */
+	void clear () { evict (0); }
+
+	Stats stats () const;
+
+private:
+	ClipDataCache ();
+
+	struct Key {
+		std::vector<PBD::ID> sources;
+		samplepos_t          start;
+		samplecnt_t          length;
+
+		bool operator< (Key const&) const;
+	};
+
+	struct Item {
+		std::shared_ptr<Entry> entry;
+		uint64_t               last_used;
+	};
+
+	typedef std::map<Key, Item> Items;
+
+	mutable Glib::Threads::Mutex         _lock;
+	Items                                _items;
+	std::vector<std::shared_ptr<Entry> > _retired; ///< replaced by larger entries, but still in use
+	uint64_t                             _serial;
+	Stats                                _stats;
+};
+
+} // namespace ARDOUR
@@ -18,8 +18,13 @@
 #ifndef _ardour_convolver_h_
 #define _ardour_convolver_h_
 
+#include <map>
+#include <memory>
+#include <string>
 #include <vector>
 
+#include <glibmm/threads.h>
+
 #include "zita-convolver/zita-convolver.h"
 
 #include "ardour/libardour_visibility.h"
@@ -60,7 +65,15 @@ public:
 	void run_mono_no_latency (float*, uint32_t);
 
 protected:
-	ArdourZita::Convproc _convproc;
+	/* The shared IR partitions must outlive _convproc, which links to them */
+	std::shared_ptr<ArdourZita::Convproc const> _shared_impdata;
+	ArdourZita::Convproc                         _convproc;
+
+	/** Identifies the impulse-response data, used as key for the
+	 * cache of pre-processed IR partitions. Instances with an empty ID
+	 * do not share their data.
+	 */
+	std::string _impdata_id;
 
 	uint32_t _n_samples;
 	uint32_t _max_size;
@@ -107,6 +120,10 @@ private:
 			return _readable->n_channels ();
 		}
 
+		sampleoffset_t offset () const  { return _offset; }
+		samplecnt_t    length () const  { return _length; }
+		uint32_t       channel () const { return _channel; }
+
 	private:
 		std::shared_ptr<AudioReadable> _readable;
 
@@ -115,9 +132,31 @@ private:
 		uint32_t       _channel;
 	};
 
+	int         configure (ArdourZita::Convproc&, uint32_t n_part) const;
+	int         create_impdata (ArdourZita::Convproc&) const;
+	std::string impdata_key (uint32_t n_part) const;
+
+	std::shared_ptr<ArdourZita::Convproc const> shared_impdata (uint32_t n_part);
+	std::shared_ptr<ArdourZita::Convproc const> load_impdata (uint32_t n_part, std::string const& key) const;
+	static void prune_impdata_cache (std::string const& dir, std::string const& keep);
+
 	std::vector<ImpData> _impdata;
 	uint32_t             _n_inputs;
 	uint32_t             _n_outputs;
+
+	/** cache entry, pending while the partitions are computed or loaded */
+	struct ImpDataEntry {
+		ImpDataEntry () : pending (true) {}
+
+		std::weak_ptr<ArdourZita::Convproc const> impdata;
+		bool                                      pending;
+		Glib::Threads::Cond                       cond;
+	};
+
+	typedef std::map<std::string, std::shared_ptr<ImpDataEntry> > ImpDataCache;
+
+	static Glib::Threads::Mutex _impdata_cache_lock;
+	static ImpDataCache         _impdata_cache;
 };
 
 class LIBARDOUR_API Convolver : public Convolution
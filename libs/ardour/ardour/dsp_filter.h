@@ -21,6 +21,7 @@
 #include <atomic>
 #include <cstdint>
 #include <cstring>
+#include <vector>
 #include <assert.h>
 #include <glib.h>
 #include <glibmm.h>
@@ -162,6 +163,66 @@ namespace ARDOUR { namespace DSP {
 	 */
 	void peaks (const float *data, float &min, float &max, uint32_t n_samples);
 
+	/** subtract every sample of `src' from the corresponding sample of `data'.
+	 *
+	 * @param data minuend, result
+	 * @param src subtrahend
+	 * @param n_samples number of samples in data and src
+	 */
+	void subtract (float *data, const float *src, const uint32_t n_samples);
+	/** multiply and accumulate: data += a * b, sample by sample.
+	 *
+	 * @param data accumulator
+	 * @param a multiplicand
+	 * @param b multiplicand
+	 * @param n_samples number of samples in data, a and b
+	 */
+	void multiply_add (float *data, const float *a, const float *b, const uint32_t n_samples);
+	/** scale and offset: data = data * gain + offset.
+	 *
+	 * @param data data to process
+	 * @param gain multiplier
+	 * @param offset value to add after scaling
+	 * @param n_samples number of samples to process
+	 */
+	void scale_offset (float *data, const float gain, const float offset, const uint32_t n_samples);
+	/** limit every sample to the given range
+	 *
+	 * @param data data to process
+	 * @param min lower bound
+	 * @param max upper bound
+	 * @param n_samples number of samples to process
+	 */
+	void clamp (float *data, const float min, const float max, const uint32_t n_samples);
+	/** full-wave rectify: replace every sample with its absolute value
+	 *
+	 * @param data data to process
+	 * @param n_samples number of samples to process
+	 */
+	void rectify (float *data, const uint32_t n_samples);
+	/** calculate root mean square
+	 *
+	 * @param data data to analyze
+	 * @param n_samples number of samples to analyze
+	 * @returns RMS of the given data, 0 if n_samples is zero
+	 */
+	float rms (const float *data, const uint32_t n_samples);
+	/** linear interpolation, e.g. for variable-rate playback or delay-lines
+	 *
+	 * Read `n_samples' values from `src', starting at (fractional) position
+	 * `pos', advancing by `step' for every output sample. Positions outside
+	 * of the source data read as zero.
+	 *
+	 * @param dst destination
+	 * @param src source data
+	 * @param src_len number of samples in src
+	 * @param pos start position in src
+	 * @param step position increment per output sample
+	 * @param n_samples number of samples to write to dst
+	 * @returns position after the last sample that was written
+	 */
+	double interpolate (float *dst, const float *src, const uint32_t src_len, double pos, const double step, const uint32_t n_samples);
+
 	/** non-linear power-scale meter deflection
 	 *
 	 * @param power signal power (dB)
@@ -218,6 +279,88 @@ namespace ARDOUR { namespace DSP {
 			float _a;
 	};
 
+	/** Envelope Follower
+	 *
+	 * Peak envelope with separate attack and release time-constants,
+	 * e.g. for compressors, gates and side-chain effects.
+	 */
+	class LIBARDOUR_API EnvelopeFollower {
+		public:
+			/** instantiate an envelope follower
+			 *
+			 * @param samplerate samplerate
+			 * @param attack attack time in milliseconds
+			 * @param release release time in milliseconds
+			 */
+			EnvelopeFollower (double samplerate, float attack = 10.f, float release = 100.f);
+			/** process audio data
+			 *
+			 * @param data audio data to analyze
+			 * @param env destination for the envelope, may be the same as data, or NULL
+			 * @param n_samples number of samples to process
+			 * @returns envelope level after processing
+			 */
+			float run (float const *data, float *env, const uint32_t n_samples);
+			/** update attack and release times
+			 *
+			 * @param attack attack time in milliseconds
+			 * @param release release time in milliseconds
+			 */
+			void set_times (float attack, float release);
+			/** current envelope level */
+			float level () const { return _z; }
+			/** reset filter state */
+			void reset () { _z = 0.f; }
+		private:
+			float _rate;
+			float _z;
+			float _att;
+			float _rel;
+	};
+
+	/** FIR Filter
+	 *
+	 * Direct convolution with a short impulse-response, e.g. for
+	 * interpolation, oversampling or crossover filters.
+	 * For long impulse-responses use ARDOUR::DSP::Convolution instead.
+	 */
+	class LIBARDOUR_API FIRFilter {
+		public:
+			/** instantiate a FIR Filter
+			 *
+			 * @param n_taps max number of coefficients
+			 */
+			FIRFilter (uint32_t n_taps);
+			~FIRFilter ();
+
+			/** set filter coefficients
+			 *
+			 * @param coeff coefficients, coeff[0] applies to the most recent sample
+			 * @param n_taps number of coefficients, at most the number given to the c'tor
+			 * @returns false if too many coefficients were given
+			 */
+			bool set_coefficients (float const *coeff, const uint32_t n_taps);
+			/** process audio data
+			 *
+			 * @param data pointer to audio-data, processed in-place
+			 * @param n_samples number of samples to process
+			 */
+			void run (float *data, const uint32_t n_samples);
+			/** reset filter state */
+			void reset ();
+
+			uint32_t n_taps () const { return _n_taps; }
+
+		private:
+			FIRFilter (FIRFilter const&);
+
+			uint32_t _max_taps;
+			uint32_t _n_taps;
+			uint32_t _pos;
+			float*   _coeff;
+			float*   _hist;
+	};
+
 	/** Biquad Filter */
 	class LIBARDOUR_API Biquad {
 		public:
@@ -285,6 +428,85 @@ namespace ARDOUR { namespace DSP {
 			double _b0, _b1, _b2;
 	};
 
+	/** Multi-Channel Biquad Filter Cascade
+	 *
+	 * Process many channels at once, using one SIMD vector-lane per
+	 * channel (4, 8 or 16 channels in parallel depending on the CPU).
+	 * Every channel has its own cascade of n_stages Biquad sections,
+	 * each with its own coefficients.
+	 */
+	class LIBARDOUR_API MultiBiquad {
+		public:
+			/** Instantiate Multi-Channel Biquad Filter
+			 *
+			 * @param samplerate Samplerate
+			 * @param n_channels number of channels
+			 * @param n_stages number of Biquad sections per channel
+			 */
+			MultiBiquad (double samplerate, uint32_t n_channels, uint32_t n_stages = 1);
+			~MultiBiquad ();
+
+			uint32_t n_channels () const { return _n_channels; }
+			uint32_t n_stages () const { return _n_stages; }
+
+			/** process interleaved audio data
+			 *
+			 * @param data pointer to interleaved audio-data (n_channels samples per frame)
+			 * @param n_frames number of frames to process
+			 */
+			void run_interleaved (float* data, const uint32_t n_frames);
+
+			/** process non-interleaved audio data
+			 *
+			 * @param data array of n_channels pointers to audio-data
+			 * @param n_samples number of samples to process
+			 */
+			void run (float* const* data, const uint32_t n_samples);
+
+			/** setup filter of one channel, compute coefficients
+			 *
+			 * @param chn channel
+			 * @param stage Biquad section
+			 * @param t filter type (LowPass, HighPass, etc)
+			 * @param freq filter frequency
+			 * @param Q filter quality
+			 * @param gain filter gain
+			 */
+			void compute (uint32_t chn, uint32_t stage, Biquad::Type t, double freq, double Q, double gain);
+
+			/** setup filter of all channels, compute coefficients */
+			void compute_all (uint32_t stage, Biquad::Type t, double freq, double Q, double gain);
+
+			/** setup filter of one channel, copy coefficients from given Biquad */
+			void configure (uint32_t chn, uint32_t stage, Biquad const&);
+
+			/** filter transfer function of a channel's cascade
+			 * @param chn channel
+			 * @param freq frequency
+			 * @return gain at given frequency in dB (clamped to -120..+120)
+			 */
+			float dB_at_freq (uint32_t chn, float freq) const;
+
+			/** reset filter state */
+			void reset ();
+
+		private:
+			void set_coefficients (uint32_t chn, uint32_t stage);
+			void flush_denormals ();
+
+			double   _rate;
+			uint32_t _n_channels;
+			uint32_t _n_stages;
+
+			std::vector<Biquad> _filters;
+
+			float* _coeff;
+			float* _state;
+			float* _interleaved;
+
+			static const uint32_t _block_size;
+	};
+
 	class LIBARDOUR_API SpectrumAnalyzer {
 	public:
 		virtual ~SpectrumAnalyzer () {}
@@ -27,6 +27,9 @@
 
 #include "audiographer/utils/identity_vertex.h"
 
+#include <atomic>
+#include <map>
+
 #include <boost/ptr_container/ptr_list.hpp>
 #include <glibmm/threadpool.h>
 
@@ -52,6 +55,7 @@ namespace AudioGrapher {
 namespace ARDOUR
 {
 
+class Buffer;
 class ExportTimespan;
 class MidiBuffer;
 class Session;
@@ -89,7 +93,7 @@ class LIBARDOUR_API ExportGraphBuilder
 	ExportGraphBuilder (Session const & session);
 	~ExportGraphBuilder ();
 
-	samplecnt_t process (samplecnt_t samples, bool last_cycle);
+	samplecnt_t process (samplecnt_t samples, samplepos_t position, bool last_cycle);
 	bool post_process (); // returns true when finished
 	bool need_postprocessing () const { return !intermediates.empty(); }
 	bool realtime() const { return _realtime; }
@@ -105,6 +109,8 @@ class LIBARDOUR_API ExportGraphBuilder
 		return _exported_files;
 	}
 
+	std::vector<std::string> exported_files (std::shared_ptr<ExportTimespan> span) const;
+
   private:
 
 	void add_analyser (const std::string& fn, AnalysisPtr ap) {
@@ -113,9 +119,11 @@ class LIBARDOUR_API ExportGraphBuilder
 
 	void add_export_fn (std::string const& fn) {
 		_exported_files.push_back (fn);
+		_timespan_files.insert (std::make_pair (timespan, fn));
 	}
 
 	std::vector<std::string> _exported_files;
+	std::multimap<std::shared_ptr<ExportTimespan>, std::string> _timespan_files;
 
 	void add_split_config (FileSpec const & config);
 
@@ -297,15 +305,49 @@ class LIBARDOUR_API ExportGraphBuilder
 		samplecnt_t               max_samples_out;
 	};
 
+	typedef boost::ptr_list<ChannelConfig> ChannelConfigList;
+
+	// Roots for export processor trees of a timespan
+	struct Span {
+		Span (std::shared_ptr<ExportTimespan> ts) : timespan (ts), done (false) {}
+
+		std::shared_ptr<ExportTimespan> timespan;
+		ChannelConfigList               channel_configs;
+		ChannelMap                      channels;
+		bool                            done;
+	};
+
+	// A timespan to process, or an Intermediate to post-process
+	struct Job {
+		Job (Span& s, sampleoffset_t o, samplecnt_t n, bool l)
+			: span (&s), intermediate (0), off (o), samples (n), last_cycle (l), done (false) {}
+		Job (Intermediate& i)
+			: span (0), intermediate (&i), off (0), samples (0), last_cycle (false), done (false) {}
+
+		Span*          span;
+		Intermediate*  intermediate;
+		sampleoffset_t off;
+		samplecnt_t    samples;
+		bool           last_cycle;
+		bool           done;
+	};
+
+	void process_span (Span&, sampleoffset_t off, samplecnt_t samples, bool last_cycle);
+	void run_job (Job&);
+	void run_jobs ();
+	void run_concurrently ();
+
 	Session const & session;
+
+	// The timespan that is currently being configured
 	std::shared_ptr<ExportTimespan> timespan;
 
-	// Roots for export processor trees
-	typedef boost::ptr_list<ChannelConfig> ChannelConfigList;
-	ChannelConfigList channel_configs;
+	// Timespans that are exported in the same pass
+	boost::ptr_list<Span> spans;
 
 	// The sources of all data, each channel is read only once
-	ChannelMap channels;
+	typedef std::map<ExportChannelPtr, Buffer const*> ChannelBufferMap;
+	ChannelBufferMap channel_buffers;
 
 	samplecnt_t process_buffer_samples;
 
@@ -316,8 +358,20 @@ class LIBARDOUR_API ExportGraphBuilder
 	bool        _realtime;
 	samplecnt_t _master_align;
 
-	Glib::ThreadPool     thread_pool;
 	Glib::Threads::Mutex engine_request_lock;
+
+	// Concurrent processing of timespans and post-processing,
+	// storage is reserved when timespans and intermediates are added
+	std::vector<Job>     jobs;
+	std::atomic<int>     job_next;
+	std::atomic<int>     job_count;
+	std::atomic<int>     job_done;
+	Glib::Threads::Mutex job_mutex;
+	Glib::Threads::Cond  job_cond;
+	std::string          job_error;
+
+	// destroyed first, tasks that are still queued may access jobs
+	Glib::ThreadPool     thread_pool;
 };
 
 } // namespace ARDOUR
@@ -25,13 +25,16 @@
 
 #include <map>
 #include <memory>
+#include <set>
 
 #include <boost/operators.hpp>
 
 #include "pbd/gstdio_compat.h"
+#include "pbd/microseconds.h"
 #include "pbd/pthread_utils.h"
 
 #include "ardour/export_pointers.h"
+#include "ardour/export_status.h"
 #include "ardour/session.h"
 #include "ardour/libardour_visibility.h"
 #include "ardour/types.h"
@@ -159,12 +162,24 @@ class LIBARDOUR_API ExportHandler : public ExportElementFactory, public sigc::tr
 	int  post_process ();
 	void finish_timespan ();
 
+	bool single_pass_capable (ExportTimespanPtr) const;
+	void collect_timespans ();
+
+	void add_stage_stats (ExportStatus::Progress);
+	void report_stage_stats () const;
+
 	typedef std::pair<ConfigMap::iterator, ConfigMap::iterator> TimespanBounds;
 	ExportTimespanPtr     current_timespan;
 	TimespanBounds        timespan_bounds;
 
+	/* timespans rendered in the current pass (incl. current_timespan) */
+	std::set<ExportTimespanPtr> current_timespans;
+	samplepos_t                 pass_start;
+	samplepos_t                 pass_end;
+
 	PBD::ScopedConnection process_connection;
 	samplepos_t           process_position;
+	PBD::microseconds_t   stage_start;
 
 	/* CD Marker stuff */
 
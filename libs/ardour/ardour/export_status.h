@@ -84,6 +84,23 @@ class LIBARDOUR_API ExportStatus {
 
 	AnalysisResults         result_map;
 
+	/* Throughput info */
+
+	struct StageStats {
+		StageStats () : samples (0), usecs (0) {}
+		samplecnt_t samples;
+		int64_t     usecs;
+
+		/** session-time rendered per wall-clock time */
+		double realtime_factor (samplecnt_t sample_rate) const {
+			return usecs > 0 ? (1e6 * samples / (double) sample_rate) / usecs : 0;
+		}
+	};
+
+	StageStats              stage_stats[Command + 1];
+
+	static const char* stage_name (Progress);
+
   private:
 	volatile bool          _aborted;
 	volatile bool          _errors;
@@ -47,6 +47,7 @@ class Graph;
 class IOPlug;
 class Route;
 class RTTaskList;
+class RTSubTask;
 class Session;
 class GraphEdges;
 
@@ -93,6 +94,12 @@ public:
 	/* RTTasks */
 	void process_tasklist (RTTaskList const&);
 
+	/* RTSubTasks, called from within a running graph */
+	uint32_t trigger_idle (std::vector<RTSubTask*> const&, size_t first);
+
+	/** true if the calling thread is a process-graph thread */
+	static bool in_graph_thread () { return _in_graph_thread; }
+
 protected:
 	virtual void session_going_away ();
 
@@ -126,6 +133,8 @@ private:
 	/* number of background worker threads >= 0 */
 	std::atomic<uint32_t> _n_workers;
 
+	static thread_local bool _in_graph_thread;
+
 	/* flag to terminate background threads */
 	std::atomic<int> _terminate;
 
@@ -40,6 +40,7 @@ public:
 	virtual void clear () {
 		sources.clear ();
 		paths.clear ();
+		file_progress.clear ();
 	}
 
 	std::string doing_what;
@@ -55,6 +56,13 @@ public:
 	bool                       import_markers;
 	MidiTrackNameSource        midi_track_name_source;
 
+	/** progress of each file (0..1), in the same order as @a paths.
+	 * Files may be imported concurrently, in which case @a progress is
+	 * the sum of progress of the files that are being imported, so that
+	 * (current - 1 + progress) / total remains the overall progress.
+	 */
+	std::vector<float> file_progress;
+
 	/** set to true when all files have been imported, as distinct from the done in ARDOUR::InterThreadInfo,
 	 *  which indicates that one run of the import thread has been completed.
 	 */
@@ -52,6 +52,8 @@ private:
 	std::list<InternalSend*> _sends;
 	/** mutex to protect _sends */
 	Glib::Threads::Mutex _sends_mutex;
+	/** buffers of active sends, collected in ::run */
+	std::vector<BufferSet const*> _send_buffers;
 };
 
 } // namespace ARDOUR
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __LOUDNESSMETERDSP_H
+#define __LOUDNESSMETERDSP_H
+
+#include <cstdint>
+
+#include "ardour/libardour_visibility.h"
+
+/** Live ITU-R BS.1770 meter: per-channel true-peak and
+ * momentary (400ms) / short-term (3s) loudness of all channels.
+ *
+ * Unlike ARDOUR::LUFSMeter (which is meant for offline analysis)
+ * all channels are processed block-wise: the K-weighting filters of all
+ * channels run in a single interleaved ARDOUR::biquad_cascade, and the
+ * polyphase true-peak interpolator shares its coefficients across
+ * channels, with the inner loops running over samples (vectorizable).
+ */
+class LIBARDOUR_API Loudnessmeterdsp
+{
+public:
+
+    Loudnessmeterdsp (float fsamp, uint32_t n_channels);
+    ~Loudnessmeterdsp (void);
+
+    /** @param p array of (at least) @a n_channels pointers to audio data,
+     *  excess channels of the meter are treated as silent.
+     */
+    void process (float const* const* p, uint32_t n_channels, uint32_t n);
+
+    /** @return highest true-peak (coefficient) of given channel since last call */
+    float read_true_peak (uint32_t chn);
+
+    float momentary () const  { return _momentary; }  // LUFS, 400ms
+    float short_term () const { return _short_term; } // LUFS, 3s
+
+    uint32_t n_channels () const { return _n_channels; }
+
+    void reset ();
+
+private:
+    void  k_weight (float const* const* p, uint32_t n_channels, uint32_t off, uint32_t n);
+    void  true_peak (float const* const* p, uint32_t n_channels, uint32_t off, uint32_t n);
+    float sumfrag (uint32_t n_frag) const;
+
+    uint32_t _n_channels;
+    uint32_t _n_fragment;     // 100ms
+    bool     _x4;             // 4x upsampling, 2x above 48kHz
+
+    float*   _coeff;          // K-weighting, 2 biquad stages per channel
+    float*   _state;          // biquad_cascade state
+    float*   _weight;         // per channel power weight
+    float*   _interleaved;    // K-weighted scratch buffer
+
+    float*   _hist;           // per channel: interpolator history + block
+    float*   _upsampled;      // interpolated samples of one phase
+    float*   _tp;             // per channel max true-peak since last read
+    bool*    _flag;           // per channel, set by read_true_peak ()
+
+    uint32_t _frag_pos;
+    float    _frag_pwr;
+    float    _power[32];      // fragment power ring-buffer
+    uint32_t _pow_idx;
+    float    _momentary;
+    float    _short_term;
+
+    static const uint32_t _block_size = 256;
+    static const uint32_t _n_taps     = 48;
+};
+
+#endif
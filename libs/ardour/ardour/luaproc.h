@@ -231,6 +231,9 @@ class LIBARDOUR_API LuaPluginInfo : public PluginInfo
 		return _max_outputs;
 	}
 
+	/* every instance has its own interpreter */
+	bool concurrent_instantiation () const { return true; }
+
 	void set_factory_presets (std::vector<Plugin::PresetRecord> const& p) {
 		_factory_presets = p;
 	}
@@ -415,6 +415,8 @@ public:
 	PluginPtr load (Session& session);
 	std::vector<Plugin::PresetRecord> get_presets (bool user_only) const;
 
+	bool concurrent_instantiation () const;
+
 	bool is_instrument () const;
 	bool is_utility () const;
 	bool is_analyzer () const;
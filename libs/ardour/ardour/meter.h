@@ -33,6 +33,7 @@
 #include "ardour/iec1ppmdsp.h"
 #include "ardour/iec2ppmdsp.h"
 #include "ardour/kmeterdsp.h"
+#include "ardour/loudnessmeterdsp.h"
 #include "ardour/vumeterdsp.h"
 
 namespace ARDOUR {
@@ -82,6 +83,12 @@ public:
 
 	float meter_level (uint32_t n, MeterType type);
 
+	/** ITU-R BS.1770 loudness of all audio channels, requires MeterLUFS
+	 * to be enabled. These are also reported by meter_level() for every channel.
+	 */
+	float momentary_loudness () const;
+	float short_term_loudness () const;
+
 	void      set_meter_type (MeterType t);
 	MeterType meter_type () const { return _meter_type; }
 
@@ -113,6 +120,9 @@ private:
 	std::vector<Iec2ppmdsp*> _iec2meter;
 	std::vector<Vumeterdsp*> _vumeter;
 
+	Loudnessmeterdsp*         _loudness;
+	std::vector<float const*> _loudness_data;
+
 	MeterType _meter_type;
 };
 
@@ -62,6 +62,12 @@ public:
 
 	bool insert_event(const Evoral::Event<TimeType>& event);
 	bool merge_in_place(const MidiBuffer &other);
+	bool merge_in_place(MidiBuffer const* const* src, size_t n_src);
+
+	/** Number of buffers merge_in_place() merges in a single pass
+	 * (excluding this buffer). Larger sets are merged in chunks.
+	 */
+	static const size_t max_merge_sources = 64;
 
 	/** EventSink interface for non-RT use (export, bounce). */
 	uint32_t write(TimeType time, Evoral::EventType type, uint32_t size, const uint8_t* buf);
@@ -27,6 +27,7 @@
 #include <map>
 #include <queue>
 #include <utility>
+#include <vector>
 
 #include <glibmm/threads.h>
 
@@ -146,15 +147,20 @@ public:
 
 		static Variant::Type value_type (Property prop);
 
+		/** A change of a note property. Values are stored as integers,
+		 * times as ticks, which is much smaller than a Variant.
+		 */
 		struct NoteChange {
 			NoteDiffCommand::Property property;
 			NotePtr note;
 			uint32_t note_id;
-			Variant old_value;
-			Variant new_value;
+			int64_t old_value;
+			int64_t new_value;
 		};
 
-		typedef std::list<NoteChange>                                    ChangeList;
+		static int64_t change_value (Property prop, const Variant& value);
+
+		typedef std::vector<NoteChange>                                  ChangeList;
 		typedef std::list< std::shared_ptr< Evoral::Note<TimeType> > > NoteList;
 
 		const ChangeList& changes()       const { return _changes; }
@@ -171,6 +177,11 @@ public:
 		XMLNode &marshal_change(const NoteChange&) const;
 		NoteChange unmarshal_change(XMLNode *xml_note);
 
+		void find_changed_notes ();
+		bool reindex_in_place (size_t n_notes) const;
+		static void set_value (const NotePtr& note, Property prop, int64_t value);
+		static bool is_indexed (Property prop);
+
 		XMLNode &marshal_note(const NotePtr note) const;
 		NotePtr unmarshal_note(XMLNode *xml_note);
 	};
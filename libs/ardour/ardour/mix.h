@@ -33,6 +33,18 @@ extern "C" {
 }
 
 LIBARDOUR_API void x86_sse_find_peaks              (float const* buf, uint32_t nsamples, float* min, float* max);
+LIBARDOUR_API void x86_sse_biquad_cascade          (float* buf, uint32_t n_channels, uint32_t nframes, uint32_t n_stages, float const* coeff, float* state);
+LIBARDOUR_API float x86_sse_apply_gain_ramp        (float* buf, uint32_t nframes, float initial, float target, float coeff);
+LIBARDOUR_API void x86_sse_mix_buffers_with_ramp   (float* dst, float const* src, uint32_t nframes, float initial, float target);
+LIBARDOUR_API void x86_sse_interleave              (float* dst, float const* src, uint32_t nframes, uint32_t stride);
+LIBARDOUR_API void x86_sse_deinterleave            (float* dst, float const* src, uint32_t nframes, uint32_t stride);
+LIBARDOUR_API float x86_sse_sum_of_squares         (float const* buf, uint32_t nframes);
+LIBARDOUR_API void x86_sse_subtract_buffers        (float* dst, float const* src, uint32_t nframes);
+LIBARDOUR_API void x86_sse_multiply_add_buffers    (float* dst, float const* a, float const* b, uint32_t nframes);
+LIBARDOUR_API void x86_sse_scale_offset_buffer     (float* buf, uint32_t nframes, float gain, float offset);
+LIBARDOUR_API void x86_sse_clamp_buffer            (float* buf, uint32_t nframes, float min, float max);
+LIBARDOUR_API void x86_sse_rectify_buffer          (float* buf, uint32_t nframes);
+LIBARDOUR_API float x86_sse_dot_product            (float const* a, float const* b, uint32_t n);
 
 extern "C" {
 /* AVX functions */
@@ -52,6 +64,19 @@ LIBARDOUR_API void x86_sse_avx_find_peaks               (float const* buf, uint3
 /* FMA functions */
 #ifdef FPU_AVX_FMA_SUPPORT
 LIBARDOUR_API void  x86_fma_mix_buffers_with_gain       (float* dst, float const* src, uint32_t nframes, float gain);
+LIBARDOUR_API void  x86_fma_biquad_cascade              (float* buf, uint32_t n_channels, uint32_t nframes, uint32_t n_stages, float const* coeff, float* state);
+LIBARDOUR_API float x86_fma_apply_gain_ramp             (float* buf, uint32_t nframes, float initial, float target, float coeff);
+LIBARDOUR_API void  x86_fma_mix_buffers_with_ramp       (float* dst, float const* src, uint32_t nframes, float initial, float target);
+LIBARDOUR_API void  x86_fma_float_to_s16                (int16_t* dst, float const* src, uint32_t nframes);
+LIBARDOUR_API void  x86_fma_float_to_s24                (int32_t* dst, float const* src, uint32_t nframes);
+LIBARDOUR_API float x86_fma_sum_of_squares              (float const* buf, uint32_t nframes);
+LIBARDOUR_API void  x86_fma_subtract_buffers            (float* dst, float const* src, uint32_t nframes);
+LIBARDOUR_API void  x86_fma_multiply_add_buffers        (float* dst, float const* a, float const* b, uint32_t nframes);
+LIBARDOUR_API void  x86_fma_scale_offset_buffer         (float* buf, uint32_t nframes, float gain, float offset);
+LIBARDOUR_API void  x86_fma_clamp_buffer                (float* buf, uint32_t nframes, float min, float max);
+LIBARDOUR_API void  x86_fma_rectify_buffer              (float* buf, uint32_t nframes);
+LIBARDOUR_API float x86_fma_dot_product                 (float const* a, float const* b, uint32_t n);
+LIBARDOUR_API double x86_fma_interpolate_buffer         (float* dst, float const* src, uint32_t src_len, double pos, double step, uint32_t nframes);
 #endif
 
 /* AVX512F functions */
@@ -62,6 +87,21 @@ LIBARDOUR_API void  x86_avx512f_mix_buffers_with_gain   (float* dst, float const
 LIBARDOUR_API void  x86_avx512f_mix_buffers_no_gain     (float* dst, float const* src, uint32_t nframes);
 LIBARDOUR_API void  x86_avx512f_copy_vector             (float* dst, float const* src, uint32_t nframes);
 LIBARDOUR_API void  x86_avx512f_find_peaks              (float const* buf, uint32_t nsamples, float* min, float* max);
+LIBARDOUR_API void  x86_avx512f_biquad_cascade          (float* buf, uint32_t n_channels, uint32_t nframes, uint32_t n_stages, float const* coeff, float* state);
+LIBARDOUR_API float x86_avx512f_apply_gain_ramp         (float* buf, uint32_t nframes, float initial, float target, float coeff);
+LIBARDOUR_API void  x86_avx512f_mix_buffers_with_ramp   (float* dst, float const* src, uint32_t nframes, float initial, float target);
+LIBARDOUR_API void  x86_avx512f_interleave              (float* dst, float const* src, uint32_t nframes, uint32_t stride);
+LIBARDOUR_API void  x86_avx512f_deinterleave            (float* dst, float const* src, uint32_t nframes, uint32_t stride);
+LIBARDOUR_API void  x86_avx512f_float_to_s16            (int16_t* dst, float const* src, uint32_t nframes);
+LIBARDOUR_API void  x86_avx512f_float_to_s24            (int32_t* dst, float const* src, uint32_t nframes);
+LIBARDOUR_API float x86_avx512f_sum_of_squares          (float const* buf, uint32_t nframes);
+LIBARDOUR_API void  x86_avx512f_subtract_buffers        (float* dst, float const* src, uint32_t nframes);
+LIBARDOUR_API void  x86_avx512f_multiply_add_buffers    (float* dst, float const* a, float const* b, uint32_t nframes);
+LIBARDOUR_API void  x86_avx512f_scale_offset_buffer     (float* buf, uint32_t nframes, float gain, float offset);
+LIBARDOUR_API void  x86_avx512f_clamp_buffer            (float* buf, uint32_t nframes, float min, float max);
+LIBARDOUR_API void  x86_avx512f_rectify_buffer          (float* buf, uint32_t nframes);
+LIBARDOUR_API float x86_avx512f_dot_product             (float const* a, float const* b, uint32_t n);
+LIBARDOUR_API double x86_avx512f_interpolate_buffer     (float* dst, float const* src, uint32_t src_len, double pos, double step, uint32_t nframes);
 #endif
 
 /* debug wrappers for SSE functions */
@@ -93,6 +133,20 @@ extern "C" {
 	LIBARDOUR_API void  arm_neon_find_peaks            (float const* src, uint32_t nframes, float* minf, float* maxf);
 	LIBARDOUR_API void  arm_neon_mix_buffers_no_gain   (float* dst, float const* src, uint32_t nframes);
 	LIBARDOUR_API void  arm_neon_mix_buffers_with_gain (float* dst, float const* src, uint32_t nframes, float gain);
+	LIBARDOUR_API void  arm_neon_biquad_cascade        (float* buf, uint32_t n_channels, uint32_t nframes, uint32_t n_stages, float const* coeff, float* state);
+	LIBARDOUR_API float arm_neon_apply_gain_ramp       (float* buf, uint32_t nframes, float initial, float target, float coeff);
+	LIBARDOUR_API void  arm_neon_mix_buffers_with_ramp (float* dst, float const* src, uint32_t nframes, float initial, float target);
+	LIBARDOUR_API void  arm_neon_interleave            (float* dst, float const* src, uint32_t nframes, uint32_t stride);
+	LIBARDOUR_API void  arm_neon_deinterleave          (float* dst, float const* src, uint32_t nframes, uint32_t stride);
+	LIBARDOUR_API void  arm_neon_float_to_s16          (int16_t* dst, float const* src, uint32_t nframes);
+	LIBARDOUR_API void  arm_neon_float_to_s24          (int32_t* dst, float const* src, uint32_t nframes);
+	LIBARDOUR_API float arm_neon_sum_of_squares        (float const* buf, uint32_t nframes);
+	LIBARDOUR_API void  arm_neon_subtract_buffers      (float* dst, float const* src, uint32_t nframes);
+	LIBARDOUR_API void  arm_neon_multiply_add_buffers  (float* dst, float const* a, float const* b, uint32_t nframes);
+	LIBARDOUR_API void  arm_neon_scale_offset_buffer   (float* buf, uint32_t nframes, float gain, float offset);
+	LIBARDOUR_API void  arm_neon_clamp_buffer          (float* buf, uint32_t nframes, float min, float max);
+	LIBARDOUR_API void  arm_neon_rectify_buffer        (float* buf, uint32_t nframes);
+	LIBARDOUR_API float arm_neon_dot_product           (float const* a, float const* b, uint32_t n);
 }
 #endif
 
@@ -105,3 +159,43 @@ LIBARDOUR_API void  default_mix_buffers_with_gain     (ARDOUR::Sample* dst, ARDO
 LIBARDOUR_API void  default_mix_buffers_no_gain       (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes);
 LIBARDOUR_API void  default_copy_vector               (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes);
 
+/* Process a cascade of biquad sections (transposed direct form II) on
+ * interleaved audio data, every channel uses its own coefficients and state.
+ *
+ * coeff: n_stages * 5 rows (b0, b1, b2, a1, a2) of n_channels values each
+ * state: n_stages * 2 rows (z1, z2) of n_channels values each
+ *
+ * Optimized versions process one channel per vector lane.
+ */
+LIBARDOUR_API void  default_biquad_cascade            (ARDOUR::Sample* buf, uint32_t n_channels, ARDOUR::pframes_t nframes, uint32_t n_stages, float const* coeff, float* state);
+/* process only channels first_chn .. last_chn - 1 (used for remaining channels by optimized versions) */
+LIBARDOUR_API void  default_biquad_cascade_lanes      (ARDOUR::Sample* buf, uint32_t n_channels, ARDOUR::pframes_t nframes, uint32_t n_stages, float const* coeff, float* state, uint32_t first_chn, uint32_t last_chn);
+
+/* apply a gain ramp: a one-pole lowpass filter from initial to target gain, returns the final gain */
+LIBARDOUR_API float default_apply_gain_ramp           (ARDOUR::Sample* buf, ARDOUR::pframes_t nframes, float initial, float target, float coeff);
+/* mix src into dst using a linear gain ramp: gain[n] = initial + n * (target - initial) / nframes */
+LIBARDOUR_API void  default_mix_buffers_with_ramp     (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes, float initial, float target);
+/* dst[n * stride] = src[n] */
+LIBARDOUR_API void  default_interleave                (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes, uint32_t stride);
+/* dst[n] = src[n * stride] */
+LIBARDOUR_API void  default_deinterleave              (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes, uint32_t stride);
+/* convert to signed 16 bit, round to nearest, clamp */
+LIBARDOUR_API void  default_float_to_s16              (int16_t* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes);
+/* convert to signed 24 bit in the upper 24 bits of a 32 bit word, round to nearest, clamp */
+LIBARDOUR_API void  default_float_to_s24              (int32_t* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes);
+LIBARDOUR_API float default_sum_of_squares            (ARDOUR::Sample const* buf, ARDOUR::pframes_t nframes);
+/* dst[n] -= src[n] */
+LIBARDOUR_API void  default_subtract_buffers          (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes);
+/* dst[n] += a[n] * b[n] */
+LIBARDOUR_API void  default_multiply_add_buffers      (ARDOUR::Sample* dst, ARDOUR::Sample const* a, ARDOUR::Sample const* b, ARDOUR::pframes_t nframes);
+/* buf[n] = buf[n] * gain + offset */
+LIBARDOUR_API void  default_scale_offset_buffer       (ARDOUR::Sample* buf, ARDOUR::pframes_t nframes, float gain, float offset);
+/* buf[n] = min (max, max (min, buf[n])) */
+LIBARDOUR_API void  default_clamp_buffer              (ARDOUR::Sample* buf, ARDOUR::pframes_t nframes, float min, float max);
+/* buf[n] = fabsf (buf[n]) */
+LIBARDOUR_API void  default_rectify_buffer            (ARDOUR::Sample* buf, ARDOUR::pframes_t nframes);
+/* sum of a[k] * b[k] */
+LIBARDOUR_API float default_dot_product               (float const* a, float const* b, uint32_t n);
+/* dst[n] = linear interpolation of src at pos + n * step, zero outside of src, returns pos + nframes * step */
+LIBARDOUR_API double default_interpolate_buffer       (ARDOUR::Sample* dst, ARDOUR::Sample const* src, uint32_t src_len, double pos, double step, ARDOUR::pframes_t nframes);
+
@@ -482,6 +482,9 @@ typedef std::list<PluginPresetPtr>      PluginPresetList;
 PluginPtr
 find_plugin (ARDOUR::Session&, std::string unique_id, ARDOUR::PluginType);
 
+PluginInfoPtr
+find_plugin_info (std::string unique_id, ARDOUR::PluginType);
+
 class LIBARDOUR_API PluginInfo
 {
 public:
@@ -537,6 +540,10 @@ public:
 	/* hide from user */
 	virtual bool is_internal () const { return internal; }
 
+	/* @return true if ::load() may be called from any thread, concurrently
+	 * with other instances being loaded (e.g. when loading a session). */
+	virtual bool concurrent_instantiation () const { return false; }
+
 protected:
 	friend class PluginManager;
 	bool     internal;
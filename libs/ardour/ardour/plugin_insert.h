@@ -50,6 +50,7 @@ namespace ARDOUR {
 class Session;
 class Route;
 class Plugin;
+class RTSubTaskList;
 
 /** Plugin inserts: send data through a plugin
  */
@@ -355,6 +356,29 @@ private:
 	PinMappings _out_map;
 	ChanMapping _thru_map; // out-idx <=  in-idx
 
+	/* concurrent processing of replicated instances */
+	struct ReplicaArgs {
+		BufferSet*         bufs;
+		PinMappings const* in_map;
+		samplepos_t        start;
+		samplepos_t        end;
+		double             speed;
+		pframes_t          nframes;
+		samplecnt_t        offset;
+	};
+
+	bool check_parallel_replicas () const;
+	void setup_replica_tasks ();
+	void run_replicas (BufferSet&, PinMappings const&, samplepos_t start, samplepos_t end, double speed, pframes_t nframes, samplecnt_t offset);
+	void run_replica (uint32_t pc);
+
+	std::unique_ptr<RTSubTaskList> _replica_tasks;
+	ReplicaArgs                    _replica_args;
+	bool                           _parallel_replicas;
+	std::atomic<bool>              _replica_failed;
+	std::atomic<int64_t>           _replica_dt;
+	float                          _replica_cost; // average per instance [usec]
+
 	void automate_and_run (BufferSet& bufs, samplepos_t start, samplepos_t end, double speed, pframes_t nframes);
 	void connect_and_run (BufferSet& bufs, samplepos_t start, samplecnt_t end, double speed, pframes_t nframes, samplecnt_t offset, bool with_auto);
 	void bypass (BufferSet& bufs, pframes_t nframes);
@@ -95,6 +95,15 @@ class LIBARDOUR_API BackendPort : public ProtoPort
 
 	virtual void* get_buffer (pframes_t nframes) = 0;
 
+	/* flat list of ports connected to an input port,
+	 * published via RCU for lock-free use in the process thread.
+	 */
+	typedef std::vector<BackendPort*> SourceTable;
+
+	std::shared_ptr<SourceTable const> sources () const {
+		return _sources.reader ();
+	}
+
 	const LatencyRange latency_range (bool for_playback) const
 	{
 		return for_playback ? _playback_latency_range : _capture_latency_range;
@@ -107,6 +116,15 @@ class LIBARDOUR_API BackendPort : public ProtoPort
 protected:
 	PortEngineSharedImpl& _backend;
 
+	/** Collect audio from connected ports, for use in get_buffer () of
+	 * audio input ports. If exactly one port is connected, its buffer is
+	 * returned as-is (no copy), otherwise all sources are summed into @a buf.
+	 *
+	 * @param buf the port's own buffer
+	 * @return buffer holding the input port's data for the current cycle
+	 */
+	Sample* mix_connections (Sample* buf, pframes_t n_samples);
+
 private:
 	std::string            _name;
 	std::string            _pretty_name;
@@ -116,8 +134,11 @@ private:
 	LatencyRange           _playback_latency_range;
 	std::set<BackendPortPtr> _connections;
 
+	SerializedRCUManager<SourceTable> _sources;
+
 	void store_connection (BackendPortHandle);
 	void remove_connection (BackendPortHandle);
+	void update_sources ();
 
 }; // class BackendPort
 
@@ -36,6 +36,8 @@
 #include "ardour/monitor_port.h"
 #include "ardour/port.h"
 
+class Loudnessmeterdsp;
+
 namespace ARDOUR {
 
 class PortEngine;
@@ -48,18 +50,93 @@ class CircularEventBuffer;
 class LIBARDOUR_API PortManager
 {
 public:
+	/** Digital peak meter of a physical input port.
+	 *
+	 * level, peak and rms are owned by the process thread.
+	 * The GUI uses read(), which returns the values published at the
+	 * end of the last process cycle, using a lock-free double buffer.
+	 *
+	 * Meters are only computed while a UI subscribes to them.
+	 */
 	struct DPM {
+		struct Reading {
+			Reading () : level (0), peak (0), rms (0), true_peak (0) {}
+			Sample level;
+			Sample peak;
+			Sample rms;
+			Sample true_peak;
+		};
+
 		DPM ()
 		{
+			_subscribers.store (0);
+			_generation.store (0);
 			reset ();
 		}
+		DPM (DPM const& other)
+		{
+			_subscribers.store (0);
+			_generation.store (0);
+			reset ();
+			level     = other.level;
+			peak      = other.peak;
+			rms       = other.rms;
+			true_peak = other.true_peak;
+		}
+		DPM& operator= (DPM const& other)
+		{
+			level     = other.level;
+			peak      = other.peak;
+			rms       = other.rms;
+			true_peak = other.true_peak;
+			return *this;
+		}
 		void reset ()
 		{
-			level = 0;
-			peak  = 0;
+			level     = 0;
+			peak      = 0;
+			rms       = 0;
+			true_peak = 0;
+		}
+
+		/* process thread: make current values available to read() */
+		void publish ()
+		{
+			const unsigned int g = _generation.load (std::memory_order_relaxed) + 1;
+			Reading& r = _readings[g & 1];
+			r.level     = level;
+			r.peak      = peak;
+			r.rms       = rms;
+			r.true_peak = true_peak;
+			_generation.store (g, std::memory_order_release);
+		}
+
+		Reading read () const
+		{
+			Reading r;
+			unsigned int g;
+			do {
+				/* retry in the unlikely case that a new value
+				 * was published while copying */
+				g = _generation.load (std::memory_order_acquire);
+				r = _readings[g & 1];
+			} while (_generation.load (std::memory_order_acquire) != g);
+			return r;
 		}
+
+		void subscribe ()   { _subscribers.fetch_add (1); }
+		void unsubscribe () { _subscribers.fetch_sub (1); }
+		bool active () const { return _subscribers.load (std::memory_order_relaxed) > 0; }
+
 		Sample level;
 		Sample peak;
+		Sample rms;
+		Sample true_peak; ///< max. inter-sample peak since reset
+
+	private:
+		Reading                   _readings[2];
+		std::atomic<unsigned int> _generation;
+		std::atomic<int>          _subscribers;
 	};
 
 	struct MPM {
@@ -96,9 +173,11 @@ public:
 	typedef std::shared_ptr<MPM>                  MIDIPortMeter;
 
 	struct AudioInputPort {
-		AudioInputPort (samplecnt_t);
+		AudioInputPort (samplecnt_t sz, samplecnt_t sr);
 		AudioPortScope scope;
 		AudioPortMeter meter;
+		std::shared_ptr<Loudnessmeterdsp> true_peak_dsp;
+		bool active () const { return meter->active (); }
 		void apply_falloff (pframes_t, samplecnt_t sr, bool reset = false);
 		void silence (pframes_t);
 		void process (Sample const*, pframes_t, bool reset = false);
@@ -221,6 +221,7 @@ CONFIG_VARIABLE (std::string, clip_library_dir, "clip-library-dir", "@default@")
 CONFIG_VARIABLE (std::string, sample_lib_path, "sample-lib-path", "") /* custom paths */
 CONFIG_VARIABLE (bool, allow_special_bus_removal, "allow-special-bus-removal", false)
 CONFIG_VARIABLE (int32_t, processor_usage, "processor-usage", -1)
+CONFIG_VARIABLE (int32_t, plugin_replica_parallel_threshold, "plugin-replica-parallel-threshold", -1) /* usec per instance, < 0 to disable */
 CONFIG_VARIABLE (int32_t, cpu_dma_latency, "cpu-dma-latency", -1) /* >=0 to enable */
 CONFIG_VARIABLE (int32_t, io_thread_count, "io-thread-count", -2)
 CONFIG_VARIABLE (int32_t, io_thread_policy, "io-thread-policy", 0)
@@ -293,8 +294,15 @@ CONFIG_VARIABLE (bool, show_video_server_dialog, "show-video-server-dialog", fal
 
 /* export */
 CONFIG_VARIABLE (float, export_preroll, "export-preroll", 2.0) // seconds
+CONFIG_VARIABLE (bool, export_single_pass, "export-single-pass", false)
 CONFIG_VARIABLE (float, export_silence_threshold, "export-silence-threshold", -90) // dB
 CONFIG_VARIABLE (float, ppqn_factor_for_export, "ppqn-factor-for-export", 1) // Temporal::ticks_per_beat
 
 CONFIG_VARIABLE (float, max_midi_clip_size, "max-midi-clip-size", 1024) // number of MIDI events
 CONFIG_VARIABLE (float, max_audio_clip_duration, "max-audio-clip-duration" , 30.) // seconds
+CONFIG_VARIABLE (float, clip_streaming_threshold, "clip-streaming-threshold", 60.) // seconds, longer audio clips are streamed from disk, 0: never
+CONFIG_VARIABLE (uint32_t, clip_cache_size, "clip-cache-size", 256) // MB of audio clip data that is kept for re-use after the last clip using it is gone
+CONFIG_VARIABLE (bool, prestretch_clips, "prestretch-clips", false) // render time-stretched audio clips in the background instead of stretching them while playing
+CONFIG_VARIABLE (bool, region_fx_cache, "region-fx-cache", false) // keep the output of region FX and re-use it while nothing changed
+CONFIG_VARIABLE (uint32_t, region_fx_cache_memory, "region-fx-cache-memory", 256) // MB of rendered region FX data kept in memory
+CONFIG_VARIABLE (uint32_t, region_fx_cache_disk, "region-fx-cache-disk", 2048) // MB of rendered region FX data kept in the session's cache folder, 0: never spill to disk
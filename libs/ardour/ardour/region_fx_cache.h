@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+
+#include <glibmm/threads.h>
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace ARDOUR {
+
+class BufferSet;
+
+/** Rendered output of a region's FX chain.
+ *
+ * When enabled (see RCConfiguration::get_region_fx_cache), AudioRegion::read_at
+ * keeps the data that it processed with the region's plugins, and re-uses it
+ * until the region, its plugins or their automation change.
+ *
+ * Data is held in chunks of fixed size that contain all channels. Chunks
+ * are filled from the start as playback passes over them, only the filled
+ * part of a chunk can be used.
+ *
+ * When the memory used by all caches exceeds the configured limit, the
+ * least recently used chunks of all caches are written to their cache's
+ * file (up to a second limit for all files), or dropped. Caches that are
+ * busy at the time are skipped.
+ */
+class LIBARDOUR_API RegionFxCache
+{
+public:
+	struct LIBARDOUR_API Stats {
+		Stats () : hits (0), misses (0), spills (0), reloads (0), memory_bytes (0), disk_bytes (0) {}
+
+		float hit_rate () const { return hits + misses > 0 ? hits / (float) (hits + misses) : 0.f; }
+
+		uint64_t hits;
+		uint64_t misses;
+		uint64_t spills;       ///< chunks written to disk
+		uint64_t reloads;      ///< chunks read back from disk
+		size_t   memory_bytes;
+		size_t   disk_bytes;
+	};
+
+	/** @param spill_path file to use when data does not fit into memory,
+	 * it is created when needed and removed with the cache.
+	 * @param n_chans number of channels to cache
+	 */
+	RegionFxCache (std::string const& spill_path, uint32_t n_chans);
+	~RegionFxCache ();
+
+	/** Copy cached data to the start of the first n_chans audio buffers of @a bufs.
+	 * @param start offset of the data in the region
+	 * @return true if all of [start, start + cnt) is cached
+	 */
+	bool read (BufferSet& bufs, samplepos_t start, samplecnt_t cnt);
+
+	/** @return true if all of [start, start + cnt) is cached, spilled data included */
+	bool cached (samplepos_t start, samplecnt_t cnt) const;
+
+	/** Add data from the first n_chans audio buffers of @a bufs.
+	 * Data that does not continue what a chunk already holds is ignored.
+	 */
+	void write (BufferSet const& bufs, samplepos_t start, samplecnt_t cnt);
+
+	void clear ();
+
+	uint32_t n_chans () const { return _n_chans; }
+
+	/** statistics of this cache, memory and disk usage are not included */
+	Stats local_stats () const;
+
+	/** statistics of all caches */
+	static Stats stats ();
+
+	static samplecnt_t chunk_size () { return 16384; }
+
+private:
+	RegionFxCache (RegionFxCache const&);
+
+	struct Chunk {
+		Chunk () : data (0), filled (0), file_offset (-1), dirty (false), last_used (0) {}
+
+		Sample*     data; ///< n_chans * chunk_size () samples, 0 when spilled
+		samplecnt_t filled;
+		int64_t     file_offset;
+		bool        dirty; ///< data in memory differs from data on disk
+		uint64_t    last_used;
+	};
+
+	typedef std::map<samplepos_t, Chunk> Chunks;
+
+	size_t chunk_bytes () const { return _n_chans * chunk_size () * sizeof (Sample); }
+
+	bool covers (samplepos_t start, samplecnt_t cnt) const;
+	bool load (Chunk&);
+	void spill (Chunks::iterator);
+	void drop (Chunks::iterator);
+	void enforce_limits (samplepos_t keep);
+	void close_file ();
+	Chunks::iterator lru_chunk (samplepos_t keep);
+
+	std::string _spill_path;
+	uint32_t    _n_chans;
+	Chunks      _chunks;
+	int         _fd;
+	int64_t     _file_size;
+	Stats       _stats;
+
+	mutable Glib::Threads::Mutex _lock;
+
+	static Glib::Threads::Mutex      _registry_lock;
+	static std::set<RegionFxCache*> _registry;
+};
+
+} // namespace ARDOUR
@@ -19,6 +19,7 @@
 #ifndef _ardour_rt_task_h_
 #define _ardour_rt_task_h_
 
+#include <atomic>
 #include <functional>
 
 #include "ardour/graphnode.h"
@@ -27,6 +28,7 @@ namespace ARDOUR
 {
 class Graph;
 class RTTaskList;
+class RTSubTaskList;
 
 class LIBARDOUR_API RTTask : public ProcessNode
 {
@@ -42,6 +44,32 @@ private:
 	Graph*                   _graph;
 };
 
+/** A task that is queued while the graph is running.
+ *
+ * Sub-tasks are claimed by either the thread that owns the
+ * RTSubTaskList or an idle graph worker, whichever comes first.
+ * Running an already claimed task is a no-op.
+ */
+class LIBARDOUR_API RTSubTask : public ProcessNode
+{
+public:
+	RTSubTask (RTSubTaskList* l, std::function<void ()> const& fn);
+
+	void prep (GraphChain const*) {}
+	/** called by a graph thread that took the task from the trigger queue */
+	void run (GraphChain const*);
+
+private:
+	friend class RTSubTaskList;
+	/** called by the owner of the list */
+	void try_run ();
+	bool claim ();
+
+	std::function<void ()> _f;
+	RTSubTaskList*         _list;
+	std::atomic<bool>      _claimed;
+};
+
 }
 
 #endif
@@ -19,8 +19,11 @@
 #ifndef _ardour_rt_tasklist_h_
 #define _ardour_rt_tasklist_h_
 
+#include <atomic>
 #include <vector>
 
+#include "pbd/semutils.h"
+
 #include "ardour/libardour_visibility.h"
 #include "ardour/rt_task.h"
 
@@ -44,5 +47,47 @@ private:
 	std::shared_ptr<Graph> _graph;
 };
 
+/** A list of tasks that can be processed concurrently from
+ * within a running process-graph (e.g. by a Route's processor).
+ *
+ * Tasks are set up in advance from a non-realtime context, and
+ * may be processed repeatedly. Idle graph worker threads help
+ * with processing, if there are any, otherwise tasks are run
+ * in the calling thread.
+ */
+class LIBARDOUR_API RTSubTaskList
+{
+public:
+	RTSubTaskList (std::shared_ptr<Graph>);
+	~RTSubTaskList ();
+
+	/* not realtime safe */
+	void push_back (std::function<void ()> fn);
+	void clear ();
+
+	size_t size () const { return _tasks.size (); }
+
+	/** process all tasks, wait for them to complete.
+	 *
+	 * This only returns once every task that was handed to the graph
+	 * was also taken from its trigger queue, so no task is left queued
+	 * when the calling graph node is done. The calling thread runs
+	 * all tasks that were not yet claimed, and sleeps while waiting
+	 * for the remaining ones.
+	 *
+	 * @return number of tasks that were handed to other threads
+	 */
+	uint32_t process ();
+
+private:
+	friend class RTSubTask;
+	void task_released ();
+
+	std::vector<RTSubTask*> _tasks;
+	std::shared_ptr<Graph>  _graph;
+	std::atomic<size_t>     _n_pending;
+	PBD::Semaphore          _done_sem;
+};
+
 } // namespace ARDOUR
 #endif
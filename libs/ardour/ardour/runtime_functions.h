@@ -31,11 +31,44 @@ namespace ARDOUR {
 	typedef void  (*mix_buffers_no_gain_t)   (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t);
 	typedef void  (*copy_vector_t)           (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t);
 
+	/* multi-channel biquad cascade, see default_biquad_cascade() in mix.h */
+	typedef void  (*biquad_cascade_t)        (ARDOUR::Sample *, uint32_t, pframes_t, uint32_t, const float *, float *);
+
+	typedef float (*apply_gain_ramp_t)       (ARDOUR::Sample *, pframes_t, float, float, float);
+	typedef void  (*mix_buffers_with_ramp_t) (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t, float, float);
+	typedef void  (*interleave_t)            (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t, uint32_t);
+	typedef void  (*deinterleave_t)          (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t, uint32_t);
+	typedef void  (*float_to_s16_t)          (int16_t *, const ARDOUR::Sample *, pframes_t);
+	typedef void  (*float_to_s24_t)          (int32_t *, const ARDOUR::Sample *, pframes_t);
+	typedef float (*sum_of_squares_t)        (const ARDOUR::Sample *, pframes_t);
+	typedef void  (*subtract_buffers_t)      (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t);
+	typedef void  (*multiply_add_buffers_t)  (ARDOUR::Sample *, const ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t);
+	typedef void  (*scale_offset_buffer_t)   (ARDOUR::Sample *, pframes_t, float, float);
+	typedef void  (*clamp_buffer_t)          (ARDOUR::Sample *, pframes_t, float, float);
+	typedef void  (*rectify_buffer_t)        (ARDOUR::Sample *, pframes_t);
+	typedef float (*dot_product_t)           (const float *, const float *, uint32_t);
+	typedef double (*interpolate_buffer_t)   (ARDOUR::Sample *, const ARDOUR::Sample *, uint32_t, double, double, pframes_t);
+
 	LIBARDOUR_API extern compute_peak_t          compute_peak;
 	LIBARDOUR_API extern find_peaks_t            find_peaks;
 	LIBARDOUR_API extern apply_gain_to_buffer_t  apply_gain_to_buffer;
 	LIBARDOUR_API extern mix_buffers_with_gain_t mix_buffers_with_gain;
 	LIBARDOUR_API extern mix_buffers_no_gain_t   mix_buffers_no_gain;
 	LIBARDOUR_API extern copy_vector_t           copy_vector;
+	LIBARDOUR_API extern biquad_cascade_t        biquad_cascade;
+	LIBARDOUR_API extern apply_gain_ramp_t       apply_gain_ramp;
+	LIBARDOUR_API extern mix_buffers_with_ramp_t mix_buffers_with_ramp;
+	LIBARDOUR_API extern interleave_t            interleave;
+	LIBARDOUR_API extern deinterleave_t          deinterleave;
+	LIBARDOUR_API extern float_to_s16_t          float_to_s16;
+	LIBARDOUR_API extern float_to_s24_t          float_to_s24;
+	LIBARDOUR_API extern sum_of_squares_t        sum_of_squares;
+	LIBARDOUR_API extern subtract_buffers_t      subtract_buffers;
+	LIBARDOUR_API extern multiply_add_buffers_t  multiply_add_buffers;
+	LIBARDOUR_API extern scale_offset_buffer_t   scale_offset_buffer;
+	LIBARDOUR_API extern clamp_buffer_t          clamp_buffer;
+	LIBARDOUR_API extern rectify_buffer_t        rectify_buffer;
+	LIBARDOUR_API extern dot_product_t           dot_product;
+	LIBARDOUR_API extern interpolate_buffer_t    interpolate_buffer;
 }
 
@@ -275,6 +275,7 @@ public:
 	std::string analysis_dir () const;    ///< Analysis data
 	std::string plugins_dir () const;     ///< Plugin state
 	std::string externals_dir () const;   ///< Links to external files
+	std::string cache_dir () const;       ///< Data that can be re-created
 
 	std::string construct_peak_filepath (const std::string& audio_path, const bool in_session = false, const bool old_peak_name = false) const;
 
@@ -333,6 +334,7 @@ public:
 	}
 
 	std::shared_ptr<RTTaskList> rt_tasklist () { return _rt_tasklist; }
+	std::shared_ptr<Graph> process_graph () const { return _process_graph; }
 	std::shared_ptr<IOTaskList> io_tasklist () { return _io_tasklist; }
 
 	RouteList get_routelist (bool mixer_order = false, PresentationInfo::Flag fl = PresentationInfo::MixerRoutes) const;
@@ -936,6 +938,22 @@ public:
 	uint32_t registered_lua_function_count () const { return _n_lua_scripts; }
 	void scripts_changed (); // called from lua, updates _n_lua_scripts
 
+	/** Execution time of a session script, in microseconds.
+	 * Only measured while profiling is enabled.
+	 */
+	struct LuaFunctionStats {
+		LuaFunctionStats () : count (0), total (0), max (0) {}
+		uint64_t count;
+		double   total;
+		double   max;
+	};
+
+	/* stats take the lua_lock, they are not available to session scripts */
+	void set_lua_function_profiling (bool yn) { _lua_profile.store (yn); }
+	bool lua_function_profiling () const { return _lua_profile.load (); }
+	std::map<std::string, LuaFunctionStats> lua_function_stats ();
+	void reset_lua_function_stats ();
+
 	PBD::Signal<void()> LuaScriptsChanged;
 
 	/* I/O Plugin */
@@ -1035,6 +1053,30 @@ public:
 		return _bypass_all_loaded_plugins;
 	}
 
+	/** Take the plugin that was instantiated ahead of time, while loading
+	 * the session, for the plugin-insert described by @a node.
+	 *
+	 * @param state_restored set to true if the plugin's state has also been restored
+	 * @return the plugin, or a null pointer if none was pre-loaded
+	 */
+	std::shared_ptr<Plugin> take_preloaded_plugin (XMLNode const& node, std::string const& unique_id, bool& state_restored);
+
+	/** Time spent in the stages of loading the session, in microseconds */
+	struct LoadTimes {
+		LoadTimes () : parse (0), plugins (0), routes (0), connect (0), n_plugins (0), n_preloaded (0) {}
+		int64_t  parse;       ///< reading the session file
+		int64_t  plugins;     ///< instantiating plugins, concurrently and during route creation
+		int64_t  routes;      ///< creating tracks and busses, excluding plugin instantiation
+		int64_t  connect;     ///< connecting ports
+		uint32_t n_plugins;   ///< plugins that were instantiated
+		uint32_t n_preloaded; ///< plugins that were instantiated concurrently
+	};
+
+	LoadTimes const& load_times () const { return _load_times; }
+
+	/** Account for a plugin that was instantiated while loading */
+	void add_plugin_load_time (int64_t us);
+
 	uint32_t next_send_id();
 	uint32_t next_surround_send_id();
 	uint32_t next_aux_send_id();
@@ -1326,8 +1368,10 @@ public:
 		ProcessFunction = 1,
 		NoRoll = 2,
 		Roll = 3,
+		LuaScripts = 4,
+		LuaGC = 5,
 		/* end */
-		NTT = 4
+		NTT = 6
 	};
 
 	PBD::TimingStats dsp_stats[NTT];
@@ -1611,7 +1655,10 @@ private:
 	luabridge::LuaRef * _lua_load;
 	luabridge::LuaRef * _lua_save;
 	luabridge::LuaRef * _lua_cleanup;
+	luabridge::LuaRef * _lua_stats;
+	luabridge::LuaRef * _lua_reset_stats;
 	uint32_t            _n_lua_scripts;
+	std::atomic<bool>   _lua_profile;
 
 	void setup_lua ();
 	void luabindings_session_rt (lua_State*);
@@ -1930,6 +1977,17 @@ private:
 	std::shared_ptr<Route> XMLRouteFactory_2X (const XMLNode&, int);
 	std::shared_ptr<Route> XMLRouteFactory_3X (const XMLNode&, int);
 
+	struct PreloadedPlugin {
+		std::string             unique_id;
+		std::shared_ptr<Plugin> plugin;
+		bool                    state_restored;
+	};
+
+	void preload_plugins (const XMLNode&, int);
+
+	std::map<std::string, PreloadedPlugin> _preloaded_plugins; ///< key: processor ID
+	LoadTimes                              _load_times;
+
 	void route_processors_changed (RouteProcessorChange);
 
 	bool find_route_name (std::string const &, uint32_t& id, std::string& name, bool);
@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "ardour/automation_control.h"
 #include "ardour/libardour_visibility.h"
 
@@ -49,16 +51,17 @@ public:
 
 	virtual void automation_run (samplepos_t start, pframes_t nframes);
 
+	/* The combined value of all masters (product of gain ratios, or
+	 * logical OR for toggled controls) is cached whenever masters are
+	 * added/removed or change their value, so that this is wait-free
+	 * and can be used in realtime context.
+	 */
 	double get_masters_value () const {
-		Glib::Threads::RWLock::ReaderLock lm (master_lock);
-		return get_masters_value_locked ();
+		return _masters_value.load ();
 	}
 
 	/* factor out get_masters_value() */
-	double reduce_by_masters (double val, bool ignore_automation_state = false) const {
-		Glib::Threads::RWLock::ReaderLock lm (master_lock);
-		return reduce_by_masters_locked (val, ignore_automation_state);
-	}
+	double reduce_by_masters (double val, bool ignore_automation_state = false) const;
 
 	bool get_masters_curve (samplepos_t s, samplepos_t e, float* v, samplecnt_t l) const {
 		Glib::Threads::RWLock::ReaderLock lm (master_lock);
@@ -116,6 +119,7 @@ protected:
 
 		PBD::ScopedConnection changed_connection;
 		PBD::ScopedConnection dropped_connection;
+		PBD::ScopedConnection state_connection;
 
   private:
 		std::weak_ptr<AutomationControl> _master;
@@ -131,6 +135,14 @@ protected:
 	typedef std::map<PBD::ID,MasterRecord> Masters;
 	Masters _masters;
 
+	/* snapshot of get_masters_value_locked (), see update_masters_value () */
+	std::atomic<double> _masters_value;
+	std::atomic<int>    _n_masters;
+	std::atomic<int>    _masters_serial;
+
+	void   update_masters_value ();
+	void   masters_value_changed ();
+
 	void   master_going_away (std::weak_ptr<AutomationControl>);
 	double get_value_locked() const;
 	void   actually_set_value (double value, PBD::Controllable::GroupControlDisposition);
@@ -139,7 +151,6 @@ protected:
 	virtual bool get_masters_curve_locked (samplepos_t, samplepos_t, float*, samplecnt_t) const;
 	bool masters_curve_multiply (timepos_t const &, timepos_t const &, float*, samplecnt_t) const;
 
-	virtual double reduce_by_masters_locked (double val, bool) const;
 	virtual double scale_automation_callback (double val, double ratio) const;
 
 	virtual bool handle_master_change (std::shared_ptr<AutomationControl>);
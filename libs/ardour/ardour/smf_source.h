@@ -86,6 +86,7 @@ public:
   protected:
 	void close ();
 	void flush_midi (const WriterLock& lock);
+	std::string smf_path () const { return _path; }
 
   private:
 	bool _open;
@@ -115,6 +116,7 @@ public:
 	                          timecnt_t const &            cnt);
 
 	void load_model_unlocked (bool force_reload=false);
+	bool load_model_mapped ();
 
 };
 
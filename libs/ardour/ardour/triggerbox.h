@@ -21,6 +21,7 @@
 #include <pthread.h>
 
 #include <atomic>
+#include <list>
 #include <map>
 #include <memory>
 #include <vector>
@@ -45,6 +46,7 @@
 #include "evoral/PatchChange.h"
 #include "evoral/SMF.h"
 
+#include "ardour/clip_data_cache.h"
 #include "ardour/event_ring_buffer.h"
 #include "ardour/midi_model.h"
 #include "ardour/midi_state_tracker.h"
@@ -335,6 +337,11 @@ class LIBARDOUR_API Trigger : public PBD::Stateful {
 	std::shared_ptr<Region> the_region() const { return _region; }
 	virtual bool playable() const = 0;
 
+	/* true if (part of) the data is read from disk during playback */
+	virtual bool streaming () const { return false; }
+	/* approximate size of the data held in memory, in bytes */
+	virtual size_t memory_usage () const { return 0; }
+
 	uint32_t index() const { return _index; }
 
 	/* Managed by TriggerBox, these record the time that the trigger is
@@ -561,11 +568,33 @@ class LIBARDOUR_API AudioTrigger : public Trigger {
 	bool stretching () const;
 	uint32_t channels () const { return data.size(); }
 
+	bool streaming () const;
+	size_t memory_usage () const;
+
+	/* called from the TriggerBoxThread */
+	void refill_stream ();
+
+	/* Background rendering of the clip at a given stretch ratio, so that
+	 * ::run() can play it without running the stretcher.
+	 */
+	struct PreStretch;
+
+	/* called from the TriggerBoxThread */
+	PreStretch* create_prestretch (double ratio);
+	void install_prestretch (PreStretch&);
+
 	RubberBand::RubberBandStretcher* alloc_stretcher () const;
 
+	/* For clips that are streamed from disk, only the first
+	 * `capacity` samples of `length` are held in memory.
+	 *
+	 * Data of clips loaded from a region is owned by the ClipDataCache
+	 * and shared with other clips, it must not be modified.
+	 */
 	struct AudioData : std::vector<Sample*> {
 		samplecnt_t length;
 		samplecnt_t capacity;
+		ClipDataCache::EntryPtr shared;
 
 		AudioData () : length (0), capacity (0) {}
 		~AudioData ();
@@ -582,10 +611,25 @@ class LIBARDOUR_API AudioTrigger : public Trigger {
 	void retrigger ();
 
   private:
+	struct Stream;
+	struct Render;
+
 	AudioData        data;
+	Stream*          _stream;
 	RubberBand::RubberBandStretcher*  _stretcher;
 	samplepos_t _start_offset;
 
+	/* pre-stretched data, the TriggerBoxThread publishes _render, the
+	 * process thread announces the one it is playing in _render_in_use.
+	 */
+	std::atomic<Render*> _render;
+	std::atomic<Render*> _render_in_use;
+	std::atomic<bool>    _prestretch_requested;
+	std::vector<Render*> _retired_renders;
+	Render*              _playing;
+	samplepos_t          _render_pos;
+	bool                 _check_render;
+
 
 	/* computed during run */
 
@@ -601,8 +645,11 @@ class LIBARDOUR_API AudioTrigger : public Trigger {
 
 	void drop_data ();
 	int load_data (std::shared_ptr<AudioRegion>);
+	samplecnt_t data_at (samplepos_t pos, samplecnt_t cnt, Sample const** src);
 	void estimate_tempo ();
 	void reset_stretcher ();
+	void use_render (double ratio);
+	void drop_renders ();
 	void _startup (BufferSet&, pframes_t dest_offset, Temporal::BBT_Offset const &);
 	int set_region_in_worker_thread_internal (std::shared_ptr<Region> r, bool from_capture);
 };
@@ -614,6 +661,7 @@ class LIBARDOUR_API MIDITrigger : public Trigger {
 	~MIDITrigger ();
 
 	bool playable() const { return rt_midibuffer.load() || _region; }
+	size_t memory_usage () const;
 
 	void captured (SlotArmInfo&, BufferSet&);
 	void disarm ();
@@ -748,6 +796,9 @@ class LIBARDOUR_API TriggerBoxThread
 	void set_region (TriggerBox&, uint32_t slot, std::shared_ptr<Region>);
 	void request_delete_trigger (Trigger* t);
 	void request_build_source (Trigger* t, Temporal::timecnt_t const & duration);
+	void request_stream_refill (AudioTrigger* t);
+	void request_prestretch (AudioTrigger* t, double ratio);
+	void cancel_prestretch (AudioTrigger* t);
 
 	void summon();
 	void stop();
@@ -761,7 +812,9 @@ class LIBARDOUR_API TriggerBoxThread
 		Quit,
 		SetRegion,
 		DeleteTrigger,
-		BuildSourceAndRegion
+		BuildSourceAndRegion,
+		RefillStream,
+		PreStretchClip
 	};
 
 	struct Request {
@@ -773,9 +826,11 @@ class LIBARDOUR_API TriggerBoxThread
 		TriggerBox* box;
 		uint32_t slot;
 		std::shared_ptr<Region> region;
-		/* for DeleteTrigger and BuildSourceAndRegion */
+		/* for DeleteTrigger, BuildSourceAndRegion, RefillStream and PreStretchClip */
 		Trigger* trigger;
 		Temporal::timecnt_t duration;
+		/* for PreStretchClip */
+		double ratio;
 
 		void* operator new (size_t);
 		void  operator delete (void* ptr, size_t);
@@ -793,6 +848,13 @@ class LIBARDOUR_API TriggerBoxThread
 	void build_source (Trigger*, Temporal::timecnt_t const & duration);
 	void build_midi_source (MIDITrigger*, Temporal::timecnt_t const &);
 	void build_audio_source (AudioTrigger*, Temporal::timecnt_t const &);
+
+	/* pre-stretch jobs are processed in chunks, in between requests */
+	void prestretch (AudioTrigger*, double ratio);
+	void run_prestretch ();
+
+	Glib::Threads::Mutex                 _prestretch_lock;
+	std::list<AudioTrigger::PreStretch*> _prestretch;
 };
 
 struct CueRecord {
@@ -977,6 +1039,11 @@ class LIBARDOUR_API TriggerBox : public Processor, public std::enable_shared_fro
 
 	void dump (std::ostream &) const;
 
+	/* total size of clip data held in memory, in bytes */
+	size_t memory_usage () const;
+	/* per-slot report of memory used, and whether clips are streamed */
+	void memory_report (std::ostream &) const;
+
 	PBD::Signal<void(samplecnt_t)> Captured;
 
 	/* return start time for capture; only valid if is_set is true upon return */
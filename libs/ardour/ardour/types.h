@@ -244,7 +244,9 @@ enum MeterType {
 	MeterVU        = 0x0400,
 	MeterK12       = 0x0800,
 	MeterPeak0dB   = 0x1000,
-	MeterMCP       = 0x2000
+	MeterMCP       = 0x2000,
+	MeterTruePeak  = 0x4000,
+	MeterLUFS      = 0x8000
 };
 
 enum TrackMode {
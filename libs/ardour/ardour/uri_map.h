@@ -20,7 +20,9 @@
 
 #pragma once
 
-#include <map>
+#include <atomic>
+#include <string>
+#include <vector>
 
 #include <glibmm/threads.h>
 
@@ -38,8 +40,9 @@ namespace ARDOUR {
 
 /** Implementation of the LV2 urid extension.
  *
- * This just uses a pair of std::map and is not so great in the space overhead
- * department, but it's fast enough and not really performance critical anyway.
+ * Looking up URIs that are already mapped, and unmapping IDs, is lock-free,
+ * so that many plugins can be instantiated concurrently. Only adding a new
+ * URI takes a lock. URIs are never removed.
  */
 class LIBARDOUR_API URIMap {
 public:
@@ -55,9 +58,16 @@ public:
 	LV2_URID_Map*   urid_map()   { return &_urid_map_feature_data; }
 	LV2_URID_Unmap* urid_unmap() { return &_urid_unmap_feature_data; }
 
+	~URIMap();
+
 	uint32_t    uri_to_id(const char* uri);
 	const char* id_to_uri(uint32_t id) const;
 
+	/** number of mapped URIs */
+	uint32_t size() const;
+	/** number of times that adding a URI had to wait for another thread */
+	uint64_t n_contended() const { return _n_contended.load(); }
+
 	// Cached URIDs for use in real-time code
 	struct URIDs {
 		void init(URIMap& uri_map);
@@ -132,11 +142,36 @@ public:
 	URIDs urids;
 
 private:
-	typedef std::map<const std::string, uint32_t> Map;
-	typedef std::map<uint32_t, const std::string> Unmap;
+	struct Entry {
+		Entry(const char* u, uint32_t h, uint32_t i) : uri(u), hash(h), id(i) {}
+
+		const std::string uri;
+		const uint32_t    hash;
+		const uint32_t    id;
+	};
+
+	struct Slots {
+		Slots(uint32_t n);
+		~Slots();
+
+		const uint32_t             size;
+		std::atomic<const Entry*>* slots;
+	};
+
+	static uint32_t hash(const char* uri);
+	static uint32_t lookup(const Slots* map, const char* uri, uint32_t hash);
+	static void     place(Slots* map, const Entry* e);
+
+	uint32_t insert(const char* uri, uint32_t hash);
+
+	std::atomic<Slots*> _map;   ///< open addressing hash-table, size is a power of two
+	std::atomic<Slots*> _unmap; ///< entries indexed by id - 1
+
+	/* only modified with _lock held */
+	std::vector<Entry*> _entries;
+	std::vector<Slots*> _retired; ///< replaced tables, that may still be used by readers
 
-	Map   _map;
-	Unmap _unmap;
+	std::atomic<uint64_t> _n_contended;
 
 	LV2_Feature         _urid_map_feature;
 	LV2_URID_Map        _urid_map_feature_data;
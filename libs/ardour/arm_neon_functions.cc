@@ -515,4 +515,333 @@ arm_neon_copy_vector(
 	}
 }
 
+/**
+ * @brief NEON multi-channel biquad cascade, processes 4 channels in parallel
+ *
+ * @param[in,out] buf interleaved audio data
+ * @param n_channels number of interleaved channels
+ * @param nframes number of frames to process
+ * @param n_stages number of biquad sections
+ * @param coeff filter coefficients, see default_biquad_cascade()
+ * @param[in,out] state filter state, see default_biquad_cascade()
+ */
+C_FUNC void
+arm_neon_biquad_cascade(float *buf, uint32_t n_channels, uint32_t nframes, uint32_t n_stages, const float *coeff, float *state)
+{
+	const uint32_t n_vec = n_channels & ~3;
+
+	for (uint32_t s = 0; s < n_stages; ++s) {
+		const float *c = &coeff[s * 5 * n_channels];
+		float       *z = &state[s * 2 * n_channels];
+
+		for (uint32_t l = 0; l < n_vec; l += 4) {
+			const float32x4_t b0 = vld1q_f32(&c[0 * n_channels + l]);
+			const float32x4_t b1 = vld1q_f32(&c[1 * n_channels + l]);
+			const float32x4_t b2 = vld1q_f32(&c[2 * n_channels + l]);
+			const float32x4_t a1 = vld1q_f32(&c[3 * n_channels + l]);
+			const float32x4_t a2 = vld1q_f32(&c[4 * n_channels + l]);
+
+			float32x4_t z1 = vld1q_f32(&z[l]);
+			float32x4_t z2 = vld1q_f32(&z[n_channels + l]);
+
+			float *d = &buf[l];
+			for (uint32_t i = 0; i < nframes; ++i, d += n_channels) {
+				const float32x4_t x = vld1q_f32(d);
+				const float32x4_t y = vmlaq_f32(z1, b0, x);
+				z1 = vmlsq_f32(vmlaq_f32(z2, b1, x), a1, y);
+				z2 = vmlsq_f32(vmulq_f32(b2, x), a2, y);
+				vst1q_f32(d, y);
+			}
+
+			vst1q_f32(&z[l], z1);
+			vst1q_f32(&z[n_channels + l], z2);
+		}
+	}
+
+	// Process the remaining < 4 channels
+	if (n_vec < n_channels) {
+		default_biquad_cascade_lanes(buf, n_channels, nframes, n_stages, coeff, state, n_vec, n_channels);
+	}
+}
+
+/**
+ * @brief NEON one-pole gain ramp (declick), processes 4 samples in parallel
+ *
+ * Uses the closed form g[i] = target + (initial - target) * (1 - coeff)^i
+ *
+ * @return gain after the last sample
+ */
+C_FUNC float
+arm_neon_apply_gain_ramp(float *buf, uint32_t nframes, float initial, float target, float coeff)
+{
+	const float p[4] = { 1.f, (1.f - coeff), (1.f - coeff) * (1.f - coeff), (1.f - coeff) * (1.f - coeff) * (1.f - coeff) };
+
+	const float32x4_t t = vdupq_n_f32(target);
+	const float32x4_t r = vdupq_n_f32(p[3] * (1.f - coeff));
+	float32x4_t       d = vmulq_n_f32(vld1q_f32(p), initial - target);
+
+	while (nframes >= 4) {
+		const float32x4_t x = vld1q_f32(buf);
+		vst1q_f32(buf, vmulq_f32(x, vaddq_f32(t, d)));
+		d = vmulq_f32(d, r);
+		buf += 4;
+		nframes -= 4;
+	}
+
+	/* the remaining samples and the returned gain (that of the next
+	 * sample) use the same closed form as the vectorized loop */
+	float dv[4];
+	vst1q_f32(dv, d);
+
+	for (uint32_t i = 0; i < nframes; ++i) {
+		buf[i] *= target + dv[i];
+	}
+	return target + dv[nframes];
+}
+
+/**
+ * @brief NEON mix buffers with a linear gain ramp from initial to target
+ */
+C_FUNC void
+arm_neon_mix_buffers_with_ramp(float *dst, const float *src, uint32_t nframes, float initial, float target)
+{
+	const float       delta = (target - initial) / nframes;
+	const float32x4_t g0    = vdupq_n_f32(initial);
+	const float32x4_t dv    = vdupq_n_f32(delta);
+	const float32x4_t four  = vdupq_n_f32(4.f);
+	const float       i0[4] = { 0.f, 1.f, 2.f, 3.f };
+	float32x4_t       idx   = vld1q_f32(i0);
+
+	uint32_t i = 0;
+	for (; i + 4 <= nframes; i += 4) {
+		/* mul + add, rather than fused multiply-add, matches the default implementation */
+		const float32x4_t g = vaddq_f32(g0, vmulq_f32(dv, idx));
+		vst1q_f32(&dst[i], vaddq_f32(vld1q_f32(&dst[i]), vmulq_f32(vld1q_f32(&src[i]), g)));
+		idx = vaddq_f32(idx, four);
+	}
+
+	for (; i < nframes; ++i) {
+		dst[i] = dst[i] + src[i] * (initial + delta * (float)i);
+	}
+}
+
+/**
+ * @brief NEON interleave a single channel
+ */
+C_FUNC void
+arm_neon_interleave(float *dst, const float *src, uint32_t nframes, uint32_t stride)
+{
+	if (stride != 2) {
+		default_interleave(dst, src, nframes, stride);
+		return;
+	}
+
+	/* read-modify-write the other channel, stop before the last frame,
+	 * dst[2 * nframes - 1] is not part of this channel's data */
+	uint32_t i = 0;
+	for (; i + 4 < nframes; i += 4) {
+		float32x4x2_t v = vld2q_f32(&dst[2 * i]);
+		v.val[0]        = vld1q_f32(&src[i]);
+		vst2q_f32(&dst[2 * i], v);
+	}
+
+	default_interleave(&dst[2 * i], &src[i], nframes - i, stride);
+}
+
+/**
+ * @brief NEON de-interleave a single channel
+ */
+C_FUNC void
+arm_neon_deinterleave(float *dst, const float *src, uint32_t nframes, uint32_t stride)
+{
+	if (stride != 2) {
+		default_deinterleave(dst, src, nframes, stride);
+		return;
+	}
+
+	uint32_t i = 0;
+	for (; i + 4 < nframes; i += 4) {
+		const float32x4x2_t v = vld2q_f32(&src[2 * i]);
+		vst1q_f32(&dst[i], v.val[0]);
+	}
+
+	default_deinterleave(&dst[i], &src[2 * i], nframes - i, stride);
+}
+
+/**
+ * @brief NEON convert float to signed 16 bit integer (round to nearest, clamp)
+ */
+C_FUNC void
+arm_neon_float_to_s16(int16_t *dst, const float *src, uint32_t nframes)
+{
+#ifdef __aarch64__
+	const float32x4_t vmin = vdupq_n_f32(-32768.f);
+	const float32x4_t vmax = vdupq_n_f32(32767.f);
+
+	while (nframes >= 8) {
+		float32x4_t x0 = vmulq_n_f32(vld1q_f32(src), 32768.f);
+		float32x4_t x1 = vmulq_n_f32(vld1q_f32(src + 4), 32768.f);
+		x0 = vminq_f32(vmaxq_f32(x0, vmin), vmax);
+		x1 = vminq_f32(vmaxq_f32(x1, vmin), vmax);
+		vst1q_s16(dst, vcombine_s16(vmovn_s32(vcvtnq_s32_f32(x0)), vmovn_s32(vcvtnq_s32_f32(x1))));
+		src += 8;
+		dst += 8;
+		nframes -= 8;
+	}
+#endif
+	default_float_to_s16(dst, src, nframes);
+}
+
+/**
+ * @brief NEON convert float to signed 24 bit in the upper 24 bits of a 32 bit word
+ */
+C_FUNC void
+arm_neon_float_to_s24(int32_t *dst, const float *src, uint32_t nframes)
+{
+#ifdef __aarch64__
+	const float32x4_t vmin = vdupq_n_f32(-8388608.f);
+	const float32x4_t vmax = vdupq_n_f32(8388607.f);
+
+	while (nframes >= 4) {
+		float32x4_t x = vmulq_n_f32(vld1q_f32(src), 8388608.f);
+		x = vminq_f32(vmaxq_f32(x, vmin), vmax);
+		vst1q_s32(dst, vshlq_n_s32(vcvtnq_s32_f32(x), 8));
+		src += 4;
+		dst += 4;
+		nframes -= 4;
+	}
+#endif
+	default_float_to_s24(dst, src, nframes);
+}
+
+/**
+ * @brief NEON sum of squares
+ */
+C_FUNC float
+arm_neon_sum_of_squares(const float *buf, uint32_t nframes)
+{
+	float32x4_t acc0 = vdupq_n_f32(0.f);
+	float32x4_t acc1 = vdupq_n_f32(0.f);
+
+	while (nframes >= 8) {
+		const float32x4_t x0 = vld1q_f32(buf);
+		const float32x4_t x1 = vld1q_f32(buf + 4);
+		acc0 = vmlaq_f32(acc0, x0, x0);
+		acc1 = vmlaq_f32(acc1, x1, x1);
+		buf += 8;
+		nframes -= 8;
+	}
+
+	acc0 = vaddq_f32(acc0, acc1);
+	float32x2_t s = vadd_f32(vget_low_f32(acc0), vget_high_f32(acc0));
+	float sum = vget_lane_f32(vpadd_f32(s, s), 0);
+
+	while (nframes > 0) {
+		sum += *buf * *buf;
+		++buf;
+		--nframes;
+	}
+	return sum;
+}
+
+/**
+ * @brief NEON subtract buffers, dst[i] -= src[i]
+ */
+C_FUNC void
+arm_neon_subtract_buffers(float *dst, const float *src, uint32_t nframes)
+{
+	while (nframes >= 4) {
+		vst1q_f32(dst, vsubq_f32(vld1q_f32(dst), vld1q_f32(src)));
+		src += 4;
+		dst += 4;
+		nframes -= 4;
+	}
+	default_subtract_buffers(dst, src, nframes);
+}
+
+/**
+ * @brief NEON multiply and accumulate, dst[i] += a[i] * b[i]
+ */
+C_FUNC void
+arm_neon_multiply_add_buffers(float *dst, const float *a, const float *b, uint32_t nframes)
+{
+	while (nframes >= 4) {
+		vst1q_f32(dst, vmlaq_f32(vld1q_f32(dst), vld1q_f32(a), vld1q_f32(b)));
+		a += 4;
+		b += 4;
+		dst += 4;
+		nframes -= 4;
+	}
+	default_multiply_add_buffers(dst, a, b, nframes);
+}
+
+/**
+ * @brief NEON scale and offset, buf[i] = buf[i] * gain + offset
+ */
+C_FUNC void
+arm_neon_scale_offset_buffer(float *buf, uint32_t nframes, float gain, float offset)
+{
+	const float32x4_t o = vdupq_n_f32(offset);
+
+	while (nframes >= 4) {
+		vst1q_f32(buf, vmlaq_n_f32(o, vld1q_f32(buf), gain));
+		buf += 4;
+		nframes -= 4;
+	}
+	default_scale_offset_buffer(buf, nframes, gain, offset);
+}
+
+/**
+ * @brief NEON limit samples to [min, max]
+ */
+C_FUNC void
+arm_neon_clamp_buffer(float *buf, uint32_t nframes, float min, float max)
+{
+	const float32x4_t lo = vdupq_n_f32(min);
+	const float32x4_t hi = vdupq_n_f32(max);
+
+	while (nframes >= 4) {
+		vst1q_f32(buf, vminq_f32(vmaxq_f32(vld1q_f32(buf), lo), hi));
+		buf += 4;
+		nframes -= 4;
+	}
+	default_clamp_buffer(buf, nframes, min, max);
+}
+
+/**
+ * @brief NEON absolute value, buf[i] = fabsf (buf[i])
+ */
+C_FUNC void
+arm_neon_rectify_buffer(float *buf, uint32_t nframes)
+{
+	while (nframes >= 4) {
+		vst1q_f32(buf, vabsq_f32(vld1q_f32(buf)));
+		buf += 4;
+		nframes -= 4;
+	}
+	default_rectify_buffer(buf, nframes);
+}
+
+/**
+ * @brief NEON dot product, sum of a[i] * b[i]
+ */
+C_FUNC float
+arm_neon_dot_product(const float *a, const float *b, uint32_t n)
+{
+	float32x4_t acc0 = vdupq_n_f32(0.f);
+	float32x4_t acc1 = vdupq_n_f32(0.f);
+
+	while (n >= 8) {
+		acc0 = vmlaq_f32(acc0, vld1q_f32(a), vld1q_f32(b));
+		acc1 = vmlaq_f32(acc1, vld1q_f32(a + 4), vld1q_f32(b + 4));
+		a += 8;
+		b += 8;
+		n -= 8;
+	}
+
+	acc0 = vaddq_f32(acc0, acc1);
+	float32x2_t s = vadd_f32(vget_low_f32(acc0), vget_high_f32(acc0));
+	return vget_lane_f32(vpadd_f32(s, s), 0) + default_dot_product(a, b, n);
+}
+
 #endif
@@ -30,6 +30,7 @@
 #include <set>
 
 #include <glibmm/fileutils.h>
+#include <glibmm/miscutils.h>
 #include <glibmm/threads.h>
 
 #include "pbd/gstdio_compat.h"
@@ -53,6 +54,7 @@
 #include "ardour/playlist.h"
 #include "ardour/audiofilesource.h"
 #include "ardour/region_factory.h"
+#include "ardour/region_fx_cache.h"
 #include "ardour/region_fx_plugin.h"
 #include "ardour/runtime_functions.h"
 #include "ardour/sndfilesource.h"
@@ -255,6 +257,7 @@ AudioRegion::init ()
 	_cache_tail = 0;
 	_fx_block_size = 0;
 	_fx_latent_read = false;
+	_fx_render_cache_faded = false;
 }
 
 void
@@ -271,6 +274,7 @@ AudioRegion::send_change (const PropertyChange& what_changed)
 	our_interests.add (Properties::fade_in);
 	our_interests.add (Properties::fade_out);
 	our_interests.add (Properties::start);
+	our_interests.add (Properties::length);
 
 	if (what_changed.contains (our_interests)) {
 		_invalidated.exchange (true);
@@ -729,6 +733,9 @@ AudioRegion::read_at (Sample*     buf,
 	if (chan_n == 0 && _invalidated.exchange (false)) {
 		_cache_start = _cache_end = -1;
 		_cache_tail  = 0;
+		if (_fx_render_cache) {
+			_fx_render_cache->clear ();
+		}
 	}
 
 	std::unique_ptr<gain_t[]> gain_array;
@@ -786,7 +793,30 @@ AudioRegion::read_at (Sample*     buf,
 			n_proc += n_tail;
 		}
 
-		if (_cache_end != internal_offset + suffix && fx_latency > 0) {
+		RegionFxCache* rendered = fx_render_cache ();
+
+		/* While the plugins are running, only switch to rendered data
+		 * if it covers the rest of the region including its tail.
+		 * Otherwise the plugins would have to start over at the next
+		 * miss, losing their state (e.g. cutting off reverb tails).
+		 */
+		if (rendered && (_fx_pos < 0 || rendered->cached (internal_offset + suffix, lsamples + tsamples - internal_offset - suffix))) {
+			_readcache.ensure_buffers (ChanCount (DataType::AUDIO, n_chn), to_read + n_tail);
+			if (rendered->read (_readcache, internal_offset + suffix, to_read + n_tail)) {
+				DEBUG_TRACE (DEBUG::AudioPlayback, string_compose ("Region '%1' channel: %2 use rendered FX %3 - %4\n",
+				             name(), chan_n, internal_offset + suffix, internal_offset + suffix + to_read + n_tail));
+				copy_from_readcache (mixdown_buffer, chan_n, to_read + n_tail);
+				_cache_start = internal_offset + suffix;
+				_cache_end   = internal_offset + suffix + to_read + n_tail;
+				_cache_tail  = n_tail;
+				/* the plugins did not see this data, start over when processing resumes */
+				_fx_pos = -1;
+				cl.release ();
+				goto endread;
+			}
+		}
+
+		if ((_cache_end != internal_offset + suffix || _fx_pos < 0) && fx_latency > 0) {
 			_fx_latent_read = true;
 			n_proc += fx_latency;
 			n_read = min (to_read + fx_latency, esamples);
@@ -920,16 +950,11 @@ AudioRegion::read_at (Sample*     buf,
 		/* for mono regions without plugins, mixdown_buffer is valid as-is */
 		if (n_chn > 1 || have_fx) {
 			/* copy data for current channel */
-			if (chan_n < n_channels()) {
-				copy_vector (mixdown_buffer, _readcache.get_audio (chan_n).data (), to_read + n_tail);
-			} else {
-				if (Config->get_replicate_missing_region_channels()) {
-					chan_n = chan_n % n_channels ();
-					copy_vector (mixdown_buffer, _readcache.get_audio (chan_n).data (), to_read + n_tail);
-				} else {
-					memset (mixdown_buffer, 0, sizeof (Sample) * (to_read + n_tail));
-				}
-			}
+			copy_from_readcache (mixdown_buffer, chan_n, to_read + n_tail);
+		}
+
+		if (rendered) {
+			rendered->write (_readcache, internal_offset + suffix, to_read + n_tail);
 		}
 
 		_cache_start = internal_offset + suffix;
@@ -1067,6 +1092,42 @@ endread:
 	return to_read + T;
 }
 
+RegionFxCache*
+AudioRegion::fx_render_cache () const
+{
+	if (!Config->get_region_fx_cache ()) {
+		_fx_render_cache.reset ();
+		return 0;
+	}
+
+	/* fades that are applied before FX are part of the rendered data */
+	bool const faded = _fade_before_fx && _session.config.get_use_region_fades ();
+
+	if (_fx_render_cache && (_fx_render_cache->n_chans () != n_channels () || _fx_render_cache_faded != faded)) {
+		_fx_render_cache.reset ();
+	}
+
+	if (!_fx_render_cache) {
+		std::string path = Glib::build_filename (_session.cache_dir (), string_compose ("regionfx-%1.raw", id ().to_s ()));
+		_fx_render_cache.reset (new RegionFxCache (path, n_channels ()));
+		_fx_render_cache_faded = faded;
+	}
+
+	return _fx_render_cache.get ();
+}
+
+void
+AudioRegion::copy_from_readcache (Sample* buf, uint32_t chan_n, samplecnt_t cnt) const
+{
+	if (chan_n < n_channels()) {
+		copy_vector (buf, _readcache.get_audio (chan_n).data (), cnt);
+	} else if (Config->get_replicate_missing_region_channels()) {
+		copy_vector (buf, _readcache.get_audio (chan_n % n_channels ()).data (), cnt);
+	} else {
+		memset (buf, 0, sizeof (Sample) * cnt);
+	}
+}
+
 /** Read data directly from one of our sources, accounting for the situation when the track has a different channel
  *  count to the region.
  *
@@ -2589,6 +2650,7 @@ AudioRegion::remove_plugin (std::shared_ptr<RegionFxPlugin> fx)
 		_cache_start = _cache_end = -1;
 		_cache_tail  = 0;
 		_readcache.clear ();
+		_fx_render_cache.reset ();
 	}
 
 	lm.release ();
@@ -482,6 +482,49 @@ BufferSet::merge_from (const BufferSet& in, samplecnt_t nframes)
 	}
 }
 
+/** Merge the buffers of all of \a in into our existing buffers.
+ *
+ * Audio is mixed one set at a time, MIDI is merged from all sets
+ * in a single pass over the events (see MidiBuffer::merge_in_place).
+ */
+void
+BufferSet::merge_from (std::vector<BufferSet const*> const& in, samplecnt_t nframes)
+{
+	for (auto const& bs : in) {
+		BufferSet::iterator o = begin (DataType::AUDIO);
+		for (BufferSet::const_iterator i = bs->begin (DataType::AUDIO); i != bs->end (DataType::AUDIO) && o != end (DataType::AUDIO); ++i, ++o) {
+			o->merge_from (*i, nframes);
+		}
+	}
+
+	MidiBuffer const* src[MidiBuffer::max_merge_sources];
+
+	for (uint32_t n = 0; n < _count.n_midi (); ++n) {
+		MidiBuffer& mb (get_midi (n));
+		size_t n_src = 0;
+		bool   ok    = true;
+
+		for (auto const& bs : in) {
+			if (n >= bs->count ().n_midi ()) {
+				continue;
+			}
+			src[n_src++] = &bs->get_midi (n);
+			if (n_src == MidiBuffer::max_merge_sources) {
+				ok    = mb.merge_in_place (src, n_src) && ok;
+				n_src = 0;
+			}
+		}
+
+		if (n_src > 0) {
+			ok = mb.merge_in_place (src, n_src) && ok;
+		}
+
+		if (!ok) {
+			std::cerr << string_compose ("BufferSet::merge_from failed (MIDI buffer %1 is full)", n) << std::endl;
+		}
+	}
+}
+
 void
 BufferSet::silence (samplecnt_t nframes, samplecnt_t offset)
 {
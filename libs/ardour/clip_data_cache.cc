@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "pbd/compose.h"
+
+#include "ardour/audioregion.h"
+#include "ardour/clip_data_cache.h"
+#include "ardour/debug.h"
+#include "ardour/source.h"
+
+using namespace ARDOUR;
+
+ClipDataCache::Entry::Entry (uint32_t n_chans, samplecnt_t cnt)
+	: length (0)
+	, capacity (cnt)
+{
+	data.reserve (n_chans);
+	for (uint32_t n = 0; n < n_chans; ++n) {
+		data.push_back (new Sample[cnt]);
+	}
+}
+
+ClipDataCache::Entry::~Entry ()
+{
+	for (auto & d : data) {
+		delete [] d;
+	}
+}
+
+bool
+ClipDataCache::Key::operator< (Key const& other) const
+{
+	if (start != other.start) {
+		return start < other.start;
+	}
+	if (length != other.length) {
+		return length < other.length;
+	}
+	return sources < other.sources;
+}
+
+ClipDataCache&
+ClipDataCache::instance ()
+{
+	static ClipDataCache cache;
+	return cache;
+}
+
+ClipDataCache::ClipDataCache ()
+	: _serial (0)
+{
+}
+
+ClipDataCache::EntryPtr
+ClipDataCache::get (std::shared_ptr<AudioRegion const> ar, samplecnt_t capacity)
+{
+	const uint32_t nchans = ar->n_channels ();
+
+	Key key;
+	key.start  = ar->start_sample ();
+	key.length = ar->length_samples ();
+	for (uint32_t n = 0; n < nchans; ++n) {
+		key.sources.push_back (ar->source (n)->id ());
+	}
+
+	capacity = std::min (capacity, key.length);
+
+	if (nchans == 0 || capacity <= 0) {
+		return EntryPtr ();
+	}
+
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+		Items::iterator i = _items.find (key);
+		if (i != _items.end () && i->second.entry->capacity >= capacity) {
+			i->second.last_used = ++_serial;
+			++_stats.hits;
+			return i->second.entry;
+		}
+		++_stats.misses;
+	}
+
+	/* read without holding the lock, other clips may be looked up meanwhile */
+
+	std::shared_ptr<Entry> e;
+
+	try {
+		e.reset (new Entry (nchans, capacity));
+	} catch (...) {
+		return EntryPtr ();
+	}
+
+	e->length = key.length;
+
+	for (uint32_t n = 0; n < nchans; ++n) {
+		const samplecnt_t got = ar->read (e->data[n], 0, capacity, n);
+		if (got < capacity) {
+			memset (e->data[n] + std::max<samplecnt_t> (0, got), 0, sizeof (Sample) * (capacity - std::max<samplecnt_t> (0, got)));
+		}
+	}
+
+	DEBUG_TRACE (DEBUG::Triggers, string_compose ("clip cache: read %1 samples of '%2'\n", capacity, ar->name ()));
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	Items::iterator i = _items.find (key);
+
+	if (i != _items.end ()) {
+		if (i->second.entry->capacity >= capacity) {
+			/* read concurrently by another thread */
+			i->second.last_used = ++_serial;
+			return i->second.entry;
+		}
+		/* replace; clips that use the smaller entry keep their reference,
+		 * it is freed by ::evict() once they are done with it.
+		 */
+		_retired.push_back (i->second.entry);
+		i->second.entry = e;
+		i->second.last_used = ++_serial;
+	} else {
+		Item item;
+		item.entry     = e;
+		item.last_used = ++_serial;
+		_items.insert (std::make_pair (key, item));
+	}
+
+	return e;
+}
+
+void
+ClipDataCache::evict (size_t max_unused)
+{
+	std::vector<std::shared_ptr<Entry> > to_free;
+
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+
+		for (auto i = _retired.begin (); i != _retired.end ();) {
+			if (i->use_count () == 1) {
+				to_free.push_back (*i);
+				i = _retired.erase (i);
+			} else {
+				++i;
+			}
+		}
+
+		std::vector<Items::iterator> unused;
+		size_t                       unused_bytes = 0;
+
+		for (Items::iterator i = _items.begin (); i != _items.end (); ++i) {
+			if (i->second.entry.use_count () == 1) {
+				unused.push_back (i);
+				unused_bytes += i->second.entry->bytes ();
+			}
+		}
+
+		std::sort (unused.begin (), unused.end (), [] (Items::iterator const& a, Items::iterator const& b) {
+			return a->second.last_used < b->second.last_used;
+		});
+
+		for (auto const& i : unused) {
+			if (unused_bytes <= max_unused) {
+				break;
+			}
+			unused_bytes -= i->second.entry->bytes ();
+			to_free.push_back (i->second.entry);
+			_items.erase (i);
+			++_stats.evictions;
+		}
+	}
+
+	/* data is freed here, without holding the lock */
+	if (!to_free.empty ()) {
+		DEBUG_TRACE (DEBUG::Triggers, string_compose ("clip cache: freeing %1 entries\n", to_free.size ()));
+	}
+}
+
+ClipDataCache::Stats
+ClipDataCache::stats () const
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	Stats rv (_stats);
+
+	for (auto const& r : _retired) {
+		rv.bytes += r->bytes ();
+	}
+
+	for (auto const& i : _items) {
+		const size_t b = i.second.entry->bytes ();
+		rv.bytes += b;
+		++rv.entries;
+		if (i.second.entry.use_count () == 1) {
+			rv.unused_bytes += b;
+			++rv.unused;
+		}
+	}
+
+	return rv;
+}
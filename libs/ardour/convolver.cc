@@ -17,8 +17,18 @@
  */
 
 #include <assert.h>
+#include <algorithm>
+#include <sstream>
+#include <unistd.h>
 
+#include <glib.h>
+#include <glibmm/checksum.h>
+#include <glibmm/miscutils.h>
+
+#include "pbd/compose.h"
 #include "pbd/error.h"
+#include "pbd/file_utils.h"
+#include "pbd/gstdio_compat.h"
 #include "pbd/pthread_utils.h"
 
 #include "ardour/audio_buffer.h"
@@ -27,6 +37,7 @@
 #include "ardour/chan_mapping.h"
 #include "ardour/convolver.h"
 #include "ardour/dsp_filter.h"
+#include "ardour/filesystem_paths.h"
 #include "ardour/readable.h"
 #include "ardour/session.h"
 #include "ardour/source_factory.h"
@@ -39,6 +50,12 @@ using namespace ARDOUR;
 using namespace ARDOUR::DSP;
 using namespace ArdourZita;
 
+Glib::Threads::Mutex      Convolution::_impdata_cache_lock;
+Convolution::ImpDataCache Convolution::_impdata_cache;
+
+/* max. total size of files in the IR cache folder */
+static const int64_t impdata_cache_size = 512 * 1048576;
+
 Convolution::Convolution (Session& session, uint32_t n_in, uint32_t n_out)
     : SessionHandleRef (session)
     , _n_samples (0)
@@ -92,6 +109,8 @@ Convolution::restart ()
 	_convproc.stop_process ();
 	_convproc.cleanup ();
 	_convproc.set_options (0);
+	/* _convproc no longer references shared partitions */
+	_shared_impdata.reset ();
 
 	if (_impdata.empty ()) {
 		_configured = false;
@@ -118,7 +137,41 @@ Convolution::restart ()
 		_max_size = std::max (_max_size, (uint32_t)i->readable_length_samples ());
 	}
 
-	int rv = _convproc.configure (
+	int rv = configure (_convproc, n_part);
+
+	if (rv == 0) {
+		_shared_impdata = shared_impdata (n_part);
+		if (!_shared_impdata || _convproc.impdata_share (*_shared_impdata) != 0) {
+			_shared_impdata.reset ();
+			rv = create_impdata (_convproc);
+		}
+	}
+
+	if (rv == 0) {
+		rv = _convproc.start_process (pbd_absolute_rt_priority (PBD_SCHED_FIFO, PBD_RT_PRI_PROC), PBD_SCHED_FIFO);
+	}
+
+	assert (rv == 0); // bail out in debug builds
+
+	if (rv != 0) {
+		_convproc.stop_process ();
+		_convproc.cleanup ();
+		_shared_impdata.reset ();
+		_configured = false;
+		return;
+	}
+
+	_configured = true;
+
+#ifndef NDEBUG
+	_convproc.print (stdout);
+#endif
+}
+
+int
+Convolution::configure (Convproc& cp, uint32_t n_part) const
+{
+	return cp.configure (
 	    /*in*/ _n_inputs,
 	    /*out*/ _n_outputs,
 	    /*max-convolution length */ _max_size,
@@ -126,6 +179,12 @@ Convolution::restart ()
 	    /*Convproc::MINPART*/ _n_samples,
 	    /*Convproc::MAXPART*/ n_part,
 	    /*density 0 = auto, i/o dependent */ 0);
+}
+
+int
+Convolution::create_impdata (Convproc& cp) const
+{
+	int rv = 0;
 
 	for (std::vector<ImpData>::const_iterator i = _impdata.begin (); i != _impdata.end (); ++i) {
 		uint32_t pos = 0;
@@ -150,14 +209,14 @@ Convolution::restart ()
 				}
 			}
 
-			rv = _convproc.impdata_create (
+			rv = cp.impdata_create (
 			    /*i/o map */ i->c_in, i->c_out,
 			    /*stride, de-interleave */ 1,
 			    ir,
 			    ir_delay + pos, ir_delay + pos + ns);
 
 			if (rv != 0) {
-				break;
+				return rv;
 			}
 
 			pos += ns;
@@ -168,24 +227,173 @@ Convolution::restart ()
 		}
 	}
 
-	if (rv == 0) {
-		rv = _convproc.start_process (pbd_absolute_rt_priority (PBD_SCHED_FIFO, PBD_RT_PRI_PROC), PBD_SCHED_FIFO);
+	return rv;
+}
+
+std::string
+Convolution::impdata_key (uint32_t n_part) const
+{
+	if (_impdata_id.empty ()) {
+		return "";
 	}
 
-	assert (rv == 0); // bail out in debug builds
+	std::stringstream ss;
+	ss << _impdata_id
+	   << " sr:" << _session.nominal_sample_rate ()
+	   << " io:" << _n_inputs << "x" << _n_outputs
+	   << " size:" << _max_size
+	   << " quantum:" << _n_samples
+	   << " part:" << n_part
+	   << " fft:" << sizeof (fftwf_complex);
 
-	if (rv != 0) {
-		_convproc.stop_process ();
-		_convproc.cleanup ();
-		_configured = false;
-		return;
+	for (std::vector<ImpData>::const_iterator i = _impdata.begin (); i != _impdata.end (); ++i) {
+		ss << " [" << i->c_in << ":" << i->c_out
+		   << " g:" << std::hexfloat << i->gain << std::dec
+		   << " d:" << i->delay
+		   << " o:" << i->offset ()
+		   << " l:" << i->length ()
+		   << " c:" << i->channel ()
+		   << "]";
 	}
 
-	_configured = true;
+	return ss.str ();
+}
 
-#ifndef NDEBUG
-	_convproc.print (stdout);
-#endif
+/** Look up pre-processed IR partitions that can be shared by this instance.
+ * Partitions are computed at most once per process and stored in the user's
+ * cache folder to speed up loading sessions.
+ */
+std::shared_ptr<Convproc const>
+Convolution::shared_impdata (uint32_t n_part)
+{
+	std::string const key = impdata_key (n_part);
+
+	if (key.empty ()) {
+		return std::shared_ptr<Convproc const> ();
+	}
+
+	std::shared_ptr<ImpDataEntry> entry;
+
+	{
+		Glib::Threads::Mutex::Lock lm (_impdata_cache_lock);
+
+		while (!entry) {
+			ImpDataCache::iterator i = _impdata_cache.find (key);
+			if (i == _impdata_cache.end () || (!i->second->pending && i->second->impdata.expired ())) {
+				entry.reset (new ImpDataEntry);
+				_impdata_cache[key] = entry;
+			} else if (i->second->pending) {
+				/* another instance is computing the same partitions */
+				std::shared_ptr<ImpDataEntry> e (i->second);
+				e->cond.wait (_impdata_cache_lock);
+			} else {
+				std::shared_ptr<Convproc const> cp = i->second->impdata.lock ();
+				if (cp) {
+					return cp;
+				}
+			}
+		}
+	}
+
+	/* compute or load without holding the lock, other IRs can be
+	 * loaded concurrently */
+	std::shared_ptr<Convproc const> cp = load_impdata (n_part, key);
+
+	Glib::Threads::Mutex::Lock lm (_impdata_cache_lock);
+	entry->impdata = cp;
+	entry->pending = false;
+	if (!cp) {
+		ImpDataCache::iterator i = _impdata_cache.find (key);
+		if (i != _impdata_cache.end () && i->second == entry) {
+			_impdata_cache.erase (i);
+		}
+	}
+	entry->cond.broadcast ();
+	return cp;
+}
+
+std::shared_ptr<Convproc const>
+Convolution::load_impdata (uint32_t n_part, std::string const& key) const
+{
+	std::string const dir  = Glib::build_filename (user_cache_directory (), "convolver");
+	std::string const path = Glib::build_filename (dir, Glib::Checksum::compute_checksum (Glib::Checksum::CHECKSUM_SHA1, key) + ".ir");
+
+	std::shared_ptr<Convproc> cp (new Convproc);
+
+	if (configure (*cp, n_part)) {
+		return std::shared_ptr<Convproc const> ();
+	}
+
+	bool  loaded = false;
+	FILE* f      = g_fopen (path.c_str (), "rb");
+
+	if (f) {
+		loaded = cp->impdata_load (f) == 0;
+		fclose (f);
+		if (loaded) {
+			/* mark as recently used, see prune_impdata_cache () */
+			PBD::touch_file (path);
+		} else {
+			/* stale or corrupt, impdata_load() reset the configuration */
+			::g_unlink (path.c_str ());
+			if (configure (*cp, n_part)) {
+				return std::shared_ptr<Convproc const> ();
+			}
+		}
+	}
+
+	if (!loaded) {
+		if (create_impdata (*cp)) {
+			return std::shared_ptr<Convproc const> ();
+		}
+
+		/* write to a temporary file first, concurrent processes may read the cache */
+		std::string const tmp = string_compose ("%1.%2.tmp", path, getpid ());
+		if (g_mkdir_with_parents (dir.c_str (), 0755) == 0 && (f = g_fopen (tmp.c_str (), "wb")) != 0) {
+			bool ok = cp->impdata_save (f) == 0;
+			ok = (fclose (f) == 0) && ok;
+			if (!ok || ::g_rename (tmp.c_str (), path.c_str ()) != 0) {
+				::g_unlink (tmp.c_str ());
+			} else {
+				prune_impdata_cache (dir, path);
+			}
+		}
+	}
+
+	return cp;
+}
+
+/** Remove the least recently used files from the IR cache folder,
+ * until the total size is below impdata_cache_size.
+ */
+void
+Convolution::prune_impdata_cache (std::string const& dir, std::string const& keep)
+{
+	std::vector<std::string> files;
+	PBD::find_files_matching_pattern (files, dir, "*.ir");
+
+	typedef std::pair<time_t, std::pair<int64_t, std::string> > CacheFile;
+	std::vector<CacheFile> cache_files;
+	int64_t total = 0;
+
+	for (std::vector<std::string>::const_iterator i = files.begin (); i != files.end (); ++i) {
+		GStatBuf statbuf;
+		if (g_stat (i->c_str (), &statbuf) != 0) {
+			continue;
+		}
+		total += statbuf.st_size;
+		if (*i != keep) {
+			cache_files.push_back (std::make_pair (statbuf.st_mtime, std::make_pair ((int64_t) statbuf.st_size, *i)));
+		}
+	}
+
+	std::sort (cache_files.begin (), cache_files.end ());
+
+	for (std::vector<CacheFile>::const_iterator i = cache_files.begin (); i != cache_files.end () && total > impdata_cache_size; ++i) {
+		if (::g_unlink (i->second.second.c_str ()) == 0) {
+			total -= i->second.first;
+		}
+	}
 }
 
 void
@@ -258,6 +466,12 @@ Convolver::Convolver (
 		throw failed_constructor ();
 	}
 
+	/* share pre-processed partitions with other instances using the same file */
+	GStatBuf sb;
+	if (g_stat (path.c_str (), &sb) == 0) {
+		_impdata_id = string_compose ("%1 %2 %3", path, (int64_t)sb.st_size, (int64_t)sb.st_mtime);
+	}
+
 	/* map channels
 	 * - Mono:
 	 *    always use first only
@@ -82,6 +82,51 @@ ARDOUR::DSP::peaks (const float* data, float& min, float& max, uint32_t n_sample
 	ARDOUR::find_peaks (data, n_samples, &min, &max);
 }
 
+void
+ARDOUR::DSP::subtract (float* data, const float* src, const uint32_t n_samples)
+{
+	ARDOUR::subtract_buffers (data, src, n_samples);
+}
+
+void
+ARDOUR::DSP::multiply_add (float* data, const float* a, const float* b, const uint32_t n_samples)
+{
+	ARDOUR::multiply_add_buffers (data, a, b, n_samples);
+}
+
+void
+ARDOUR::DSP::scale_offset (float* data, const float gain, const float offset, const uint32_t n_samples)
+{
+	ARDOUR::scale_offset_buffer (data, n_samples, gain, offset);
+}
+
+void
+ARDOUR::DSP::clamp (float* data, const float min, const float max, const uint32_t n_samples)
+{
+	ARDOUR::clamp_buffer (data, n_samples, min, max);
+}
+
+void
+ARDOUR::DSP::rectify (float* data, const uint32_t n_samples)
+{
+	ARDOUR::rectify_buffer (data, n_samples);
+}
+
+float
+ARDOUR::DSP::rms (const float* data, const uint32_t n_samples)
+{
+	if (n_samples == 0) {
+		return 0;
+	}
+	return sqrtf (ARDOUR::sum_of_squares (data, n_samples) / n_samples);
+}
+
+double
+ARDOUR::DSP::interpolate (float* dst, const float* src, const uint32_t src_len, double pos, const double step, const uint32_t n_samples)
+{
+	return ARDOUR::interpolate_buffer (dst, src, src_len, pos, step, n_samples);
+}
+
 void
 ARDOUR::DSP::process_map (BufferSet* bufs, const ChanCount& n_out, const ChanMapping& in_map, const ChanMapping& out_map, pframes_t nframes, samplecnt_t offset)
 {
@@ -156,6 +201,110 @@ LowPass::ctrl (float* data, const float val, const uint32_t n_samples)
 
 /* ****************************************************************************/
 
+EnvelopeFollower::EnvelopeFollower (double samplerate, float attack, float release)
+	: _rate (samplerate)
+	, _z (0)
+{
+	set_times (attack, release);
+}
+
+void
+EnvelopeFollower::set_times (float attack, float release)
+{
+	_att = 1.f - expf (-1000.f / (std::max (.01f, attack) * _rate));
+	_rel = 1.f - expf (-1000.f / (std::max (.01f, release) * _rate));
+}
+
+float
+EnvelopeFollower::run (float const* data, float* env, const uint32_t n_samples)
+{
+	// localize variables
+	const float att = _att;
+	const float rel = _rel;
+	float       z   = _z;
+	if (env) {
+		for (uint32_t i = 0; i < n_samples; ++i) {
+			const float x = fabsf (data[i]);
+			z += (x > z ? att : rel) * (x - z);
+			env[i] = z;
+		}
+	} else {
+		for (uint32_t i = 0; i < n_samples; ++i) {
+			const float x = fabsf (data[i]);
+			z += (x > z ? att : rel) * (x - z);
+		}
+	}
+	if (!isfinite_local (z)) {
+		z = 0;
+	} else if (!std::isnormal (z)) {
+		z = 0;
+	}
+	_z = z;
+	return z;
+}
+
+/* ****************************************************************************/
+
+FIRFilter::FIRFilter (uint32_t n_taps)
+	: _max_taps (std::max<uint32_t> (1, n_taps))
+	, _n_taps (1)
+	, _pos (0)
+	, _coeff (0)
+	, _hist (0)
+{
+	cache_aligned_malloc ((void**)&_coeff, sizeof (float) * _max_taps);
+	/* history is stored twice, so that the most recent n_taps samples
+	 * are always available in a contiguous block.
+	 */
+	cache_aligned_malloc ((void**)&_hist, sizeof (float) * 2 * _max_taps);
+	::memset (_coeff, 0, sizeof (float) * _max_taps);
+	_coeff[0] = 1.f;
+	reset ();
+}
+
+FIRFilter::~FIRFilter ()
+{
+	cache_aligned_free (_coeff);
+	cache_aligned_free (_hist);
+}
+
+bool
+FIRFilter::set_coefficients (float const* coeff, const uint32_t n_taps)
+{
+	if (n_taps == 0 || n_taps > _max_taps) {
+		return false;
+	}
+	if (n_taps != _n_taps) {
+		_n_taps = n_taps;
+		reset ();
+	}
+	copy_vector (_coeff, coeff, n_taps);
+	return true;
+}
+
+void
+FIRFilter::reset ()
+{
+	::memset (_hist, 0, sizeof (float) * 2 * _max_taps);
+	_pos = 0;
+}
+
+void
+FIRFilter::run (float* data, const uint32_t n_samples)
+{
+	const uint32_t     n     = _n_taps;
+	float const* const coeff = _coeff;
+
+	for (uint32_t i = 0; i < n_samples; ++i) {
+		_pos = (_pos == 0 ? n : _pos) - 1;
+		_hist[_pos] = _hist[_pos + n] = data[i];
+
+		data[i] = dot_product (coeff, &_hist[_pos], n);
+	}
+}
+
+/* ****************************************************************************/
+
 Biquad::Biquad (double samplerate)
 	: _rate (samplerate)
 	, _z1 (0.0)
@@ -475,6 +624,158 @@ Biquad::dB_at_freq (float freq) const
 
 /* ****************************************************************************/
 
+const uint32_t MultiBiquad::_block_size = 256;
+
+MultiBiquad::MultiBiquad (double samplerate, uint32_t n_channels, uint32_t n_stages)
+	: _rate (samplerate)
+	, _n_channels (n_channels)
+	, _n_stages (n_stages)
+	, _coeff (0)
+	, _state (0)
+	, _interleaved (0)
+{
+	assert (n_channels > 0 && n_stages > 0);
+
+	_filters.reserve (n_channels * n_stages);
+	for (uint32_t i = 0; i < n_channels * n_stages; ++i) {
+		_filters.push_back (Biquad (samplerate));
+	}
+
+	cache_aligned_malloc ((void**)&_coeff, sizeof (float) * 5 * n_stages * n_channels);
+	cache_aligned_malloc ((void**)&_state, sizeof (float) * 2 * n_stages * n_channels);
+	cache_aligned_malloc ((void**)&_interleaved, sizeof (float) * _block_size * n_channels);
+
+	for (uint32_t c = 0; c < n_channels; ++c) {
+		for (uint32_t s = 0; s < n_stages; ++s) {
+			set_coefficients (c, s);
+		}
+	}
+	reset ();
+}
+
+MultiBiquad::~MultiBiquad ()
+{
+	cache_aligned_free (_coeff);
+	cache_aligned_free (_state);
+	cache_aligned_free (_interleaved);
+}
+
+void
+MultiBiquad::set_coefficients (uint32_t chn, uint32_t stage)
+{
+	double a1, a2, b0, b1, b2;
+	_filters[chn * _n_stages + stage].coefficients (a1, a2, b0, b1, b2);
+
+	float* c = &_coeff[stage * 5 * _n_channels + chn];
+	c[0 * _n_channels] = b0;
+	c[1 * _n_channels] = b1;
+	c[2 * _n_channels] = b2;
+	c[3 * _n_channels] = a1;
+	c[4 * _n_channels] = a2;
+}
+
+void
+MultiBiquad::compute (uint32_t chn, uint32_t stage, Biquad::Type t, double freq, double Q, double gain)
+{
+	if (chn >= _n_channels || stage >= _n_stages) {
+		return;
+	}
+	_filters[chn * _n_stages + stage].compute (t, freq, Q, gain);
+	set_coefficients (chn, stage);
+}
+
+void
+MultiBiquad::compute_all (uint32_t stage, Biquad::Type t, double freq, double Q, double gain)
+{
+	if (stage >= _n_stages) {
+		return;
+	}
+	_filters[stage].compute (t, freq, Q, gain);
+	set_coefficients (0, stage);
+	for (uint32_t c = 1; c < _n_channels; ++c) {
+		_filters[c * _n_stages + stage].configure (_filters[stage]);
+		set_coefficients (c, stage);
+	}
+}
+
+void
+MultiBiquad::configure (uint32_t chn, uint32_t stage, Biquad const& other)
+{
+	if (chn >= _n_channels || stage >= _n_stages) {
+		return;
+	}
+	_filters[chn * _n_stages + stage].configure (other);
+	set_coefficients (chn, stage);
+}
+
+float
+MultiBiquad::dB_at_freq (uint32_t chn, float freq) const
+{
+	if (chn >= _n_channels) {
+		return 0;
+	}
+	float rv = 0;
+	for (uint32_t s = 0; s < _n_stages; ++s) {
+		rv += _filters[chn * _n_stages + s].dB_at_freq (freq);
+	}
+	return std::min (120.f, std::max (-120.f, rv));
+}
+
+void
+MultiBiquad::reset ()
+{
+	ARDOUR::DSP::memset (_state, 0, 2 * _n_stages * _n_channels);
+}
+
+void
+MultiBiquad::flush_denormals ()
+{
+	for (uint32_t i = 0; i < 2 * _n_stages * _n_channels; ++i) {
+		if (!isfinite_local (_state[i]) || !std::isnormal (_state[i])) {
+			_state[i] = 0;
+		}
+	}
+}
+
+void
+MultiBiquad::run_interleaved (float* data, const uint32_t n_frames)
+{
+	ARDOUR::biquad_cascade (data, _n_channels, n_frames, _n_stages, _coeff, _state);
+	flush_denormals ();
+}
+
+void
+MultiBiquad::run (float* const* data, const uint32_t n_samples)
+{
+	uint32_t done = 0;
+	while (done < n_samples) {
+		const uint32_t n = std::min (_block_size, n_samples - done);
+
+		for (uint32_t c = 0; c < _n_channels; ++c) {
+			float const* src = &data[c][done];
+			float*       dst = &_interleaved[c];
+			for (uint32_t i = 0; i < n; ++i, dst += _n_channels) {
+				*dst = src[i];
+			}
+		}
+
+		ARDOUR::biquad_cascade (_interleaved, _n_channels, n, _n_stages, _coeff, _state);
+
+		for (uint32_t c = 0; c < _n_channels; ++c) {
+			float const* src = &_interleaved[c];
+			float*       dst = &data[c][done];
+			for (uint32_t i = 0; i < n; ++i, src += _n_channels) {
+				dst[i] = *src;
+			}
+		}
+
+		done += n;
+	}
+	flush_denormals ();
+}
+
+/* ****************************************************************************/
+
 FFTSpectrum::FFTSpectrum (uint32_t window_size, double rate)
 	: hann_window (0)
 {
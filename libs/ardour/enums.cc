@@ -268,6 +268,8 @@ setup_enum_writer ()
 	REGISTER_ENUM (MeterVU);
 	REGISTER_ENUM (MeterPeak0dB);
 	REGISTER_ENUM (MeterMCP);
+	REGISTER_ENUM (MeterTruePeak);
+	REGISTER_ENUM (MeterLUFS);
 	REGISTER (_MeterType);
 
 	REGISTER_ENUM (Normal);
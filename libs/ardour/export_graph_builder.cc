@@ -22,6 +22,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <climits>
 #include <vector>
 
 #include <glib.h>
@@ -155,11 +156,17 @@ using std::string;
 
 namespace ARDOUR {
 
+/* job_next while no jobs are set up */
+static const int job_closed = INT_MAX / 2;
+
 ExportGraphBuilder::ExportGraphBuilder (Session const & session)
 	: session (session)
 	, thread_pool (hardware_concurrency())
 {
 	process_buffer_samples = session.engine().samples_per_cycle();
+	job_next.store (job_closed);
+	job_count.store (0);
+	job_done.store (0);
 }
 
 ExportGraphBuilder::~ExportGraphBuilder ()
@@ -167,50 +174,172 @@ ExportGraphBuilder::~ExportGraphBuilder ()
 }
 
 samplecnt_t
-ExportGraphBuilder::process (samplecnt_t samples, bool last_cycle)
+ExportGraphBuilder::process (samplecnt_t samples, samplepos_t position, bool last_cycle)
 {
 	assert(samples <= process_buffer_samples);
 
 	sampleoffset_t off = 0;
-	for (ChannelMap::iterator it = channels.begin(); it != channels.end(); ++it) {
-		Buffer const* buf;
-		it->first->read (buf, samples);
+	for (ChannelBufferMap::iterator it = channel_buffers.begin(); it != channel_buffers.end(); ++it) {
+		it->first->read (it->second, samples);
 
 		if (session.remaining_latency_preroll () >= _master_align + samples) {
 			/* Skip processing during pre-roll, only read/write export ringbuffers */
 			return 0;
 		}
+	}
+
+	if (session.remaining_latency_preroll () > _master_align) {
+		off = session.remaining_latency_preroll () - _master_align;
+		assert (off < samples);
+	}
+
+	samplecnt_t const n_samples = samples - off;
+
+	if (spans.size () < 2) {
+		if (!spans.empty ()) {
+			process_span (spans.front (), off, n_samples, last_cycle);
+		}
+		return n_samples;
+	}
 
-		off = 0;
-		if (session.remaining_latency_preroll () > _master_align) {
-			off = session.remaining_latency_preroll () - _master_align;
-			assert (off < samples);
+	/* Several timespans are exported in a single pass. Only pass on the
+	 * part of this cycle that is inside a given timespan, and process
+	 * the timespans concurrently.
+	 */
+	jobs.clear ();
+	for (boost::ptr_list<Span>::iterator i = spans.begin(); i != spans.end(); ++i) {
+		Span& span (*i);
+		samplepos_t const s = span.timespan->get_start ();
+		samplepos_t const e = span.timespan->get_end ();
+
+		if (span.done || position + n_samples <= s || position >= e) {
+			continue;
 		}
 
+		sampleoffset_t const s_off = std::max<samplepos_t> (0, s - position);
+		samplecnt_t const    s_cnt = std::min<samplepos_t> (position + n_samples, e) - position - s_off;
+
+		span.done = position + n_samples >= e;
+		jobs.push_back (Job (span, off + s_off, s_cnt, span.done));
+	}
+
+	run_concurrently ();
+	return n_samples;
+}
+
+void
+ExportGraphBuilder::process_span (Span& span, sampleoffset_t off, samplecnt_t samples, bool last_cycle)
+{
+	for (ChannelMap::iterator it = span.channels.begin(); it != span.channels.end(); ++it) {
+		Buffer const* buf = channel_buffers.find (it->first)->second;
+
 		AudioBuffer const* ab = dynamic_cast<AudioBuffer const*> (buf);
 		MidiBuffer const*  mb;
 		if (ab) {
 			Sample const* process_buffer = ab->data ();
-			ConstProcessContext<Sample> context(&process_buffer[off], samples - off, 1);
+			ConstProcessContext<Sample> context(&process_buffer[off], samples, 1);
 			if (last_cycle) { context().set_flag (ProcessContext<Sample>::EndOfInput); }
 			it->second->process (context);
 		}
 		if  ((mb = dynamic_cast<MidiBuffer const*> (buf))) {
-			it->second->process (*mb, off, samples - off, last_cycle);
+			it->second->process (*mb, off, samples, last_cycle);
 		}
 	}
+}
+
+void
+ExportGraphBuilder::run_job (Job& job)
+{
+	if (job.span) {
+		process_span (*job.span, job.off, job.samples, job.last_cycle);
+	} else {
+		job.done = job.intermediate->process ();
+	}
+}
 
-	return samples - off;
+/** Process jobs until none are left, called by the thread that runs
+ * ExportGraphBuilder::run_concurrently, and by helpers in the thread-pool.
+ */
+void
+ExportGraphBuilder::run_jobs ()
+{
+	int i;
+	while ((i = job_next.fetch_add (1)) < job_count.load ()) {
+		try {
+			run_job (jobs[i]);
+		} catch (std::exception const& e) {
+			Glib::Threads::Mutex::Lock lm (job_mutex);
+			if (job_error.empty ()) {
+				job_error = e.what ();
+			}
+		}
+
+		if (job_done.fetch_add (1) + 1 == job_count.load ()) {
+			Glib::Threads::Mutex::Lock lm (job_mutex);
+			job_cond.signal ();
+		}
+	}
+}
+
+/** Process all jobs, using idle threads of the thread-pool if possible.
+ * The calling thread takes part, and only waits for jobs that were already
+ * started by other threads. Exceptions are passed on to the caller.
+ */
+void
+ExportGraphBuilder::run_concurrently ()
+{
+	int const n_jobs = jobs.size ();
+
+	if (n_jobs < 2) {
+		for (auto& job : jobs) {
+			run_job (job);
+		}
+		return;
+	}
+
+	job_error.clear ();
+	job_done.store (0);
+	job_count.store (n_jobs);
+	job_next.store (0);
+
+	/* Threaders of the jobs also use the pool, keep one thread available */
+	int const n_helpers = std::min (n_jobs - 1, thread_pool.get_max_threads () - 1);
+	for (int i = 0; i < n_helpers; ++i) {
+		thread_pool.push (sigc::mem_fun (*this, &ExportGraphBuilder::run_jobs));
+	}
+
+	run_jobs ();
+
+	Glib::Threads::Mutex::Lock lm (job_mutex);
+	while (job_done.load () != n_jobs) {
+		job_cond.wait (job_mutex);
+	}
+
+	/* helpers that start late must not take jobs of the next cycle
+	 * before they are set up */
+	job_next.store (job_closed);
+
+	if (!job_error.empty ()) {
+		throw Exception (*this, job_error);
+	}
 }
 
 bool
 ExportGraphBuilder::post_process ()
 {
-	for (std::list<Intermediate *>::iterator it = intermediates.begin(); it != intermediates.end(); /* ++ in loop */) {
-		if ((*it)->process()) {
-			it = intermediates.erase (it);
-		} else {
-			++it;
+	/* each intermediate reads back its own TmpFile, and feeds
+	 * its own normalizers and encoders: process them concurrently.
+	 */
+	jobs.clear ();
+	for (std::list<Intermediate *>::iterator it = intermediates.begin(); it != intermediates.end(); ++it) {
+		jobs.push_back (Job (**it));
+	}
+
+	run_concurrently ();
+
+	for (auto const& job : jobs) {
+		if (job.done) {
+			intermediates.remove (job.intermediate);
 		}
 	}
 
@@ -231,11 +360,13 @@ void
 ExportGraphBuilder::reset ()
 {
 	timespan.reset();
-	channel_configs.clear ();
-	channels.clear ();
+	spans.clear ();
+	channel_buffers.clear ();
 	intermediates.clear ();
+	jobs.clear ();
 	analysis_map.clear();
 	_exported_files.clear();
+	_timespan_files.clear();
 	_realtime = false;
 	_master_align = 0;
 }
@@ -243,18 +374,38 @@ ExportGraphBuilder::reset ()
 void
 ExportGraphBuilder::cleanup (bool remove_out_files/*=false*/)
 {
-	ChannelConfigList::iterator iter = channel_configs.begin();
+	for (boost::ptr_list<Span>::iterator i = spans.begin(); i != spans.end(); ++i) {
+		ChannelConfigList& channel_configs (i->channel_configs);
+		ChannelConfigList::iterator iter = channel_configs.begin();
 
-	while (iter != channel_configs.end() ) {
-		iter->remove_children(remove_out_files);
-		iter = channel_configs.erase(iter);
+		while (iter != channel_configs.end() ) {
+			iter->remove_children(remove_out_files);
+			iter = channel_configs.erase(iter);
+		}
 	}
 }
 
+/** Set the timespan that following calls to add_config() refer to.
+ * Setting more than one timespan exports all of them in a single pass.
+ */
 void
 ExportGraphBuilder::set_current_timespan (std::shared_ptr<ExportTimespan> span)
 {
 	timespan = span;
+	spans.push_back (new Span (span));
+	jobs.reserve (spans.size ());
+}
+
+std::vector<std::string>
+ExportGraphBuilder::exported_files (std::shared_ptr<ExportTimespan> span) const
+{
+	std::vector<std::string> rv;
+	for (auto const& f : _timespan_files) {
+		if (f.first == span) {
+			rv.push_back (f.second);
+		}
+	}
+	return rv;
 }
 
 void
@@ -329,7 +480,9 @@ ExportGraphBuilder::get_analysis_results (AnalysisResults& results) {
 void
 ExportGraphBuilder::add_split_config (FileSpec const & config)
 {
-	for (ChannelConfigList::iterator it = channel_configs.begin(); it != channel_configs.end(); ++it) {
+	Span& span (spans.back ());
+
+	for (ChannelConfigList::iterator it = span.channel_configs.begin(); it != span.channel_configs.end(); ++it) {
 		if (*it == config) {
 			it->add_child (config);
 			return;
@@ -337,7 +490,12 @@ ExportGraphBuilder::add_split_config (FileSpec const & config)
 	}
 
 	// No duplicate channel config found, create new one
-	channel_configs.push_back (new ChannelConfig (*this, config, channels));
+	span.channel_configs.push_back (new ChannelConfig (*this, config, span.channels));
+
+	// Register channels to be read
+	for (ChannelMap::const_iterator it = span.channels.begin(); it != span.channels.end(); ++it) {
+		channel_buffers.insert (std::make_pair (it->first, (Buffer const*) 0));
+	}
 }
 
 /* Encoder */
@@ -893,6 +1051,7 @@ ExportGraphBuilder::Intermediate::prepare_post_processing()
 
 	tmp_file->add_output (threader);
 	parent.intermediates.push_back (this);
+	parent.jobs.reserve (parent.intermediates.size ());
 }
 
 void
@@ -27,6 +27,7 @@
 #include <glibmm/convert.h>
 
 #include "pbd/convert.h"
+#include "pbd/microseconds.h"
 
 #include "ardour/audioengine.h"
 #include "ardour/audiofile_tagger.h"
@@ -40,6 +41,7 @@
 #include "ardour/export_status.h"
 #include "ardour/export_format_specification.h"
 #include "ardour/export_filename.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/soundcloud_upload.h"
 #include "ardour/surround_return.h"
 #include "ardour/system_exec.h"
@@ -245,38 +247,44 @@ ExportHandler::start_timespan ()
 		return -1;
 	}
 
-	export_status->timespan++;
-
 	/* finish_timespan pops the config_map entry that has been done, so
 	   this is the timespan to do this time
 	*/
 	current_timespan = config_map.begin()->first;
 
-	export_status->total_samples_current_timespan = current_timespan->get_length();
+	/* .. along with any other timespan that can be exported in the same pass */
+	collect_timespans ();
+
+	export_status->timespan += current_timespans.size ();
+
+	export_status->total_samples_current_timespan = pass_end - pass_start;
 	export_status->timespan_name = current_timespan->name();
 	export_status->processed_samples_current_timespan = 0;
 
 	/* Register file configurations to graph builder */
 
-	/* Here's the config_map entries that use this timespan */
-	timespan_bounds = config_map.equal_range (current_timespan);
 	graph_builder->reset ();
-	graph_builder->set_current_timespan (current_timespan);
-	handle_duplicate_format_extensions();
 	bool realtime = current_timespan->realtime ();
 	bool region_export = true;
-	for (ConfigMap::iterator it = timespan_bounds.first; it != timespan_bounds.second; ++it) {
-		// Filenames can be shared across timespans
-		FileSpec & spec = it->second;
-		spec.filename->set_timespan (it->first);
-		switch (spec.channel_config->region_processing_type ()) {
-			case RegionExportChannelFactory::None:
-				region_export = false;
-				break;
-			default:
-				break;
+
+	for (auto const& ts : current_timespans) {
+		/* Here's the config_map entries that use this timespan */
+		timespan_bounds = config_map.equal_range (ts);
+		graph_builder->set_current_timespan (ts);
+		handle_duplicate_format_extensions();
+		for (ConfigMap::iterator it = timespan_bounds.first; it != timespan_bounds.second; ++it) {
+			// Filenames can be shared across timespans
+			FileSpec & spec = it->second;
+			spec.filename->set_timespan (it->first);
+			switch (spec.channel_config->region_processing_type ()) {
+				case RegionExportChannelFactory::None:
+					region_export = false;
+					break;
+				default:
+					break;
+			}
+			graph_builder->add_config (spec, realtime);
 		}
-		graph_builder->add_config (spec, realtime);
 	}
 
 	// ExportDialog::update_realtime_selection does not allow this
@@ -286,7 +294,8 @@ ExportHandler::start_timespan ()
 
 	post_processing = false;
 	session.ProcessExport.connect_same_thread (process_connection, std::bind (&ExportHandler::process, this, _1));
-	process_position = current_timespan->get_start();
+	process_position = pass_start;
+	stage_start = 0;
 
 	if (!region_export && !current_timespan->vapor ().empty () && session.surround_master ()) {
 		session.surround_master ()->surround_return ()->setup_export (current_timespan->vapor (), current_timespan->get_start (), current_timespan->get_end ());
@@ -296,6 +305,70 @@ ExportHandler::start_timespan ()
 	return session.start_audio_export (process_position, realtime, region_export);
 }
 
+bool
+ExportHandler::single_pass_capable (ExportTimespanPtr ts) const
+{
+	if (ts->realtime () || !ts->vapor ().empty ()) {
+		return false;
+	}
+
+	TimespanBounds bounds = const_cast<ConfigMap&> (config_map).equal_range (ts);
+	for (ConfigMap::iterator it = bounds.first; it != bounds.second; ++it) {
+		ExportChannelConfigPtr cc = it->second.channel_config;
+		if (cc->region_processing_type () != RegionExportChannelFactory::None) {
+			return false;
+		}
+		ExportChannelConfiguration::ChannelList const& channels = cc->get_channels ();
+		for (auto const& c : channels) {
+			if (c->midi ()) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/** Collect timespans that can be exported together with the current_timespan.
+ *
+ * With single-pass export enabled, all timespans that overlap (or abut)
+ * are rendered in one freewheel pass over the session range covering them.
+ */
+void
+ExportHandler::collect_timespans ()
+{
+	current_timespans.clear ();
+	current_timespans.insert (current_timespan);
+
+	pass_start = current_timespan->get_start ();
+	pass_end   = current_timespan->get_end ();
+
+	if (!Config->get_export_single_pass () || !single_pass_capable (current_timespan)) {
+		return;
+	}
+
+	/* config_map is sorted by timespan start */
+	for (ConfigMap::iterator it = config_map.upper_bound (current_timespan); it != config_map.end (); it = config_map.upper_bound (it->first)) {
+		ExportTimespanPtr ts = it->first;
+		if (ts->get_start () > pass_end) {
+			break;
+		}
+		if (!single_pass_capable (ts)) {
+			continue;
+		}
+		current_timespans.insert (ts);
+		pass_end = std::max (pass_end, ts->get_end ());
+	}
+
+	if (current_timespans.size () > 1) {
+		/* progress is reported for the combined pass */
+		samplecnt_t sum = 0;
+		for (auto const& ts : current_timespans) {
+			sum += ts->get_length ();
+		}
+		export_status->total_samples += (pass_end - pass_start) - sum;
+	}
+}
+
 void
 ExportHandler::handle_duplicate_format_extensions()
 {
@@ -358,7 +431,11 @@ ExportHandler::process_timespan (samplecnt_t samples)
 	/* update position */
 
 	samplecnt_t samples_to_read = 0;
-	samplepos_t const end = current_timespan->get_end();
+	samplepos_t const end = pass_end;
+
+	if (stage_start == 0) {
+		stage_start = PBD::get_microseconds ();
+	}
 
 	if (process_position >= end) {
 		/* export complete, post-roll to feed and flush latent plugins
@@ -370,6 +447,8 @@ ExportHandler::process_timespan (samplecnt_t samples)
 
 		export_status->stop = true;
 
+		add_stage_stats (export_status->active_job);
+
 		/* Start post-processing/normalizing if necessary */
 		post_processing = graph_builder->need_postprocessing ();
 		if (post_processing) {
@@ -390,7 +469,7 @@ ExportHandler::process_timespan (samplecnt_t samples)
 	}
 
 	/* Do actual processing */
-	samplecnt_t ret = graph_builder->process (samples_to_read, last_cycle);
+	samplecnt_t ret = graph_builder->process (samples_to_read, process_position, last_cycle);
 	if (ret > 0) {
 		process_position += ret;
 		export_status->processed_samples += ret;
@@ -403,10 +482,7 @@ ExportHandler::process_timespan (samplecnt_t samples)
 int
 ExportHandler::post_process ()
 {
-	if (graph_builder->post_process ()) {
-		finish_timespan ();
-		export_status->active_job = ExportStatus::Exporting;
-	} else {
+	if (export_status->active_job == ExportStatus::Exporting) {
 		if (graph_builder->realtime ()) {
 			export_status->active_job = ExportStatus::Encoding;
 		} else {
@@ -414,11 +490,42 @@ ExportHandler::post_process ()
 		}
 	}
 
+	if (graph_builder->post_process ()) {
+		add_stage_stats (export_status->active_job);
+		finish_timespan ();
+		export_status->active_job = ExportStatus::Exporting;
+	}
+
 	export_status->current_postprocessing_cycle++;
 
 	return 0;
 }
 
+/** Accumulate wall-clock time and samples of the stage that just completed */
+void
+ExportHandler::add_stage_stats (ExportStatus::Progress stage)
+{
+	PBD::microseconds_t now = PBD::get_microseconds ();
+	ExportStatus::StageStats& st (export_status->stage_stats[stage]);
+	st.samples += pass_end - pass_start;
+	st.usecs   += now - stage_start;
+	stage_start = now;
+}
+
+void
+ExportHandler::report_stage_stats () const
+{
+	samplecnt_t const sr = session.nominal_sample_rate ();
+	for (int i = ExportStatus::Exporting; i <= ExportStatus::Encoding; ++i) {
+		ExportStatus::StageStats const& st (export_status->stage_stats[i]);
+		if (st.usecs > 0) {
+			info << string_compose (_("Export: %1 took %2 sec (%3x realtime)"),
+			                        ExportStatus::stage_name ((ExportStatus::Progress) i),
+			                        st.usecs / 1e6, st.realtime_factor (sr)) << endmsg;
+		}
+	}
+}
+
 void
 ExportHandler::command_output(std::string output, size_t size)
 {
@@ -439,143 +546,153 @@ ExportHandler::finish_timespan ()
 	 * for a single config, config_map iterator below does not yet
 	 * take that into account.
 	 */
-	for (auto const& f : graph_builder->exported_files ()) {
-		Session::Exported (current_timespan->name(), f, config_map.begin()->second.format->reimport(), current_timespan->get_start ()); /* EMIT SIGNAL */
+	for (auto const& ts : current_timespans) {
+		bool reimport = config_map.find (ts)->second.format->reimport();
+		for (auto const& f : graph_builder->exported_files (ts)) {
+			Session::Exported (ts->name(), f, reimport, ts->get_start ()); /* EMIT SIGNAL */
+		}
 	}
 
-	while (config_map.begin() != timespan_bounds.second) {
+	for (auto const& ts : current_timespans) {
+		ConfigMap::iterator cit;
+		while ((cit = config_map.find (ts)) != config_map.end ()) {
 
-		// XXX single timespan+format may produce multiple files
-		// e.g export selection == session
-		// -> TagLib::FileRef is null
+			// XXX single timespan+format may produce multiple files
+			// e.g export selection == session
+			// -> TagLib::FileRef is null
 
-		FileSpec& config = config_map.begin()->second;
-		ExportFormatSpecPtr fmt = config.format;
-		config.filename->set_channel_config (config.channel_config);
-		std::string filename = config.filename->get_path (fmt);
+			FileSpec& config = cit->second;
+			ExportFormatSpecPtr fmt = config.format;
+			config.filename->set_channel_config (config.channel_config);
+			std::string filename = config.filename->get_path (fmt);
 
-		if (fmt->type () == ExportFormatBase::T_None) {
-			graph_builder->reset ();
-			config_map.erase (config_map.begin());
-			continue;
-		}
-
-		if (fmt->with_cue()) {
-			export_cd_marker_file (current_timespan, fmt, filename, CDMarkerCUE);
-		}
+			if (fmt->type () == ExportFormatBase::T_None) {
+				graph_builder->reset ();
+				config_map.erase (cit);
+				continue;
+			}
 
-		if (fmt->with_toc()) {
-			export_cd_marker_file (current_timespan, fmt, filename, CDMarkerTOC);
-		}
+			if (fmt->with_cue()) {
+				export_cd_marker_file (ts, fmt, filename, CDMarkerCUE);
+			}
 
-		if (fmt->with_mp4chaps()) {
-			export_cd_marker_file (current_timespan, fmt, filename, MP4Chaps);
-		}
+			if (fmt->with_toc()) {
+				export_cd_marker_file (ts, fmt, filename, CDMarkerTOC);
+			}
 
-		/* close file first, otherwise TagLib enounters an ERROR_SHARING_VIOLATION
-		 * The process cannot access the file because it is being used.
-		 * ditto for post-export and upload.
-		 */
-		graph_builder->reset ();
+			if (fmt->with_mp4chaps()) {
+				export_cd_marker_file (ts, fmt, filename, MP4Chaps);
+			}
 
-		if (fmt->tag()) {
-			/* TODO: check Umlauts and encoding in filename.
-			 * TagLib eventually calls CreateFileA(),
+			/* close file first, otherwise TagLib enounters an ERROR_SHARING_VIOLATION
+			 * The process cannot access the file because it is being used.
+			 * ditto for post-export and upload.
 			 */
-			export_status->active_job = ExportStatus::Tagging;
-			AudiofileTagger::tag_file(filename, *SessionMetadata::Metadata());
-		}
+			graph_builder->reset ();
+
+			if (fmt->tag()) {
+				/* TODO: check Umlauts and encoding in filename.
+				 * TagLib eventually calls CreateFileA(),
+				 */
+				export_status->active_job = ExportStatus::Tagging;
+				AudiofileTagger::tag_file(filename, *SessionMetadata::Metadata());
+			}
 
-		if (!fmt->command().empty()) {
-			SessionMetadata const & metadata (*SessionMetadata::Metadata());
-
-			export_status->active_job = ExportStatus::Command;
-			PBD::ScopedConnection command_connection;
-
-			std::stringstream track_number;
-			track_number << metadata.track_number ();
-			std::stringstream total_tracks;
-			total_tracks << metadata.total_tracks ();
-			std::stringstream year;
-			year << metadata.year ();
-
-			std::map<char, std::string> subs {
-				{'a', metadata.artist ()},
-				{'b', PBD::basename_nosuffix (filename)},
-				{'c', metadata.copyright ()},
-				{'d', Glib::path_get_dirname (filename) + G_DIR_SEPARATOR},
-				{'f', filename},
-				{'l', metadata.lyricist ()},
-				{'n', session.name ()},
-				{'s', session.path ()},
-				{'o', metadata.conductor ()},
-				{'t', metadata.title ()},
-				{'z', metadata.organization ()},
-				{'A', metadata.album ()},
-				{'C', metadata.comment ()},
-				{'E', metadata.engineer ()},
-				{'G', metadata.genre ()},
-				{'L', total_tracks.str ()},
-				{'M', metadata.mixer ()},
-				{'N', current_timespan->name()}, // =?= config_map.begin()->first->name ()
-				{'O', metadata.composer ()},
-				{'P', metadata.producer ()},
-				{'S', metadata.disc_subtitle ()},
-				{'T', track_number.str ()},
-				{'Y', year.str ()},
-				{'Z', metadata.country ()}
-			};
-
-			ARDOUR::SystemExec *se = new ARDOUR::SystemExec(fmt->command(), subs, true);
-			info << "Post-export command line : {" << se->to_s () << "}" << endmsg;
-			se->ReadStdout.connect_same_thread(command_connection, std::bind(&ExportHandler::command_output, this, _1, _2));
-			int ret = se->start (SystemExec::MergeWithStdin);
-			if (ret == 0) {
-				// successfully started
-				while (se->is_running ()) {
-					// wait for system exec to terminate
-					Glib::usleep (1000);
+			if (!fmt->command().empty()) {
+				SessionMetadata const & metadata (*SessionMetadata::Metadata());
+
+				export_status->active_job = ExportStatus::Command;
+				PBD::ScopedConnection command_connection;
+
+				std::stringstream track_number;
+				track_number << metadata.track_number ();
+				std::stringstream total_tracks;
+				total_tracks << metadata.total_tracks ();
+				std::stringstream year;
+				year << metadata.year ();
+
+				std::map<char, std::string> subs {
+					{'a', metadata.artist ()},
+					{'b', PBD::basename_nosuffix (filename)},
+					{'c', metadata.copyright ()},
+					{'d', Glib::path_get_dirname (filename) + G_DIR_SEPARATOR},
+					{'f', filename},
+					{'l', metadata.lyricist ()},
+					{'n', session.name ()},
+					{'s', session.path ()},
+					{'o', metadata.conductor ()},
+					{'t', metadata.title ()},
+					{'z', metadata.organization ()},
+					{'A', metadata.album ()},
+					{'C', metadata.comment ()},
+					{'E', metadata.engineer ()},
+					{'G', metadata.genre ()},
+					{'L', total_tracks.str ()},
+					{'M', metadata.mixer ()},
+					{'N', ts->name()},
+					{'O', metadata.composer ()},
+					{'P', metadata.producer ()},
+					{'S', metadata.disc_subtitle ()},
+					{'T', track_number.str ()},
+					{'Y', year.str ()},
+					{'Z', metadata.country ()}
+				};
+
+				ARDOUR::SystemExec *se = new ARDOUR::SystemExec(fmt->command(), subs, true);
+				info << "Post-export command line : {" << se->to_s () << "}" << endmsg;
+				se->ReadStdout.connect_same_thread(command_connection, std::bind(&ExportHandler::command_output, this, _1, _2));
+				int ret = se->start (SystemExec::MergeWithStdin);
+				if (ret == 0) {
+					// successfully started
+					while (se->is_running ()) {
+						// wait for system exec to terminate
+						Glib::usleep (1000);
+					}
+				} else {
+					error << "Post-export command FAILED with Error: " << ret << endmsg;
 				}
-			} else {
-				error << "Post-export command FAILED with Error: " << ret << endmsg;
+				delete (se);
 			}
-			delete (se);
-		}
 
-		// XXX THIS IS IN REALTIME CONTEXT, CALLED FROM
-		// AudioEngine::process_callback()
-		// freewheeling, yes, but still uploading here is NOT
-		// a good idea.
-		//
-		// even less so, since SoundcloudProgress is using
-		// connect_same_thread() - GUI updates from the RT thread
-		// will cause crashes. http://pastebin.com/UJKYNGHR
-		if (fmt->soundcloud_upload()) {
-			SoundcloudUploader *soundcloud_uploader = new SoundcloudUploader;
-			std::string token = soundcloud_uploader->Get_Auth_Token(soundcloud_username, soundcloud_password);
-			DEBUG_TRACE (DEBUG::Soundcloud, string_compose(
-						"uploading %1 - username=%2, password=%3, token=%4",
-						filename, soundcloud_username, soundcloud_password, token) );
-			std::string path = soundcloud_uploader->Upload (
-					filename,
-					PBD::basename_nosuffix(filename), // title
-					token,
-					soundcloud_make_public,
-					soundcloud_downloadable,
-					this);
-
-			if (path.length() != 0) {
-				info << string_compose ( _("File %1 uploaded to %2"), filename, path) << endmsg;
-				if (soundcloud_open_page) {
-					DEBUG_TRACE (DEBUG::Soundcloud, string_compose ("opening %1", path) );
-					open_uri(path.c_str());  // open the soundcloud website to the new file
+			// XXX THIS IS IN REALTIME CONTEXT, CALLED FROM
+			// AudioEngine::process_callback()
+			// freewheeling, yes, but still uploading here is NOT
+			// a good idea.
+			//
+			// even less so, since SoundcloudProgress is using
+			// connect_same_thread() - GUI updates from the RT thread
+			// will cause crashes. http://pastebin.com/UJKYNGHR
+			if (fmt->soundcloud_upload()) {
+				SoundcloudUploader *soundcloud_uploader = new SoundcloudUploader;
+				std::string token = soundcloud_uploader->Get_Auth_Token(soundcloud_username, soundcloud_password);
+				DEBUG_TRACE (DEBUG::Soundcloud, string_compose(
+							"uploading %1 - username=%2, password=%3, token=%4",
+							filename, soundcloud_username, soundcloud_password, token) );
+				std::string path = soundcloud_uploader->Upload (
+						filename,
+						PBD::basename_nosuffix(filename), // title
+						token,
+						soundcloud_make_public,
+						soundcloud_downloadable,
+						this);
+
+				if (path.length() != 0) {
+					info << string_compose ( _("File %1 uploaded to %2"), filename, path) << endmsg;
+					if (soundcloud_open_page) {
+						DEBUG_TRACE (DEBUG::Soundcloud, string_compose ("opening %1", path) );
+						open_uri(path.c_str());  // open the soundcloud website to the new file
+					}
+				} else {
+					error << _("upload to Soundcloud failed. Perhaps your email or password are incorrect?\n") << endmsg;
 				}
-			} else {
-				error << _("upload to Soundcloud failed. Perhaps your email or password are incorrect?\n") << endmsg;
+				delete soundcloud_uploader;
 			}
-			delete soundcloud_uploader;
+			config_map.erase (cit);
 		}
-		config_map.erase (config_map.begin());
+	}
+
+	if (config_map.empty ()) {
+		report_stage_stats ();
 	}
 
 	/* finish timespan is called in freewheeling rt-context,
@@ -21,6 +21,8 @@
 
 #include "ardour/export_status.h"
 
+#include "pbd/i18n.h"
+
 namespace ARDOUR
 {
 
@@ -52,6 +54,30 @@ ExportStatus::init ()
 	total_postprocessing_cycles = 0;
 	current_postprocessing_cycle = 0;
 	result_map.clear();
+
+	for (auto& st : stage_stats) {
+		st = StageStats ();
+	}
+}
+
+const char*
+ExportStatus::stage_name (Progress p)
+{
+	switch (p) {
+		case Exporting:
+			return _("rendering");
+		case Normalizing:
+			return _("normalizing");
+		case Encoding:
+			return _("encoding");
+		case Tagging:
+			return _("tagging");
+		case Uploading:
+			return _("uploading");
+		case Command:
+			return _("post-export command");
+	}
+	return "";
 }
 
 void
@@ -157,6 +157,21 @@ apply_gain_to_buffer_t  ARDOUR::apply_gain_to_buffer  = 0;
 mix_buffers_with_gain_t ARDOUR::mix_buffers_with_gain = 0;
 mix_buffers_no_gain_t   ARDOUR::mix_buffers_no_gain   = 0;
 copy_vector_t           ARDOUR::copy_vector           = 0;
+biquad_cascade_t        ARDOUR::biquad_cascade        = 0;
+apply_gain_ramp_t       ARDOUR::apply_gain_ramp       = 0;
+mix_buffers_with_ramp_t ARDOUR::mix_buffers_with_ramp = 0;
+interleave_t            ARDOUR::interleave            = 0;
+deinterleave_t          ARDOUR::deinterleave          = 0;
+float_to_s16_t          ARDOUR::float_to_s16          = 0;
+float_to_s24_t          ARDOUR::float_to_s24          = 0;
+sum_of_squares_t        ARDOUR::sum_of_squares        = 0;
+subtract_buffers_t      ARDOUR::subtract_buffers      = 0;
+multiply_add_buffers_t  ARDOUR::multiply_add_buffers  = 0;
+scale_offset_buffer_t   ARDOUR::scale_offset_buffer   = 0;
+clamp_buffer_t          ARDOUR::clamp_buffer          = 0;
+rectify_buffer_t        ARDOUR::rectify_buffer        = 0;
+dot_product_t           ARDOUR::dot_product           = 0;
+interpolate_buffer_t    ARDOUR::interpolate_buffer    = 0;
 
 PBD::Signal<void(std::string)>                    ARDOUR::BootMessage;
 PBD::Signal<void(std::string, std::string, bool)> ARDOUR::PluginScanMessage;
@@ -211,6 +226,21 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = x86_avx512f_mix_buffers_with_gain;
 			mix_buffers_no_gain   = x86_avx512f_mix_buffers_no_gain;
 			copy_vector           = x86_avx512f_copy_vector;
+			biquad_cascade        = x86_avx512f_biquad_cascade;
+			apply_gain_ramp       = x86_avx512f_apply_gain_ramp;
+			mix_buffers_with_ramp = x86_avx512f_mix_buffers_with_ramp;
+			interleave            = x86_avx512f_interleave;
+			deinterleave          = x86_avx512f_deinterleave;
+			float_to_s16          = x86_avx512f_float_to_s16;
+			float_to_s24          = x86_avx512f_float_to_s24;
+			sum_of_squares        = x86_avx512f_sum_of_squares;
+			subtract_buffers      = x86_avx512f_subtract_buffers;
+			multiply_add_buffers  = x86_avx512f_multiply_add_buffers;
+			scale_offset_buffer   = x86_avx512f_scale_offset_buffer;
+			clamp_buffer          = x86_avx512f_clamp_buffer;
+			rectify_buffer        = x86_avx512f_rectify_buffer;
+			dot_product           = x86_avx512f_dot_product;
+			interpolate_buffer    = x86_avx512f_interpolate_buffer;
 
 			generic_mix_functions = false;
 
@@ -228,6 +258,21 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = x86_fma_mix_buffers_with_gain;
 			mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 			copy_vector           = x86_sse_avx_copy_vector;
+			biquad_cascade        = x86_fma_biquad_cascade;
+			apply_gain_ramp       = x86_fma_apply_gain_ramp;
+			mix_buffers_with_ramp = x86_fma_mix_buffers_with_ramp;
+			interleave            = x86_sse_interleave;
+			deinterleave          = x86_sse_deinterleave;
+			float_to_s16          = x86_fma_float_to_s16;
+			float_to_s24          = x86_fma_float_to_s24;
+			sum_of_squares        = x86_fma_sum_of_squares;
+			subtract_buffers      = x86_fma_subtract_buffers;
+			multiply_add_buffers  = x86_fma_multiply_add_buffers;
+			scale_offset_buffer   = x86_fma_scale_offset_buffer;
+			clamp_buffer          = x86_fma_clamp_buffer;
+			rectify_buffer        = x86_fma_rectify_buffer;
+			dot_product           = x86_fma_dot_product;
+			interpolate_buffer    = x86_fma_interpolate_buffer;
 
 			generic_mix_functions = false;
 
@@ -243,6 +288,21 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = x86_sse_avx_mix_buffers_with_gain;
 			mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 			copy_vector           = x86_sse_avx_copy_vector;
+			biquad_cascade        = x86_sse_biquad_cascade;
+			apply_gain_ramp       = x86_sse_apply_gain_ramp;
+			mix_buffers_with_ramp = x86_sse_mix_buffers_with_ramp;
+			interleave            = x86_sse_interleave;
+			deinterleave          = x86_sse_deinterleave;
+			float_to_s16          = default_float_to_s16;
+			float_to_s24          = default_float_to_s24;
+			sum_of_squares        = x86_sse_sum_of_squares;
+			subtract_buffers      = x86_sse_subtract_buffers;
+			multiply_add_buffers  = x86_sse_multiply_add_buffers;
+			scale_offset_buffer   = x86_sse_scale_offset_buffer;
+			clamp_buffer          = x86_sse_clamp_buffer;
+			rectify_buffer        = x86_sse_rectify_buffer;
+			dot_product           = x86_sse_dot_product;
+			interpolate_buffer    = default_interpolate_buffer;
 
 			generic_mix_functions = false;
 
@@ -256,6 +316,21 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = x86_sse_mix_buffers_with_gain;
 			mix_buffers_no_gain   = x86_sse_mix_buffers_no_gain;
 			copy_vector           = default_copy_vector;
+			biquad_cascade        = x86_sse_biquad_cascade;
+			apply_gain_ramp       = x86_sse_apply_gain_ramp;
+			mix_buffers_with_ramp = x86_sse_mix_buffers_with_ramp;
+			interleave            = x86_sse_interleave;
+			deinterleave          = x86_sse_deinterleave;
+			float_to_s16          = default_float_to_s16;
+			float_to_s24          = default_float_to_s24;
+			sum_of_squares        = x86_sse_sum_of_squares;
+			subtract_buffers      = x86_sse_subtract_buffers;
+			multiply_add_buffers  = x86_sse_multiply_add_buffers;
+			scale_offset_buffer   = x86_sse_scale_offset_buffer;
+			clamp_buffer          = x86_sse_clamp_buffer;
+			rectify_buffer        = x86_sse_rectify_buffer;
+			dot_product           = x86_sse_dot_product;
+			interpolate_buffer    = default_interpolate_buffer;
 
 			generic_mix_functions = false;
 		}
@@ -271,6 +346,21 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = arm_neon_mix_buffers_with_gain;
 			mix_buffers_no_gain   = arm_neon_mix_buffers_no_gain;
 			copy_vector           = arm_neon_copy_vector;
+			biquad_cascade        = arm_neon_biquad_cascade;
+			apply_gain_ramp       = arm_neon_apply_gain_ramp;
+			mix_buffers_with_ramp = arm_neon_mix_buffers_with_ramp;
+			interleave            = arm_neon_interleave;
+			deinterleave          = arm_neon_deinterleave;
+			float_to_s16          = arm_neon_float_to_s16;
+			float_to_s24          = arm_neon_float_to_s24;
+			sum_of_squares        = arm_neon_sum_of_squares;
+			subtract_buffers      = arm_neon_subtract_buffers;
+			multiply_add_buffers  = arm_neon_multiply_add_buffers;
+			scale_offset_buffer   = arm_neon_scale_offset_buffer;
+			clamp_buffer          = arm_neon_clamp_buffer;
+			rectify_buffer        = arm_neon_rectify_buffer;
+			dot_product           = arm_neon_dot_product;
+			interpolate_buffer    = default_interpolate_buffer;
 
 			generic_mix_functions = false;
 		}
@@ -284,6 +374,21 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = veclib_mix_buffers_with_gain;
 			mix_buffers_no_gain   = veclib_mix_buffers_no_gain;
 			copy_vector           = default_copy_vector;
+			biquad_cascade        = default_biquad_cascade;
+			apply_gain_ramp       = default_apply_gain_ramp;
+			mix_buffers_with_ramp = default_mix_buffers_with_ramp;
+			interleave            = default_interleave;
+			deinterleave          = default_deinterleave;
+			float_to_s16          = default_float_to_s16;
+			float_to_s24          = default_float_to_s24;
+			sum_of_squares        = default_sum_of_squares;
+			subtract_buffers      = default_subtract_buffers;
+			multiply_add_buffers  = default_multiply_add_buffers;
+			scale_offset_buffer   = default_scale_offset_buffer;
+			clamp_buffer          = default_clamp_buffer;
+			rectify_buffer        = default_rectify_buffer;
+			dot_product           = default_dot_product;
+			interpolate_buffer    = default_interpolate_buffer;
 
 			generic_mix_functions = false;
 
@@ -303,12 +408,31 @@ setup_hardware_optimization (bool try_optimization)
 		mix_buffers_with_gain = default_mix_buffers_with_gain;
 		mix_buffers_no_gain   = default_mix_buffers_no_gain;
 		copy_vector           = default_copy_vector;
+		biquad_cascade        = default_biquad_cascade;
+		apply_gain_ramp       = default_apply_gain_ramp;
+		mix_buffers_with_ramp = default_mix_buffers_with_ramp;
+		interleave            = default_interleave;
+		deinterleave          = default_deinterleave;
+		float_to_s16          = default_float_to_s16;
+		float_to_s24          = default_float_to_s24;
+		sum_of_squares        = default_sum_of_squares;
+		subtract_buffers      = default_subtract_buffers;
+		multiply_add_buffers  = default_multiply_add_buffers;
+		scale_offset_buffer   = default_scale_offset_buffer;
+		clamp_buffer          = default_clamp_buffer;
+		rectify_buffer        = default_rectify_buffer;
+		dot_product           = default_dot_product;
+		interpolate_buffer    = default_interpolate_buffer;
 
 		info << "No H/W specific optimizations in use" << endmsg;
 	}
 
 	AudioGrapher::Routines::override_compute_peak (compute_peak);
 	AudioGrapher::Routines::override_apply_gain_to_buffer (apply_gain_to_buffer);
+	AudioGrapher::Routines::override_interleave (interleave);
+	AudioGrapher::Routines::override_deinterleave (deinterleave);
+	AudioGrapher::Routines::override_float_to_s16 (float_to_s16);
+	AudioGrapher::Routines::override_float_to_s24 (float_to_s24);
 }
 
 static void
@@ -1074,6 +1198,7 @@ ARDOUR::reset_performance_meters (Session *session)
 		for (size_t n = 0; n < Session::NTT; ++n) {
 			session->dsp_stats[n].queue_reset ();
 		}
+		session->reset_lua_function_stats ();
 	}
 	for (size_t n = 0; n < AudioEngine::NTT; ++n) {
 		AudioEngine::instance()->dsp_stats[n].queue_reset ();
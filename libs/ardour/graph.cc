@@ -47,6 +47,8 @@ using namespace ARDOUR;
 using namespace PBD;
 using namespace std;
 
+thread_local bool Graph::_in_graph_thread = false;
+
 #ifdef DEBUG_RT_ALLOC
 static Graph* graph = 0;
 
@@ -245,6 +247,9 @@ Graph::reached_terminal_node ()
 
 		/* We have run all the nodes that are at the `output' end of
 		 * the graph, so there is nothing more to do this time around.
+		 *
+		 * RTSubTasks are not left in the queue either, their owner
+		 * waits until they were taken (see RTSubTaskList::process).
 		 */
 		assert (_trigger_queue_size.load() == 0);
 
@@ -349,6 +354,7 @@ Graph::run_one ()
 void
 Graph::helper_thread ()
 {
+	_in_graph_thread = true;
 	_n_workers.fetch_add (1);
 	uint32_t id = _n_workers.load();
 
@@ -382,6 +388,7 @@ Graph::main_thread ()
 {
 	/* first time setup */
 
+	_in_graph_thread = true;
 	suspend_rt_malloc_checks ();
 	ProcessThread* pt = new ProcessThread ();
 
@@ -599,6 +606,39 @@ Graph::process_tasklist (RTTaskList const& rt)
 	DEBUG_TRACE (DEBUG::ProcessThreads, "graph execution complete\n");
 }
 
+/** Queue sub-tasks for processing by idle worker threads.
+ *
+ * This is called from a graph thread while processing a node,
+ * and only wakes up threads that are currently idle. Tasks that
+ * are not picked up in time are processed by the caller, see
+ * RTSubTaskList::process.
+ *
+ * @return number of tasks that were queued
+ */
+uint32_t
+Graph::trigger_idle (std::vector<RTSubTask*> const& tasks, size_t first)
+{
+	assert (_in_graph_thread);
+
+	uint32_t idle_cnt = _idle_thread_cnt.load ();
+	uint32_t n_queued = 0;
+
+	for (size_t i = first; i < tasks.size () && n_queued < idle_cnt; ++i) {
+		_trigger_queue_size.fetch_add (1);
+		if (!_trigger_queue.push_back (tasks[i])) {
+			PBD::atomic_dec_and_test (_trigger_queue_size);
+			break;
+		}
+		++n_queued;
+	}
+
+	for (uint32_t i = 0; i < n_queued; ++i) {
+		_execution_sem.signal ();
+	}
+
+	return n_queued;
+}
+
 /* ****************************************************************************/
 
 GraphChain::GraphChain (GraphNodeList const& nodelist, GraphEdges const& edges)
@@ -24,8 +24,10 @@
 #include "libardour-config.h"
 #endif
 
+#include <atomic>
 #include <cstdio>
 #include <cstdlib>
+#include <functional>
 #include <string>
 #include <climits>
 #include <cerrno>
@@ -42,6 +44,9 @@
 
 #include "pbd/basename.h"
 #include "pbd/convert.h"
+#include "pbd/cpus.h"
+#include "pbd/pthread_utils.h"
+#include "pbd/semutils.h"
 
 #include "evoral/SMF.h"
 
@@ -252,22 +257,78 @@ compose_status_message (const string& path,
 	return string_compose (_("Copying %1"), Glib::path_get_basename (path));
 }
 
+/** Combines the progress of files that are imported concurrently,
+ * see ImportStatus::file_progress.
+ */
+class ImportProgress
+{
+public:
+	ImportProgress (ImportStatus& status)
+		: _status (status)
+		, _n_active (0)
+		, _sum (0)
+	{
+		_status.file_progress.assign (_status.paths.size (), 0);
+		_status.progress = 0;
+	}
+
+	void start (std::string const& doing_what)
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+		_status.doing_what = doing_what;
+		++_n_active;
+	}
+
+	void set (size_t n, float progress)
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+		_sum += progress - _status.file_progress[n];
+		_status.file_progress[n] = progress;
+		_status.progress = std::max (0.f, _sum);
+	}
+
+	void done (size_t n)
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+		if (--_n_active == 0) {
+			_sum = 0;
+		} else {
+			_sum -= _status.file_progress[n];
+		}
+		_status.file_progress[n] = 1;
+		_status.progress = std::max (0.f, _sum);
+		++_status.current;
+	}
+
+	uint32_t current () const
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+		return _status.current;
+	}
+
+private:
+	ImportStatus&                _status;
+	mutable Glib::Threads::Mutex _lock;
+	uint32_t             _n_active;
+	float                _sum;
+};
+
 static void
 write_audio_data_to_new_files (ImportableSource* source, ImportStatus& status,
-                               vector<std::shared_ptr<Source> >& newfiles)
+                               vector<std::shared_ptr<Source> >& newfiles,
+                               ImportProgress& progress, size_t file_index)
 {
 	const samplecnt_t nframes = ResampledImportableSource::blocksize;
-	std::shared_ptr<AudioFileSource> afs;
 	uint32_t channels = source->channels();
 	if (channels == 0) {
 		return;
 	}
 
 	std::unique_ptr<float[]> data(new float[nframes * channels]);
-	vector<std::shared_ptr<Sample[]> > channel_data;
+	vector<std::shared_ptr<AudioFileSource> > afs;
 
 	for (uint32_t n = 0; n < channels; ++n) {
-		channel_data.push_back(std::shared_ptr<Sample[]>(new Sample[nframes]));
+		afs.push_back (std::dynamic_pointer_cast<AudioFileSource>(newfiles[n]));
 	}
 
 	float gain = 1;
@@ -275,7 +336,6 @@ write_audio_data_to_new_files (ImportableSource* source, ImportStatus& status,
 	std::shared_ptr<AudioSource> s = std::dynamic_pointer_cast<AudioSource> (newfiles[0]);
 	assert (s);
 
-	status.progress = 0.0f;
 	float progress_multiplier = 1;
 	float progress_base = 0;
 	const float progress_length = source->ratio() * source->length();
@@ -299,7 +359,7 @@ write_audio_data_to_new_files (ImportableSource* source, ImportStatus& status,
 			peak = compute_peak (data.get(), nread, peak);
 
 			read_count += nread / channels;
-			status.progress = 0.5 * read_count / progress_length;
+			progress.set (file_index, 0.5 * read_count / progress_length);
 		}
 
 		if (peak >= 1) {
@@ -312,54 +372,103 @@ write_audio_data_to_new_files (ImportableSource* source, ImportStatus& status,
 		progress_base = 0.5;
 	}
 
-	samplecnt_t read_count = 0;
-
-	while (!status.cancel) {
+	/* Reading (and resampling) is pipelined with writing (and computing
+	 * peaks): a reader thread fills one block, while this thread writes
+	 * the other one to disk. Blocks hold de-interleaved data.
+	 */
+	struct Block {
+		Block (uint32_t channels, samplecnt_t nframes) : data (new Sample[channels * nframes]), length (0) {}
+		std::unique_ptr<Sample[]> data;
+		samplecnt_t               length;
+	};
+
+	const size_t n_blocks = 2;
+	vector<std::shared_ptr<Block> > blocks;
+	for (size_t b = 0; b < n_blocks; ++b) {
+		blocks.push_back (std::shared_ptr<Block> (new Block (channels, nframes)));
+	}
 
-		samplecnt_t nread, nfread;
-		uint32_t x;
-		uint32_t chn;
+	samplecnt_t read_count = 0;
 
-		if ((nread = source->read (data.get(), nframes * channels)) == 0) {
-#ifdef PLATFORM_WINDOWS
-			/* Flush the data once we've finished importing the file. Windows can  */
-			/* cache the data for very long periods of time (perhaps not writing   */
-			/* it to disk until Ardour closes). So let's force it to flush now.    */
-			for (chn = 0; chn < channels; ++chn)
-				if ((afs = std::dynamic_pointer_cast<AudioFileSource>(newfiles[chn])) != 0)
-					afs->flush ();
-#endif
-			break;
-		}
+	auto read_block = [&] (Block& b) {
+		samplecnt_t const nread = status.cancel ? 0 : source->read (data.get(), nframes * channels);
 
-		if (gain != 1) {
+		if (nread > 0 && gain != 1) {
 			/* here is the gain fix for out-of-range sample values that we computed earlier */
 			apply_gain_to_buffer (data.get(), nread, gain);
 		}
 
-		nfread = nread / channels;
+		b.length = nread / channels;
 
 		/* de-interleave */
 
-		for (chn = 0; chn < channels; ++chn) {
-
+		for (uint32_t chn = 0; chn < channels; ++chn) {
+			Sample* dst = &b.data[chn * nframes];
+			uint32_t x;
 			samplecnt_t n;
-			for (x = chn, n = 0; n < nfread; x += channels, ++n) {
-				channel_data[chn][n] = (Sample) data[x];
+			for (x = chn, n = 0; n < b.length; x += channels, ++n) {
+				dst[n] = (Sample) data[x];
 			}
 		}
+	};
 
-		/* flush to disk */
-
-		for (chn = 0; chn < channels; ++chn) {
-			if ((afs = std::dynamic_pointer_cast<AudioFileSource>(newfiles[chn])) != 0) {
-				afs->write (channel_data[chn].get(), nfread);
+	auto write_block = [&] (Block const& b) {
+		for (uint32_t chn = 0; chn < channels; ++chn) {
+			if (afs[chn]) {
+				afs[chn]->write (&b.data[chn * nframes], b.length);
 			}
 		}
+		read_count += b.length;
+		progress.set (file_index, progress_base + progress_multiplier * read_count / progress_length);
+	};
+
+	PBD::Semaphore to_read ("ImportRead", n_blocks);
+	PBD::Semaphore to_write ("ImportWrite", 0);
+
+	std::function<void ()> reader = [&] () {
+		for (size_t b = 0;; b = (b + 1) % n_blocks) {
+			to_read.wait ();
+			read_block (*blocks[b]);
+			to_write.signal ();
+			if (blocks[b]->length == 0) {
+				break;
+			}
+		}
+	};
+
+	/* fall back to reading and writing alternately if no thread can be created */
+	PBD::Thread* reader_thread = PBD::Thread::create (reader, "ImportRead");
+
+	for (size_t b = 0;; b = (b + 1) % n_blocks) {
+		if (reader_thread) {
+			to_write.wait ();
+		} else {
+			read_block (*blocks[b]);
+		}
+		if (blocks[b]->length == 0) {
+			break;
+		}
+		write_block (*blocks[b]);
+		if (reader_thread) {
+			to_read.signal ();
+		}
+	}
+
+	if (reader_thread) {
+		reader_thread->join ();
+		delete reader_thread;
+	}
 
-		read_count += nfread;
-		status.progress = progress_base + progress_multiplier * read_count / progress_length;
+#ifdef PLATFORM_WINDOWS
+	/* Flush the data once we've finished importing the file. Windows can  */
+	/* cache the data for very long periods of time (perhaps not writing   */
+	/* it to disk until Ardour closes). So let's force it to flush now.    */
+	for (uint32_t chn = 0; chn < channels; ++chn) {
+		if (afs[chn]) {
+			afs[chn]->flush ();
+		}
 	}
+#endif
 }
 
 static void
@@ -625,6 +734,18 @@ Session::import_files (ImportStatus& status)
 
 	status.sources.clear ();
 
+	ImportProgress progress (status);
+
+	/* audio files are imported after MIDI files, concurrently */
+	struct AudioImport {
+		size_t                            index;
+		string                            path;
+		std::shared_ptr<ImportableSource> source;
+		Sources                           newfiles;
+	};
+
+	vector<AudioImport> audio_imports;
+
 	for (vector<string>::const_iterator p = status.paths.begin(); p != status.paths.end() && !status.cancel; ++p) {
 
 		std::shared_ptr<ImportableSource> source;
@@ -744,11 +865,15 @@ Session::import_files (ImportStatus& status)
 		}
 
 		if (source) { // audio
-			status.doing_what = compose_status_message (*p, source->samplerate(),
-			                                            sample_rate(), status.current, status.total);
-			write_audio_data_to_new_files (source.get(), status, newfiles);
+			AudioImport ai;
+			ai.index    = p - status.paths.begin ();
+			ai.path     = *p;
+			ai.source   = source;
+			ai.newfiles = newfiles;
+			audio_imports.push_back (ai);
+			continue;
 		} else if (smf_reader) { // midi
-			status.doing_what = string_compose(_("Loading MIDI file %1"), *p);
+			progress.start (string_compose(_("Loading MIDI file %1"), *p));
 			write_midi_data_to_new_files (smf_reader.get(), status, newfiles, status.split_midi_channels);
 
 			if (status.import_markers) {
@@ -761,8 +886,48 @@ Session::import_files (ImportStatus& status)
 			}
 		}
 
-		++status.current;
-		status.progress = 0;
+		progress.done (p - status.paths.begin ());
+	}
+
+	if (!status.cancel && !audio_imports.empty ()) {
+		std::atomic<size_t> next (0);
+
+		std::function<void ()> worker = [&] () {
+			/* like the thread calling import_files () */
+			Temporal::TempoMap::fetch ();
+
+			size_t n;
+			while (!status.cancel && (n = next.fetch_add (1)) < audio_imports.size ()) {
+				AudioImport& ai (audio_imports[n]);
+				progress.start (compose_status_message (ai.path, ai.source->samplerate(), sample_rate(), progress.current (), status.total));
+				write_audio_data_to_new_files (ai.source.get(), status, ai.newfiles, progress, ai.index);
+				/* close the file */
+				ai.source.reset ();
+				progress.done (ai.index);
+			}
+		};
+
+		/* files are independent, import them using a pool of threads,
+		 * which includes this one. Every worker also runs a reader thread
+		 * (see write_audio_data_to_new_files), use half as many workers
+		 * as there are CPUs.
+		 */
+		const size_t n_threads = std::min<size_t> (std::max<size_t> (1, hardware_concurrency () / 2), audio_imports.size ());
+
+		vector<PBD::Thread*> threads;
+		for (size_t t = 1; t < n_threads; ++t) {
+			PBD::Thread* thread = PBD::Thread::create (worker, string_compose ("Import %1", t));
+			if (thread) {
+				threads.push_back (thread);
+			}
+		}
+
+		worker ();
+
+		for (auto const& t : threads) {
+			t->join ();
+			delete t;
+		}
 	}
 
 	if (!status.cancel) {
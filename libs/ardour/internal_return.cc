@@ -47,11 +47,17 @@ InternalReturn::run (BufferSet& bufs, samplepos_t /*start_sample*/, samplepos_t
 		return;
 	}
 
+	/* collect all sends first, so that MIDI can be merged in one pass */
+	_send_buffers.clear ();
 	for (auto & send : _sends) {
 		if (send->active () && (!send->source_route() || send->source_route()->active())) {
-			bufs.merge_from (send->get_buffers(), nframes);
+			_send_buffers.push_back (&send->get_buffers());
 		}
 	}
+
+	if (!_send_buffers.empty ()) {
+		bufs.merge_from (_send_buffers, nframes);
+	}
 }
 
 void
@@ -59,6 +65,7 @@ InternalReturn::add_send (InternalSend* send)
 {
 	Glib::Threads::Mutex::Lock lm (_sends_mutex);
 	_sends.push_back (send);
+	_send_buffers.reserve (_sends.size ());
 }
 
 void
@@ -427,7 +427,7 @@ IOPlug::ensure_io ()
 	 if (_pre) {
 		 for (uint32_t i = 0; i < _n_out.n_audio (); ++i) {
 			 std::string const& n = AudioEngine::instance ()->make_port_name_non_relative (_output->audio (i)->name ());
-			 _audio_input_ports.insert (make_pair (n, PortManager::AudioInputPort (24288))); // 2^19 ~ 1MB / port
+			 _audio_input_ports.insert (make_pair (n, PortManager::AudioInputPort (24288, AudioEngine::instance ()->sample_rate ()))); // 2^19 ~ 1MB / port
 		 }
 		 for (uint32_t i = 0; i < _n_out.n_midi (); ++i) {
 			 std::string const& n = AudioEngine::instance ()->make_port_name_non_relative (_output->midi (i)->name ());
@@ -514,6 +514,12 @@ IOPlug::connect_and_run (samplepos_t start, pframes_t n_samples)
 		for (auto p = _bufs.audio_begin (); p != _bufs.audio_end (); ++p, ++a) {
 			AudioBuffer const& ab (*p);
 			PortManager::AudioInputPort& ai (a->second);
+			if (!ai.active ()) {
+				if (reset) {
+					ai.meter->reset ();
+				}
+				continue;
+			}
 			ai.apply_falloff (n_samples, rate, reset);
 			ai.process (ab.data (), n_samples, reset);
 		}
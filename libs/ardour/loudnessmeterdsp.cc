@@ -0,0 +1,310 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "pbd/malign.h"
+
+#include "ardour/loudnessmeterdsp.h"
+#include "ardour/runtime_functions.h"
+
+/* 4x upsampling, cosine windowed sinc, 48 taps per phase.
+ * Same interpolator as ARDOUR::LUFSMeter, the phases
+ * interpolate at 1/4, 2/4 and 3/4 after the 24th tap.
+ */
+static const float tp_phase[3][48] = {
+	{
+		-2.330790e-05f, 1.321291e-04f, -3.394408e-04f, 6.562235e-04f,
+		-1.094138e-03f, 1.665807e-03f, -2.385230e-03f, 3.268371e-03f,
+		-4.334012e-03f, 5.604985e-03f, -7.109989e-03f, 8.886314e-03f,
+		-1.098403e-02f, 1.347264e-02f, -1.645206e-02f, 2.007155e-02f,
+		-2.456432e-02f, 3.031531e-02f, -3.800644e-02f, 4.896667e-02f,
+		-6.616853e-02f, 9.788141e-02f, -1.788607e-01f, 9.000753e-01f,
+		2.993829e-01f, -1.269367e-01f, 7.922398e-02f, -5.647748e-02f,
+		4.295093e-02f, -3.385706e-02f, 2.724946e-02f, -2.218943e-02f,
+		1.816976e-02f, -1.489313e-02f, 1.217411e-02f, -9.891211e-03f,
+		7.961470e-03f, -6.326144e-03f, 4.942202e-03f, -3.777065e-03f,
+		2.805240e-03f, -2.006106e-03f, 1.362416e-03f, -8.592768e-04f,
+		4.834383e-04f, -2.228007e-04f, 6.607267e-05f, -2.537056e-06f
+	},
+	{
+		-1.450055e-05f, 1.359163e-04f, -3.928527e-04f, 8.006445e-04f,
+		-1.375510e-03f, 2.134915e-03f, -3.098103e-03f, 4.286860e-03f,
+		-5.726614e-03f, 7.448018e-03f, -9.489286e-03f, 1.189966e-02f,
+		-1.474471e-02f, 1.811472e-02f, -2.213828e-02f, 2.700557e-02f,
+		-3.301023e-02f, 4.062971e-02f, -5.069345e-02f, 6.477499e-02f,
+		-8.625619e-02f, 1.239454e-01f, -2.101678e-01f, 6.359382e-01f,
+		6.359382e-01f, -2.101678e-01f, 1.239454e-01f, -8.625619e-02f,
+		6.477499e-02f, -5.069345e-02f, 4.062971e-02f, -3.301023e-02f,
+		2.700557e-02f, -2.213828e-02f, 1.811472e-02f, -1.474471e-02f,
+		1.189966e-02f, -9.489286e-03f, 7.448018e-03f, -5.726614e-03f,
+		4.286860e-03f, -3.098103e-03f, 2.134915e-03f, -1.375510e-03f,
+		8.006445e-04f, -3.928527e-04f, 1.359163e-04f, -1.450055e-05f
+	},
+	{
+		-2.537056e-06f, 6.607267e-05f, -2.228007e-04f, 4.834383e-04f,
+		-8.592768e-04f, 1.362416e-03f, -2.006106e-03f, 2.805240e-03f,
+		-3.777065e-03f, 4.942202e-03f, -6.326144e-03f, 7.961470e-03f,
+		-9.891211e-03f, 1.217411e-02f, -1.489313e-02f, 1.816976e-02f,
+		-2.218943e-02f, 2.724946e-02f, -3.385706e-02f, 4.295093e-02f,
+		-5.647748e-02f, 7.922398e-02f, -1.269367e-01f, 2.993829e-01f,
+		9.000753e-01f, -1.788607e-01f, 9.788141e-02f, -6.616853e-02f,
+		4.896667e-02f, -3.800644e-02f, 3.031531e-02f, -2.456432e-02f,
+		2.007155e-02f, -1.645206e-02f, 1.347264e-02f, -1.098403e-02f,
+		8.886314e-03f, -7.109989e-03f, 5.604985e-03f, -4.334012e-03f,
+		3.268371e-03f, -2.385230e-03f, 1.665807e-03f, -1.094138e-03f,
+		6.562235e-04f, -3.394408e-04f, 1.321291e-04f, -2.330790e-05f
+	}
+};
+
+static const float channel_weight[5] = { 1.0, 1.0, 1.0, 1.41, 1.41 };
+
+const uint32_t Loudnessmeterdsp::_block_size;
+const uint32_t Loudnessmeterdsp::_n_taps;
+
+Loudnessmeterdsp::Loudnessmeterdsp (float fsamp, uint32_t n_channels)
+	: _n_channels (n_channels)
+	, _n_fragment (fsamp / 10)
+	, _x4 (fsamp <= 48000)
+{
+	assert (n_channels > 0);
+
+	cache_aligned_malloc ((void**)&_coeff, sizeof (float) * 10 * n_channels);
+	cache_aligned_malloc ((void**)&_state, sizeof (float) * 4 * n_channels);
+	cache_aligned_malloc ((void**)&_weight, sizeof (float) * n_channels);
+	cache_aligned_malloc ((void**)&_interleaved, sizeof (float) * _block_size * n_channels);
+	cache_aligned_malloc ((void**)&_hist, sizeof (float) * (_n_taps - 1 + _block_size) * n_channels);
+	cache_aligned_malloc ((void**)&_upsampled, sizeof (float) * _block_size);
+	cache_aligned_malloc ((void**)&_tp, sizeof (float) * n_channels);
+	_flag = new bool[n_channels];
+
+	/* ITU-R BS.1770 K-weighting for the given rate:
+	 * high-shelf (head effects) followed by a high-pass (RLB weighting).
+	 */
+	double f0 = 1681.974450955533;
+	double G  = 3.999843853973347;
+	double Q  = 0.7071752369554196;
+	double K  = tan (M_PI * f0 / fsamp);
+	double Vh = pow (10.0, G / 20.0);
+	double Vb = pow (Vh, 0.4996667741545416);
+	double a0 = 1.0 + K / Q + K * K;
+
+	const float shelf[5] = {
+		(float) ((Vh + Vb * K / Q + K * K) / a0),
+		(float) (2.0 * (K * K - Vh) / a0),
+		(float) ((Vh - Vb * K / Q + K * K) / a0),
+		(float) (2.0 * (K * K - 1.0) / a0),
+		(float) ((1.0 - K / Q + K * K) / a0)
+	};
+
+	f0 = 38.13547087602444;
+	Q  = 0.5003270373238773;
+	K  = tan (M_PI * f0 / fsamp);
+	a0 = 1.0 + K / Q + K * K;
+
+	const float highpass[5] = {
+		1.f, -2.f, 1.f,
+		(float) (2.0 * (K * K - 1.0) / a0),
+		(float) ((1.0 - K / Q + K * K) / a0)
+	};
+
+	for (uint32_t c = 0; c < n_channels; ++c) {
+		for (uint32_t i = 0; i < 5; ++i) {
+			_coeff[i * n_channels + c]       = shelf[i];
+			_coeff[(5 + i) * n_channels + c] = highpass[i];
+		}
+		_weight[c] = c < 5 ? channel_weight[c] : 1.f;
+	}
+
+	/* mono is treated as dual-mono */
+	if (n_channels == 1) {
+		_weight[0] = 2.f;
+	}
+
+	reset ();
+}
+
+Loudnessmeterdsp::~Loudnessmeterdsp (void)
+{
+	cache_aligned_free (_coeff);
+	cache_aligned_free (_state);
+	cache_aligned_free (_weight);
+	cache_aligned_free (_interleaved);
+	cache_aligned_free (_hist);
+	cache_aligned_free (_upsampled);
+	cache_aligned_free (_tp);
+	delete[] _flag;
+}
+
+void
+Loudnessmeterdsp::reset ()
+{
+	memset (_state, 0, sizeof (float) * 4 * _n_channels);
+	memset (_hist, 0, sizeof (float) * (_n_taps - 1 + _block_size) * _n_channels);
+	memset (_power, 0, sizeof (_power));
+
+	for (uint32_t c = 0; c < _n_channels; ++c) {
+		_tp[c]   = 0;
+		_flag[c] = false;
+	}
+
+	_frag_pos   = _n_fragment;
+	_frag_pwr   = 1e-30f;
+	_pow_idx    = 0;
+	_momentary  = -std::numeric_limits<float>::infinity ();
+	_short_term = -std::numeric_limits<float>::infinity ();
+}
+
+void
+Loudnessmeterdsp::process (float const* const* p, uint32_t n_channels, uint32_t n)
+{
+	uint32_t off = 0;
+
+	n_channels = std::min (n_channels, _n_channels);
+
+	while (n > 0) {
+		const uint32_t k = std::min (std::min (n, _block_size), _frag_pos);
+
+		true_peak (p, n_channels, off, k);
+		k_weight (p, n_channels, off, k);
+
+		off       += k;
+		n         -= k;
+		_frag_pos -= k;
+
+		if (_frag_pos == 0) {
+			/* every 100 ms */
+			_power[_pow_idx++] = _frag_pwr / (float)_n_fragment;
+			_pow_idx &= 31;
+			_frag_pwr = 1e-30f;
+			_frag_pos = _n_fragment;
+
+			_momentary  = -0.691f + 10.f * log10f (sumfrag (4));  // 400ms
+			_short_term = -0.691f + 10.f * log10f (sumfrag (30)); // 3s
+		}
+	}
+
+	/* flush denormals, recover from NaN/inf input */
+	for (uint32_t i = 0; i < 4 * _n_channels; ++i) {
+		if (!std::isnormal (_state[i])) {
+			_state[i] = 0;
+		}
+	}
+	if (!std::isfinite (_frag_pwr)) {
+		_frag_pwr = 1e-30f;
+	}
+}
+
+float
+Loudnessmeterdsp::sumfrag (uint32_t n_frag) const
+{
+	float s = 0;
+	int   k = (32 + _pow_idx - n_frag) & 31;
+	for (uint32_t i = 0; i < n_frag; ++i) {
+		s += _power[(i + k) & 31];
+	}
+	return s / n_frag;
+}
+
+void
+Loudnessmeterdsp::k_weight (float const* const* p, uint32_t n_channels, uint32_t off, uint32_t n)
+{
+	const uint32_t stride = _n_channels;
+
+	for (uint32_t c = 0; c < stride; ++c) {
+		if (c < n_channels) {
+			ARDOUR::interleave (&_interleaved[c], &p[c][off], n, stride);
+		} else {
+			for (uint32_t i = 0; i < n; ++i) {
+				_interleaved[i * stride + c] = 0;
+			}
+		}
+	}
+
+	ARDOUR::biquad_cascade (_interleaved, stride, n, 2, _coeff, _state);
+
+	float pwr = 0;
+	for (uint32_t c = 0; c < n_channels; ++c) {
+		float const* y = &_interleaved[c];
+		float        s = 0;
+		for (uint32_t i = 0; i < n; ++i, y += stride) {
+			s += *y * *y;
+		}
+		pwr += s * _weight[c];
+	}
+	_frag_pwr += pwr;
+}
+
+void
+Loudnessmeterdsp::true_peak (float const* const* p, uint32_t n_channels, uint32_t off, uint32_t n)
+{
+	const uint32_t n_hist   = _n_taps - 1;
+	const uint32_t n_phases = _x4 ? 3 : 1;
+
+	for (uint32_t c = 0; c < n_channels; ++c) {
+		float* h = &_hist[c * (n_hist + _block_size)];
+		memcpy (&h[n_hist], &p[c][off], sizeof (float) * n);
+
+		float peak = ARDOUR::compute_peak (&h[n_hist], n, 0);
+
+		for (uint32_t ph = 0; ph < n_phases; ++ph) {
+			float const* f = tp_phase[_x4 ? ph : 1];
+			float*       u = _upsampled;
+
+			/* loop over samples innermost, so that the
+			 * compiler can vectorize the convolution */
+			for (uint32_t i = 0; i < n; ++i) {
+				u[i] = f[0] * h[i];
+			}
+			for (uint32_t t = 1; t < _n_taps; ++t) {
+				const float  ft = f[t];
+				float const*  x  = &h[t];
+				for (uint32_t i = 0; i < n; ++i) {
+					u[i] += ft * x[i];
+				}
+			}
+			peak = ARDOUR::compute_peak (u, n, peak);
+		}
+
+		memmove (h, &h[n], sizeof (float) * n_hist);
+
+		if (_flag[c]) {
+			/* Display thread has read the value. */
+			_tp[c]   = peak;
+			_flag[c] = false;
+		} else if (peak > _tp[c]) {
+			_tp[c] = peak;
+		}
+	}
+}
+
+/* Returns highest true-peak of the given channel since last call */
+float
+Loudnessmeterdsp::read_true_peak (uint32_t chn)
+{
+	if (chn >= _n_channels) {
+		return 0;
+	}
+	float rv = _tp[chn];
+	_flag[chn] = true; // Resets _tp in next process().
+	return rv;
+}
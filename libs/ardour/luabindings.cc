@@ -87,6 +87,7 @@
 #include "ardour/runtime_functions.h"
 #include "ardour/region.h"
 #include "ardour/region_factory.h"
+#include "ardour/region_fx_cache.h"
 #include "ardour/region_fx_plugin.h"
 #include "ardour/return.h"
 #include "ardour/revision.h"
@@ -105,6 +106,7 @@
 #include "ardour/surround_send.h"
 #include "ardour/surround_pannable.h"
 #include "ardour/track.h"
+#include "ardour/triggerbox.h"
 #include "ardour/tempo.h"
 #include "ardour/user_bundle.h"
 #include "ardour/vca.h"
@@ -282,7 +284,9 @@ CLASSKEYS(ARDOUR::PortEngine);
 CLASSKEYS(ARDOUR::PortManager);
 CLASSKEYS(ARDOUR::PresentationInfo);
 CLASSKEYS(ARDOUR::RCConfiguration);
+CLASSKEYS(ARDOUR::RegionFxCache::Stats);
 CLASSKEYS(ARDOUR::Session);
+CLASSKEYS(ARDOUR::Session::LuaFunctionStats);
 CLASSKEYS(ARDOUR::SessionConfiguration);
 CLASSKEYS(ARDOUR::SimpleExport);
 CLASSKEYS(ARDOUR::Slavable);
@@ -353,6 +357,7 @@ CLASSKEYS(std::shared_ptr<ARDOUR::AudioReadable>);
 CLASSKEYS(std::shared_ptr<ARDOUR::Region>);
 CLASSKEYS(std::shared_ptr<ARDOUR::SessionPlaylists>);
 CLASSKEYS(std::shared_ptr<ARDOUR::Track>);
+CLASSKEYS(std::shared_ptr<ARDOUR::TriggerBox>);
 CLASSKEYS(std::shared_ptr<Evoral::ControlList>);
 CLASSKEYS(std::shared_ptr<Evoral::Event<Temporal::Beats> >);
 CLASSKEYS(std::shared_ptr<Evoral::Note<Temporal::Beats> >);
@@ -1502,6 +1507,7 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("add_aux_send", &Route::add_aux_send)
 		.addFunction ("remove_sidechain", &Route::remove_sidechain)
 		.addFunction ("main_outs", &Route::main_outs)
+		.addFunction ("triggerbox", &Route::triggerbox)
 		.addFunction ("muted", &Route::muted)
 		.addFunction ("soloed", &Route::soloed)
 		.addFunction ("amp", &Route::amp)
@@ -2097,6 +2103,21 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("reset_parameters_to_default", &RegionFxPlugin::reset_parameters_to_default)
 		.endClass ()
 
+		.beginClass <RegionFxCache::Stats> ("RegionFxCacheStats")
+		.addData ("hits", &RegionFxCache::Stats::hits, false)
+		.addData ("misses", &RegionFxCache::Stats::misses, false)
+		.addData ("spills", &RegionFxCache::Stats::spills, false)
+		.addData ("reloads", &RegionFxCache::Stats::reloads, false)
+		.addData ("memory_bytes", &RegionFxCache::Stats::memory_bytes, false)
+		.addData ("disk_bytes", &RegionFxCache::Stats::disk_bytes, false)
+		.addFunction ("hit_rate", &RegionFxCache::Stats::hit_rate)
+		.endClass ()
+
+		.beginClass <RegionFxCache> ("RegionFxCache")
+		.addStaticFunction ("stats", &RegionFxCache::stats)
+		.addStaticFunction ("chunk_size", &RegionFxCache::chunk_size)
+		.endClass ()
+
 		.deriveWSPtrClass <MPControl<gain_t>, PBD::Controllable> ("MPGainControl")
 		.addFunction ("set_value", &MPControl<gain_t>::set_value)
 		.addFunction ("get_value", &MPControl<gain_t>::get_value)
@@ -2194,6 +2215,12 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("set_meter_type", &PeakMeter::set_meter_type)
 		.addFunction ("meter_type", &PeakMeter::meter_type)
 		.addFunction ("reset_max", &PeakMeter::reset_max)
+		.addFunction ("momentary_loudness", &PeakMeter::momentary_loudness)
+		.addFunction ("short_term_loudness", &PeakMeter::short_term_loudness)
+		.endClass ()
+
+		.deriveWSPtrClass <TriggerBox, Processor> ("TriggerBox")
+		.addFunction ("memory_usage", &TriggerBox::memory_usage)
 		.endClass ()
 
 		.deriveWSPtrClass <MonitorProcessor, Processor> ("MonitorProcessor")
@@ -2527,6 +2554,8 @@ LuaBindings::common (lua_State* L)
 		.addConst ("MeterK12", ARDOUR::MeterType(MeterK12))
 		.addConst ("MeterPeak0dB", ARDOUR::MeterType(MeterPeak0dB))
 		.addConst ("MeterMCP", ARDOUR::MeterType(MeterMCP))
+		.addConst ("MeterTruePeak", ARDOUR::MeterType(MeterTruePeak))
+		.addConst ("MeterLUFS", ARDOUR::MeterType(MeterLUFS))
 		.endNamespace ()
 
 		.beginNamespace ("MeterPoint")
@@ -3289,11 +3318,24 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("mix_buffers_no_gain", ARDOUR::mix_buffers_no_gain)
 		.addFunction ("mix_buffers_with_gain", ARDOUR::mix_buffers_with_gain)
 		.addFunction ("copy_vector", ARDOUR::copy_vector)
+		.addFunction ("biquad_cascade", ARDOUR::biquad_cascade)
+		.addFunction ("apply_gain_ramp", ARDOUR::apply_gain_ramp)
+		.addFunction ("mix_buffers_with_ramp", ARDOUR::mix_buffers_with_ramp)
+		.addFunction ("interleave", ARDOUR::interleave)
+		.addFunction ("deinterleave", ARDOUR::deinterleave)
+		.addFunction ("sum_of_squares", ARDOUR::sum_of_squares)
 		.addFunction ("dB_to_coefficient", &dB_to_coefficient)
 		.addFunction ("fast_coefficient_to_dB", &fast_coefficient_to_dB)
 		.addFunction ("accurate_coefficient_to_dB", &accurate_coefficient_to_dB)
 		.addFunction ("memset", &DSP::memset)
 		.addFunction ("mmult", &DSP::mmult)
+		.addFunction ("subtract", &DSP::subtract)
+		.addFunction ("multiply_add", &DSP::multiply_add)
+		.addFunction ("scale_offset", &DSP::scale_offset)
+		.addFunction ("clamp", &DSP::clamp)
+		.addFunction ("rectify", &DSP::rectify)
+		.addFunction ("rms", &DSP::rms)
+		.addFunction ("interpolate", &DSP::interpolate)
 		.addFunction ("log_meter", &DSP::log_meter)
 		.addFunction ("log_meter_coeff", &DSP::log_meter_coeff)
 		.addFunction ("process_map", &DSP::process_map)
@@ -3306,6 +3348,20 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("set_cutoff", &DSP::LowPass::set_cutoff)
 		.addFunction ("reset", &DSP::LowPass::reset)
 		.endClass ()
+		.beginClass <DSP::EnvelopeFollower> ("EnvelopeFollower")
+		.addConstructor <void (*) (double, float, float)> ()
+		.addFunction ("run", &DSP::EnvelopeFollower::run)
+		.addFunction ("set_times", &DSP::EnvelopeFollower::set_times)
+		.addFunction ("level", &DSP::EnvelopeFollower::level)
+		.addFunction ("reset", &DSP::EnvelopeFollower::reset)
+		.endClass ()
+		.beginClass <DSP::FIRFilter> ("FIRFilter")
+		.addConstructor <void (*) (uint32_t)> ()
+		.addFunction ("run", &DSP::FIRFilter::run)
+		.addFunction ("set_coefficients", &DSP::FIRFilter::set_coefficients)
+		.addFunction ("n_taps", &DSP::FIRFilter::n_taps)
+		.addFunction ("reset", &DSP::FIRFilter::reset)
+		.endClass ()
 		.beginClass <DSP::Biquad> ("Biquad")
 		.addConstructor <void (*) (double)> ()
 		.addFunction ("run", &DSP::Biquad::run)
@@ -3315,6 +3371,17 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("reset", &DSP::Biquad::reset)
 		.addFunction ("dB_at_freq", &DSP::Biquad::dB_at_freq)
 		.endClass ()
+		.beginClass <DSP::MultiBiquad> ("MultiBiquad")
+		.addConstructor <void (*) (double, uint32_t, uint32_t)> ()
+		.addFunction ("n_channels", &DSP::MultiBiquad::n_channels)
+		.addFunction ("n_stages", &DSP::MultiBiquad::n_stages)
+		.addFunction ("run_interleaved", &DSP::MultiBiquad::run_interleaved)
+		.addFunction ("compute", &DSP::MultiBiquad::compute)
+		.addFunction ("compute_all", &DSP::MultiBiquad::compute_all)
+		.addFunction ("configure", &DSP::MultiBiquad::configure)
+		.addFunction ("reset", &DSP::MultiBiquad::reset)
+		.addFunction ("dB_at_freq", &DSP::MultiBiquad::dB_at_freq)
+		.endClass ()
 		.beginClass <DSP::FFTSpectrum> ("FFTSpectrum")
 		.addConstructor <void (*) (uint32_t, double)> ()
 		.addFunction ("set_data_hann", &DSP::FFTSpectrum::set_data_hann)
@@ -3508,6 +3575,16 @@ LuaBindings::session (lua_State* L)
 	// non-realtime session functions
 	luabridge::getGlobalNamespace (L)
 		.beginNamespace ("ARDOUR")
+		.beginClass <Session::LuaFunctionStats> ("LuaFunctionStats")
+		.addData ("count", &Session::LuaFunctionStats::count, false)
+		.addData ("total", &Session::LuaFunctionStats::total, false)
+		.addData ("max", &Session::LuaFunctionStats::max, false)
+		.endClass ()
+
+		// std::map<std::string, Session::LuaFunctionStats>
+		.beginStdMap <std::string, Session::LuaFunctionStats> ("LuaFunctionStatsMap")
+		.endClass ()
+
 		.beginClass <Session> ("Session")
 		.addFunction ("save_state", &Session::save_state)
 		.addFunction ("rename", &Session::rename)
@@ -3518,6 +3595,10 @@ LuaBindings::session (lua_State* L)
 		.addFunction ("have_external_connections_for_current_backend", &Session::have_external_connections_for_current_backend)
 		.addFunction ("unnamed", &Session::unnamed)
 		.addFunction ("writable", &Session::writable)
+		.addFunction ("set_lua_function_profiling", &Session::set_lua_function_profiling)
+		.addFunction ("lua_function_profiling", &Session::lua_function_profiling)
+		.addFunction ("lua_function_stats", &Session::lua_function_stats)
+		.addFunction ("reset_lua_function_stats", &Session::reset_lua_function_stats)
 
 		.addFunction<RouteList (Session::*)(uint32_t, PresentationInfo::order_t, const std::string&, const std::string&, PlaylistDisposition)> ("new_route_from_template", &Session::new_route_from_template)
 		// TODO  session_add_audio_track  session_add_midi_track  session_add_mixed_track
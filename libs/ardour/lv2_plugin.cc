@@ -168,6 +168,11 @@ public:
 
 	LilvWorld* world;
 
+	/* lilv is not thread-safe, this serializes instantiating plugins
+	 * and restoring their state when loading a session concurrently.
+	 */
+	Glib::Threads::Mutex lock;
+
 	LilvNode* atom_AtomPort;
 	LilvNode* atom_Chunk;
 	LilvNode* atom_Sequence;
@@ -2294,6 +2299,8 @@ LV2Plugin::set_state(const XMLNode& node, int version)
 	XMLNode*             child;
 	LocaleGuard          lg;
 
+	Glib::Threads::Mutex::Lock lm (_world.lock);
+
 	if (node.name() != state_node_name()) {
 		error << string_compose (_("LV2<%1>: Bad node sent to LV2Plugin::set_state"), name()) << endmsg;
 		return -1;
@@ -3690,6 +3697,7 @@ LV2PluginInfo::~LV2PluginInfo()
 PluginPtr
 LV2PluginInfo::load(Session& session)
 {
+	Glib::Threads::Mutex::Lock lm (_world.lock);
 	try {
 		PluginPtr plugin;
 		const LilvPlugins* plugins = lilv_world_get_all_plugins(_world.world);
@@ -3708,6 +3716,13 @@ LV2PluginInfo::load(Session& session)
 	return PluginPtr();
 }
 
+bool
+LV2PluginInfo::concurrent_instantiation () const
+{
+	/* load() may be called from any thread, but does not run concurrently */
+	return true;
+}
+
 std::vector<Plugin::PresetRecord>
 LV2PluginInfo::get_presets (bool user_only) const
 {
@@ -43,6 +43,7 @@ using namespace ARDOUR;
 
 PeakMeter::PeakMeter (Session& s, const std::string& name)
 	: Processor (s, string_compose ("meter-%1", name), Temporal::TimeDomainProvider (Temporal::AudioTime))
+	, _loudness (0)
 {
 	Kmeterdsp::init  (s.nominal_sample_rate ());
 	Iec1ppmdsp::init (s.nominal_sample_rate ());
@@ -69,6 +70,7 @@ PeakMeter::~PeakMeter ()
 		_iec2meter.pop_back ();
 		_vumeter.pop_back ();
 	}
+	delete _loudness;
 	while (_peak_power.size () > 0) {
 		_peak_buffer.pop_back ();
 		_peak_power.pop_back ();
@@ -187,6 +189,14 @@ PeakMeter::run (BufferSet& bufs, samplepos_t /*start_sample*/, samplepos_t /*end
 		if (_meter_type & MeterVU) {
 			_vumeter[i]->process (bufs.get_audio (i).data (), nframes);
 		}
+		if (_meter_type & (MeterTruePeak | MeterLUFS)) {
+			_loudness_data[i] = bufs.get_audio (i).data ();
+		}
+	}
+
+	/* all channels at once */
+	if ((_meter_type & (MeterTruePeak | MeterLUFS)) && _loudness && n_audio > 0) {
+		_loudness->process (&_loudness_data[0], n_audio, nframes);
 	}
 
 	/* Zero any excess peaks */
@@ -223,6 +233,9 @@ PeakMeter::reset ()
 		_iec2meter[n]->reset ();
 		_vumeter[n]->reset ();
 	}
+	if (_loudness) {
+		_loudness->reset ();
+	}
 }
 
 void
@@ -349,6 +362,12 @@ PeakMeter::set_max_channels (const ChanCount& chn)
 	assert (_iec2meter.size () == n_audio);
 	assert (_vumeter.size () == n_audio);
 
+	if (!_loudness || _loudness->n_channels () != n_audio) {
+		delete _loudness;
+		_loudness = n_audio > 0 ? new Loudnessmeterdsp (_session.nominal_sample_rate (), n_audio) : 0;
+	}
+	_loudness_data.resize (n_audio, 0);
+
 	reset ();
 	reset_max ();
 }
@@ -409,6 +428,19 @@ PeakMeter::meter_level (uint32_t n, MeterType type)
 				}
 			}
 			break;
+		case MeterTruePeak:
+			{
+				const uint32_t n_midi = current_meters.n_midi ();
+				if (_loudness && n >= n_midi && n < _loudness->n_channels () + n_midi) {
+					return accurate_coefficient_to_dB (_loudness->read_true_peak (n - n_midi));
+				}
+			}
+			break;
+		case MeterLUFS:
+			if (_loudness && n >= current_meters.n_midi ()) {
+				return _loudness->momentary ();
+			}
+			break;
 		case MeterPeak:
 		case MeterPeak0dB:
 			if (n < _peak_power.size ()) {
@@ -444,6 +476,24 @@ PeakMeter::meter_level (uint32_t n, MeterType type)
 	return minus_infinity ();
 }
 
+float
+PeakMeter::momentary_loudness () const
+{
+	if (!_loudness) {
+		return minus_infinity ();
+	}
+	return _loudness->momentary ();
+}
+
+float
+PeakMeter::short_term_loudness () const
+{
+	if (!_loudness) {
+		return minus_infinity ();
+	}
+	return _loudness->short_term ();
+}
+
 void
 PeakMeter::set_meter_type (MeterType t)
 {
@@ -477,6 +527,9 @@ PeakMeter::set_meter_type (MeterType t)
 			_vumeter[n]->reset ();
 		}
 	}
+	if ((t & (MeterTruePeak | MeterLUFS)) && _loudness) {
+		_loudness->reset ();
+	}
 
 	MeterTypeChanged (t); /* EMIT SIGNAL */
 }
@@ -20,6 +20,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <iostream>
 
 #include "pbd/malign.h"
@@ -35,6 +36,8 @@ using namespace std;
 using namespace ARDOUR;
 using namespace PBD;
 
+const size_t MidiBuffer::max_merge_sources;
+
 // FIXME: mirroring for MIDI buffers?
 MidiBuffer::MidiBuffer(size_t capacity)
 	: Buffer (DataType::MIDI)
@@ -443,164 +446,130 @@ MidiBuffer::second_simultaneous_midi_byte_is_first (uint8_t a, uint8_t b)
 bool
 MidiBuffer::merge_in_place (const MidiBuffer &other)
 {
-	const size_t header_size = sizeof(TimeType) + sizeof(Evoral::EventType);
-
-	if (other.size() && size()) {
-		DEBUG_TRACE (DEBUG::MidiIO, string_compose ("merge in place, sizes %1/%2\n", size(), other.size()));
-	}
-
-	if (other.size() == 0) {
-		return true;
-	}
+	MidiBuffer const* src = &other;
+	return merge_in_place (&src, 1);
+}
 
-	if (size() + other.size() > _capacity) {
-		return false;
-	}
+/** Merge the events of \a n_src buffers into this buffer in a single pass.
+ *
+ * All buffers (including this one) must be sorted. Simultaneous events
+ * are ordered using second_simultaneous_midi_byte_is_first(), with events
+ * of this buffer considered first, followed by those of \a src in order.
+ *
+ * Realtime safe.
+ * @return false if operation failed (not enough room)
+ */
+bool
+MidiBuffer::merge_in_place (MidiBuffer const* const* src, size_t n_src)
+{
+	const size_t header_size = sizeof(TimeType) + sizeof(Evoral::EventType);
 
-	if (size() == 0) {
-		copy (other);
+	if (n_src > max_merge_sources) {
+		for (size_t i = 0; i < n_src; i += max_merge_sources) {
+			if (!merge_in_place (src + i, std::min (max_merge_sources, n_src - i))) {
+				return false;
+			}
+		}
 		return true;
 	}
 
-	const_iterator them = other.begin();
-	iterator us = begin();
-
-	while (them != other.end()) {
+	struct Cursor {
+		uint8_t const* data;
+		size_t         offset;
+		size_t         size;
+	};
 
-		size_t bytes_to_merge;
-		ssize_t merge_offset;
+	/* read position of each non-empty buffer, ours first */
+	Cursor cursor[max_merge_sources + 1];
+	size_t n_cursors = 0;
+	size_t total     = _size;
 
-		/* gather up total size of events that are earlier than
-		   the event referenced by "us"
-		*/
-
-		merge_offset = -1;
-		bytes_to_merge = 0;
+	if (_size > 0) {
+		cursor[n_cursors++] = { 0, 0, _size };
+	}
 
-		while (them != other.end() && (*them).time() < (*us).time()) {
-			if (merge_offset == -1) {
-				merge_offset = them.offset;
-			}
-			bytes_to_merge += align32 (header_size + (*them).size());
-			++them;
+	for (size_t i = 0; i < n_src; ++i) {
+		assert (src[i] != this);
+		if (src[i]->size () == 0) {
+			continue;
 		}
+		cursor[n_cursors++] = { src[i]->_data, 0, src[i]->size () };
+		total += src[i]->size ();
+	}
 
-		/* "them" now points to either:
-		 *
-		 * 1) an event that has the same or later timestamp than the
-		 *        event pointed to by "us"
-		 *
-		 * OR
-		 *
-		 * 2) the end of the "other" buffer
-		 *
-		 * if "sz" is non-zero, there is data to be merged from "other"
-		 * into this buffer before we do anything else, corresponding
-		 * to the events from "other" that we skipped while advancing
-		 * "them".
-		 */
+	if (total == _size) {
+		return true;
+	}
 
-		if (bytes_to_merge) {
-			assert(merge_offset >= 0);
-			/* move existing */
-			memmove (_data + us.offset + bytes_to_merge, _data + us.offset, _size - us.offset);
-			/* increase _size */
-			_size += bytes_to_merge;
-			assert (_size <= _capacity);
-			/* insert new stuff */
-			memcpy  (_data + us.offset, other._data + merge_offset, bytes_to_merge);
-			/* update iterator to our own events. this is a miserable hack */
-			us.offset += bytes_to_merge;
-		}
+	if (total > _capacity) {
+		return false;
+	}
 
-		/* if we're at the end of the other buffer, we're done */
+	DEBUG_TRACE (DEBUG::MidiIO, string_compose ("merge in place, %1 buffers, sizes %2/%3\n", n_cursors, _size, total));
 
-		if (them == other.end()) {
-			break;
-		}
+	if (n_cursors == 1) {
+		/* this buffer is empty, and only one other has events */
+		memcpy (_data, cursor[0].data, cursor[0].size);
+		_size   = cursor[0].size;
+		_silent = false;
+		return true;
+	}
 
-		/* if we have two messages messages with the same timestamp. we
-		 * must order them correctly.
+	if (_size > 0) {
+		/* move our own events to the end of the buffer, and write
+		 * merged events from the start. All events of the other
+		 * buffers fit into the gap, so the write position can never
+		 * overtake the read position of our own events.
 		 */
+		memmove (_data + _capacity - _size, _data, _size);
+		cursor[0].data = _data + _capacity - _size;
+	}
 
-		if ((*us).time() == (*them).time()) {
-
-			DEBUG_TRACE (DEBUG::MidiIO,
-				     string_compose ("simultaneous MIDI events discovered during merge, times %1/%2 status %3/%4\n",
-						     (*us).time(), (*them).time(),
-						     (int) *(_data + us.offset + header_size),
-						     (int) *(other._data + them.offset + header_size)));
+	size_t pos = 0;
 
-			uint8_t our_midi_status_byte = *(_data + us.offset + header_size);
-			uint8_t their_midi_status_byte = *(other._data + them.offset + header_size);
-			bool them_first = second_simultaneous_midi_byte_is_first (our_midi_status_byte, their_midi_status_byte);
+	while (n_cursors > 0) {
 
-			DEBUG_TRACE (DEBUG::MidiIO, string_compose ("other message came first ? %1\n", them_first));
+		/* find the buffer with the next event */
 
-			if (!them_first) {
-				/* skip past our own event */
-				++us;
-			}
+		size_t   next   = 0;
+		TimeType time   = *(reinterpret_cast<TimeType const*>((uintptr_t)(cursor[0].data + cursor[0].offset)));
+		uint8_t  status = cursor[0].data[cursor[0].offset + header_size];
 
-			bytes_to_merge = align32 (header_size + (*them).size());
-
-			/* move our remaining events later in the buffer by
-			 * enough to fit the one message we're going to merge
-			 */
-
-			memmove (_data + us.offset + bytes_to_merge, _data + us.offset, _size - us.offset);
-			/* increase _size */
-			_size += bytes_to_merge;
-			assert(_size <= _capacity);
-			/* insert new stuff */
-			memcpy  (_data + us.offset, other._data + them.offset, bytes_to_merge);
-			/* update iterator to our own events. this is a miserable hack */
-			us.offset += bytes_to_merge;
-			/* 'us' is now an iterator to the event right after the
-			   new ones that we merged
-			*/
-			if (them_first) {
-				/* need to skip the event pointed to by 'us'
-				   since its at the same time as 'them'
-				   (still), and we'll enter
-				*/
-
-				if (us != end()) {
-					++us;
-				}
+		for (size_t c = 1; c < n_cursors; ++c) {
+			const TimeType t = *(reinterpret_cast<TimeType const*>((uintptr_t)(cursor[c].data + cursor[c].offset)));
+			const uint8_t  s = cursor[c].data[cursor[c].offset + header_size];
+			if (t < time || (t == time && second_simultaneous_midi_byte_is_first (status, s))) {
+				next   = c;
+				time   = t;
+				status = s;
 			}
+		}
 
-			/* we merged one event from the other buffer, so
-			 * advance the iterator there.
-			 */
+		Cursor& cur (cursor[next]);
 
-			++them;
+		const int event_size = Evoral::midi_event_size (cur.data + cur.offset + header_size);
+		assert (event_size >= 0);
+		const size_t bytes = align32 (header_size + event_size);
 
-		} else {
+		/* our own events may overlap when the gap is small, other's do not */
+		memmove (_data + pos, cur.data + cur.offset, bytes);
 
-			/* advance past our own events to get to the correct insertion
-			   point for the next event(s) from "other"
-			*/
+		pos        += bytes;
+		cur.offset += bytes;
 
-			while (us != end() && (*us).time() <= (*them).time()) {
-				++us;
+		if (cur.offset >= cur.size) {
+			/* retain order, it matters for simultaneous events */
+			for (size_t c = next + 1; c < n_cursors; ++c) {
+				cursor[c - 1] = cursor[c];
 			}
+			--n_cursors;
 		}
+	}
 
-		/* check to see if we reached the end of this buffer while
-		 * looking for the insertion point.
-		 */
-
-		if (us == end()) {
-
-			/* just append the rest of other and we're done*/
+	assert (pos == total);
 
-			memcpy (_data + us.offset, other._data + them.offset, other._size - them.offset);
-			_size += other._size - them.offset;
-			assert(_size <= _capacity);
-			break;
-		}
-	}
+	_size   = pos;
+	_silent = false;
 
 	return true;
 }
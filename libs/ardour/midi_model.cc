@@ -258,6 +258,49 @@ MidiModel::NoteDiffCommand::value_type(Property prop)
 	return Variant::NOTHING;
 }
 
+int64_t
+MidiModel::NoteDiffCommand::change_value (Property prop, const Variant& value)
+{
+	switch (prop) {
+	case StartTime:
+	case Length:
+		return value.get_beats().to_ticks();
+	default:
+		return value.get_int();
+	}
+}
+
+void
+MidiModel::NoteDiffCommand::set_value (const NotePtr& note, Property prop, int64_t value)
+{
+	switch (prop) {
+	case NoteNumber:
+		note->set_note (value);
+		break;
+	case Velocity:
+		note->set_velocity (value);
+		break;
+	case StartTime:
+		note->set_time (TimeType::ticks (value));
+		break;
+	case Length:
+		note->set_length (TimeType::ticks (value));
+		break;
+	case Channel:
+		note->set_channel (value);
+		break;
+	}
+}
+
+/** @return true if notes must be removed from the model and added again
+ * when @a prop changes, to keep the model's indexes ordered.
+ */
+bool
+MidiModel::NoteDiffCommand::is_indexed (Property prop)
+{
+	return prop == NoteNumber || prop == StartTime || prop == Channel;
+}
+
 void
 MidiModel::NoteDiffCommand::change (const NotePtr  note,
                                     Property       prop,
@@ -266,16 +309,48 @@ MidiModel::NoteDiffCommand::change (const NotePtr  note,
 	assert (note);
 
 	const NoteChange change = {
-		prop, note, 0, get_value(note, prop), new_value
+		prop, note, 0, change_value (prop, get_value (note, prop)), change_value (prop, new_value)
 	};
 
-	if (change.old_value == new_value) {
+	if (change.old_value == change.new_value) {
 		return;
 	}
 
 	_changes.push_back (change);
 }
 
+/** Look up the notes of changes that were not in the model when the command
+ * was loaded, using a single pass over the notes of the model.
+ */
+void
+MidiModel::NoteDiffCommand::find_changed_notes ()
+{
+	std::map<Evoral::event_id_t, NotePtr> missing;
+
+	for (ChangeList::const_iterator i = _changes.begin(); i != _changes.end(); ++i) {
+		if (!i->note) {
+			missing.insert (make_pair (i->note_id, NotePtr ()));
+		}
+	}
+
+	if (missing.empty()) {
+		return;
+	}
+
+	for (Notes::const_iterator n = _model->notes().begin(); n != _model->notes().end(); ++n) {
+		std::map<Evoral::event_id_t, NotePtr>::iterator m = missing.find ((*n)->id());
+		if (m != missing.end()) {
+			m->second = *n;
+		}
+	}
+
+	for (ChangeList::iterator i = _changes.begin(); i != _changes.end(); ++i) {
+		if (!i->note) {
+			i->note = missing[i->note_id];
+		}
+	}
+}
+
 MidiModel::NoteDiffCommand &
 MidiModel::NoteDiffCommand::operator+= (const NoteDiffCommand& other)
 {
@@ -314,70 +389,59 @@ MidiModel::NoteDiffCommand::operator() ()
 			_model->remove_note_unlocked(*i);
 		}
 
+		/* notes found during deserialization, so try again now that
+		   the model state is different.
+		*/
+		find_changed_notes ();
+
 		/* notes we modify in a way that requires remove-then-add to maintain ordering */
 		set<NotePtr> temporary_removals;
 
 		for (ChangeList::iterator i = _changes.begin(); i != _changes.end(); ++i) {
-			Property prop = i->property;
-
-			if (!i->note) {
-				/* note found during deserialization, so try
-				   again now that the model state is different.
-				*/
-				i->note = _model->find_note (i->note_id);
-				assert (i->note);
+			assert (i->note);
+			if (is_indexed (i->property)) {
+				temporary_removals.insert (i->note);
 			}
+		}
 
-			switch (prop) {
-			case NoteNumber:
-				if (temporary_removals.find (i->note) == temporary_removals.end()) {
-					_model->remove_note_unlocked (i->note);
-					temporary_removals.insert (i->note);
-				}
-				i->note->set_note (i->new_value.get_int());
-				break;
+		if (reindex_in_place (temporary_removals.size())) {
 
-			case StartTime:
-				if (temporary_removals.find (i->note) == temporary_removals.end()) {
-					_model->remove_note_unlocked (i->note);
-					temporary_removals.insert (i->note);
-				}
-				i->note->set_time (i->new_value.get_beats());
-				break;
+			/* Nothing can be refused or truncated by re-adding the
+			   notes, so change them where they are and sort the
+			   model once.
+			*/
 
-			case Channel:
-				if (temporary_removals.find (i->note) == temporary_removals.end()) {
-					_model->remove_note_unlocked (i->note);
-					temporary_removals.insert (i->note);
-				}
-				i->note->set_channel (i->new_value.get_int());
-				break;
+			for (ChangeList::iterator i = _changes.begin(); i != _changes.end(); ++i) {
+				set_value (i->note, i->property, i->new_value);
+			}
 
-				/* no remove-then-add required for these properties, since we do not index them
-				 */
+			_model->reindex_notes_unlocked ();
 
-			case Velocity:
-				i->note->set_velocity (i->new_value.get_int());
-				break;
+		} else {
 
-			case Length:
-				i->note->set_length (i->new_value.get_beats());
-				break;
+			for (set<NotePtr>::iterator i = temporary_removals.begin(); i != temporary_removals.end(); ++i) {
+				_model->remove_note_unlocked (*i);
+			}
 
+			for (ChangeList::iterator i = _changes.begin(); i != _changes.end(); ++i) {
+				set_value (i->note, i->property, i->new_value);
+				if (i->property == Length) {
+					_model->note_length_changed_unlocked (i->note);
+				}
 			}
-		}
 
-		for (set<NotePtr>::iterator i = temporary_removals.begin(); i != temporary_removals.end(); ++i) {
-			NoteDiffCommand side_effects (model(), "side effects");
-			if (_model->add_note_unlocked (*i, &side_effects)) {
-				/* The note was re-added ok */
-				*this += side_effects;
-			} else {
-				/* The note that we removed earlier could not be re-added.  This change record
-				   must say that the note was removed.  We'll keep the changes we made, though,
-				   as if the note is re-added by the undo the changes must also be undone.
-				*/
-				_removed_notes.push_back (*i);
+			for (set<NotePtr>::iterator i = temporary_removals.begin(); i != temporary_removals.end(); ++i) {
+				NoteDiffCommand side_effects (model(), "side effects");
+				if (_model->add_note_unlocked (*i, &side_effects)) {
+					/* The note was re-added ok */
+					*this += side_effects;
+				} else {
+					/* The note that we removed earlier could not be re-added.  This change record
+					   must say that the note was removed.  We'll keep the changes we made, though,
+					   as if the note is re-added by the undo the changes must also be undone.
+					*/
+					_removed_notes.push_back (*i);
+				}
 			}
 		}
 
@@ -409,75 +473,52 @@ MidiModel::NoteDiffCommand::undo ()
 		   checker doesn't refuse the re-add.
 		*/
 
-		/* notes we modify in a way that requires remove-then-add to maintain ordering */
-		set<NotePtr> temporary_removals;
-
-
 		/* lazily discover any affected notes that were not discovered when
 		 * loading the history because of deletions, etc.
 		 */
 
-		for (ChangeList::iterator i = _changes.begin(); i != _changes.end(); ++i) {
-			if (!i->note) {
-				i->note = _model->find_note (i->note_id);
-				assert (i->note);
-			}
-		}
+		find_changed_notes ();
 
-		for (ChangeList::iterator i = _changes.begin(); i != _changes.end(); ++i) {
-			Property prop = i->property;
+		/* notes we modify in a way that requires remove-then-add to maintain ordering.
 
-			switch (prop) {
-			case NoteNumber:
-				if (temporary_removals.find (i->note) == temporary_removals.end() &&
-				    find (_removed_notes.begin(), _removed_notes.end(), i->note) == _removed_notes.end()) {
+		   We only need to mark a note for re-add if it isn't on the _removed_notes
+		   list (which means that it has already been removed and it will be re-added
+		   anyway)
+		*/
+		set<NotePtr> temporary_removals;
 
-					/* We only need to mark this note for re-add if (a) we haven't
-					   already marked it and (b) it isn't on the _removed_notes
-					   list (which means that it has already been removed and it
-					   will be re-added anyway)
-					*/
+		if (!_changes.empty()) {
+			set<NotePtr> const removed (_removed_notes.begin(), _removed_notes.end());
 
-					_model->remove_note_unlocked (i->note);
+			for (ChangeList::iterator i = _changes.begin(); i != _changes.end(); ++i) {
+				assert (i->note);
+				if (is_indexed (i->property) && removed.find (i->note) == removed.end()) {
 					temporary_removals.insert (i->note);
 				}
-				i->note->set_note (i->old_value.get_int());
-				break;
+			}
+		}
 
-			case StartTime:
-				if (temporary_removals.find (i->note) == temporary_removals.end() &&
-				    find (_removed_notes.begin(), _removed_notes.end(), i->note) == _removed_notes.end()) {
+		if (reindex_in_place (temporary_removals.size())) {
 
-					/* See above ... */
+			/* undo changes in reverse order, in case a property was changed more than once */
+			for (ChangeList::reverse_iterator i = _changes.rbegin(); i != _changes.rend(); ++i) {
+				set_value (i->note, i->property, i->old_value);
+			}
 
-					_model->remove_note_unlocked (i->note);
-					temporary_removals.insert (i->note);
-				}
-				i->note->set_time (i->old_value.get_beats());
-				break;
+			_model->reindex_notes_unlocked ();
+			temporary_removals.clear ();
 
-			case Channel:
-				if (temporary_removals.find (i->note) == temporary_removals.end() &&
-				    find (_removed_notes.begin(), _removed_notes.end(), i->note) == _removed_notes.end()) {
+		} else {
 
-					/* See above ... */
+			for (set<NotePtr>::iterator i = temporary_removals.begin(); i != temporary_removals.end(); ++i) {
+				_model->remove_note_unlocked (*i);
+			}
 
-					_model->remove_note_unlocked (i->note);
-					temporary_removals.insert (i->note);
+			for (ChangeList::reverse_iterator i = _changes.rbegin(); i != _changes.rend(); ++i) {
+				set_value (i->note, i->property, i->old_value);
+				if (i->property == Length) {
+					_model->note_length_changed_unlocked (i->note);
 				}
-				i->note->set_channel (i->old_value.get_int());
-				break;
-
-				/* no remove-then-add required for these properties, since we do not index them
-				 */
-
-			case Velocity:
-				i->note->set_velocity (i->old_value.get_int());
-				break;
-
-			case Length:
-				i->note->set_length (i->old_value.get_beats());
-				break;
 			}
 		}
 
@@ -502,6 +543,21 @@ MidiModel::NoteDiffCommand::undo ()
 	_model->ContentsChanged(); /* EMIT SIGNAL */
 }
 
+/** @return true if @a n_notes notes of the model, whose time, note number or channel
+ * changed, should be sorted again in place, rather than removed and added one by one.
+ */
+bool
+MidiModel::NoteDiffCommand::reindex_in_place (size_t n_notes) const
+{
+	/* adding a note can change or remove other notes, unless overlaps are allowed */
+	if (_model->insert_merge_policy() != InsertMergeRelax) {
+		return false;
+	}
+
+	/* sorting all notes costs about as much as removing and adding an eighth of them */
+	return n_notes > 0 && n_notes >= _model->n_notes() / 8;
+}
+
 XMLNode&
 MidiModel::NoteDiffCommand::marshal_note(const NotePtr note) const
 {
@@ -566,15 +622,15 @@ MidiModel::NoteDiffCommand::marshal_change (const NoteChange& change) const
 	xml_change->set_property ("property", change.property);
 
 	if (change.property == StartTime || change.property == Length) {
-		xml_change->set_property ("old", change.old_value.get_beats ());
+		xml_change->set_property ("old", TimeType::ticks (change.old_value));
 	} else {
-		xml_change->set_property ("old", change.old_value.get_int ());
+		xml_change->set_property ("old", (int) change.old_value);
 	}
 
 	if (change.property == StartTime || change.property == Length) {
-		xml_change->set_property ("new", change.new_value.get_beats ());
+		xml_change->set_property ("new", TimeType::ticks (change.new_value));
 	} else {
-		xml_change->set_property ("new", change.new_value.get_int ());
+		xml_change->set_property ("new", (int) change.new_value);
 	}
 
 	if (change.note) {
@@ -594,6 +650,8 @@ MidiModel::NoteDiffCommand::unmarshal_change (XMLNode *xml_change)
 {
 	NoteChange change;
 	change.note_id = 0;
+	change.old_value = 0;
+	change.new_value = 0;
 
 	if (!xml_change->get_property("property", change.property)) {
 		fatal << "!!!" << endmsg;
@@ -610,7 +668,7 @@ MidiModel::NoteDiffCommand::unmarshal_change (XMLNode *xml_change)
 	Temporal::Beats old_time;
 	if ((change.property == StartTime || change.property == Length) &&
 	    xml_change->get_property ("old", old_time)) {
-		change.old_value = old_time;
+		change.old_value = old_time.to_ticks ();
 	} else if (xml_change->get_property ("old", old_val)) {
 		change.old_value = old_val;
 	} else {
@@ -622,7 +680,7 @@ MidiModel::NoteDiffCommand::unmarshal_change (XMLNode *xml_change)
 	Temporal::Beats new_time;
 	if ((change.property == StartTime || change.property == Length) &&
 	    xml_change->get_property ("new", new_time)) {
-		change.new_value = new_time;
+		change.new_value = new_time.to_ticks ();
 	} else if (xml_change->get_property ("new", new_val)) {
 		change.new_value = new_val;
 	} else {
@@ -631,12 +689,11 @@ MidiModel::NoteDiffCommand::unmarshal_change (XMLNode *xml_change)
 	}
 
 	/* we must point at the instance of the note that is actually in the model.
-	   so go look for it ... it may not be there (it could have been
-	   deleted in a later operation, so store the note id so that we can
-	   look it up again later).
+	   set_state() looks for all of them at once ... it may not be there (it
+	   could have been deleted in a later operation, so store the note id so
+	   that we can look it up again later).
 	*/
 
-	change.note = _model->find_note (note_id);
 	change.note_id = note_id;
 
 	return change;
@@ -679,9 +736,11 @@ MidiModel::NoteDiffCommand::set_state (const XMLNode& diff_command, int /*versio
 
 	if (changed_notes) {
 		XMLNodeList notes = changed_notes->children();
+		_changes.reserve (notes.size());
 		transform (notes.begin(), notes.end(), back_inserter(_changes),
 		           std::bind (&NoteDiffCommand::unmarshal_change, this, _1));
 
+		find_changed_notes ();
 	}
 
 	/* side effect removals caused by changes */
@@ -1511,7 +1570,6 @@ MidiModel::resolve_overlaps_unlocked (const NotePtr note, void* arg)
 	TimeType ea  = note->end_time();
 
 	const Pitches& p (pitches (note->channel()));
-	NotePtr search_note(new Note<TimeType>(0, TimeType(), TimeType(), note->note()));
 	set<NotePtr> to_be_deleted;
 	bool set_note_length = false;
 	bool set_note_time = false;
@@ -1520,8 +1578,9 @@ MidiModel::resolve_overlaps_unlocked (const NotePtr note, void* arg)
 
 	DEBUG_TRACE (DEBUG::Sequence, string_compose ("%1 checking overlaps for note %2 @ %3\n", this, (int)note->note(), note->time()));
 
-	for (Pitches::const_iterator i = p.lower_bound (search_note);
-	     i != p.end() && (*i)->note() == note->note(); ++i) {
+	/* notes that start after the end of this note cannot overlap it */
+	for (Pitches::const_iterator i = overlap_lower_bound (note->channel(), note->note(), sa);
+	     i != p.end() && (*i)->note() == note->note() && (*i)->time() <= ea; ++i) {
 
 		TimeType sb = (*i)->time();
 		TimeType eb = (*i)->end_time();
@@ -1574,6 +1633,7 @@ MidiModel::resolve_overlaps_unlocked (const NotePtr note, void* arg)
 					cmd->change ((*i), NoteDiffCommand::Length, note->end_time() - (*i)->time());
 				}
 				(*i)->set_length (note->end_time() - (*i)->time());
+				note_length_changed_unlocked (*i);
 				return -1; /* do not add the new note */
 				break;
 			default:
@@ -548,8 +548,10 @@ void
 MidiTrack::write_out_of_band_data (BufferSet& bufs, samplecnt_t nframes) const
 {
 	MidiBuffer& buf (bufs.get_midi (0));
-	buf.merge_from (_immediate_event_buffer, nframes);
-	buf.merge_from (_user_immediate_event_buffer, nframes);
+	MidiBuffer const* src[] = { &_immediate_event_buffer, &_user_immediate_event_buffer };
+	if (!buf.merge_in_place (src, 2)) {
+		cerr << string_compose ("MidiTrack::write_out_of_band_data failed (buffer is full: size: %1 capacity %2)", buf.size (), buf.capacity ()) << endl;
+	}
 }
 
 int
@@ -145,6 +145,170 @@ default_copy_vector (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t
 	memcpy(dst, src, nframes*sizeof(ARDOUR::Sample));
 }
 
+void
+default_biquad_cascade (ARDOUR::Sample * buf, uint32_t n_channels, pframes_t nframes, uint32_t n_stages, const float * coeff, float * state)
+{
+	default_biquad_cascade_lanes (buf, n_channels, nframes, n_stages, coeff, state, 0, n_channels);
+}
+
+void
+default_biquad_cascade_lanes (ARDOUR::Sample * buf, uint32_t n_channels, pframes_t nframes, uint32_t n_stages, const float * coeff, float * state, uint32_t first_chn, uint32_t last_chn)
+{
+	for (uint32_t s = 0; s < n_stages; ++s) {
+		const float* b0 = &coeff[(s * 5 + 0) * n_channels];
+		const float* b1 = &coeff[(s * 5 + 1) * n_channels];
+		const float* b2 = &coeff[(s * 5 + 2) * n_channels];
+		const float* a1 = &coeff[(s * 5 + 3) * n_channels];
+		const float* a2 = &coeff[(s * 5 + 4) * n_channels];
+		float*       z1 = &state[(s * 2 + 0) * n_channels];
+		float*       z2 = &state[(s * 2 + 1) * n_channels];
+
+		for (uint32_t c = first_chn; c < last_chn; ++c) {
+			float s1 = z1[c];
+			float s2 = z2[c];
+			ARDOUR::Sample* d = &buf[c];
+			for (pframes_t i = 0; i < nframes; ++i, d += n_channels) {
+				const float xn = *d;
+				const float z  = b0[c] * xn + s1;
+				s1 = b1[c] * xn - a1[c] * z + s2;
+				s2 = b2[c] * xn - a2[c] * z;
+				*d = z;
+			}
+			z1[c] = s1;
+			z2[c] = s2;
+		}
+	}
+}
+
+float
+default_apply_gain_ramp (ARDOUR::Sample * buf, pframes_t nframes, float initial, float target, float coeff)
+{
+	float lpf = initial;
+	for (pframes_t i = 0; i < nframes; ++i) {
+		buf[i] *= lpf;
+		lpf += coeff * (target - lpf);
+	}
+	return lpf;
+}
+
+void
+default_mix_buffers_with_ramp (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t nframes, float initial, float target)
+{
+	const float delta = (target - initial) / nframes;
+	for (pframes_t i = 0; i < nframes; ++i) {
+		dst[i] = dst[i] + src[i] * (initial + delta * (float) i);
+	}
+}
+
+void
+default_interleave (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t nframes, uint32_t stride)
+{
+	for (pframes_t i = 0; i < nframes; ++i) {
+		dst[i * stride] = src[i];
+	}
+}
+
+void
+default_deinterleave (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t nframes, uint32_t stride)
+{
+	for (pframes_t i = 0; i < nframes; ++i) {
+		dst[i] = src[i * stride];
+	}
+}
+
+void
+default_float_to_s16 (int16_t * dst, const ARDOUR::Sample * src, pframes_t nframes)
+{
+	for (pframes_t i = 0; i < nframes; ++i) {
+		long v = lrintf (src[i] * 32768.f);
+		dst[i] = (int16_t) max (-32768L, min (32767L, v));
+	}
+}
+
+void
+default_float_to_s24 (int32_t * dst, const ARDOUR::Sample * src, pframes_t nframes)
+{
+	for (pframes_t i = 0; i < nframes; ++i) {
+		long v = lrintf (src[i] * 8388608.f);
+		dst[i] = (int32_t) max (-8388608L, min (8388607L, v)) * 256;
+	}
+}
+
+float
+default_sum_of_squares (const ARDOUR::Sample * buf, pframes_t nframes)
+{
+	float sum = 0;
+	for (pframes_t i = 0; i < nframes; ++i) {
+		sum += buf[i] * buf[i];
+	}
+	return sum;
+}
+
+void
+default_subtract_buffers (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t nframes)
+{
+	for (pframes_t i = 0; i < nframes; ++i) {
+		dst[i] -= src[i];
+	}
+}
+
+void
+default_multiply_add_buffers (ARDOUR::Sample * dst, const ARDOUR::Sample * a, const ARDOUR::Sample * b, pframes_t nframes)
+{
+	for (pframes_t i = 0; i < nframes; ++i) {
+		dst[i] += a[i] * b[i];
+	}
+}
+
+void
+default_scale_offset_buffer (ARDOUR::Sample * buf, pframes_t nframes, float gain, float offset)
+{
+	for (pframes_t i = 0; i < nframes; ++i) {
+		buf[i] = buf[i] * gain + offset;
+	}
+}
+
+void
+default_clamp_buffer (ARDOUR::Sample * buf, pframes_t nframes, float min, float max)
+{
+	for (pframes_t i = 0; i < nframes; ++i) {
+		buf[i] = std::min (max, std::max (min, buf[i]));
+	}
+}
+
+void
+default_rectify_buffer (ARDOUR::Sample * buf, pframes_t nframes)
+{
+	for (pframes_t i = 0; i < nframes; ++i) {
+		buf[i] = fabsf (buf[i]);
+	}
+}
+
+float
+default_dot_product (const float * a, const float * b, uint32_t n)
+{
+	float sum = 0;
+	for (uint32_t k = 0; k < n; ++k) {
+		sum += a[k] * b[k];
+	}
+	return sum;
+}
+
+double
+default_interpolate_buffer (ARDOUR::Sample * dst, const ARDOUR::Sample * src, uint32_t src_len, double pos, double step, pframes_t nframes)
+{
+	for (pframes_t i = 0; i < nframes; ++i) {
+		const double  p  = pos + (double) i * step;
+		const double  fl = floor (p);
+		const int64_t x  = (int64_t) fl;
+		const float   f  = (float) (p - fl);
+		const float   a  = (x >= 0 && x < src_len) ? src[x] : 0.f;
+		const float   b  = (x + 1 >= 0 && x + 1 < src_len) ? src[x + 1] : 0.f;
+		dst[i] = a + f * (b - a);
+	}
+	return pos + (double) nframes * step;
+}
+
 #if defined (__APPLE__) && defined (BUILD_VECLIB_OPTIMIZATIONS)
 #include <Accelerate/Accelerate.h>
 
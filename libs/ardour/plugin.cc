@@ -203,8 +203,8 @@ Plugin::invalidate_preset_cache (std::string const& id, Plugin* plugin, bool add
 	}
 }
 
-PluginPtr
-ARDOUR::find_plugin(Session& session, string identifier, PluginType type)
+PluginInfoPtr
+ARDOUR::find_plugin_info (string identifier, PluginType type)
 {
 	PluginManager& mgr (PluginManager::instance());
 	PluginInfoList plugs;
@@ -253,14 +253,14 @@ ARDOUR::find_plugin(Session& session, string identifier, PluginType type)
 #endif
 
 	default:
-		return PluginPtr ((Plugin *) 0);
+		return PluginInfoPtr ();
 	}
 
 	PluginInfoList::iterator i;
 
 	for (i = plugs.begin(); i != plugs.end(); ++i) {
 		if (identifier == (*i)->unique_id){
-			return (*i)->load (session);
+			return *i;
 		}
 	}
 
@@ -273,7 +273,7 @@ ARDOUR::find_plugin(Session& session, string identifier, PluginType type)
 	if (type == ARDOUR::LXVST || type == ARDOUR::Windows_VST) {
 		for (i = plugs.begin(); i != plugs.end(); ++i) {
 			if (identifier == (*i)->name){
-				return (*i)->load (session);
+				return *i;
 			}
 		}
 	}
@@ -289,14 +289,24 @@ ARDOUR::find_plugin(Session& session, string identifier, PluginType type)
 		identifier = AUPluginInfo::convert_old_unique_id (identifier);
 		for (i = plugs.begin(); i != plugs.end(); ++i) {
 			if (identifier == (*i)->unique_id){
-				return (*i)->load (session);
+				return *i;
 			}
 		}
 	}
 
 #endif
 
-	return PluginPtr ();
+	return PluginInfoPtr ();
+}
+
+PluginPtr
+ARDOUR::find_plugin(Session& session, string identifier, PluginType type)
+{
+	PluginInfoPtr info = find_plugin_info (identifier, type);
+	if (!info) {
+		return PluginPtr ();
+	}
+	return info->load (session);
 }
 
 ChanCount
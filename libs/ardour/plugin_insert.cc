@@ -30,10 +30,12 @@
 
 #include "pbd/assert.h"
 #include "pbd/failed_constructor.h"
+#include "pbd/microseconds.h"
 #include "pbd/xml++.h"
 #include "pbd/types_convert.h"
 
 #include "ardour/audio_buffer.h"
+#include "ardour/audioengine.h"
 #include "ardour/automation_list.h"
 #include "ardour/buffer_set.h"
 #include "ardour/debug.h"
@@ -44,6 +46,8 @@
 #include "ardour/plugin.h"
 #include "ardour/plugin_insert.h"
 #include "ardour/port.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/rt_tasklist.h"
 #include "ardour/session.h"
 #include "ardour/types.h"
 
@@ -67,12 +71,16 @@ PluginInsert::PluginInsert (Session& s, Temporal::TimeDomainProvider const & tdp
 	, _strict_io (false)
 	, _custom_cfg (false)
 	, _maps_from_state (false)
+	, _parallel_replicas (false)
+	, _replica_cost (0)
 	, _latency_changed (false)
 	, _bypass_port (UINT32_MAX)
 	, _inverted_bypass_enable (false)
 {
 	_stat_reset.store (0);
 	_flush.store (0);
+	_replica_failed.store (false);
+	_replica_dt.store (0);
 
 	/* the first is the master */
 	if (plug) {
@@ -1118,10 +1126,14 @@ PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t e
 		}
 	} else {
 		/* in-place processing */
-		uint32_t pc = 0;
-		for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i, ++pc) {
-			if ((*i)->connect_and_run(bufs, start, end, speed, in_map.p(pc), out_map.p(pc), nframes, offset)) {
-				deactivate ();
+		if (_parallel_replicas && bufs.count().n_midi() == 0) {
+			run_replicas (bufs, in_map, start, end, speed, nframes, offset);
+		} else {
+			uint32_t pc = 0;
+			for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i, ++pc) {
+				if ((*i)->connect_and_run(bufs, start, end, speed, in_map.p(pc), out_map.p(pc), nframes, offset)) {
+					deactivate ();
+				}
 			}
 		}
 		// now silence unconnected outputs
@@ -1673,11 +1685,121 @@ PluginInsert::is_channelstrip () const
 	return false;
 }
 
+void
+PluginInsert::run_replicas (BufferSet& bufs, PinMappings const& in_map, samplepos_t start, samplepos_t end, double speed, pframes_t nframes, samplecnt_t offset)
+{
+	_replica_args.bufs    = &bufs;
+	_replica_args.in_map  = &in_map;
+	_replica_args.start   = start;
+	_replica_args.end     = end;
+	_replica_args.speed   = speed;
+	_replica_args.nframes = nframes;
+	_replica_args.offset  = offset;
+
+	_replica_dt.store (0);
+
+	int32_t const threshold = Config->get_plugin_replica_parallel_threshold ();
+	if (threshold >= 0 && _replica_cost >= threshold && _replica_tasks->size () == _plugins.size ()) {
+		_replica_tasks->process ();
+	} else {
+		for (uint32_t pc = 0; pc < _plugins.size (); ++pc) {
+			run_replica (pc);
+		}
+	}
+
+	/* running average of the time it takes to process a single instance */
+	float const dt = _replica_dt.load () / (float) _plugins.size ();
+	_replica_cost += (dt - _replica_cost) * .125f;
+
+	bool failed = true;
+	if (_replica_failed.compare_exchange_strong (failed, false)) {
+		deactivate ();
+	}
+}
+
+void
+PluginInsert::run_replica (uint32_t pc)
+{
+	ReplicaArgs const& a (_replica_args);
+
+	PBD::microseconds_t t0 = PBD::get_microseconds ();
+	if (_plugins[pc]->connect_and_run (*a.bufs, a.start, a.end, a.speed, a.in_map->p (pc), _out_map.p (pc), a.nframes, a.offset)) {
+		_replica_failed.store (true);
+	}
+	_replica_dt.fetch_add (PBD::get_microseconds () - t0);
+}
+
+/** Check if replicated instances can be processed concurrently.
+ *
+ * This requires in-place processing without MIDI, and that no
+ * instance writes to a buffer that is used by another instance.
+ */
+bool
+PluginInsert::check_parallel_replicas () const
+{
+	if (_no_inplace || get_count () < 2 || !_replica_tasks) {
+		return false;
+	}
+	if (_configured_internal.n_midi () > 0 || _configured_out.n_midi () > 0) {
+		return false;
+	}
+
+	for (uint32_t pc = 0; pc < get_count (); ++pc) {
+		ChanMapping::Mappings const& om (_out_map.p (pc).mappings ());
+		ChanMapping::Mappings::const_iterator outs = om.find (DataType::AUDIO);
+		if (outs == om.end ()) {
+			continue;
+		}
+		for (uint32_t other = 0; other < get_count (); ++other) {
+			if (other == pc) {
+				continue;
+			}
+			for (auto const& o : outs->second) {
+				bool valid;
+				_out_map.p (other).get_src (DataType::AUDIO, o.second, &valid);
+				if (valid) {
+					return false;
+				}
+				_in_map.p (other).get_src (DataType::AUDIO, o.second, &valid);
+				if (valid) {
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+void
+PluginInsert::setup_replica_tasks ()
+{
+	/* Tasks are only used while the route is processed, and are never
+	 * left queued after that (see RTSubTaskList::process). Holding the
+	 * process lock, the graph is idle, so tasks can be freed.
+	 */
+#ifndef PLATFORM_WINDOWS
+	assert (!AudioEngine::instance()->process_lock().trylock());
+#endif
+
+	if (!_replica_tasks) {
+		_replica_tasks.reset (new RTSubTaskList (_session.process_graph ()));
+	}
+	if (_replica_tasks->size () == get_count ()) {
+		return;
+	}
+	_replica_tasks->clear ();
+	for (uint32_t pc = 0; pc < get_count (); ++pc) {
+		_replica_tasks->push_back ([this, pc] () { run_replica (pc); });
+	}
+	_replica_cost = 0;
+}
+
 void
 PluginInsert::mapping_changed ()
 {
 	PluginMapChanged (); /* EMIT SIGNAL */
 	_no_inplace = check_inplace ();
+	_parallel_replicas = check_parallel_replicas ();
 	_session.set_dirty();
 }
 
@@ -2188,6 +2310,9 @@ PluginInsert::configure_io (ChanCount in, ChanCount out)
 
 	_no_inplace = check_inplace ();
 
+	setup_replica_tasks ();
+	_parallel_replicas = check_parallel_replicas ();
+
 	/* only the "noinplace_buffers" thread buffers need to be this large,
 	 * this can be optimized. other buffers are fine with
 	 * ChanCount::max (natural_input_streams (), natural_output_streams())
@@ -2645,11 +2770,22 @@ PluginInsert::set_state(const XMLNode& node, int version)
 	}
 
 	bool any_vst = false;
+	bool state_restored = false;
 	uint32_t count = 1;
 	node.get_property ("count", count);
 
 	if (_plugins.empty()) {
-		std::shared_ptr<Plugin> plugin = find_and_load_plugin (_session, node, type, unique_id, any_vst);
+		/* the plugin may have been instantiated concurrently while loading the session */
+		std::shared_ptr<Plugin> plugin = _session.take_preloaded_plugin (node, unique_id, state_restored);
+
+		if (!plugin) {
+			const PBD::microseconds_t start_time = PBD::get_microseconds ();
+			plugin = find_and_load_plugin (_session, node, type, unique_id, any_vst);
+			if (plugin && _session.loading ()) {
+				_session.add_plugin_load_time (PBD::get_microseconds () - start_time);
+			}
+		}
+
 		if (!plugin) {
 			return -1;
 		}
@@ -2700,6 +2836,10 @@ PluginInsert::set_state(const XMLNode& node, int version)
 		   ) {
 
 			for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i) {
+				if (state_restored && i == _plugins.begin ()) {
+					/* already done by Session::preload_plugins() */
+					continue;
+				}
 				/* Plugin state can include external files which are named after the ID.
 				 *
 				 * If regenerate_xml_or_string_ids() is set, the ID will already have
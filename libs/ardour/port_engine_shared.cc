@@ -18,12 +18,14 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <cstring>
 #include <regex.h>
 
 #include "pbd/error.h"
 
 #include "ardour/port_engine_shared.h"
 #include "ardour/port_manager.h"
+#include "ardour/runtime_functions.h"
 
 #include "pbd/i18n.h"
 
@@ -33,6 +35,7 @@ BackendPort::BackendPort (PortEngineSharedImpl &b, const std::string& name, Port
 	: _backend (b)
 	, _name  (name)
 	, _flags (flags)
+	, _sources (new SourceTable)
 {
 	_capture_latency_range.min = 0;
 	_capture_latency_range.max = 0;
@@ -97,6 +100,7 @@ void
 BackendPort::store_connection (BackendPortHandle port)
 {
 	_connections.insert (port);
+	update_sources ();
 }
 
 int
@@ -126,6 +130,7 @@ void BackendPort::remove_connection (BackendPortHandle port)
 	std::set<BackendPortPtr>::iterator it = _connections.find (port);
 	assert (it != _connections.end ());
 	_connections.erase (it);
+	update_sources ();
 }
 
 
@@ -137,6 +142,50 @@ void BackendPort::disconnect_all (BackendPortHandle self)
 		_backend.port_connect_callback (name(), (*it)->name(), false);
 		_connections.erase (it);
 	}
+	update_sources ();
+}
+
+void
+BackendPort::update_sources ()
+{
+	if (!is_input ()) {
+		return;
+	}
+
+	RCUWriter<SourceTable>       writer (_sources);
+	std::shared_ptr<SourceTable> st = writer.get_copy ();
+
+	st->clear ();
+	st->reserve (_connections.size ());
+	for (std::set<BackendPortPtr>::const_iterator it = _connections.begin (); it != _connections.end (); ++it) {
+		assert ((*it)->is_output ());
+		st->push_back (it->get ());
+	}
+}
+
+Sample*
+BackendPort::mix_connections (Sample* buf, pframes_t n_samples)
+{
+	std::shared_ptr<SourceTable const> st = _sources.reader ();
+
+	SourceTable::const_iterator it = st->begin ();
+
+	switch (st->size ()) {
+		case 0:
+			memset (buf, 0, n_samples * sizeof (Sample));
+			return buf;
+		case 1:
+			/* pass-through, like JACK does */
+			return static_cast<Sample*> ((*it)->get_buffer (n_samples));
+		default:
+			break;
+	}
+
+	copy_vector (buf, static_cast<Sample const*> ((*it)->get_buffer (n_samples)), n_samples);
+	while (++it != st->end ()) {
+		mix_buffers_no_gain (buf, static_cast<Sample const*> ((*it)->get_buffer (n_samples)), n_samples);
+	}
+	return buf;
 }
 
 bool
@@ -19,6 +19,8 @@
  */
 
 #include <algorithm>
+#include <cmath>
+#include <iterator>
 #include <vector>
 
 #ifdef COMPILER_MSVC
@@ -41,11 +43,13 @@
 #include "ardour/circular_buffer.h"
 #include "ardour/debug.h"
 #include "ardour/filesystem_paths.h"
+#include "ardour/loudnessmeterdsp.h"
 #include "ardour/midi_port.h"
 #include "ardour/midiport_manager.h"
 #include "ardour/port_manager.h"
 #include "ardour/profile.h"
 #include "ardour/rt_tasklist.h"
+#include "ardour/runtime_functions.h"
 #include "ardour/session.h"
 #include "ardour/types_convert.h"
 
@@ -105,10 +109,13 @@ PortManager::falloff_cache_calc (pframes_t n_samples, samplecnt_t rate)
 	falloff_cache.calc (n_samples, rate);
 }
 
-PortManager::AudioInputPort::AudioInputPort (samplecnt_t sz)
+PortManager::AudioInputPort::AudioInputPort (samplecnt_t sz, samplecnt_t sr)
 	: scope (AudioPortScope (new CircularSampleBuffer (sz)))
 	, meter (AudioPortMeter (new DPM))
 {
+	if (sr > 0) {
+		true_peak_dsp.reset (new Loudnessmeterdsp (sr, 1));
+	}
 }
 
 void
@@ -118,17 +125,27 @@ PortManager::AudioInputPort::apply_falloff (pframes_t n_samples, samplecnt_t rat
 		meter->reset ();
 	}
 
+	const float falloff = falloff_cache.calc (n_samples, rate);
+
 	if (meter->level > 1e-10) {
-		meter->level *= falloff_cache.calc (n_samples, rate);
+		meter->level *= falloff;
 	} else {
 		meter->level = 0;
 	}
+
+	if (meter->rms > 1e-10) {
+		meter->rms *= falloff;
+	} else {
+		meter->rms = 0;
+	}
 }
 
 void
 PortManager::AudioInputPort::silence (pframes_t n_samples)
 {
 	meter->level = 0;
+	meter->rms   = 0;
+	meter->publish ();
 	scope->silence (n_samples);
 }
 
@@ -137,10 +154,19 @@ PortManager::AudioInputPort::process (Sample const* buf, pframes_t n_samples, bo
 {
 	scope->write (buf, n_samples);
 
-	float level  = reset ? 0 : meter->level;
-	level        = compute_peak (buf, n_samples, level);
-	meter->level = std::min (level, 100.f); // cut off at +40dBFS for falloff.
-	meter->peak  = std::max (meter->peak, level);
+	const float peak = compute_peak (buf, n_samples, reset ? 0 : meter->level);
+	const float rms  = sqrtf (sum_of_squares (buf, n_samples) / n_samples);
+
+	meter->level = std::min (peak, 100.f); // cut off at +40dBFS for falloff.
+	meter->peak  = std::max (meter->peak, meter->level);
+	meter->rms   = std::min (std::max (reset ? 0 : meter->rms, rms), 100.f);
+
+	if (true_peak_dsp) {
+		true_peak_dsp->process (&buf, 1, n_samples);
+		meter->true_peak = std::max (meter->true_peak, true_peak_dsp->read_true_peak (0));
+	}
+
+	meter->publish ();
 }
 
 PortManager::MIDIInputPort::MIDIInputPort (samplecnt_t sz)
@@ -1118,7 +1144,7 @@ PortManager::update_input_ports (bool clear)
 			if (port_is_mine (*p) || !_backend->get_port_by_name (*p)) {
 				continue;
 			}
-			apw->insert (make_pair (*p, AudioInputPort (24288))); // 2^19 ~ 1MB / port
+			apw->insert (make_pair (*p, AudioInputPort (24288, _backend->sample_rate ()))); // 2^19 ~ 1MB / port
 		}
 	}
 
@@ -1981,13 +2007,21 @@ PortManager::run_input_meters (pframes_t n_samples, samplecnt_t rate)
 
 	_monitor_port.monitor (port_engine (), n_samples);
 
-	/* calculate peak of all physical inputs (readable ports) */
+	/* calculate peak of all physical inputs (readable ports),
+	 * that a meter is subscribed to */
 	std::shared_ptr<AudioInputPorts const> aip = _audio_input_ports.reader ();
 
 	for (auto const& p : *aip) {
 		assert (!port_is_mine (p.first));
 		AudioInputPort& ai = *const_cast<AudioInputPort*>(&p.second);
 
+		if (!ai.active ()) {
+			if (reset) {
+				ai.meter->reset ();
+			}
+			continue;
+		}
+
 		ai.apply_falloff (n_samples, rate, reset);
 
 		PortEngine::PortHandle ph = _backend->get_port_by_name (p.first);
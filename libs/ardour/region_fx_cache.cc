@@ -0,0 +1,386 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef COMPILER_MSVC
+#include <unistd.h>
+#endif
+#include <fcntl.h>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <vector>
+
+#include <glib.h>
+#include "pbd/gstdio_compat.h"
+
+#include <glibmm/miscutils.h>
+
+#include "pbd/compose.h"
+
+#include "ardour/audio_buffer.h"
+#include "ardour/buffer_set.h"
+#include "ardour/debug.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/region_fx_cache.h"
+#include "ardour/runtime_functions.h"
+
+using namespace ARDOUR;
+using namespace PBD;
+
+namespace {
+	/* shared by all caches */
+	std::atomic<size_t>   memory_used (0);
+	std::atomic<size_t>   disk_used (0);
+	std::atomic<uint64_t> total_hits (0);
+	std::atomic<uint64_t> total_misses (0);
+	std::atomic<uint64_t> total_spills (0);
+	std::atomic<uint64_t> total_reloads (0);
+	/* last-used stamps are comparable across caches */
+	std::atomic<uint64_t> serial (0);
+}
+
+Glib::Threads::Mutex      RegionFxCache::_registry_lock;
+std::set<RegionFxCache*> RegionFxCache::_registry;
+
+RegionFxCache::RegionFxCache (std::string const& spill_path, uint32_t n_chans)
+	: _spill_path (spill_path)
+	, _n_chans (n_chans)
+	, _fd (-1)
+	, _file_size (0)
+{
+	Glib::Threads::Mutex::Lock lm (_registry_lock);
+	_registry.insert (this);
+}
+
+RegionFxCache::~RegionFxCache ()
+{
+	{
+		Glib::Threads::Mutex::Lock lm (_registry_lock);
+		_registry.erase (this);
+	}
+	clear ();
+}
+
+RegionFxCache::Stats
+RegionFxCache::local_stats () const
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	return _stats;
+}
+
+RegionFxCache::Stats
+RegionFxCache::stats ()
+{
+	Stats s;
+	s.hits         = total_hits.load ();
+	s.misses       = total_misses.load ();
+	s.spills       = total_spills.load ();
+	s.reloads      = total_reloads.load ();
+	s.memory_bytes = memory_used.load ();
+	s.disk_bytes   = disk_used.load ();
+	return s;
+}
+
+bool
+RegionFxCache::read (BufferSet& bufs, samplepos_t start, samplecnt_t cnt)
+{
+	if (cnt <= 0 || bufs.count ().n_audio () < _n_chans) {
+		return false;
+	}
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	if (!covers (start, cnt)) {
+		++_stats.misses;
+		++total_misses;
+		return false;
+	}
+
+	samplecnt_t const cs    = chunk_size ();
+	samplepos_t const first = start / cs;
+	samplepos_t const last  = (start + cnt - 1) / cs;
+
+	for (samplepos_t idx = first; idx <= last; ++idx) {
+		Chunks::iterator i = _chunks.find (idx);
+		Chunk&           c = i->second;
+
+		if (!c.data && !load (c)) {
+			drop (i);
+			++_stats.misses;
+			++total_misses;
+			return false;
+		}
+
+		samplepos_t const s = std::max (start, idx * cs);
+		samplepos_t const e = std::min (start + cnt, (idx + 1) * cs);
+
+		for (uint32_t chn = 0; chn < _n_chans; ++chn) {
+			copy_vector (bufs.get_audio (chn).data (s - start), c.data + chn * cs + (s - idx * cs), e - s);
+		}
+		c.last_used = ++serial;
+	}
+
+	++_stats.hits;
+	++total_hits;
+
+	enforce_limits (-1);
+	return true;
+}
+
+bool
+RegionFxCache::cached (samplepos_t start, samplecnt_t cnt) const
+{
+	if (cnt <= 0) {
+		return false;
+	}
+	Glib::Threads::Mutex::Lock lm (_lock);
+	return covers (start, cnt);
+}
+
+bool
+RegionFxCache::covers (samplepos_t start, samplecnt_t cnt) const
+{
+	/* _lock must be held */
+	samplecnt_t const cs    = chunk_size ();
+	samplepos_t const first = start / cs;
+	samplepos_t const last  = (start + cnt - 1) / cs;
+
+	Chunks::const_iterator i = _chunks.find (first);
+	for (samplepos_t idx = first; idx <= last; ++idx, ++i) {
+		if (i == _chunks.end () || i->first != idx || i->second.filled < std::min (start + cnt, (idx + 1) * cs) - idx * cs) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void
+RegionFxCache::write (BufferSet const& bufs, samplepos_t start, samplecnt_t cnt)
+{
+	if (cnt <= 0 || bufs.count ().n_audio () < _n_chans) {
+		return;
+	}
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	samplecnt_t const cs    = chunk_size ();
+	samplepos_t const first = start / cs;
+	samplepos_t const last  = (start + cnt - 1) / cs;
+
+	for (samplepos_t idx = first; idx <= last; ++idx) {
+		samplepos_t const s = std::max (start, idx * cs) - idx * cs;
+		samplepos_t const e = std::min (start + cnt, (idx + 1) * cs) - idx * cs;
+
+		Chunks::iterator i = _chunks.find (idx);
+		if (i == _chunks.end ()) {
+			if (s > 0) {
+				continue;
+			}
+			i = _chunks.insert (std::make_pair (idx, Chunk ())).first;
+		}
+
+		Chunk& c = i->second;
+
+		if (s > c.filled || e <= c.filled) {
+			/* not contiguous, or nothing new */
+			continue;
+		}
+
+		if (!c.data) {
+			if (c.filled > 0) {
+				if (!load (c)) {
+					drop (i);
+					continue;
+				}
+			} else {
+				c.data = new Sample[_n_chans * cs];
+				memory_used += chunk_bytes ();
+			}
+		}
+
+		for (uint32_t chn = 0; chn < _n_chans; ++chn) {
+			copy_vector (c.data + chn * cs + s, bufs.get_audio (chn).data (idx * cs + s - start), e - s);
+		}
+
+		c.filled    = e;
+		c.dirty     = true;
+		c.last_used = ++serial;
+	}
+
+	enforce_limits (last);
+}
+
+void
+RegionFxCache::clear ()
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	for (auto& i : _chunks) {
+		if (i.second.data) {
+			delete [] i.second.data;
+			memory_used -= chunk_bytes ();
+		}
+	}
+	_chunks.clear ();
+	close_file ();
+}
+
+bool
+RegionFxCache::load (Chunk& c)
+{
+	assert (!c.data && c.file_offset >= 0 && _fd >= 0);
+
+	size_t const bytes = chunk_bytes ();
+	c.data = new Sample[_n_chans * chunk_size ()];
+
+	if (lseek (_fd, c.file_offset, SEEK_SET) != c.file_offset || ::read (_fd, c.data, bytes) != (ssize_t) bytes) {
+		delete [] c.data;
+		c.data = 0;
+		return false;
+	}
+
+	memory_used += bytes;
+	++_stats.reloads;
+	++total_reloads;
+	c.dirty = false;
+	return true;
+}
+
+void
+RegionFxCache::spill (Chunks::iterator i)
+{
+	Chunk&       c     = i->second;
+	size_t const bytes = chunk_bytes ();
+
+	assert (c.data);
+
+	if (c.file_offset < 0) {
+		size_t const limit = (size_t) Config->get_region_fx_cache_disk () * 1048576;
+		if (disk_used.load () + bytes > limit) {
+			drop (i);
+			return;
+		}
+		if (_fd < 0) {
+			g_mkdir_with_parents (Glib::path_get_dirname (_spill_path).c_str (), 0755);
+			_fd = g_open (_spill_path.c_str (), O_CREAT | O_RDWR | O_TRUNC, 0644);
+			if (_fd < 0) {
+				DEBUG_TRACE (DEBUG::RegionFx, string_compose ("Cannot create region FX cache file '%1'\n", _spill_path));
+				drop (i);
+				return;
+			}
+		}
+		c.file_offset = _file_size;
+		c.dirty       = true;
+		_file_size   += bytes;
+		disk_used    += bytes;
+	}
+
+	if (c.dirty) {
+		if (lseek (_fd, c.file_offset, SEEK_SET) != c.file_offset || ::write (_fd, c.data, bytes) != (ssize_t) bytes) {
+			drop (i);
+			return;
+		}
+		++_stats.spills;
+		++total_spills;
+	}
+
+	delete [] c.data;
+	c.data  = 0;
+	c.dirty = false;
+	memory_used -= bytes;
+}
+
+void
+RegionFxCache::drop (Chunks::iterator i)
+{
+	if (i->second.data) {
+		delete [] i->second.data;
+		memory_used -= chunk_bytes ();
+	}
+	_chunks.erase (i);
+}
+
+RegionFxCache::Chunks::iterator
+RegionFxCache::lru_chunk (samplepos_t keep)
+{
+	Chunks::iterator lru = _chunks.end ();
+	for (Chunks::iterator i = _chunks.begin (); i != _chunks.end (); ++i) {
+		if (i->second.data && i->first != keep && (lru == _chunks.end () || i->second.last_used < lru->second.last_used)) {
+			lru = i;
+		}
+	}
+	return lru;
+}
+
+void
+RegionFxCache::enforce_limits (samplepos_t keep)
+{
+	size_t const limit = (size_t) Config->get_region_fx_cache_memory () * 1048576;
+
+	if (memory_used.load () <= limit) {
+		return;
+	}
+
+	/* The limit is shared by all caches, spill the least recently used
+	 * data of any cache. This cache is locked by the caller, others are
+	 * skipped while they are in use (their region is being read).
+	 */
+	Glib::Threads::Mutex::Lock rl (_registry_lock);
+
+	std::vector<RegionFxCache*> caches;
+
+	for (auto const& c : _registry) {
+		if (c == this || c->_lock.trylock ()) {
+			caches.push_back (c);
+		}
+	}
+
+	while (memory_used.load () > limit) {
+		RegionFxCache*   victim = 0;
+		Chunks::iterator lru;
+		for (auto const& c : caches) {
+			Chunks::iterator i = c->lru_chunk (c == this ? keep : -1);
+			if (i != c->_chunks.end () && (!victim || i->second.last_used < lru->second.last_used)) {
+				victim = c;
+				lru    = i;
+			}
+		}
+		if (!victim) {
+			break;
+		}
+		victim->spill (lru);
+	}
+
+	for (auto const& c : caches) {
+		if (c != this) {
+			c->_lock.unlock ();
+		}
+	}
+}
+
+void
+RegionFxCache::close_file ()
+{
+	if (_fd < 0) {
+		return;
+	}
+	::close (_fd);
+	::g_unlink (_spill_path.c_str ());
+	_fd = -1;
+	disk_used -= _file_size;
+	_file_size = 0;
+}
@@ -18,6 +18,7 @@
 
 #include "ardour/graph.h"
 #include "ardour/rt_task.h"
+#include "ardour/rt_tasklist.h"
 
 using namespace ARDOUR;
 
@@ -33,3 +34,39 @@ RTTask::run (GraphChain const*)
 	_f ();
 	_graph->reached_terminal_node ();
 }
+
+RTSubTask::RTSubTask (RTSubTaskList* l, std::function<void ()> const& fn)
+	: _f (fn)
+	, _list (l)
+	, _claimed (true)
+{
+}
+
+bool
+RTSubTask::claim ()
+{
+	bool expected = false;
+	return _claimed.compare_exchange_strong (expected, true);
+}
+
+void
+RTSubTask::try_run ()
+{
+	if (claim ()) {
+		_f ();
+	}
+}
+
+void
+RTSubTask::run (GraphChain const*)
+{
+	RTSubTaskList* l = _list;
+
+	/* the task may already have been processed by the owner */
+	if (claim ()) {
+		_f ();
+	}
+
+	/* the owner may free the task once it was released */
+	l->task_released ();
+}
@@ -16,6 +16,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include "pbd/atomic.h"
+
 #include "ardour/graph.h"
 #include "ardour/rt_tasklist.h"
 
@@ -45,3 +47,78 @@ RTTaskList::process ()
 	}
 	_tasks.clear ();
 }
+
+RTSubTaskList::RTSubTaskList (std::shared_ptr<Graph> process_graph)
+	: _graph (process_graph)
+	, _n_pending (0)
+	, _done_sem ("subtasks_done", 0)
+{
+}
+
+RTSubTaskList::~RTSubTaskList ()
+{
+	clear ();
+}
+
+void
+RTSubTaskList::push_back (std::function<void ()> fn)
+{
+	_tasks.push_back (new RTSubTask (this, fn));
+}
+
+void
+RTSubTaskList::clear ()
+{
+	for (auto const& t : _tasks) {
+		delete t;
+	}
+	_tasks.clear ();
+}
+
+void
+RTSubTaskList::task_released ()
+{
+	/* the last worker to release a task wakes up the owner */
+	if (PBD::atomic_dec_and_test (_n_pending)) {
+		_done_sem.signal ();
+	}
+}
+
+uint32_t
+RTSubTaskList::process ()
+{
+	size_t const n_tasks = _tasks.size ();
+
+	for (auto const& t : _tasks) {
+		t->_claimed.store (false);
+	}
+
+	/* hand all but the first task to idle workers, if any.
+	 *
+	 * Workers may already release tasks while they are queued, so
+	 * count all of them as pending, plus one that is held by this
+	 * thread until it is done queueing and processing.
+	 */
+	uint32_t n_queued = 0;
+	if (n_tasks > 1 && Graph::in_graph_thread ()) {
+		_n_pending.store (n_tasks);
+		n_queued = _graph->trigger_idle (_tasks, 1);
+		/* drop the tasks that were not queued */
+		_n_pending.fetch_sub (n_tasks - 1 - n_queued);
+	}
+
+	/* process whatever was not yet picked up by other threads */
+	for (auto const& t : _tasks) {
+		t->try_run ();
+	}
+
+	/* wait for workers to take all queued tasks from the trigger
+	 * queue and to complete the ones they claimed. A worker only
+	 * releases a task after running it.
+	 */
+	if (n_queued > 0 && !PBD::atomic_dec_and_test (_n_pending)) {
+		_done_sem.wait ();
+	}
+
+	return n_queued;
+}
@@ -54,6 +54,7 @@
 #include "pbd/search_path.h"
 #include "pbd/stl_delete.h"
 #include "pbd/replace_all.h"
+#include "pbd/timing.h"
 #include "pbd/types_convert.h"
 #include "pbd/unwind.h"
 
@@ -74,6 +75,7 @@
 #include "ardour/bundle.h"
 #include "ardour/butler.h"
 #include "ardour/click.h"
+#include "ardour/clip_data_cache.h"
 #include "ardour/control_protocol_manager.h"
 #include "ardour/data_type.h"
 #include "ardour/debug.h"
@@ -274,7 +276,10 @@ Session::Session (AudioEngine &eng,
 	, _lua_load (0)
 	, _lua_save (0)
 	, _lua_cleanup (0)
+	, _lua_stats (0)
+	, _lua_reset_stats (0)
 	, _n_lua_scripts (0)
+	, _lua_profile (false)
 	, _io_plugins (new IOPlugList)
 	, _butler (new Butler (*this))
 	, _transport_fsm (new TransportFSM (*this))
@@ -724,6 +729,8 @@ Session::destroy ()
 		delete _lua_save;
 		delete _lua_load;
 		delete _lua_cleanup;
+		delete _lua_stats;
+		delete _lua_reset_stats;
 		lua.collect_garbage ();
 	}
 
@@ -840,6 +847,9 @@ Session::destroy ()
 	/* not strictly necessary, but doing it here allows the shared_ptr debugging to work */
 	_playlists.reset ();
 
+	/* the triggers are gone, release audio data that they shared */
+	ClipDataCache::instance ().clear ();
+
 	emit_thread_terminate ();
 
 	pthread_cond_destroy (&_rt_emit_cond);
@@ -5577,6 +5587,42 @@ Session::registered_lua_functions ()
 	return rv;
 }
 
+std::map<std::string, Session::LuaFunctionStats>
+Session::lua_function_stats ()
+{
+	Glib::Threads::Mutex::Lock lm (lua_lock);
+	std::map<std::string, LuaFunctionStats> rv;
+
+	try {
+		luabridge::LuaRef stats ((*_lua_stats)());
+		for (luabridge::Iterator i (stats); !i.isNil (); ++i) {
+			if (!i.key ().isString () || !i.value ().isTable ()) { assert(0); continue; }
+			luabridge::LuaRef s (i.value ());
+			LuaFunctionStats fs;
+			fs.count = s["cnt"].cast<double> ();
+			fs.total = s["total"].cast<double> ();
+			fs.max   = s["max"].cast<double> ();
+			rv[i.key ().cast<std::string> ()] = fs;
+		}
+	} catch (...) { }
+	return rv;
+}
+
+void
+Session::reset_lua_function_stats ()
+{
+	Glib::Threads::Mutex::Lock lm (lua_lock);
+	try { (*_lua_reset_stats)(); } catch (...) { }
+}
+
+/* clock used to profile session scripts, passed to the Lua session
+ * object as upvalue, it is not directly accessible by scripts.
+ */
+static int _lua_clock (lua_State* L) {
+	lua_pushnumber (L, PBD::get_microseconds ());
+	return 1;
+}
+
 static void _lua_print (std::string s) {
 #ifndef NDEBUG
 	std::cout << "LuaSession: " << s << "\n";
@@ -5590,7 +5636,12 @@ Session::try_run_lua (pframes_t nframes)
 	if (_n_lua_scripts == 0) return;
 	Glib::Threads::Mutex::Lock tm (lua_lock, Glib::Threads::TRY_LOCK);
 	if (tm.locked ()) {
-		try { (*_lua_run)(nframes); } catch (...) { }
+		{
+			TimerRAII tr (dsp_stats[LuaScripts]);
+			/* a single call into Lua runs all scripts */
+			try { (*_lua_run)(_lua_profile.load (), nframes); } catch (...) { }
+		}
+		TimerRAII tr (dsp_stats[LuaGC]);
 		lua.collect_garbage_step ();
 	}
 }
@@ -5599,13 +5650,31 @@ void
 Session::setup_lua ()
 {
 	lua.Print.connect (&_lua_print);
+
+	lua_pushcfunction (lua.getState (), &_lua_clock);
+	lua_setglobal (lua.getState (), "_session_clock");
+
 	lua.do_command (
-			"function ArdourSession ()"
-			"  local self = { scripts = {}, instances = {} }"
+			"function ArdourSession (clock)"
+			"  local self = { scripts = {}, instances = {}, stats = {}, order = {} }"
+			""
+			/* flat list of instances, so that ::run does not need to
+			 * iterate over a hash-table or look up names.
+			 */
+			"  local reorder = function ()"
+			"   local o = {}"
+			"   for n, f in pairs (self.instances) do"
+			"    o[#o + 1] = { n = n, f = f, s = self.stats[n] }"
+			"   end"
+			"   table.sort (o, function (a, b) return a.n < b.n end)"
+			"   self.order = o"
+			"  end"
 			""
 			"  local remove = function (n)"
 			"   self.scripts[n] = nil"
 			"   self.instances[n] = nil"
+			"   self.stats[n] = nil"
+			"   reorder ()"
 			"   Session:scripts_changed()" // call back
 			"  end"
 			""
@@ -5617,6 +5686,8 @@ Session::setup_lua ()
 			"   self.scripts[n] = { ['f'] = f, ['a'] = a }"
 			"   local env = { print = print, tostring = tostring, assert = assert, ipairs = ipairs, error = error, select = select, string = string, type = type, tonumber = tonumber, collectgarbage = collectgarbage, pairs = pairs, math = math, table = table, pcall = pcall, bit32=bit32, Session = Session, PBD = PBD, Temporal = Temporal, Timecode = Timecode, Evoral = Evoral, C = C, ARDOUR = ARDOUR }"
 			"   self.instances[n] = load (string.dump(f, true), nil, nil, env)(a)"
+			"   self.stats[n] = { cnt = 0, total = 0, max = 0 }"
+			"   reorder ()"
 			"   Session:scripts_changed()" // call back
 			"  end"
 			""
@@ -5627,20 +5698,47 @@ Session::setup_lua ()
 			"   addinternal (n, load(f), a)"
 			"  end"
 			""
-			"  local run = function (...)"
-			"   for n, s in pairs (self.instances) do"
-			"     local status, err = pcall (s, ...)"
-			"     if not status then"
-			"       print ('fn \"'.. n .. '\": ', err)"
-			"       remove (n)"
-			"      end"
+			/* GC is stepped by Session::try_run_lua, so that its cost
+			 * can be measured separately
+			 */
+			"  local run = function (profile, ...)"
+			"   local o = self.order"
+			"   for i = 1, #o do"
+			"    local e = o[i]"
+			"    local status, err"
+			"    if profile then"
+			"     local t0 = clock ()"
+			"     status, err = pcall (e.f, ...)"
+			"     local dt = clock () - t0"
+			"     local s = e.s"
+			"     s.cnt = s.cnt + 1"
+			"     s.total = s.total + dt"
+			"     if dt > s.max then s.max = dt end"
+			"    else"
+			"     status, err = pcall (e.f, ...)"
+			"    end"
+			"    if not status then"
+			"     print ('fn \"'.. e.n .. '\": ', err)"
+			"     remove (e.n)"
+			"    end"
+			"   end"
+			"  end"
+			""
+			"  local stats = function ()"
+			"   return self.stats"
+			"  end"
+			""
+			"  local reset_stats = function ()"
+			"   for _, s in pairs (self.stats) do"
+			"    s.cnt = 0 s.total = 0 s.max = 0"
 			"   end"
-			"   collectgarbage(\"step\")"
 			"  end"
 			""
 			"  local cleanup = function ()"
 			"   self.scripts = nil"
 			"   self.instances = nil"
+			"   self.stats = nil"
+			"   self.order = {}"
 			"  end"
 			""
 			"  local list = function ()"
@@ -5693,11 +5791,13 @@ Session::setup_lua ()
 			"  end"
 			""
 			" return { run = run, add = add, remove = remove,"
-		  "          list = list, restore = restore, save = save, cleanup = cleanup}"
+		  "          list = list, restore = restore, save = save, cleanup = cleanup,"
+		  "          stats = stats, reset_stats = reset_stats}"
 			" end"
 			" "
-			" sess = ArdourSession ()"
+			" sess = ArdourSession (_session_clock)"
 			" ArdourSession = nil"
+			" _session_clock = nil"
 			" "
 			"function ardour () end"
 			);
@@ -5716,6 +5816,8 @@ Session::setup_lua ()
 		_lua_save = new luabridge::LuaRef(lua_sess["save"]);
 		_lua_load = new luabridge::LuaRef(lua_sess["restore"]);
 		_lua_cleanup = new luabridge::LuaRef(lua_sess["cleanup"]);
+		_lua_stats = new luabridge::LuaRef(lua_sess["stats"]);
+		_lua_reset_stats = new luabridge::LuaRef(lua_sess["reset_stats"]);
 	} catch (luabridge::LuaException const& e) {
 		fatal << string_compose (_("programming error: %1"),
 				std::string ("Failed to setup session Lua interpreter") + e.what ())
@@ -35,6 +35,7 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <atomic>
 #include <string>
 #include <cerrno>
 #include <cstdio> /* snprintf(3) ... grrr */
@@ -78,6 +79,7 @@
 #include "evoral/SMF.h"
 
 #include "pbd/basename.h"
+#include "pbd/cpus.h"
 #include "pbd/debug.h"
 #include "pbd/enumwriter.h"
 #include "pbd/error.h"
@@ -349,7 +351,9 @@ Session::post_engine_init ()
 		 * it will try to make connections whose details are loaded by set_port_states.
 		 */
 
+		const int64_t connect_start_time = g_get_monotonic_time ();
 		hookup_io ();
+		_load_times.connect = g_get_monotonic_time () - connect_start_time;
 
 		/* Let control protocols know that we are now all connected, so they
 		 * could start talking to surfaces if they want to.
@@ -1011,7 +1015,11 @@ Session::load_state (string snapshot_name, bool from_template)
 
 	_writable = exists_and_writable (xmlpath) && exists_and_writable(Glib::path_get_dirname(xmlpath));
 
-	if (!state_tree->read (xmlpath)) {
+	const int64_t parse_start_time = g_get_monotonic_time ();
+	const bool    parsed           = state_tree->read (xmlpath);
+	_load_times.parse = g_get_monotonic_time () - parse_start_time;
+
+	if (!parsed) {
 		error << string_compose(_("Could not understand session file %1"), xmlpath) << endmsg;
 		delete state_tree;
 		state_tree = 0;
@@ -2007,9 +2015,23 @@ Session::set_state (const XMLNode& node, int version)
 	if ((child = find_named_node (node, "Routes")) == 0) {
 		error << _("Session: XML state has no 'Routes' section") << endmsg;
 		goto out;
-	} else if (load_routes (*child, version)) {
-		error << _("Session: failed to load route state") << endmsg;
-		goto out;
+	} else {
+		preload_plugins (*child, version);
+
+		const int64_t plugin_time = _load_times.plugins;
+		const int64_t start_time  = g_get_monotonic_time ();
+		const int     rv          = load_routes (*child, version);
+
+		/* plugins instantiated while creating routes are accounted for separately */
+		_load_times.routes = g_get_monotonic_time () - start_time - (_load_times.plugins - plugin_time);
+
+		/* drop plugins that were not used, e.g. if a route failed to load */
+		_preloaded_plugins.clear ();
+
+		if (rv) {
+			error << _("Session: failed to load route state") << endmsg;
+			goto out;
+		}
 	}
 
 	/* Now that we Tracks have been loaded and playlists are assigned */
@@ -2132,6 +2154,168 @@ out:
 	return ret;
 }
 
+/** Instantiate the plugins of all routes ahead of time, concurrently,
+ * if their format allows it. PluginInsert::set_state() picks them up,
+ * using take_preloaded_plugin(), so the routes and their processors are
+ * set up exactly as if the plugins had been loaded serially.
+ */
+void
+Session::preload_plugins (const XMLNode& node, int version)
+{
+	_preloaded_plugins.clear ();
+
+	if (version < 3000 || get_disable_all_loaded_plugins ()) {
+		return;
+	}
+
+	struct Job {
+		std::string             id;
+		std::string             unique_id;
+		PluginInfoPtr           info;
+		XMLNode const*          state;
+		std::shared_ptr<Plugin> plugin;
+	};
+
+	std::vector<Job> jobs;
+
+	/* state is restored along with the plugin, unless the
+	 * insert's ID changes (the state may refer to it), or
+	 * the plugin is replicated (copies are made of the first one).
+	 */
+	const bool restore_state = !regenerate_xml_or_string_ids ();
+
+	for (auto const& r : node.children ()) {
+		for (auto const& p : r->children (X_("Processor"))) {
+			Job         job;
+			std::string type;
+			uint32_t    count = 1;
+
+			if (!p->get_property (X_("type"), type) || !p->get_property (X_("unique-id"), job.unique_id) || !p->get_property (X_("id"), job.id)) {
+				continue;
+			}
+
+			/* VST and AU plugins have to be instantiated by the main thread,
+			 * only Lua DSP scripts and LV2 plugins are considered.
+			 */
+			PluginType ptype;
+			if (type == X_("luaproc")) {
+				ptype = ARDOUR::Lua;
+			} else if (type == X_("lv2")) {
+				ptype = ARDOUR::LV2;
+			} else {
+				continue;
+			}
+
+			job.info = find_plugin_info (job.unique_id, ptype);
+
+			if (!job.info || !job.info->concurrent_instantiation ()) {
+				continue;
+			}
+
+			p->get_property (X_("count"), count);
+			job.state = (restore_state && count == 1) ? p : 0;
+			jobs.push_back (job);
+		}
+	}
+
+	if (jobs.empty ()) {
+		return;
+	}
+
+	const int64_t start_time = g_get_monotonic_time ();
+
+	std::atomic<size_t> next (0);
+
+	std::function<void ()> worker = [this, &jobs, &next, version] () {
+		size_t n;
+		while ((n = next.fetch_add (1)) < jobs.size ()) {
+			Job& job (jobs[n]);
+			try {
+				job.plugin = job.info->load (*this);
+			} catch (...) {
+				job.plugin.reset ();
+			}
+			if (!job.plugin || !job.state) {
+				continue;
+			}
+			XMLNode const* state = job.state->child (job.plugin->state_node_name ().c_str ());
+			job.state = 0;
+			if (state) {
+				job.plugin->set_insert_id (PBD::ID (job.id));
+				if (0 == job.plugin->set_state (*state, version)) {
+					job.state = state;
+				}
+			}
+		}
+	};
+
+	const size_t n_threads = std::min<size_t> (hardware_concurrency (), jobs.size ());
+
+	if (n_threads < 2) {
+		worker ();
+	} else {
+		std::vector<PBD::Thread*> threads;
+		for (size_t t = 0; t < n_threads; ++t) {
+			threads.push_back (PBD::Thread::create (worker, string_compose ("PluginLoad %1", t)));
+		}
+		for (auto const& t : threads) {
+			t->join ();
+			delete t;
+		}
+	}
+
+	for (auto const& job : jobs) {
+		if (!job.plugin) {
+			continue;
+		}
+		PreloadedPlugin pp;
+		pp.unique_id      = job.unique_id;
+		pp.plugin         = job.plugin;
+		pp.state_restored = job.state != 0;
+		_preloaded_plugins[job.id] = pp;
+	}
+
+	_load_times.plugins     += g_get_monotonic_time () - start_time;
+	_load_times.n_plugins   += _preloaded_plugins.size ();
+	_load_times.n_preloaded += _preloaded_plugins.size ();
+
+	DEBUG_TRACE (DEBUG::Processors, string_compose ("Pre-loaded %1 of %2 plugins using %3 thread(s)\n", _preloaded_plugins.size (), jobs.size (), n_threads));
+}
+
+std::shared_ptr<Plugin>
+Session::take_preloaded_plugin (XMLNode const& node, std::string const& unique_id, bool& state_restored)
+{
+	std::string id;
+	state_restored = false;
+
+	if (!node.get_property (X_("id"), id)) {
+		return std::shared_ptr<Plugin> ();
+	}
+
+	std::map<std::string, PreloadedPlugin>::iterator i = _preloaded_plugins.find (id);
+
+	if (i == _preloaded_plugins.end ()) {
+		return std::shared_ptr<Plugin> ();
+	}
+
+	std::shared_ptr<Plugin> plugin;
+
+	if (i->second.unique_id == unique_id) {
+		plugin         = i->second.plugin;
+		state_restored = i->second.state_restored;
+	}
+
+	_preloaded_plugins.erase (i);
+	return plugin;
+}
+
+void
+Session::add_plugin_load_time (int64_t us)
+{
+	_load_times.plugins += us;
+	++_load_times.n_plugins;
+}
+
 int
 Session::load_routes (const XMLNode& node, int version)
 {
@@ -3168,6 +3352,12 @@ Session::externals_dir () const
 	return Glib::build_filename (_path, externals_dir_name);
 }
 
+string
+Session::cache_dir () const
+{
+	return Glib::build_filename (_path, cache_dir_name);
+}
+
 int
 Session::load_bundles (XMLNode const & node)
 {
@@ -5522,6 +5712,39 @@ Session::save_as (SaveAs& saveas)
 	return 0;
 }
 
+/** Progress of encoding a single source, polled by Session::archive_session () */
+class ArchiveEncodeProgress : public PBD::Progress
+{
+public:
+	ArchiveEncodeProgress () : _progress (0) {}
+	float progress () const { return _progress.load (); }
+
+private:
+	void set_overall_progress (float p) { _progress.store (p); }
+
+	std::atomic<float> _progress;
+};
+
+struct ArchiveEncodeJob {
+	ArchiveEncodeJob (std::shared_ptr<AudioFileSource> s, std::string const& p)
+		: afs (s)
+		, new_path (p)
+		, length (s->readable_length_samples ())
+		, progress (new ArchiveEncodeProgress)
+		, gain (1)
+		, encoded (false)
+		, failed (false)
+	{}
+
+	std::shared_ptr<AudioFileSource>       afs;
+	std::string                            new_path;
+	samplecnt_t                            length;
+	std::shared_ptr<ArchiveEncodeProgress> progress;
+	float                                  gain;
+	bool                                   encoded;
+	bool                                   failed;
+};
+
 int
 Session::archive_session (const std::string& dest,
                           const std::string& name,
@@ -5718,6 +5941,9 @@ Session::archive_session (const std::string& dest,
 			progress->set_progress (0);
 		}
 
+		std::vector<ArchiveEncodeJob> jobs;
+		std::set<std::string>         new_paths;
+
 		Glib::Threads::Mutex::Lock lm (source_lock);
 		for (SourceMap::const_iterator i = sources.begin(); i != sources.end(); ++i) {
 			if (std::dynamic_pointer_cast<SilentFileSource> (i->second)) {
@@ -5751,37 +5977,113 @@ Session::archive_session (const std::string& dest,
 			new_path = Glib::build_filename (Glib::path_get_dirname (new_path), PBD::basename_nosuffix (new_path) + channelsuffix + ".flac");
 			g_mkdir_with_parents (Glib::path_get_dirname (new_path).c_str (), 0755);
 
-			/* avoid name collisions of external files with same name */
-			if (Glib::file_test (new_path, Glib::FILE_TEST_EXISTS)) {
+			/* avoid name collisions of external files with same name,
+			 * files are only created once all names have been chosen.
+			 */
+			if (Glib::file_test (new_path, Glib::FILE_TEST_EXISTS) || new_paths.find (new_path) != new_paths.end ()) {
 				new_path = Glib::build_filename (Glib::path_get_dirname (new_path), PBD::basename_nosuffix (new_path) + channelsuffix + "-1.flac");
 			}
-			while (Glib::file_test (new_path, Glib::FILE_TEST_EXISTS)) {
+			while (Glib::file_test (new_path, Glib::FILE_TEST_EXISTS) || new_paths.find (new_path) != new_paths.end ()) {
 				new_path = bump_name_once (new_path, '-');
 			}
 
-			if (progress) {
-				progress->descend ((float)afs->readable_length_samples () / total_size);
-			}
+			new_paths.insert (new_path);
+			jobs.push_back (ArchiveEncodeJob (afs, new_path));
+		}
 
-			try {
-				SndFileSource* ns = new SndFileSource (*this, *(afs.get()), new_path, compress_audio == FLAC_16BIT, progress);
-				afs->replace_file (new_path);
-				afs->set_gain (ns->gain(), true);
-				afs->set_channel (0);
-				delete ns;
-			} catch (...) {
-				error << "failed to encode " << afs->path() << " to " << new_path << endmsg;
-				rv = -1;
-				break;
+		/* sources are encoded concurrently by a pool of threads, while
+		 * this thread reports progress and handles cancellation.
+		 */
+		std::atomic<size_t> next (0);
+		std::atomic<bool>   stop (false);
+		Glib::Threads::Mutex running_lock;
+		Glib::Threads::Cond  running_cond;
+		size_t               n_running = 0;
+
+		std::function<void ()> worker = [&] () {
+			size_t n;
+			while (!stop.load () && (n = next.fetch_add (1)) < jobs.size ()) {
+				ArchiveEncodeJob& job (jobs[n]);
+				try {
+					SndFileSource ns (*this, *(job.afs.get()), job.new_path, compress_audio == FLAC_16BIT, job.progress.get ());
+					job.gain    = ns.gain ();
+					job.encoded = true;
+				} catch (...) {
+					job.failed = true;
+					stop.store (true);
+				}
+			}
+			Glib::Threads::Mutex::Lock lx (running_lock);
+			--n_running;
+			running_cond.signal ();
+		};
+
+		const int64_t encode_start_time = g_get_monotonic_time ();
+		const size_t  n_threads         = std::min<size_t> (hardware_concurrency (), jobs.size ());
+
+		std::vector<PBD::Thread*> threads;
+		for (size_t t = 0; t < n_threads; ++t) {
+			Glib::Threads::Mutex::Lock lx (running_lock);
+			PBD::Thread* thread = PBD::Thread::create (worker, string_compose ("Encode %1", t));
+			if (thread) {
+				threads.push_back (thread);
+				++n_running;
 			}
+		}
 
+		if (threads.empty ()) {
+			++n_running;
+			worker ();
+		}
+
+		while (true) {
+			{
+				Glib::Threads::Mutex::Lock lx (running_lock);
+				if (n_running == 0) {
+					break;
+				}
+				running_cond.wait_until (running_lock, g_get_monotonic_time () + G_TIME_SPAN_SECOND / 10);
+			}
 			if (progress) {
-				progress->ascend ();
+				double encoded = 0;
+				for (auto const& job : jobs) {
+					encoded += job.length * job.progress->progress ();
+				}
+				progress->set_progress (encoded / total_size);
 				if (progress->cancelled ()) {
-					break;
+					stop.store (true);
 				}
 			}
 		}
+
+		for (auto const& t : threads) {
+			t->join ();
+			delete t;
+		}
+
+		/* now update the sources, this must not happen concurrently */
+		samplecnt_t encoded_samples = 0;
+		size_t      n_encoded       = 0;
+		for (auto const& job : jobs) {
+			if (job.failed) {
+				error << "failed to encode " << job.afs->path() << " to " << job.new_path << endmsg;
+				rv = -1;
+			}
+			if (!job.encoded) {
+				continue;
+			}
+			job.afs->replace_file (job.new_path);
+			job.afs->set_gain (job.gain, true);
+			job.afs->set_channel (0);
+			encoded_samples += job.length;
+			++n_encoded;
+		}
+
+		const int64_t elapsed_time_us = std::max<int64_t> (1, g_get_monotonic_time () - encode_start_time);
+		info << string_compose (_("Session archive: encoded %1 of %2 sources using %3 threads (%4 MB/s)"),
+		                        n_encoded, jobs.size (), std::max<size_t> (1, threads.size ()),
+		                        (int64_t) rint (encoded_samples * sizeof (Sample) / (double) elapsed_time_us))
+		     << endmsg;
 	}
 
 	if (rv) {
@@ -46,6 +46,9 @@ SlavableAutomationControl::SlavableAutomationControl(ARDOUR::Session& s,
                                                      const std::string&                        name,
                                                      Controllable::Flag                        flags)
 	: AutomationControl (s, parameter, desc, l, name, flags)
+	, _masters_value (desc.toggled ? desc.lower : 1.0)
+	, _n_masters (0)
+	, _masters_serial (0)
 	, _masters_node (0)
 {
 }
@@ -102,16 +105,51 @@ SlavableAutomationControl::get_value_locked() const
 	return Control::get_double () * get_masters_value_locked ();
 }
 
+void
+SlavableAutomationControl::update_masters_value ()
+{
+	/* read or write masters lock must be held.
+	 *
+	 * Masters may change concurrently (e.g. master automation in the
+	 * process thread and a GUI change), which both only hold a read-lock.
+	 * Retry until no other update happened meanwhile, so that the
+	 * most recent snapshot wins.
+	 */
+	int serial = _masters_serial.fetch_add (1) + 1;
+	while (true) {
+		_masters_value.store (get_masters_value_locked ());
+		_n_masters.store (_masters.size ());
+		const int now = _masters_serial.load ();
+		if (now == serial) {
+			break;
+		}
+		serial = now;
+	}
+}
+
+void
+SlavableAutomationControl::masters_value_changed ()
+{
+	Glib::Threads::RWLock::ReaderLock lm (master_lock);
+	update_masters_value ();
+}
+
 /** Get the current effective `user' value based on automation state */
 double
 SlavableAutomationControl::get_value() const
 {
-	Glib::Threads::RWLock::ReaderLock lm (master_lock);
-	if (!_masters.empty() && automation_write ()) {
+	/* lock-free equivalent of get_value_locked () */
+	if (_n_masters.load () == 0) {
+		return Control::get_double ();
+	}
+	if (automation_write ()) {
 		/* writing automation takes the fader value as-is, factor out the master */
 		return Control::get_double ();
 	}
-	return get_value_locked ();
+	if (_desc.toggled && Control::get_double ()) {
+		return _desc.upper;
+	}
+	return Control::get_double () * get_masters_value ();
 }
 
 bool
@@ -154,13 +192,12 @@ SlavableAutomationControl::masters_curve_multiply (timepos_t const & start, time
 }
 
 double
-SlavableAutomationControl::reduce_by_masters_locked (double value, bool ignore_automation_state) const
+SlavableAutomationControl::reduce_by_masters (double value, bool ignore_automation_state) const
 {
 	if (!_desc.toggled) {
-		Glib::Threads::RWLock::ReaderLock lm (master_lock);
-		if (!_masters.empty() && (ignore_automation_state || !automation_write ())) {
+		if (_n_masters.load () > 0 && (ignore_automation_state || !automation_write ())) {
 			/* need to scale given value by current master's scaling */
-			const double masters_value = get_masters_value_locked();
+			const double masters_value = get_masters_value ();
 			if (masters_value == 0.0) {
 				value = 0.0;
 			} else {
@@ -217,6 +254,15 @@ SlavableAutomationControl::add_master (std::shared_ptr<AutomationControl> m)
 			*/
 
 			m->Changed.connect_same_thread (res.first->second.changed_connection, std::bind (&SlavableAutomationControl::master_changed, this, _1, _2, std::weak_ptr<AutomationControl>(m)));
+
+			/* The master's value also depends on its automation state
+			 * (see ::get_value), which does not emit Changed.
+			 */
+			if (m->alist ()) {
+				m->alist ()->automation_state_changed.connect_same_thread (res.first->second.state_connection, std::bind (&SlavableAutomationControl::masters_value_changed, this));
+			}
+
+			update_masters_value ();
 		}
 	}
 
@@ -288,6 +334,7 @@ SlavableAutomationControl::master_changed (bool /*from_self*/, GroupControlDispo
 	std::shared_ptr<AutomationControl> m = wm.lock ();
 	assert (m);
 	Glib::Threads::RWLock::ReaderLock lm (master_lock);
+	update_masters_value ();
 	bool send_signal = handle_master_change (m);
 	lm.release (); // update_boolean_masters_records() takes lock
 
@@ -355,6 +402,8 @@ SlavableAutomationControl::remove_master (std::shared_ptr<AutomationControl> m)
 		if (!_masters.erase (m->id())) {
 			return;
 		}
+
+		update_masters_value ();
 	}
 
 	if (update_value) {
@@ -432,6 +481,7 @@ SlavableAutomationControl::clear_masters ()
 		master_ratio = get_masters_value_locked ();
 		update_value = true;
 		_masters.clear ();
+		update_masters_value ();
 	}
 
 	if (update_value) {
@@ -662,6 +712,8 @@ SlavableAutomationControl::use_saved_master_ratios ()
 		mi->second.set_state (**niter, Stateful::loading_state_version);
 	}
 
+	update_masters_value ();
+
 	delete _masters_node;
 	_masters_node = 0;
 
@@ -23,6 +23,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <vector>
 
 #include <sys/time.h>
@@ -42,6 +43,9 @@
 
 #include "evoral/Control.h"
 #include "evoral/SMF.h"
+#include "evoral/SMFReader.h"
+#include "evoral/SMFWriter.h"
+#include "evoral/midi_util.h"
 
 #include "temporal/tempo.h"
 
@@ -174,6 +178,9 @@ SMFSource::SMFSource (Session& s, const XMLNode& node, bool must_exist)
 	if (!(_flags & Source::Empty)) {
 		assert (Glib::file_test (_path, Glib::FILE_TEST_EXISTS));
 		existence_check ();
+		if (writable () && Evoral::SMFWriter::recover (_path) > 0) {
+			warning << string_compose (_("MIDI file %1 was not completely written, it has been recovered"), _path) << endmsg;
+		}
 		if (open (_path, 1, false)) {
 			throw failed_constructor ();
 		}
@@ -234,6 +241,31 @@ SMFSource::render (const ReaderLock& lock, Evoral::EventSink<Temporal::Beats>& d
 	uint8_t* ev_buffer  = 0;
 	size_t   scratch_size = 0; // keep track of scratch to minimize reallocs
 
+	if (deferred ()) {
+		/* read events from the mapped file, without loading it into libsmf */
+		Evoral::SMFReader reader;
+
+		if (reader.open (_path) == 0) {
+			Evoral::SMFReader::Track t (reader.track (deferred_track ()));
+			Evoral::SMFReader::Event ev;
+
+			while (t.next (ev)) {
+				if (ev.is_meta ()) {
+					continue;
+				}
+				if (!midi_event_is_valid (ev.buf, ev.size)) {
+					break;
+				}
+				time = Temporal::Beats::ticks_at_rate (ev.time, reader.ppqn ());
+				destination.write (time, Evoral::MIDI_EVENT, ev.size, ev.buf);
+			}
+
+			_smf_last_read_end = time;
+			_smf_last_read_time = time;
+			return;
+		}
+	}
+
 	/* start of read in SMF ticks (which may differ from our own musical ticks */
 
 	Evoral::SMF::seek_to_start();
@@ -629,7 +661,12 @@ SMFSource::mark_streaming_midi_write_started (const WriterLock& lock, NoteMode m
 	}
 
 	MidiSource::mark_streaming_midi_write_started (lock, mode);
-	Evoral::SMF::begin_write ();
+
+	/* write events to the file as they arrive, instead of saving it when done */
+	if (Evoral::SMF::begin_append (_path)) {
+		Evoral::SMF::begin_write ();
+	}
+
 	_last_ev_time_beats  = Temporal::Beats();
 	_last_ev_time_samples = 0;
 }
@@ -717,6 +754,109 @@ SMFSource::load_model (const WriterLock& lock, bool force_reload)
 	invalidate (lock);
 }
 
+/** Add all events of the file to the model, reading them from the mapped
+ * file instead of having libsmf load it. Events are added without copying
+ * them first, except for those that are changed when parsed.
+ * \return false if the file could not be read
+ */
+bool
+SMFSource::load_model_mapped ()
+{
+	Evoral::SMFReader reader;
+
+	if (reader.open (_path)) {
+		return false;
+	}
+
+	struct Entry {
+		uint64_t           time;   ///< in SMF ticks
+		Evoral::event_id_t id;
+		const uint8_t*     buf;    ///< in the mapped file, or 0
+		size_t             offset; ///< in copied, if buf is 0
+		uint32_t           size;
+	};
+
+	std::vector<Entry>   events;
+	std::vector<uint8_t> copied;
+
+	for (int i = 1; i <= reader.num_tracks (); ++i) {
+		Evoral::SMFReader::Track t (reader.track (i));
+		Evoral::SMFReader::Event ev;
+		Evoral::event_id_t       event_id = -1;
+
+		while (t.next (ev)) {
+			if (ev.is_meta ()) {
+				/* did we get an event ID ?  */
+				if (ev.note_id >= 0) {
+					event_id = ev.note_id;
+				}
+				continue;
+			}
+
+			if (!midi_event_is_valid (ev.buf, ev.size)) {
+				cerr << "WARNING: SMF ignoring illegal MIDI event" << endl;
+				break;
+			}
+
+			/* aggregate information about channels and pgm-changes */
+			uint8_t type = ev.buf[0] & 0xf0;
+			uint8_t chan = ev.buf[0] & 0x0f;
+			if (type >= 0x80 && type <= 0xE0) {
+				_used_channels.set(chan);
+				switch (type) {
+					case MIDI_CMD_NOTE_ON:
+						++_n_note_on_events;
+						break;
+					case MIDI_CMD_PGM_CHANGE:
+						_has_pgm_change = true;
+						break;
+					default:
+						break;
+				}
+			}
+
+			Entry e;
+			e.time   = ev.time;
+			e.id     = event_id >= 0 ? event_id : Evoral::next_event_id ();
+			e.size   = ev.size;
+			e.buf    = 0;
+			e.offset = 0;
+
+			if (ev.mapped) {
+				e.buf = ev.buf;
+			} else {
+				/* scratch data of the reader, overwritten by the next event */
+				e.offset = copied.size ();
+				copied.insert (copied.end (), ev.buf, ev.buf + ev.size);
+			}
+
+			events.push_back (e);
+
+			/* event ID's must immediately precede the event they are for */
+			event_id = -1;
+		}
+	}
+
+	if (reader.num_tracks () > 1) {
+		std::stable_sort (events.begin (), events.end (), [] (Entry const& a, Entry const& b) { return a.time < b.time; });
+	}
+
+	uint16_t const ppqn = reader.ppqn ();
+
+	for (auto const& e : events) {
+		const Temporal::Beats event_time = Temporal::Beats::ticks_at_rate (e.time, ppqn);
+		uint8_t* buf = const_cast<uint8_t*> (e.buf ? e.buf : &copied[e.offset]);
+
+		/* the model copies the data it keeps */
+		_model->append (Evoral::Event<Temporal::Beats> (Evoral::MIDI_EVENT, event_time, e.size, buf, false), e.id);
+
+		assert (!_length || (_length.time_domain() == Temporal::BeatTime));
+		_length = max (_length, timepos_t (event_time));
+	}
+
+	return true;
+}
+
 void
 SMFSource::load_model_unlocked (bool force_reload)
 {
@@ -751,7 +891,9 @@ SMFSource::load_model_unlocked (bool force_reload)
 	// TODO simplify event allocation
 	std::list< std::pair< Evoral::Event<Temporal::Beats>*, gint > > eventlist;
 
-	for (unsigned i = 1; i <= num_tracks(); ++i) {
+	bool const mapped = deferred () && load_model_mapped ();
+
+	for (unsigned i = 1; !mapped && i <= num_tracks(); ++i) {
 		if (seek_to_track(i)) {
 			continue;
 		}
@@ -891,6 +1033,12 @@ SMFSource::flush_midi (const WriterLock& lock)
 		return;
 	}
 
+	if (appending ()) {
+		/* still being written, the file has all data that arrived so far */
+		Evoral::SMF::flush ();
+		return;
+	}
+
 	ensure_disk_file (lock);
 
 	Evoral::SMF::end_write (_path);
@@ -17,8 +17,12 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <xmmintrin.h>
 #include "ardour/types.h"
+#include "ardour/mix.h"
 
 void
 x86_sse_find_peaks(const ARDOUR::Sample* buf, ARDOUR::pframes_t nframes, float *min, float *max)
@@ -114,5 +118,319 @@ x86_sse_find_peaks(const ARDOUR::Sample* buf, ARDOUR::pframes_t nframes, float *
 	_mm_store_ss(max, work);
 }
 
+/**
+ * @brief x86 SSE multi-channel biquad cascade, processes 4 channels in parallel
+ *
+ * @param[in,out] buf interleaved audio data
+ * @param n_channels number of interleaved channels
+ * @param nframes number of frames to process
+ * @param n_stages number of biquad sections
+ * @param coeff filter coefficients, see default_biquad_cascade()
+ * @param[in,out] state filter state, see default_biquad_cascade()
+ */
+void
+x86_sse_biquad_cascade(float* buf, uint32_t n_channels, uint32_t nframes, uint32_t n_stages, const float* coeff, float* state)
+{
+	const uint32_t n_vec = n_channels & ~3;
+
+	for (uint32_t s = 0; s < n_stages; ++s) {
+		const float* c = &coeff[s * 5 * n_channels];
+		float*       z = &state[s * 2 * n_channels];
+
+		for (uint32_t l = 0; l < n_vec; l += 4) {
+			const __m128 b0 = _mm_loadu_ps(&c[0 * n_channels + l]);
+			const __m128 b1 = _mm_loadu_ps(&c[1 * n_channels + l]);
+			const __m128 b2 = _mm_loadu_ps(&c[2 * n_channels + l]);
+			const __m128 a1 = _mm_loadu_ps(&c[3 * n_channels + l]);
+			const __m128 a2 = _mm_loadu_ps(&c[4 * n_channels + l]);
+
+			__m128 z1 = _mm_loadu_ps(&z[l]);
+			__m128 z2 = _mm_loadu_ps(&z[n_channels + l]);
+
+			float* d = &buf[l];
+			for (uint32_t i = 0; i < nframes; ++i, d += n_channels) {
+				const __m128 x = _mm_loadu_ps(d);
+				const __m128 y = _mm_add_ps(_mm_mul_ps(b0, x), z1);
+				z1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(b1, x), _mm_mul_ps(a1, y)), z2);
+				z2 = _mm_sub_ps(_mm_mul_ps(b2, x), _mm_mul_ps(a2, y));
+				_mm_storeu_ps(d, y);
+			}
+
+			_mm_storeu_ps(&z[l], z1);
+			_mm_storeu_ps(&z[n_channels + l], z2);
+		}
+	}
+
+	// process remaining < 4 channels
+	if (n_vec < n_channels) {
+		default_biquad_cascade_lanes(buf, n_channels, nframes, n_stages, coeff, state, n_vec, n_channels);
+	}
+}
+
+/**
+ * @brief x86 SSE one-pole gain ramp (declick)
+ *
+ * Equivalent to `buf[i] *= g; g += coeff * (target - g);`, but using
+ * the closed form g[i] = target + (initial - target) * (1 - coeff)^i
+ * to process 4 samples in parallel.
+ *
+ * @return gain after the last sample
+ */
+float
+x86_sse_apply_gain_ramp(float* buf, uint32_t nframes, float initial, float target, float coeff)
+{
+	const float p1 = 1.f - coeff;
+	const float p2 = p1 * p1;
+	const float p4 = p2 * p2;
+
+	const __m128 t = _mm_set1_ps(target);
+	const __m128 r = _mm_set1_ps(p4);
+	__m128       d = _mm_mul_ps(_mm_set1_ps(initial - target), _mm_set_ps(p2 * p1, p2, p1, 1.f));
+
+	while (nframes >= 4) {
+		__m128 x = _mm_loadu_ps(buf);
+		x = _mm_mul_ps(x, _mm_add_ps(t, d));
+		_mm_storeu_ps(buf, x);
+		d = _mm_mul_ps(d, r);
+		buf += 4;
+		nframes -= 4;
+	}
+
+	/* the remaining samples and the returned gain (that of the next
+	 * sample) use the same closed form as the vectorized loop */
+	float dv[4];
+	_mm_storeu_ps(dv, d);
+
+	for (uint32_t i = 0; i < nframes; ++i) {
+		buf[i] *= target + dv[i];
+	}
+	return target + dv[nframes];
+}
+
+/**
+ * @brief x86 SSE mix buffers with a linear gain ramp from initial to target
+ */
+void
+x86_sse_mix_buffers_with_ramp(float* dst, const float* src, uint32_t nframes, float initial, float target)
+{
+	const float  delta = (target - initial) / nframes;
+	const __m128 g0    = _mm_set1_ps(initial);
+	const __m128 dv    = _mm_set1_ps(delta);
+	const __m128 four  = _mm_set1_ps(4.f);
+	__m128       idx   = _mm_set_ps(3.f, 2.f, 1.f, 0.f);
+
+	uint32_t i = 0;
+	for (; i + 4 <= nframes; i += 4) {
+		const __m128 g = _mm_add_ps(g0, _mm_mul_ps(dv, idx));
+		const __m128 x = _mm_mul_ps(_mm_loadu_ps(&src[i]), g);
+		_mm_storeu_ps(&dst[i], _mm_add_ps(_mm_loadu_ps(&dst[i]), x));
+		idx = _mm_add_ps(idx, four);
+	}
+
+	for (; i < nframes; ++i) {
+		dst[i] = dst[i] + src[i] * (initial + delta * (float)i);
+	}
+}
+
+/**
+ * @brief x86 SSE write a channel into interleaved data, dst[i * stride] = src[i]
+ */
+void
+x86_sse_interleave(float* dst, const float* src, uint32_t nframes, uint32_t stride)
+{
+	uint32_t i = 0;
+
+	if (stride == 1) {
+		memcpy(dst, src, nframes * sizeof(float));
+		return;
+	}
+
+	if (stride == 2) {
+		/* update every other sample, keep the other channel, stop
+		 * early so that the last neighbour-sample is not accessed */
+		for (; i + 4 < nframes; i += 4) {
+			const __m128 s  = _mm_loadu_ps(&src[i]);
+			const __m128 d0 = _mm_loadu_ps(&dst[2 * i]);
+			const __m128 d1 = _mm_loadu_ps(&dst[2 * i + 4]);
+			const __m128 o  = _mm_shuffle_ps(d0, d1, _MM_SHUFFLE(3, 1, 3, 1));
+			_mm_storeu_ps(&dst[2 * i], _mm_unpacklo_ps(s, o));
+			_mm_storeu_ps(&dst[2 * i + 4], _mm_unpackhi_ps(s, o));
+		}
+	}
+
+	for (; i < nframes; ++i) {
+		dst[i * stride] = src[i];
+	}
+}
+
+/**
+ * @brief x86 SSE read a channel from interleaved data, dst[i] = src[i * stride]
+ */
+void
+x86_sse_deinterleave(float* dst, const float* src, uint32_t nframes, uint32_t stride)
+{
+	uint32_t i = 0;
+
+	if (stride == 1) {
+		memcpy(dst, src, nframes * sizeof(float));
+		return;
+	}
 
+	if (stride == 2) {
+		for (; i + 4 < nframes; i += 4) {
+			const __m128 s0 = _mm_loadu_ps(&src[2 * i]);
+			const __m128 s1 = _mm_loadu_ps(&src[2 * i + 4]);
+			_mm_storeu_ps(&dst[i], _mm_shuffle_ps(s0, s1, _MM_SHUFFLE(2, 0, 2, 0)));
+		}
+	}
+
+	for (; i < nframes; ++i) {
+		dst[i] = src[i * stride];
+	}
+}
 
+/**
+ * @brief x86 SSE sum of squares
+ */
+float
+x86_sse_sum_of_squares(const float* buf, uint32_t nframes)
+{
+	__m128 acc0 = _mm_setzero_ps();
+	__m128 acc1 = _mm_setzero_ps();
+
+	while (nframes >= 8) {
+		const __m128 x0 = _mm_loadu_ps(buf);
+		const __m128 x1 = _mm_loadu_ps(buf + 4);
+		acc0 = _mm_add_ps(acc0, _mm_mul_ps(x0, x0));
+		acc1 = _mm_add_ps(acc1, _mm_mul_ps(x1, x1));
+		buf += 8;
+		nframes -= 8;
+	}
+
+	acc0 = _mm_add_ps(acc0, acc1);
+	acc0 = _mm_add_ps(acc0, _mm_movehl_ps(acc0, acc0));
+	acc0 = _mm_add_ss(acc0, _mm_shuffle_ps(acc0, acc0, _MM_SHUFFLE(1, 1, 1, 1)));
+
+	float sum = _mm_cvtss_f32(acc0);
+	while (nframes > 0) {
+		sum += *buf * *buf;
+		++buf;
+		--nframes;
+	}
+	return sum;
+}
+
+/**
+ * @brief x86 SSE subtract buffers, dst[i] -= src[i]
+ */
+void
+x86_sse_subtract_buffers(float* dst, const float* src, uint32_t nframes)
+{
+	uint32_t i = 0;
+	for (; i + 4 <= nframes; i += 4) {
+		_mm_storeu_ps(&dst[i], _mm_sub_ps(_mm_loadu_ps(&dst[i]), _mm_loadu_ps(&src[i])));
+	}
+	for (; i < nframes; ++i) {
+		dst[i] -= src[i];
+	}
+}
+
+/**
+ * @brief x86 SSE multiply and accumulate, dst[i] += a[i] * b[i]
+ */
+void
+x86_sse_multiply_add_buffers(float* dst, const float* a, const float* b, uint32_t nframes)
+{
+	uint32_t i = 0;
+	for (; i + 4 <= nframes; i += 4) {
+		const __m128 x = _mm_mul_ps(_mm_loadu_ps(&a[i]), _mm_loadu_ps(&b[i]));
+		_mm_storeu_ps(&dst[i], _mm_add_ps(_mm_loadu_ps(&dst[i]), x));
+	}
+	for (; i < nframes; ++i) {
+		dst[i] += a[i] * b[i];
+	}
+}
+
+/**
+ * @brief x86 SSE scale and offset, buf[i] = buf[i] * gain + offset
+ */
+void
+x86_sse_scale_offset_buffer(float* buf, uint32_t nframes, float gain, float offset)
+{
+	const __m128 g = _mm_set1_ps(gain);
+	const __m128 o = _mm_set1_ps(offset);
+
+	uint32_t i = 0;
+	for (; i + 4 <= nframes; i += 4) {
+		_mm_storeu_ps(&buf[i], _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&buf[i]), g), o));
+	}
+	for (; i < nframes; ++i) {
+		buf[i] = buf[i] * gain + offset;
+	}
+}
+
+/**
+ * @brief x86 SSE limit samples to [min, max]
+ */
+void
+x86_sse_clamp_buffer(float* buf, uint32_t nframes, float min, float max)
+{
+	const __m128 lo = _mm_set1_ps(min);
+	const __m128 hi = _mm_set1_ps(max);
+
+	uint32_t i = 0;
+	for (; i + 4 <= nframes; i += 4) {
+		_mm_storeu_ps(&buf[i], _mm_min_ps(_mm_max_ps(_mm_loadu_ps(&buf[i]), lo), hi));
+	}
+	for (; i < nframes; ++i) {
+		buf[i] = std::min(max, std::max(min, buf[i]));
+	}
+}
+
+/**
+ * @brief x86 SSE absolute value, buf[i] = fabsf (buf[i])
+ */
+void
+x86_sse_rectify_buffer(float* buf, uint32_t nframes)
+{
+	const __m128 sign = _mm_set1_ps(-0.f);
+
+	uint32_t i = 0;
+	for (; i + 4 <= nframes; i += 4) {
+		_mm_storeu_ps(&buf[i], _mm_andnot_ps(sign, _mm_loadu_ps(&buf[i])));
+	}
+	for (; i < nframes; ++i) {
+		buf[i] = fabsf(buf[i]);
+	}
+}
+
+/**
+ * @brief x86 SSE dot product, sum of a[i] * b[i]
+ */
+float
+x86_sse_dot_product(const float* a, const float* b, uint32_t n)
+{
+	__m128 acc0 = _mm_setzero_ps();
+	__m128 acc1 = _mm_setzero_ps();
+
+	while (n >= 8) {
+		acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+		acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + 4), _mm_loadu_ps(b + 4)));
+		a += 8;
+		b += 8;
+		n -= 8;
+	}
+
+	acc0 = _mm_add_ps(acc0, acc1);
+	acc0 = _mm_add_ps(acc0, _mm_movehl_ps(acc0, acc0));
+	acc0 = _mm_add_ss(acc0, _mm_shuffle_ps(acc0, acc0, _MM_SHUFFLE(1, 1, 1, 1)));
+
+	float sum = _mm_cvtss_f32(acc0);
+	while (n > 0) {
+		sum += *a * *b;
+		++a;
+		++b;
+		--n;
+	}
+	return sum;
+}
@@ -0,0 +1,146 @@
+#include "ardour/audioregion.h"
+#include "ardour/clip_data_cache.h"
+#include "ardour/region_factory.h"
+
+#include "clip_data_cache_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (ClipDataCacheTest);
+
+using namespace ARDOUR;
+
+void
+ClipDataCacheTest::setUp ()
+{
+	AudioRegionTest::setUp ();
+	ClipDataCache::instance ().clear ();
+}
+
+void
+ClipDataCacheTest::tearDown ()
+{
+	ClipDataCache::instance ().clear ();
+	AudioRegionTest::tearDown ();
+}
+
+/* Regions that use the same part of a source share the data */
+void
+ClipDataCacheTest::sharedTest ()
+{
+	ClipDataCache& cache (ClipDataCache::instance ());
+	ClipDataCache::Stats const s0 (cache.stats ());
+
+	ClipDataCache::EntryPtr a = cache.get (_ar[0], 100);
+	ClipDataCache::EntryPtr b = cache.get (_ar[1], 100);
+
+	CPPUNIT_ASSERT (a);
+	CPPUNIT_ASSERT (a == b);
+	CPPUNIT_ASSERT_EQUAL (samplecnt_t (100), a->length);
+	CPPUNIT_ASSERT_EQUAL (samplecnt_t (100), a->capacity);
+
+	for (int i = 0; i < 100; ++i) {
+		CPPUNIT_ASSERT_EQUAL (Sample (i), a->data[0][i]);
+	}
+
+	ClipDataCache::Stats const s1 (cache.stats ());
+	CPPUNIT_ASSERT_EQUAL (s0.misses + 1, s1.misses);
+	CPPUNIT_ASSERT_EQUAL (s0.hits + 1, s1.hits);
+	CPPUNIT_ASSERT_EQUAL (size_t (1), s1.entries);
+	CPPUNIT_ASSERT_EQUAL (size_t (0), s1.unused);
+	CPPUNIT_ASSERT_EQUAL (100 * sizeof (Sample), s1.bytes);
+}
+
+/* A different part of the same source is a different entry */
+void
+ClipDataCacheTest::boundsTest ()
+{
+	ClipDataCache& cache (ClipDataCache::instance ());
+
+	PBD::PropertyList plist;
+	plist.add (Properties::start, timepos_t (10));
+	plist.add (Properties::length, 100);
+	std::shared_ptr<AudioRegion> ar = std::dynamic_pointer_cast<AudioRegion> (RegionFactory::create (_source, plist));
+
+	ClipDataCache::EntryPtr a = cache.get (_ar[0], 100);
+	ClipDataCache::EntryPtr b = cache.get (ar, 100);
+
+	CPPUNIT_ASSERT (a && b);
+	CPPUNIT_ASSERT (a != b);
+	CPPUNIT_ASSERT_EQUAL (Sample (0), a->data[0][0]);
+	CPPUNIT_ASSERT_EQUAL (Sample (10), b->data[0][0]);
+	CPPUNIT_ASSERT_EQUAL (size_t (2), cache.stats ().entries);
+}
+
+/* Partially loaded data is replaced when more is needed,
+ * users of the smaller entry can keep using it.
+ */
+void
+ClipDataCacheTest::capacityTest ()
+{
+	ClipDataCache& cache (ClipDataCache::instance ());
+
+	ClipDataCache::EntryPtr a = cache.get (_ar[0], 50);
+	CPPUNIT_ASSERT_EQUAL (samplecnt_t (50), a->capacity);
+	CPPUNIT_ASSERT_EQUAL (samplecnt_t (100), a->length);
+
+	/* capacity is limited to the length of the region */
+	ClipDataCache::EntryPtr b = cache.get (_ar[1], 1000);
+	CPPUNIT_ASSERT (a != b);
+	CPPUNIT_ASSERT_EQUAL (samplecnt_t (100), b->capacity);
+	CPPUNIT_ASSERT_EQUAL (Sample (49), a->data[0][49]);
+
+	/* the larger entry satisfies smaller requests */
+	CPPUNIT_ASSERT (cache.get (_ar[2], 50) == b);
+
+	CPPUNIT_ASSERT_EQUAL (150 * sizeof (Sample), cache.stats ().bytes);
+
+	a.reset ();
+	cache.evict (1024 * 1024);
+	CPPUNIT_ASSERT_EQUAL (100 * sizeof (Sample), cache.stats ().bytes);
+}
+
+/* Unused entries are kept up to the given size, least recently used go first */
+void
+ClipDataCacheTest::evictTest ()
+{
+	ClipDataCache& cache (ClipDataCache::instance ());
+
+	PBD::PropertyList plist;
+	plist.add (Properties::start, timepos_t (200));
+	plist.add (Properties::length, 100);
+	std::shared_ptr<AudioRegion> ar = std::dynamic_pointer_cast<AudioRegion> (RegionFactory::create (_source, plist));
+
+	ClipDataCache::EntryPtr a = cache.get (_ar[0], 100);
+	ClipDataCache::EntryPtr b = cache.get (ar, 100);
+
+	a.reset ();
+
+	ClipDataCache::Stats s (cache.stats ());
+	CPPUNIT_ASSERT_EQUAL (size_t (2), s.entries);
+	CPPUNIT_ASSERT_EQUAL (size_t (1), s.unused);
+	CPPUNIT_ASSERT_EQUAL (100 * sizeof (Sample), s.unused_bytes);
+
+	/* entries that are in use are never evicted */
+	cache.evict (0);
+	s = cache.stats ();
+	CPPUNIT_ASSERT_EQUAL (size_t (1), s.entries);
+	CPPUNIT_ASSERT_EQUAL (size_t (0), s.unused);
+
+	const uint64_t evictions = s.evictions;
+
+	a = cache.get (_ar[0], 100);
+	CPPUNIT_ASSERT (cache.get (ar, 100) == b);
+
+	a.reset ();
+	b.reset ();
+
+	/* room for one of them, `ar' was used last */
+	cache.evict (100 * sizeof (Sample));
+	s = cache.stats ();
+	CPPUNIT_ASSERT_EQUAL (evictions + 1, s.evictions);
+	CPPUNIT_ASSERT_EQUAL (size_t (1), s.entries);
+	CPPUNIT_ASSERT_EQUAL (size_t (1), s.unused);
+
+	b = cache.get (ar, 100);
+	CPPUNIT_ASSERT_EQUAL (s.hits + 1, cache.stats ().hits);
+	CPPUNIT_ASSERT_EQUAL (Sample (200), b->data[0][0]);
+}
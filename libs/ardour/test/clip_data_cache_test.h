@@ -0,0 +1,23 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "audio_region_test.h"
+
+class ClipDataCacheTest : public AudioRegionTest
+{
+	CPPUNIT_TEST_SUITE (ClipDataCacheTest);
+	CPPUNIT_TEST (sharedTest);
+	CPPUNIT_TEST (boundsTest);
+	CPPUNIT_TEST (capacityTest);
+	CPPUNIT_TEST (evictTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp ();
+	void tearDown ();
+
+	void sharedTest ();
+	void boundsTest ();
+	void capacityTest ();
+	void evictTest ();
+};
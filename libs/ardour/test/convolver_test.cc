@@ -0,0 +1,163 @@
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "zita-convolver/zita-convolver.h"
+
+#include "convolver_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (ConvolverTest);
+
+using namespace ArdourZita;
+
+/* a single partition size: all processing happens in the calling thread */
+static int
+configure (Convproc& cp, uint32_t n_out = 2)
+{
+	return cp.configure (1, n_out, 4096, 256, 256, 256, 0);
+}
+
+/* configure, and add a decaying IR for every output */
+static void
+create (Convproc& cp)
+{
+	CPPUNIT_ASSERT_EQUAL (0, configure (cp));
+
+	std::vector<float> ir (3000);
+	for (uint32_t out = 0; out < 2; ++out) {
+		for (size_t i = 0; i < ir.size (); ++i) {
+			ir[i] = (out + 1) * ((i % 7) - 3.f) / (1.f + i);
+		}
+		CPPUNIT_ASSERT_EQUAL (0, cp.impdata_create (0, out, 1, &ir[0], 0, ir.size ()));
+	}
+}
+
+static std::vector<char>
+save (Convproc const& cp)
+{
+	FILE* f = tmpfile ();
+	CPPUNIT_ASSERT (f);
+	CPPUNIT_ASSERT_EQUAL (0, cp.impdata_save (f));
+
+	std::vector<char> data (ftell (f));
+	rewind (f);
+	CPPUNIT_ASSERT_EQUAL (data.size (), fread (&data[0], 1, data.size (), f));
+	fclose (f);
+	return data;
+}
+
+static int
+load (Convproc& cp, std::vector<char> const& data, size_t len)
+{
+	FILE* f = tmpfile ();
+	CPPUNIT_ASSERT (f);
+	if (len > 0) {
+		CPPUNIT_ASSERT_EQUAL (len, fwrite (&data[0], 1, len, f));
+	}
+	rewind (f);
+	int rv = cp.impdata_load (f);
+	fclose (f);
+	return rv;
+}
+
+/* loaded data produces the same output as the data that was saved */
+void
+ConvolverTest::roundTripTest ()
+{
+	Convproc a;
+	create (a);
+	std::vector<char> const data (save (a));
+	CPPUNIT_ASSERT (data.size () > 2 * 3000 * sizeof (float));
+
+	Convproc b;
+	CPPUNIT_ASSERT_EQUAL (0, configure (b));
+	CPPUNIT_ASSERT_EQUAL (0, load (b, data, data.size ()));
+	CPPUNIT_ASSERT_EQUAL ((uint32_t) Convproc::ST_STOP, b.state ());
+	CPPUNIT_ASSERT_EQUAL (data.size (), save (b).size ());
+
+	CPPUNIT_ASSERT_EQUAL (0, a.start_process (0, 0));
+	CPPUNIT_ASSERT_EQUAL (0, b.start_process (0, 0));
+
+	double energy = 0;
+	for (uint32_t n = 0; n < 32; ++n) {
+		for (uint32_t i = 0; i < 256; ++i) {
+			a.inpdata (0)[i] = b.inpdata (0)[i] = sinf (.1f * (n * 256 + i));
+		}
+		a.process ();
+		b.process ();
+		for (uint32_t out = 0; out < 2; ++out) {
+			for (uint32_t i = 0; i < 256; ++i) {
+				CPPUNIT_ASSERT_EQUAL (a.outdata (out)[i], b.outdata (out)[i]);
+				energy += a.outdata (out)[i] * a.outdata (out)[i];
+			}
+		}
+	}
+	CPPUNIT_ASSERT (energy > 0);
+
+	/* only configured instances can load data */
+	Convproc c;
+	CPPUNIT_ASSERT (load (c, data, data.size ()) != 0);
+}
+
+/* data of a differently configured instance is refused */
+void
+ConvolverTest::mismatchTest ()
+{
+	Convproc a;
+	create (a);
+	std::vector<char> const data (save (a));
+
+	Convproc b;
+	CPPUNIT_ASSERT_EQUAL (0, configure (b, 1));
+	CPPUNIT_ASSERT (load (b, data, data.size ()) != 0);
+	CPPUNIT_ASSERT_EQUAL ((uint32_t) Convproc::ST_IDLE, b.state ());
+
+	/* the instance can be used after a failed load */
+	CPPUNIT_ASSERT_EQUAL (0, configure (b));
+	CPPUNIT_ASSERT_EQUAL (0, load (b, data, data.size ()));
+}
+
+/* damaged headers are detected, and the instance is cleaned up */
+void
+ConvolverTest::corruptTest ()
+{
+	Convproc a;
+	create (a);
+	std::vector<char> const data (save (a));
+
+	/* file header: magic, version, sizeof (fftwf_complex), inputs, outputs, options, levels;
+	 * followed by the first level: offset, partitions, partition size, count;
+	 * and its first input/output pair
+	 */
+	const size_t   offsets[] = { 0, 4, 8, 12, 16, 20, 24, 28, 32, 36, 40, 44, 48 };
+	const uint32_t bad       = 0x7fffffff;
+
+	for (size_t i = 0; i < sizeof (offsets) / sizeof (offsets[0]); ++i) {
+		std::vector<char> damaged (data);
+		memcpy (&damaged[offsets[i]], &bad, sizeof (bad));
+
+		Convproc b;
+		CPPUNIT_ASSERT_EQUAL (0, configure (b));
+		CPPUNIT_ASSERT (load (b, damaged, damaged.size ()) != 0);
+		CPPUNIT_ASSERT_EQUAL ((uint32_t) Convproc::ST_IDLE, b.state ());
+	}
+}
+
+/* incomplete files are detected, and the instance is cleaned up */
+void
+ConvolverTest::truncatedTest ()
+{
+	Convproc a;
+	create (a);
+	std::vector<char> const data (save (a));
+
+	const size_t lengths[] = { 0, 1, 27, 28, 43, 44, 51, 52, data.size () / 2, data.size () - 1 };
+
+	for (size_t i = 0; i < sizeof (lengths) / sizeof (lengths[0]); ++i) {
+		Convproc b;
+		CPPUNIT_ASSERT_EQUAL (0, configure (b));
+		CPPUNIT_ASSERT (load (b, data, lengths[i]) != 0);
+		CPPUNIT_ASSERT_EQUAL ((uint32_t) Convproc::ST_IDLE, b.state ());
+	}
+}
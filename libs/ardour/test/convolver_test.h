@@ -0,0 +1,21 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class ConvolverTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (ConvolverTest);
+	CPPUNIT_TEST (roundTripTest);
+	CPPUNIT_TEST (mismatchTest);
+	CPPUNIT_TEST (corruptTest);
+	CPPUNIT_TEST (truncatedTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp () {}
+	void tearDown () {}
+
+	void roundTripTest ();
+	void mismatchTest ();
+	void corruptTest ();
+	void truncatedTest ();
+};
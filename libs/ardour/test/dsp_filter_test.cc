@@ -0,0 +1,367 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "pbd/compose.h"
+#include "pbd/fpu.h"
+
+#include "ardour/dsp_filter.h"
+#include "ardour/mix.h"
+
+#include "dsp_filter_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (DSPFilterTest);
+
+using namespace ARDOUR;
+
+static const double rate = 48000;
+
+/* a different filter for every channel and stage */
+static void
+setup_filter (DSP::Biquad& f, uint32_t chn, uint32_t stage)
+{
+	static const DSP::Biquad::Type types[] = {
+		DSP::Biquad::LowPass, DSP::Biquad::HighPass, DSP::Biquad::Peaking, DSP::Biquad::LowShelf, DSP::Biquad::HighShelf
+	};
+	f.compute (types[(chn + stage) % 5], 100. + 250. * chn + 1000. * stage, .7, 6.);
+}
+
+static float
+test_signal (uint32_t chn, uint32_t i)
+{
+	return .5f * sinf (i * (.01f + .003f * chn)) + .25f * ((i * 7919 + chn * 104729) % 1024) / 1024.f - .125f;
+}
+
+/* process interleaved data using the given kernel, compare to Biquad::run,
+ * return max absolute deviation */
+float
+DSPFilterTest::compare (biquad_cascade_t kernel, uint32_t n_channels, uint32_t n_stages, uint32_t n_frames)
+{
+	std::vector<float> coeff (5 * n_stages * n_channels);
+	std::vector<float> state (2 * n_stages * n_channels, 0.f);
+	std::vector<float> interleaved (n_channels * n_frames);
+
+	for (uint32_t c = 0; c < n_channels; ++c) {
+		for (uint32_t i = 0; i < n_frames; ++i) {
+			interleaved[i * n_channels + c] = test_signal (c, i);
+		}
+		for (uint32_t s = 0; s < n_stages; ++s) {
+			DSP::Biquad f (rate);
+			setup_filter (f, c, s);
+
+			double a1, a2, b0, b1, b2;
+			f.coefficients (a1, a2, b0, b1, b2);
+			coeff[(s * 5 + 0) * n_channels + c] = b0;
+			coeff[(s * 5 + 1) * n_channels + c] = b1;
+			coeff[(s * 5 + 2) * n_channels + c] = b2;
+			coeff[(s * 5 + 3) * n_channels + c] = a1;
+			coeff[(s * 5 + 4) * n_channels + c] = a2;
+		}
+	}
+
+	/* process in two chunks, to verify that state is retained */
+	const uint32_t n_first = n_frames / 3;
+	kernel (&interleaved[0], n_channels, n_first, n_stages, &coeff[0], &state[0]);
+	kernel (&interleaved[n_first * n_channels], n_channels, n_frames - n_first, n_stages, &coeff[0], &state[0]);
+
+	/* compare to scalar Biquad */
+	float max_diff = 0;
+	std::vector<float> ref (n_frames);
+
+	for (uint32_t c = 0; c < n_channels; ++c) {
+		for (uint32_t i = 0; i < n_frames; ++i) {
+			ref[i] = test_signal (c, i);
+		}
+		for (uint32_t s = 0; s < n_stages; ++s) {
+			DSP::Biquad f (rate);
+			setup_filter (f, c, s);
+			f.run (&ref[0], n_frames);
+		}
+		for (uint32_t i = 0; i < n_frames; ++i) {
+			max_diff = std::max (max_diff, fabsf (ref[i] - interleaved[i * n_channels + c]));
+		}
+	}
+
+	return max_diff;
+}
+
+void
+DSPFilterTest::run (biquad_cascade_t kernel, std::string const& name)
+{
+	static const uint32_t channels[] = { 1, 3, 4, 5, 8, 13, 16, 17, 31, 64 };
+
+	for (size_t i = 0; i < sizeof (channels) / sizeof (uint32_t); ++i) {
+		for (uint32_t stages = 1; stages <= 3; ++stages) {
+			float diff = compare (kernel, channels[i], stages, 1024);
+			CPPUNIT_ASSERT_MESSAGE (string_compose ("%1 biquad cascade %2 chn %3 stages, diff: %4", name, channels[i], stages, diff), diff < 1e-4);
+		}
+	}
+}
+
+void
+DSPFilterTest::defaultBiquadTest ()
+{
+	run (default_biquad_cascade, "Default");
+}
+
+#if defined(ARCH_X86) && defined(BUILD_SSE_OPTIMIZATIONS)
+
+void
+DSPFilterTest::sseBiquadTest ()
+{
+	if (!PBD::FPU::instance ()->has_sse ()) {
+		printf ("SSE is not available at run-time\n");
+		return;
+	}
+	run (x86_sse_biquad_cascade, "SSE");
+}
+
+void
+DSPFilterTest::avxFmaBiquadTest ()
+{
+#ifdef FPU_AVX_FMA_SUPPORT
+	PBD::FPU* fpu = PBD::FPU::instance ();
+	if (!(fpu->has_avx () && fpu->has_fma ())) {
+		printf ("AVX and FMA is not available at run-time\n");
+		return;
+	}
+	run (x86_fma_biquad_cascade, "AVX/FMA");
+#endif
+}
+
+void
+DSPFilterTest::avx512fBiquadTest ()
+{
+#ifdef FPU_AVX512F_SUPPORT
+	if (!PBD::FPU::instance ()->has_avx512f ()) {
+		printf ("AVX512F is not available at run-time\n");
+		return;
+	}
+	run (x86_avx512f_biquad_cascade, "AVX512F");
+#endif
+}
+
+#elif defined ARM_NEON_SUPPORT
+
+void
+DSPFilterTest::neonBiquadTest ()
+{
+	if (!PBD::FPU::instance ()->has_neon ()) {
+		printf ("NEON is not available at run-time\n");
+		return;
+	}
+	run (arm_neon_biquad_cascade, "NEON");
+}
+
+#endif
+
+void
+DSPFilterTest::multiBiquadTest ()
+{
+	const uint32_t n_channels = 19;
+	const uint32_t n_stages   = 2;
+	const uint32_t n_samples  = 1000; // more than one internal block
+
+	DSP::MultiBiquad mb (rate, n_channels, n_stages);
+	CPPUNIT_ASSERT_EQUAL (n_channels, mb.n_channels ());
+	CPPUNIT_ASSERT_EQUAL (n_stages, mb.n_stages ());
+
+	std::vector<std::vector<float> > data (n_channels);
+	std::vector<std::vector<float> > ref (n_channels);
+	std::vector<float*>              ptr (n_channels);
+
+	for (uint32_t c = 0; c < n_channels; ++c) {
+		data[c].resize (n_samples);
+		ref[c].resize (n_samples);
+		for (uint32_t i = 0; i < n_samples; ++i) {
+			data[c][i] = ref[c][i] = test_signal (c, i);
+		}
+		for (uint32_t s = 0; s < n_stages; ++s) {
+			DSP::Biquad f (rate);
+			setup_filter (f, c, s);
+			mb.configure (c, s, f);
+			f.run (&ref[c][0], n_samples);
+		}
+		ptr[c] = &data[c][0];
+
+		float const dB_ref = mb.dB_at_freq (c, 1000);
+		CPPUNIT_ASSERT (std::isfinite (dB_ref));
+	}
+
+	mb.run (&ptr[0], n_samples);
+
+	for (uint32_t c = 0; c < n_channels; ++c) {
+		for (uint32_t i = 0; i < n_samples; ++i) {
+			CPPUNIT_ASSERT_DOUBLES_EQUAL (ref[c][i], data[c][i], 1e-4);
+		}
+	}
+
+	/* identical filter for all channels, using interleaved data */
+	DSP::MultiBiquad mi (rate, n_channels, 1);
+	mi.compute_all (0, DSP::Biquad::LowPass, 1000, .7, 0);
+
+	DSP::Biquad lp (rate);
+	lp.compute (DSP::Biquad::LowPass, 1000, .7, 0);
+
+	std::vector<float> interleaved (n_channels * n_samples);
+	for (uint32_t c = 0; c < n_channels; ++c) {
+		for (uint32_t i = 0; i < n_samples; ++i) {
+			ref[c][i] = interleaved[i * n_channels + c] = test_signal (c, i);
+		}
+		lp.reset ();
+		lp.run (&ref[c][0], n_samples);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (lp.dB_at_freq (2000), mi.dB_at_freq (c, 2000), 1e-5);
+	}
+
+	mi.run_interleaved (&interleaved[0], n_samples);
+
+	for (uint32_t c = 0; c < n_channels; ++c) {
+		for (uint32_t i = 0; i < n_samples; ++i) {
+			CPPUNIT_ASSERT_DOUBLES_EQUAL (ref[c][i], interleaved[i * n_channels + c], 1e-4);
+		}
+	}
+}
+
+/* ARDOUR::DSP helpers use the run-time selected implementation,
+ * compare them to plain scalar code */
+void
+DSPFilterTest::bufferHelperTest ()
+{
+	static const uint32_t sizes[] = { 1, 3, 4, 7, 8, 15, 16, 17, 33, 64, 100 };
+
+	for (size_t s = 0; s < sizeof (sizes) / sizeof (uint32_t); ++s) {
+		for (uint32_t off = 0; off < 4; ++off) {
+			const uint32_t     n = sizes[s];
+			std::vector<float> a (n + off);
+			std::vector<float> b (n + off);
+			std::vector<float> data (n + off);
+			std::vector<float> ref (n + off);
+
+			for (uint32_t i = 0; i < n + off; ++i) {
+				a[i] = 2.f * test_signal (0, i);
+				b[i] = test_signal (1, i);
+			}
+
+			data = ref = a;
+			DSP::subtract (&data[off], &b[off], n);
+			for (uint32_t i = off; i < n + off; ++i) {
+				ref[i] -= b[i];
+			}
+			CPPUNIT_ASSERT_MESSAGE (string_compose ("subtract n: %1 off: %2", n, off), data == ref);
+
+			DSP::multiply_add (&data[off], &a[off], &b[off], n);
+			for (uint32_t i = off; i < n + off; ++i) {
+				ref[i] += a[i] * b[i];
+			}
+			for (uint32_t i = 0; i < n + off; ++i) {
+				CPPUNIT_ASSERT_DOUBLES_EQUAL (ref[i], data[i], 1e-6);
+			}
+
+			data = ref = a;
+			DSP::scale_offset (&data[off], 1.5f, -.25f, n);
+			for (uint32_t i = off; i < n + off; ++i) {
+				ref[i] = ref[i] * 1.5f - .25f;
+			}
+			for (uint32_t i = 0; i < n + off; ++i) {
+				CPPUNIT_ASSERT_DOUBLES_EQUAL (ref[i], data[i], 1e-6);
+			}
+
+			data = ref = a;
+			DSP::clamp (&data[off], -.3f, .4f, n);
+			for (uint32_t i = off; i < n + off; ++i) {
+				ref[i] = std::min (.4f, std::max (-.3f, ref[i]));
+			}
+			CPPUNIT_ASSERT_MESSAGE (string_compose ("clamp n: %1 off: %2", n, off), data == ref);
+
+			data = ref = a;
+			DSP::rectify (&data[off], n);
+			for (uint32_t i = off; i < n + off; ++i) {
+				ref[i] = fabsf (ref[i]);
+			}
+			CPPUNIT_ASSERT_MESSAGE (string_compose ("rectify n: %1 off: %2", n, off), data == ref);
+
+			double sum = 0;
+			for (uint32_t i = off; i < n + off; ++i) {
+				sum += a[i] * a[i];
+			}
+			CPPUNIT_ASSERT_DOUBLES_EQUAL (sqrt (sum / n), DSP::rms (&a[off], n), 1e-6);
+		}
+	}
+}
+
+void
+DSPFilterTest::firFilterTest ()
+{
+	static const uint32_t taps[] = { 1, 2, 5, 8, 16, 31, 64 };
+	const uint32_t        n_samples = 512;
+
+	std::vector<float> in (n_samples);
+	for (uint32_t i = 0; i < n_samples; ++i) {
+		in[i] = test_signal (2, i);
+	}
+
+	for (size_t t = 0; t < sizeof (taps) / sizeof (uint32_t); ++t) {
+		const uint32_t     n = taps[t];
+		std::vector<float> coeff (n);
+		for (uint32_t k = 0; k < n; ++k) {
+			coeff[k] = (k + 1.f) / (n * (k % 3 + 1.f));
+		}
+
+		DSP::FIRFilter fir (64);
+		CPPUNIT_ASSERT (!fir.set_coefficients (&coeff[0], 0));
+		CPPUNIT_ASSERT (fir.set_coefficients (&coeff[0], n));
+		CPPUNIT_ASSERT_EQUAL (n, fir.n_taps ());
+
+		/* process in chunks, history must be retained */
+		std::vector<float> data (in);
+		fir.run (&data[0], 100);
+		fir.run (&data[100], 1);
+		fir.run (&data[101], n_samples - 101);
+
+		for (uint32_t i = 0; i < n_samples; ++i) {
+			double ref = 0;
+			for (uint32_t k = 0; k < n && k <= i; ++k) {
+				ref += coeff[k] * in[i - k];
+			}
+			CPPUNIT_ASSERT_DOUBLES_EQUAL (ref, data[i], 1e-5);
+		}
+	}
+
+	std::vector<float> coeff (65, 1.f);
+	DSP::FIRFilter     fir (64);
+	CPPUNIT_ASSERT (!fir.set_coefficients (&coeff[0], 65));
+}
+
+void
+DSPFilterTest::interpolateTest ()
+{
+	static const double steps[] = { .25, .37, 1.0, 1.7, 3.1 };
+	const uint32_t      src_len = 100;
+	const uint32_t      n_out   = 150;
+
+	std::vector<float> src (src_len);
+	for (uint32_t i = 0; i < src_len; ++i) {
+		src[i] = test_signal (3, i);
+	}
+
+	for (size_t s = 0; s < sizeof (steps) / sizeof (double); ++s) {
+		const double start = -2.25;
+		const double step  = steps[s];
+
+		std::vector<float> dst (n_out);
+
+		/* two calls, continuing at the returned position */
+		double pos = DSP::interpolate (&dst[0], &src[0], src_len, start, step, 37);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (start + 37 * step, pos, 1e-9);
+		pos = DSP::interpolate (&dst[37], &src[0], src_len, pos, step, n_out - 37);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (start + n_out * step, pos, 1e-9);
+
+		for (uint32_t i = 0; i < n_out; ++i) {
+			const double  p = start + i * step;
+			const int64_t x = (int64_t) floor (p);
+			const double  a = (x >= 0 && x < src_len) ? src[x] : 0;
+			const double  b = (x + 1 >= 0 && x + 1 < src_len) ? src[x + 1] : 0;
+			CPPUNIT_ASSERT_DOUBLES_EQUAL (a + (p - floor (p)) * (b - a), dst[i], 1e-6);
+		}
+	}
+}
@@ -0,0 +1,40 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "ardour/runtime_functions.h"
+
+class DSPFilterTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (DSPFilterTest);
+	CPPUNIT_TEST (defaultBiquadTest);
+#if defined(ARCH_X86) && defined(BUILD_SSE_OPTIMIZATIONS)
+	CPPUNIT_TEST (sseBiquadTest);
+	CPPUNIT_TEST (avxFmaBiquadTest);
+	CPPUNIT_TEST (avx512fBiquadTest);
+#elif defined ARM_NEON_SUPPORT
+	CPPUNIT_TEST (neonBiquadTest);
+#endif
+	CPPUNIT_TEST (multiBiquadTest);
+	CPPUNIT_TEST (bufferHelperTest);
+	CPPUNIT_TEST (firFilterTest);
+	CPPUNIT_TEST (interpolateTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void defaultBiquadTest ();
+#if defined(ARCH_X86) && defined(BUILD_SSE_OPTIMIZATIONS)
+	void sseBiquadTest ();
+	void avxFmaBiquadTest ();
+	void avx512fBiquadTest ();
+#elif defined ARM_NEON_SUPPORT
+	void neonBiquadTest ();
+#endif
+	void multiBiquadTest ();
+	void bufferHelperTest ();
+	void firFilterTest ();
+	void interpolateTest ();
+
+private:
+	void run (ARDOUR::biquad_cascade_t, std::string const&);
+	float compare (ARDOUR::biquad_cascade_t, uint32_t n_channels, uint32_t n_stages, uint32_t n_frames);
+};
@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <cassert>
+#include <vector>
 #include "pbd/compose.h"
 #include "pbd/fpu.h"
 #include "pbd/malign.h"
@@ -83,6 +85,145 @@ FPUTest::run (size_t align_max, float const max_diff)
 			CPPUNIT_ASSERT_MESSAGE (string_compose ("Find peaks not aligned off: %1 cnt: %2", off, cnt), fabsf (pk_test - pk_comp) < 2e-6 && fabsf (pk_test_max - pk_comp_max) < 2e-6);
 		}
 	}
+
+	run_extended (align_max, max_diff);
+}
+
+void
+FPUTest::run_extended (size_t align_max, float const max_diff)
+{
+	const size_t       n_chn = 5;
+	std::vector<float> src (_size);
+	std::vector<float> ilv_test (_size * n_chn);
+	std::vector<float> ilv_comp (_size * n_chn);
+
+	for (size_t i = 0; i < _size; ++i) {
+		/* exceed [-1, 1] to test clipping, include exact .5 steps to test rounding */
+		src[i] = 1.2f * sinf (i * .1f);
+		if (i % 7 == 0) {
+			src[i] = (i - 512.f) / 32768.f + .5f / 32768.f;
+		}
+	}
+
+	for (size_t off = 0; off < align_max; ++off) {
+		for (size_t cnt = 1; cnt < align_max; ++cnt) {
+			/* gain ramp, closed form vs. recursion */
+			for (size_t i = 0; i < _size; ++i) {
+				_test1[i] = _comp1[i] = src[i];
+			}
+			float g_test = apply_gain_ramp (&_test1[off], cnt, 0.1f, 0.9f, 0.01f);
+			float g_comp = default_apply_gain_ramp (&_comp1[off], cnt, 0.1f, 0.9f, 0.01f);
+			compare (string_compose ("Apply Gain Ramp not aligned off: %1 cnt: %2", off, cnt), _size, 1e-5);
+			CPPUNIT_ASSERT_MESSAGE (string_compose ("Apply Gain Ramp result off: %1 cnt: %2", off, cnt), fabsf (g_test - g_comp) < 1e-5);
+
+			/* the returned gain is bit-exact the gain that is applied to the
+			 * next sample, so that a ramp continues seamlessly in the next cycle */
+			std::vector<float> ones_test (cnt + 1, 1.f);
+			std::vector<float> ones_comp (cnt + 1, 1.f);
+			g_test = apply_gain_ramp (&ones_test[0], cnt, 0.1f, 0.9f, 0.01f);
+			g_comp = default_apply_gain_ramp (&ones_comp[0], cnt, 0.1f, 0.9f, 0.01f);
+			std::fill (ones_test.begin (), ones_test.end (), 1.f);
+			std::fill (ones_comp.begin (), ones_comp.end (), 1.f);
+			apply_gain_ramp (&ones_test[0], cnt + 1, 0.1f, 0.9f, 0.01f);
+			default_apply_gain_ramp (&ones_comp[0], cnt + 1, 0.1f, 0.9f, 0.01f);
+			CPPUNIT_ASSERT_MESSAGE (string_compose ("Apply Gain Ramp continuity off: %1 cnt: %2", off, cnt), g_test == ones_test[cnt] && g_comp == ones_comp[cnt]);
+
+			/* mix buffers w/ramp */
+			for (size_t i = 0; i < _size; ++i) {
+				_test1[i] = _comp1[i] = _comp2[i];
+			}
+			mix_buffers_with_ramp (&_test1[off], &src[off], cnt, 1.f, 0.f);
+			default_mix_buffers_with_ramp (&_comp1[off], &src[off], cnt, 1.f, 0.f);
+			/* results are in [-1.2, 3.7], one ULP may exceed FLT_EPSILON */
+			compare (string_compose ("Mix Buffers w/ramp not aligned off: %1 cnt: %2", off, cnt), _size, 4 * max_diff);
+
+			/* sum of squares */
+			float sq_test = sum_of_squares (&src[off], cnt);
+			float sq_comp = default_sum_of_squares (&src[off], cnt);
+			CPPUNIT_ASSERT_MESSAGE (string_compose ("Sum of squares not aligned off: %1 cnt: %2", off, cnt), fabsf (sq_test - sq_comp) <= 1e-5 * sq_comp);
+
+			/* element-wise arithmetic */
+			for (size_t i = 0; i < _size; ++i) {
+				_test1[i] = _comp1[i] = src[i];
+			}
+			subtract_buffers (&_test1[off], &_comp2[off], cnt);
+			default_subtract_buffers (&_comp1[off], &_comp2[off], cnt);
+			compare (string_compose ("Subtract Buffers not aligned off: %1 cnt: %2", off, cnt), _size);
+
+			multiply_add_buffers (&_test1[off], &src[off], &_comp2[off], cnt);
+			default_multiply_add_buffers (&_comp1[off], &src[off], &_comp2[off], cnt);
+			compare (string_compose ("Multiply Add Buffers not aligned off: %1 cnt: %2", off, cnt), _size, 4 * max_diff);
+
+			for (size_t i = 0; i < _size; ++i) {
+				_test1[i] = _comp1[i] = src[i];
+			}
+			scale_offset_buffer (&_test1[off], cnt, 1.5f, -.25f);
+			default_scale_offset_buffer (&_comp1[off], cnt, 1.5f, -.25f);
+			compare (string_compose ("Scale Offset not aligned off: %1 cnt: %2", off, cnt), _size, 4 * max_diff);
+
+			for (size_t i = 0; i < _size; ++i) {
+				_test1[i] = _comp1[i] = src[i];
+			}
+			clamp_buffer (&_test1[off], cnt, -.5f, .75f);
+			default_clamp_buffer (&_comp1[off], cnt, -.5f, .75f);
+			compare (string_compose ("Clamp not aligned off: %1 cnt: %2", off, cnt), _size);
+
+			for (size_t i = 0; i < _size; ++i) {
+				_test1[i] = _comp1[i] = src[i];
+			}
+			rectify_buffer (&_test1[off], cnt);
+			default_rectify_buffer (&_comp1[off], cnt);
+			compare (string_compose ("Rectify not aligned off: %1 cnt: %2", off, cnt), _size);
+
+			/* dot product, _comp1 is now non-negative */
+			float dp_test = dot_product (&_comp1[off], &_comp2[off], cnt);
+			float dp_comp = default_dot_product (&_comp1[off], &_comp2[off], cnt);
+			CPPUNIT_ASSERT_MESSAGE (string_compose ("Dot product not aligned off: %1 cnt: %2", off, cnt), fabsf (dp_test - dp_comp) <= 1e-5 * dp_comp);
+
+			/* linear interpolation, start before and end after the source data */
+			for (size_t i = 0; i < _size; ++i) {
+				_test1[i] = _comp1[i] = 0;
+			}
+			const double step   = (cnt + 3.0) / cnt;
+			double       p_test = interpolate_buffer (&_test1[off], &src[off], cnt, -1.5, step, cnt);
+			double       p_comp = default_interpolate_buffer (&_comp1[off], &src[off], cnt, -1.5, step, cnt);
+			compare (string_compose ("Interpolate not aligned off: %1 cnt: %2", off, cnt), _size, 4 * max_diff);
+			CPPUNIT_ASSERT_MESSAGE (string_compose ("Interpolate position off: %1 cnt: %2", off, cnt), fabs (p_test - p_comp) < 1e-9);
+
+			/* float to int */
+			std::vector<int16_t> s16_test (cnt);
+			std::vector<int16_t> s16_comp (cnt);
+			float_to_s16 (&s16_test[0], &src[off], cnt);
+			default_float_to_s16 (&s16_comp[0], &src[off], cnt);
+			CPPUNIT_ASSERT_MESSAGE (string_compose ("Float to S16 not aligned off: %1 cnt: %2", off, cnt), s16_test == s16_comp);
+
+			std::vector<int32_t> s24_test (cnt);
+			std::vector<int32_t> s24_comp (cnt);
+			float_to_s24 (&s24_test[0], &src[off], cnt);
+			default_float_to_s24 (&s24_comp[0], &src[off], cnt);
+			CPPUNIT_ASSERT_MESSAGE (string_compose ("Float to S24 not aligned off: %1 cnt: %2", off, cnt), s24_test == s24_comp);
+		}
+	}
+
+	/* (de)interleave, for various channel-counts */
+	for (uint32_t stride = 1; stride <= n_chn; ++stride) {
+		for (size_t cnt = 1; cnt < align_max * 2; ++cnt) {
+			for (size_t i = 0; i < _size * n_chn; ++i) {
+				ilv_test[i] = ilv_comp[i] = -1.f - i;
+			}
+			for (uint32_t c = 0; c < stride; ++c) {
+				interleave (&ilv_test[c], &src[c], cnt, stride);
+				default_interleave (&ilv_comp[c], &src[c], cnt, stride);
+			}
+			CPPUNIT_ASSERT_MESSAGE (string_compose ("Interleave stride: %1 cnt: %2", stride, cnt), ilv_test == ilv_comp);
+
+			for (uint32_t c = 0; c < stride; ++c) {
+				deinterleave (_test1, &ilv_test[c], cnt, stride);
+				default_deinterleave (_comp1, &ilv_comp[c], cnt, stride);
+				compare (string_compose ("De-interleave stride: %1 cnt: %2", stride, cnt), cnt);
+			}
+		}
+	}
 }
 
 void
@@ -122,6 +263,20 @@ FPUTest::avxFmaTest ()
 	mix_buffers_with_gain = x86_fma_mix_buffers_with_gain;
 	mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 	copy_vector           = x86_sse_avx_copy_vector;
+	apply_gain_ramp       = x86_fma_apply_gain_ramp;
+	mix_buffers_with_ramp = x86_fma_mix_buffers_with_ramp;
+	interleave            = x86_sse_interleave;
+	deinterleave          = x86_sse_deinterleave;
+	float_to_s16          = x86_fma_float_to_s16;
+	float_to_s24          = x86_fma_float_to_s24;
+	sum_of_squares        = x86_fma_sum_of_squares;
+	subtract_buffers      = x86_fma_subtract_buffers;
+	multiply_add_buffers  = x86_fma_multiply_add_buffers;
+	scale_offset_buffer   = x86_fma_scale_offset_buffer;
+	clamp_buffer          = x86_fma_clamp_buffer;
+	rectify_buffer        = x86_fma_rectify_buffer;
+	dot_product           = x86_fma_dot_product;
+	interpolate_buffer    = x86_fma_interpolate_buffer;
 
 	run (align_max, FLT_EPSILON);
 }
@@ -149,6 +304,20 @@ FPUTest::avxTest ()
 	mix_buffers_with_gain = x86_sse_avx_mix_buffers_with_gain;
 	mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 	copy_vector           = x86_sse_avx_copy_vector;
+	apply_gain_ramp       = x86_sse_apply_gain_ramp;
+	mix_buffers_with_ramp = x86_sse_mix_buffers_with_ramp;
+	interleave            = x86_sse_interleave;
+	deinterleave          = x86_sse_deinterleave;
+	float_to_s16          = default_float_to_s16;
+	float_to_s24          = default_float_to_s24;
+	sum_of_squares        = x86_sse_sum_of_squares;
+	subtract_buffers      = x86_sse_subtract_buffers;
+	multiply_add_buffers  = x86_sse_multiply_add_buffers;
+	scale_offset_buffer   = x86_sse_scale_offset_buffer;
+	clamp_buffer          = x86_sse_clamp_buffer;
+	rectify_buffer        = x86_sse_rectify_buffer;
+	dot_product           = x86_sse_dot_product;
+	interpolate_buffer    = default_interpolate_buffer;
 
 	run (align_max);
 }
@@ -176,6 +345,20 @@ FPUTest::avx512fTest ()
 	mix_buffers_with_gain = x86_avx512f_mix_buffers_with_gain;
 	mix_buffers_no_gain   = x86_avx512f_mix_buffers_no_gain;
 	copy_vector           = x86_avx512f_copy_vector;
+	apply_gain_ramp       = x86_avx512f_apply_gain_ramp;
+	mix_buffers_with_ramp = x86_avx512f_mix_buffers_with_ramp;
+	interleave            = x86_avx512f_interleave;
+	deinterleave          = x86_avx512f_deinterleave;
+	float_to_s16          = x86_avx512f_float_to_s16;
+	float_to_s24          = x86_avx512f_float_to_s24;
+	sum_of_squares        = x86_avx512f_sum_of_squares;
+	subtract_buffers      = x86_avx512f_subtract_buffers;
+	multiply_add_buffers  = x86_avx512f_multiply_add_buffers;
+	scale_offset_buffer   = x86_avx512f_scale_offset_buffer;
+	clamp_buffer          = x86_avx512f_clamp_buffer;
+	rectify_buffer        = x86_avx512f_rectify_buffer;
+	dot_product           = x86_avx512f_dot_product;
+	interpolate_buffer    = x86_avx512f_interpolate_buffer;
 
 	run (align_max, FLT_EPSILON);
 }
@@ -203,6 +386,20 @@ FPUTest::sseTest ()
 	mix_buffers_with_gain = x86_sse_mix_buffers_with_gain;
 	mix_buffers_no_gain   = x86_sse_mix_buffers_no_gain;
 	copy_vector           = default_copy_vector;
+	apply_gain_ramp       = x86_sse_apply_gain_ramp;
+	mix_buffers_with_ramp = x86_sse_mix_buffers_with_ramp;
+	interleave            = x86_sse_interleave;
+	deinterleave          = x86_sse_deinterleave;
+	float_to_s16          = default_float_to_s16;
+	float_to_s24          = default_float_to_s24;
+	sum_of_squares        = x86_sse_sum_of_squares;
+	subtract_buffers      = x86_sse_subtract_buffers;
+	multiply_add_buffers  = x86_sse_multiply_add_buffers;
+	scale_offset_buffer   = x86_sse_scale_offset_buffer;
+	clamp_buffer          = x86_sse_clamp_buffer;
+	rectify_buffer        = x86_sse_rectify_buffer;
+	dot_product           = x86_sse_dot_product;
+	interpolate_buffer    = default_interpolate_buffer;
 
 	run (align_max);
 }
@@ -227,6 +424,20 @@ FPUTest::neonTest ()
 	mix_buffers_with_gain = arm_neon_mix_buffers_with_gain;
 	mix_buffers_no_gain   = arm_neon_mix_buffers_no_gain;
 	copy_vector           = arm_neon_copy_vector;
+	apply_gain_ramp       = arm_neon_apply_gain_ramp;
+	mix_buffers_with_ramp = arm_neon_mix_buffers_with_ramp;
+	interleave            = arm_neon_interleave;
+	deinterleave          = arm_neon_deinterleave;
+	float_to_s16          = arm_neon_float_to_s16;
+	float_to_s24          = arm_neon_float_to_s24;
+	sum_of_squares        = arm_neon_sum_of_squares;
+	subtract_buffers      = arm_neon_subtract_buffers;
+	multiply_add_buffers  = arm_neon_multiply_add_buffers;
+	scale_offset_buffer   = arm_neon_scale_offset_buffer;
+	clamp_buffer          = arm_neon_clamp_buffer;
+	rectify_buffer        = arm_neon_rectify_buffer;
+	dot_product           = arm_neon_dot_product;
+	interpolate_buffer    = default_interpolate_buffer;
 
 	run (128);
 }
@@ -251,6 +462,20 @@ FPUTest::veclibTest ()
 	mix_buffers_with_gain = veclib_mix_buffers_with_gain;
 	mix_buffers_no_gain   = veclib_mix_buffers_no_gain;
 	copy_vector           = default_copy_vector;
+	apply_gain_ramp       = default_apply_gain_ramp;
+	mix_buffers_with_ramp = default_mix_buffers_with_ramp;
+	interleave            = default_interleave;
+	deinterleave          = default_deinterleave;
+	float_to_s16          = default_float_to_s16;
+	float_to_s24          = default_float_to_s24;
+	sum_of_squares        = default_sum_of_squares;
+	subtract_buffers      = default_subtract_buffers;
+	multiply_add_buffers  = default_multiply_add_buffers;
+	scale_offset_buffer   = default_scale_offset_buffer;
+	clamp_buffer          = default_clamp_buffer;
+	rectify_buffer        = default_rectify_buffer;
+	dot_product           = default_dot_product;
+	interpolate_buffer    = default_interpolate_buffer;
 
 #ifdef  __aarch64__
 	run (16, FLT_EPSILON);
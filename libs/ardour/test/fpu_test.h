@@ -39,6 +39,7 @@ public:
 
 private:
 	void run (size_t, float const max_diff = 0);
+	void run_extended (size_t, float const max_diff = 0);
 	void compare (std::string, size_t, float const max_diff = 0);
 
 	ARDOUR::compute_peak_t          compute_peak;
@@ -47,6 +48,20 @@ private:
 	ARDOUR::mix_buffers_with_gain_t mix_buffers_with_gain;
 	ARDOUR::mix_buffers_no_gain_t   mix_buffers_no_gain;
 	ARDOUR::copy_vector_t           copy_vector;
+	ARDOUR::apply_gain_ramp_t       apply_gain_ramp;
+	ARDOUR::mix_buffers_with_ramp_t mix_buffers_with_ramp;
+	ARDOUR::interleave_t            interleave;
+	ARDOUR::deinterleave_t          deinterleave;
+	ARDOUR::float_to_s16_t          float_to_s16;
+	ARDOUR::float_to_s24_t          float_to_s24;
+	ARDOUR::sum_of_squares_t        sum_of_squares;
+	ARDOUR::subtract_buffers_t      subtract_buffers;
+	ARDOUR::multiply_add_buffers_t  multiply_add_buffers;
+	ARDOUR::scale_offset_buffer_t   scale_offset_buffer;
+	ARDOUR::clamp_buffer_t          clamp_buffer;
+	ARDOUR::rectify_buffer_t        rectify_buffer;
+	ARDOUR::dot_product_t           dot_product;
+	ARDOUR::interpolate_buffer_t    interpolate_buffer;
 
 	size_t _size;
 
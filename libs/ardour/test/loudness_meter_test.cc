@@ -0,0 +1,121 @@
+#include <cmath>
+#include <vector>
+
+#include "pbd/compose.h"
+
+#include "ardour/loudnessmeterdsp.h"
+
+#include "loudness_meter_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (LoudnessMeterTest);
+
+/* Reference signals and tolerances, see EBU Tech 3341 (ITU-R BS.1770) */
+
+static void
+run_sine (Loudnessmeterdsp& m, float rate, uint32_t n_channels, uint32_t active_chn, float freq, float dBFS, float phase, float seconds, uint32_t block_size = 1024)
+{
+	const float amp = powf (10.f, .05f * dBFS);
+
+	std::vector<std::vector<float> > buf (n_channels, std::vector<float> (block_size, 0.f));
+	std::vector<float const*>        data (n_channels);
+	for (uint32_t c = 0; c < n_channels; ++c) {
+		data[c] = &buf[c][0];
+	}
+
+	uint32_t t = 0;
+	for (uint32_t remain = seconds * rate; remain > 0;) {
+		const uint32_t n = std::min (remain, block_size);
+		for (uint32_t i = 0; i < n; ++i, ++t) {
+			const float s = amp * sin (2. * M_PI * freq * t / rate + phase);
+			for (uint32_t c = 0; c < n_channels; ++c) {
+				buf[c][i] = (active_chn & (1 << c)) ? s : 0.f;
+			}
+		}
+		m.process (&data[0], n_channels, n);
+		remain -= n;
+	}
+}
+
+void
+LoudnessMeterTest::stereoSineTest ()
+{
+	/* Tech 3341, case 1 and 2: stereo 1kHz sine, -23 and -33 dBFS */
+	const float rates[] = { 44100, 48000, 96000 };
+	for (auto const& rate : rates) {
+		Loudnessmeterdsp m (rate, 2);
+		run_sine (m, rate, 2, 3, 1000, -23, 0, 4);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE (string_compose ("M @ %1", rate), -23.0, m.momentary (), 0.1);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE (string_compose ("S @ %1", rate), -23.0, m.short_term (), 0.1);
+
+		m.reset ();
+		run_sine (m, rate, 2, 3, 1000, -33, 0, 4);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE (string_compose ("M @ %1", rate), -33.0, m.momentary (), 0.1);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE (string_compose ("S @ %1", rate), -33.0, m.short_term (), 0.1);
+	}
+}
+
+void
+LoudnessMeterTest::monoSineTest ()
+{
+	/* mono is measured as dual-mono */
+	Loudnessmeterdsp m (48000, 1);
+	run_sine (m, 48000, 1, 1, 1000, -23, 0, 1);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.0, m.momentary (), 0.1);
+}
+
+void
+LoudnessMeterTest::surroundWeightTest ()
+{
+	/* single front channel: -23 dBFS sine is -26 LUFS */
+	Loudnessmeterdsp m (48000, 5);
+	run_sine (m, 48000, 5, 1 << 2, 1000, -23, 0, 1);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (-26.0, m.momentary (), 0.1);
+
+	/* surround channels are weighted +1.5dB */
+	m.reset ();
+	run_sine (m, 48000, 5, 1 << 4, 1000, -23, 0, 1);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (-24.5, m.momentary (), 0.1);
+
+	/* silence */
+	m.reset ();
+	run_sine (m, 48000, 5, 0, 1000, -23, 0, 1);
+	CPPUNIT_ASSERT (m.momentary () < -70);
+}
+
+void
+LoudnessMeterTest::truePeakTest ()
+{
+	/* Tech 3341, case 15-19 style: inter-sample peaks of a fs/4 sine
+	 * with 45 deg phase-offset. Sample-peak is 3dB lower than true-peak.
+	 * Tolerance is +0.2 / -0.4 dB.
+	 */
+	const float rates[] = { 44100, 48000, 96000 };
+	for (auto const& rate : rates) {
+		Loudnessmeterdsp m (rate, 2);
+		run_sine (m, rate, 2, 1, rate / 4, -6, M_PI / 4, .5);
+		const float tp = 20.f * log10f (m.read_true_peak (0));
+		CPPUNIT_ASSERT_MESSAGE (string_compose ("TP @ %1: %2", rate, tp), tp < -6.0 + 0.2 && tp > -6.0 - 0.4);
+		CPPUNIT_ASSERT_EQUAL (0.f, m.read_true_peak (1));
+
+		/* values are reset after reading */
+		m.reset ();
+		run_sine (m, rate, 2, 2, 1000, -23, 0, .5);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.0, 20.f * log10f (m.read_true_peak (1)), 0.1);
+		run_sine (m, rate, 2, 0, 1000, -23, 0, .1);
+		m.read_true_peak (1); // interpolator history
+		run_sine (m, rate, 2, 0, 1000, -23, 0, .1);
+		CPPUNIT_ASSERT (m.read_true_peak (1) < 1e-6);
+	}
+}
+
+void
+LoudnessMeterTest::blockSizeTest ()
+{
+	Loudnessmeterdsp a (48000, 2);
+	Loudnessmeterdsp b (48000, 2);
+	run_sine (a, 48000, 2, 3, 997, -18, 0, 3.5, 4096);
+	run_sine (b, 48000, 2, 3, 997, -18, 0, 3.5, 37);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (a.momentary (), b.momentary (), 1e-3);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (a.short_term (), b.short_term (), 1e-3);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (a.read_true_peak (0), b.read_true_peak (0), 1e-6);
+}
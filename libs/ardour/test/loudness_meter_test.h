@@ -0,0 +1,23 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class LoudnessMeterTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (LoudnessMeterTest);
+	CPPUNIT_TEST (stereoSineTest);
+	CPPUNIT_TEST (monoSineTest);
+	CPPUNIT_TEST (surroundWeightTest);
+	CPPUNIT_TEST (truePeakTest);
+	CPPUNIT_TEST (blockSizeTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp () {}
+	void tearDown () {}
+
+	void stereoSineTest ();
+	void monoSineTest ();
+	void surroundWeightTest ();
+	void truePeakTest ();
+	void blockSizeTest ();
+};
@@ -0,0 +1,156 @@
+#include <vector>
+
+#include "ardour/midi_buffer.h"
+
+#include "midi_buffer_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MidiBufferTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+static void
+push (MidiBuffer& mb, samplepos_t t, uint8_t status, uint8_t d1 = 64, uint8_t d2 = 100)
+{
+	const uint8_t msg[3] = { status, d1, d2 };
+	CPPUNIT_ASSERT (mb.push_back (t, Evoral::LIVE_MIDI_EVENT, Evoral::midi_event_size (status), msg));
+}
+
+static vector<pair<samplepos_t, uint8_t> >
+events (MidiBuffer const& mb)
+{
+	vector<pair<samplepos_t, uint8_t> > rv;
+	for (MidiBuffer::const_iterator i = mb.begin (); i != mb.end (); ++i) {
+		rv.push_back (make_pair ((*i).time (), (*i).buffer ()[0]));
+	}
+	return rv;
+}
+
+void
+MidiBufferTest::mergeTest ()
+{
+	MidiBuffer dst (1024);
+	MidiBuffer a (1024);
+	MidiBuffer b (1024);
+	MidiBuffer empty (1024);
+
+	push (dst, 5, 0x90);
+	push (dst, 50, 0x80);
+	push (a, 0, 0x91);
+	push (a, 20, 0x81);
+	push (a, 60, 0x91);
+	push (b, 10, 0xb2);
+	push (b, 55, 0xb2);
+
+	MidiBuffer const* src[] = { &a, &empty, &b };
+	CPPUNIT_ASSERT (dst.merge_in_place (src, 3));
+
+	vector<pair<samplepos_t, uint8_t> > ev = events (dst);
+	CPPUNIT_ASSERT_EQUAL (size_t (7), ev.size ());
+
+	const samplepos_t times[]  = { 0, 5, 10, 20, 50, 55, 60 };
+	const uint8_t     status[] = { 0x91, 0x90, 0xb2, 0x81, 0x80, 0xb2, 0x91 };
+	for (size_t i = 0; i < ev.size (); ++i) {
+		CPPUNIT_ASSERT_EQUAL (times[i], ev[i].first);
+		CPPUNIT_ASSERT_EQUAL (status[i], ev[i].second);
+	}
+
+	/* sources are not modified */
+	CPPUNIT_ASSERT_EQUAL (size_t (3), events (a).size ());
+	CPPUNIT_ASSERT_EQUAL (size_t (2), events (b).size ());
+
+	/* merging into an empty buffer */
+	MidiBuffer dst2 (1024);
+	CPPUNIT_ASSERT (dst2.merge_in_place (src, 3));
+	CPPUNIT_ASSERT_EQUAL (size_t (5), events (dst2).size ());
+	CPPUNIT_ASSERT_EQUAL (samplepos_t (0), events (dst2).front ().first);
+	CPPUNIT_ASSERT_EQUAL (samplepos_t (60), events (dst2).back ().first);
+}
+
+void
+MidiBufferTest::mergeManyTest ()
+{
+	/* more sources than merged in a single pass */
+	const size_t n_src = MidiBuffer::max_merge_sources * 2 + 3;
+
+	vector<MidiBuffer*>       buffers;
+	vector<MidiBuffer const*> src;
+
+	for (size_t i = 0; i < n_src; ++i) {
+		buffers.push_back (new MidiBuffer (256));
+		push (*buffers.back (), i, 0xb0 | (i % 16), i % 128);
+		push (*buffers.back (), 1000 - i, 0xb0 | (i % 16), i % 128);
+		src.push_back (buffers.back ());
+	}
+
+	MidiBuffer dst (n_src * 64);
+	push (dst, 500, 0xf8);
+	CPPUNIT_ASSERT (dst.merge_in_place (&src[0], src.size ()));
+
+	vector<pair<samplepos_t, uint8_t> > ev = events (dst);
+	CPPUNIT_ASSERT_EQUAL (2 * n_src + 1, ev.size ());
+	for (size_t i = 1; i < ev.size (); ++i) {
+		CPPUNIT_ASSERT (ev[i - 1].first <= ev[i].first);
+	}
+	CPPUNIT_ASSERT_EQUAL (uint8_t (0xf8), ev[n_src].second);
+
+	for (auto const& mb : buffers) {
+		delete mb;
+	}
+}
+
+void
+MidiBufferTest::simultaneousTest ()
+{
+	MidiBuffer dst (1024);
+	MidiBuffer a (1024);
+	MidiBuffer b (1024);
+
+	/* same channel: CC, program change, note-off, note-on, pressure, bender */
+	push (dst, 10, 0x90);
+	push (a, 10, 0xe0);
+	push (a, 20, 0x90);
+	push (b, 10, 0x80);
+	push (b, 10, 0xb0);
+	push (b, 20, 0xc0, 1);
+
+	MidiBuffer const* src[] = { &a, &b };
+	CPPUNIT_ASSERT (dst.merge_in_place (src, 2));
+
+	vector<pair<samplepos_t, uint8_t> > ev = events (dst);
+	CPPUNIT_ASSERT_EQUAL (size_t (6), ev.size ());
+
+	const uint8_t status[] = { 0x80, 0xb0, 0x90, 0xe0, 0xc0, 0x90 };
+	for (size_t i = 0; i < ev.size (); ++i) {
+		CPPUNIT_ASSERT_EQUAL (status[i], ev[i].second);
+	}
+
+	/* result matches pair-wise merge */
+	MidiBuffer pw (1024);
+	push (pw, 10, 0x90);
+	CPPUNIT_ASSERT (pw.merge_in_place (a));
+	CPPUNIT_ASSERT (pw.merge_in_place (b));
+	CPPUNIT_ASSERT (ev == events (pw));
+}
+
+void
+MidiBufferTest::capacityTest ()
+{
+	MidiBuffer dst (64);
+	MidiBuffer a (64);
+	MidiBuffer b (64);
+
+	push (dst, 0, 0x90);
+	push (a, 1, 0x90);
+	push (a, 2, 0x90);
+	push (b, 3, 0x90);
+	push (b, 4, 0x90);
+
+	MidiBuffer const* src[] = { &a, &b };
+	CPPUNIT_ASSERT (!dst.merge_in_place (src, 2));
+
+	/* buffer is unmodified */
+	vector<pair<samplepos_t, uint8_t> > ev = events (dst);
+	CPPUNIT_ASSERT_EQUAL (size_t (1), ev.size ());
+	CPPUNIT_ASSERT_EQUAL (samplepos_t (0), ev[0].first);
+}
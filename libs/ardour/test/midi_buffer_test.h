@@ -0,0 +1,21 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class MidiBufferTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (MidiBufferTest);
+	CPPUNIT_TEST (mergeTest);
+	CPPUNIT_TEST (mergeManyTest);
+	CPPUNIT_TEST (simultaneousTest);
+	CPPUNIT_TEST (capacityTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp () {}
+	void tearDown () {}
+
+	void mergeTest ();
+	void mergeManyTest ();
+	void simultaneousTest ();
+	void capacityTest ();
+};
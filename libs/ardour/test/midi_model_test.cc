@@ -0,0 +1,204 @@
+#include <iostream>
+
+#include <glib.h>
+#include <glibmm/miscutils.h>
+
+#include "pbd/xml++.h"
+
+#include "ardour/midi_source.h"
+#include "ardour/session.h"
+#include "ardour/source_factory.h"
+
+#include "midi_model_test.h"
+#include "test_util.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MidiModelTest);
+
+using namespace std;
+using namespace ARDOUR;
+using Temporal::Beats;
+
+typedef MidiModel::NoteDiffCommand NoteDiffCommand;
+typedef Evoral::Sequence<Beats>::NotePtr NotePtr;
+
+static const int64_t spacing = 480;
+static const int64_t length  = 240;
+
+void
+MidiModelTest::setUp ()
+{
+	TestNeedingSession::setUp ();
+
+	std::string const path = Glib::build_filename (new_test_output_dir ("midi_model"), "test.mid");
+	_source = std::dynamic_pointer_cast<MidiSource> (SourceFactory::createWritable (DataType::MIDI, *_session, path, get_test_sample_rate ()));
+	CPPUNIT_ASSERT (_source);
+	_model = _source->model ();
+	CPPUNIT_ASSERT (_model);
+}
+
+void
+MidiModelTest::tearDown ()
+{
+	_model.reset ();
+	_source.reset ();
+	TestNeedingSession::tearDown ();
+}
+
+/* notes with the same number do not overlap, also when shifted by less than spacing */
+void
+MidiModelTest::add_notes (int n)
+{
+	NoteDiffCommand* cmd = _model->new_note_diff_command ("add");
+	for (int i = 0; i < n; ++i) {
+		cmd->add (NotePtr (new Evoral::Note<Beats> (i % 16, Beats::ticks (i * spacing), Beats::ticks (length), 36 + i % 64, 100)));
+	}
+	_model->apply_diff_command_only (cmd);
+	delete cmd;
+}
+
+/** Move the first n notes, and make them longer, like quantizing does */
+NoteDiffCommand*
+MidiModelTest::shift_notes (int n, int64_t ticks)
+{
+	NoteDiffCommand* cmd = _model->new_note_diff_command ("shift");
+	int i = 0;
+	for (MidiModel::Notes::const_iterator note = _model->notes().begin(); note != _model->notes().end() && i < n; ++note, ++i) {
+		cmd->change (*note, NoteDiffCommand::StartTime, (*note)->time() + Beats::ticks (ticks));
+		cmd->change (*note, NoteDiffCommand::Length, (*note)->length() + Beats::ticks (ticks));
+	}
+	return cmd;
+}
+
+/** @return true if the first n notes are shifted by offset, the others are not,
+ * and the notes are sorted
+ */
+bool
+MidiModelTest::check_notes (int n, int64_t offset) const
+{
+	std::vector<int64_t> times;
+	for (MidiModel::Notes::const_iterator note = _model->notes().begin(); note != _model->notes().end(); ++note) {
+		int64_t const t = (*note)->time().to_ticks();
+		int64_t const i = t / spacing;
+		if (!times.empty() && t < times.back()) {
+			return false;
+		}
+		if (t != i * spacing + (i < n ? offset : 0) || (*note)->length().to_ticks() != length + (i < n ? offset : 0)) {
+			return false;
+		}
+		times.push_back (t);
+	}
+	return true;
+}
+
+/* a few changes, which move each note in the model */
+void
+MidiModelTest::changeTest ()
+{
+	add_notes (1000);
+
+	NoteDiffCommand* cmd = shift_notes (10, 7);
+	_model->apply_diff_command_only (cmd);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 1000, _model->notes().size());
+	CPPUNIT_ASSERT (check_notes (10, 7));
+
+	cmd->undo ();
+	CPPUNIT_ASSERT_EQUAL ((size_t) 1000, _model->notes().size());
+	CPPUNIT_ASSERT (check_notes (0, 0));
+	delete cmd;
+}
+
+/* changes of all notes, which sort the model once */
+void
+MidiModelTest::batchTest ()
+{
+	add_notes (1000);
+
+	Evoral::Sequence<Beats>::Notes n;
+	_model->get_notes (n, Evoral::Sequence<Beats>::PitchEqual, 40, 0);
+	size_t const n_pitch = n.size();
+
+	NoteDiffCommand* cmd = shift_notes (1000, 7);
+	_model->apply_diff_command_only (cmd);
+	CPPUNIT_ASSERT (check_notes (1000, 7));
+
+	n.clear ();
+	_model->get_notes (n, Evoral::Sequence<Beats>::PitchEqual, 40, 0);
+	CPPUNIT_ASSERT_EQUAL (n_pitch, n.size());
+
+	/* a note can be removed after the model was sorted */
+	NotePtr last = *_model->notes().rbegin();
+	_model->remove_note_unlocked (last);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 999, _model->notes().size());
+	_model->add_note_unlocked (last);
+
+	cmd->undo ();
+	CPPUNIT_ASSERT (check_notes (0, 0));
+
+	(*cmd) ();
+	CPPUNIT_ASSERT (check_notes (1000, 7));
+	delete cmd;
+}
+
+/* changes restored from the history apply to the same notes */
+void
+MidiModelTest::stateTest ()
+{
+	add_notes (100);
+
+	NoteDiffCommand* cmd = shift_notes (100, 7);
+	XMLNode& state (cmd->get_state ());
+	delete cmd;
+
+	NoteDiffCommand restored (_model, state);
+	delete &state;
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) 200, restored.changes().size());
+	restored ();
+	CPPUNIT_ASSERT (check_notes (100, 7));
+	restored.undo ();
+	CPPUNIT_ASSERT (check_notes (0, 0));
+}
+
+void
+MidiModelTest::editBenchmark ()
+{
+	int const n_notes = 100000;
+
+	gint64 start = g_get_monotonic_time ();
+	add_notes (n_notes);
+	gint64 const add_usec = g_get_monotonic_time () - start;
+
+	/* each note is removed and added again */
+	_session->config.set_insert_merge_policy (InsertMergeReplace);
+
+	NoteDiffCommand* cmd = shift_notes (n_notes, 7);
+	start = g_get_monotonic_time ();
+	_model->apply_diff_command_only (cmd);
+	gint64 const single_usec = g_get_monotonic_time () - start;
+	CPPUNIT_ASSERT (check_notes (n_notes, 7));
+
+	start = g_get_monotonic_time ();
+	cmd->undo ();
+	gint64 const single_undo_usec = g_get_monotonic_time () - start;
+	CPPUNIT_ASSERT (check_notes (0, 0));
+
+	/* the model is sorted once */
+	_session->config.set_insert_merge_policy (InsertMergeRelax);
+
+	start = g_get_monotonic_time ();
+	(*cmd) ();
+	gint64 const batch_usec = g_get_monotonic_time () - start;
+	CPPUNIT_ASSERT (check_notes (n_notes, 7));
+
+	start = g_get_monotonic_time ();
+	cmd->undo ();
+	gint64 const batch_undo_usec = g_get_monotonic_time () - start;
+	CPPUNIT_ASSERT (check_notes (0, 0));
+
+	delete cmd;
+
+	std::cerr << std::endl
+	          << n_notes << " notes: add " << add_usec / 1000 << " ms" << std::endl
+	          << "  change each note: apply " << single_usec / 1000 << " ms, undo " << single_undo_usec / 1000 << " ms" << std::endl
+	          << "  change all notes: apply " << batch_usec / 1000 << " ms, undo " << batch_undo_usec / 1000 << " ms" << std::endl;
+}
@@ -0,0 +1,36 @@
+#include <memory>
+
+#include "ardour/midi_model.h"
+
+#include "test_needing_session.h"
+
+namespace ARDOUR {
+	class MidiSource;
+}
+
+class MidiModelTest : public TestNeedingSession
+{
+	CPPUNIT_TEST_SUITE (MidiModelTest);
+	CPPUNIT_TEST (changeTest);
+	CPPUNIT_TEST (batchTest);
+	CPPUNIT_TEST (stateTest);
+	CPPUNIT_TEST (editBenchmark);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp ();
+	void tearDown ();
+
+	void changeTest ();
+	void batchTest ();
+	void stateTest ();
+	void editBenchmark ();
+
+private:
+	void add_notes (int n);
+	ARDOUR::MidiModel::NoteDiffCommand* shift_notes (int n, int64_t ticks);
+	bool check_notes (int n, int64_t offset) const;
+
+	std::shared_ptr<ARDOUR::MidiSource> _source;
+	std::shared_ptr<ARDOUR::MidiModel>  _model;
+};
@@ -0,0 +1,95 @@
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "pbd/microseconds.h"
+
+#include "ardour/ardour.h"
+#include "ardour/dsp_filter.h"
+#include "ardour/mix.h"
+#include "ardour/runtime_functions.h"
+
+using namespace ARDOUR;
+
+static const char* localedir = LOCALEDIR;
+
+/* Compare processing many channels with one DSP::Biquad per channel
+ * to DSP::MultiBiquad (generic and H/W optimized kernel).
+ *
+ * usage: biquad [n_channels [n_stages [n_cycles]]]
+ */
+int
+main (int argc, char* argv[])
+{
+	const uint32_t n_channels = argc > 1 ? atoi (argv[1]) : 64;
+	const uint32_t n_stages   = argc > 2 ? atoi (argv[2]) : 4;
+	const uint32_t n_cycles   = argc > 3 ? atoi (argv[3]) : 2000;
+	const uint32_t n_samples  = 1024;
+	const double   rate       = 48000;
+
+	if (n_channels < 1 || n_stages < 1 || n_cycles < 1) {
+		fprintf (stderr, "usage: %s [n_channels [n_stages [n_cycles]]]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	ARDOUR::init (true, localedir);
+
+	std::vector<std::vector<float> > data (n_channels, std::vector<float> (n_samples));
+	std::vector<float*>              ptr (n_channels);
+	std::vector<float>               interleaved (n_channels * n_samples);
+	std::vector<DSP::Biquad>         filters;
+
+	DSP::MultiBiquad mb (rate, n_channels, n_stages);
+
+	for (uint32_t c = 0; c < n_channels; ++c) {
+		for (uint32_t i = 0; i < n_samples; ++i) {
+			data[c][i] = interleaved[i * n_channels + c] = (rand () / (float) RAND_MAX) - .5f;
+		}
+		ptr[c] = &data[c][0];
+		for (uint32_t s = 0; s < n_stages; ++s) {
+			filters.push_back (DSP::Biquad (rate));
+			filters.back ().compute (DSP::Biquad::Peaking, 100. * (s + 1) + 10 * c, .7, 3);
+			mb.configure (c, s, filters.back ());
+		}
+	}
+
+	/* per channel Biquad */
+	PBD::microseconds_t t0 = PBD::get_microseconds ();
+	for (uint32_t n = 0; n < n_cycles; ++n) {
+		for (uint32_t c = 0; c < n_channels; ++c) {
+			for (uint32_t s = 0; s < n_stages; ++s) {
+				filters[c * n_stages + s].run (ptr[c], n_samples);
+			}
+		}
+	}
+	PBD::microseconds_t t1 = PBD::get_microseconds ();
+
+	/* MultiBiquad, non-interleaved */
+	for (uint32_t n = 0; n < n_cycles; ++n) {
+		mb.run (&ptr[0], n_samples);
+	}
+	PBD::microseconds_t t2 = PBD::get_microseconds ();
+
+	/* MultiBiquad, interleaved */
+	for (uint32_t n = 0; n < n_cycles; ++n) {
+		mb.run_interleaved (&interleaved[0], n_samples);
+	}
+	PBD::microseconds_t t3 = PBD::get_microseconds ();
+
+	/* generic kernel, interleaved */
+	biquad_cascade = default_biquad_cascade;
+	for (uint32_t n = 0; n < n_cycles; ++n) {
+		mb.run_interleaved (&interleaved[0], n_samples);
+	}
+	PBD::microseconds_t t4 = PBD::get_microseconds ();
+
+	const double per_cycle = 1.0 / n_cycles;
+	printf ("%u channels, %u stages, %u samples/cycle\n", n_channels, n_stages, n_samples);
+	printf ("Biquad per channel:        %8.2f us/cycle\n", (t1 - t0) * per_cycle);
+	printf ("MultiBiquad:               %8.2f us/cycle\n", (t2 - t1) * per_cycle);
+	printf ("MultiBiquad (interleaved): %8.2f us/cycle\n", (t3 - t2) * per_cycle);
+	printf ("MultiBiquad (generic):     %8.2f us/cycle\n", (t4 - t3) * per_cycle);
+
+	ARDOUR::cleanup ();
+	return 0;
+}
@@ -0,0 +1,167 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <rubberband/RubberBandStretcher.h>
+
+#include "pbd/microseconds.h"
+
+#include "ardour/ardour.h"
+#include "ardour/runtime_functions.h"
+
+using namespace ARDOUR;
+using namespace RubberBand;
+
+static const char* localedir = LOCALEDIR;
+
+static const uint32_t n_samples    = 1024; /* per process cycle */
+static const uint32_t rb_blocksize = 1024; /* as used by AudioTrigger */
+
+/* Compare the process-thread cost of playing a tempo-synced audio clip
+ * with a realtime stretcher (as AudioTrigger does by default), with
+ * playing data that was stretched offline in the background
+ * (prestretch-clips), and show the cost of rendering it.
+ *
+ * usage: clip_stretch [seconds [ratio [n_channels]]]
+ */
+int
+main (int argc, char* argv[])
+{
+	const double   seconds = argc > 1 ? atof (argv[1]) : 8;
+	const double   ratio   = argc > 2 ? atof (argv[2]) : 1.1;
+	const uint32_t nchans  = argc > 3 ? atoi (argv[3]) : 2;
+	const uint32_t sr      = 48000;
+
+	if (seconds <= 0 || ratio <= 0 || nchans < 1) {
+		fprintf (stderr, "usage: %s [seconds [ratio [n_channels]]]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	ARDOUR::init (true, localedir);
+
+	const samplecnt_t len     = seconds * sr;
+	const samplecnt_t out_len = ceil (len * ratio);
+
+	/* a few partials with some noise, and a click each beat */
+	std::vector<std::vector<Sample> > data (nchans, std::vector<Sample> (len));
+	for (uint32_t c = 0; c < nchans; ++c) {
+		for (samplecnt_t i = 0; i < len; ++i) {
+			data[c][i] = .2f * sinf (2 * M_PI * 220 * i / sr) + .1f * sinf (2 * M_PI * (330 + 10 * c) * i / sr) + .05f * (rand () / (float) RAND_MAX - .5f);
+			if (i % (sr / 2) < 64) {
+				data[c][i] += .5f;
+			}
+		}
+	}
+
+	std::vector<std::vector<Sample> > out (nchans, std::vector<Sample> (std::max<samplecnt_t> (out_len + 65536, n_samples)));
+	std::vector<std::vector<Sample> > mix (nchans, std::vector<Sample> (n_samples));
+
+	std::vector<float const*> in (nchans);
+	std::vector<float*>       outp (nchans);
+
+	/* realtime stretcher, fed and drained like AudioTrigger::audio_run () */
+
+	RubberBandStretcher rt (sr, nchans, RubberBandStretcher::Option (RubberBandStretcher::OptionProcessRealTime | RubberBandStretcher::OptionTransientsCrisp), ratio, 1.0);
+	rt.setMaxProcessSize (rb_blocksize);
+
+	samplecnt_t         read_index = 0;
+	uint32_t            cycles     = 0;
+	PBD::microseconds_t worst      = 0;
+
+	PBD::microseconds_t t0 = PBD::get_microseconds ();
+
+	while (read_index < len) {
+		PBD::microseconds_t c0 = PBD::get_microseconds ();
+		while (rt.available () < (int) n_samples && read_index < len) {
+			const samplecnt_t n = std::min<samplecnt_t> (rb_blocksize, len - read_index);
+			for (uint32_t c = 0; c < nchans; ++c) {
+				in[c] = &data[c][read_index];
+			}
+			rt.process (&in[0], n, read_index + n >= len);
+			read_index += n;
+		}
+		for (uint32_t c = 0; c < nchans; ++c) {
+			outp[c] = &out[c][0];
+		}
+		rt.retrieve (&outp[0], std::min<int> (n_samples, std::max (0, rt.available ())));
+		for (uint32_t c = 0; c < nchans; ++c) {
+			mix_buffers_no_gain (&mix[c][0], &out[c][0], n_samples);
+		}
+		worst = std::max (worst, PBD::get_microseconds () - c0);
+		++cycles;
+	}
+
+	PBD::microseconds_t t1 = PBD::get_microseconds ();
+
+	const double rt_avg   = (t1 - t0) / (double) cycles;
+	const double rt_worst = worst;
+
+	/* offline render, as done by the TriggerBoxThread */
+
+	RubberBandStretcher off (sr, nchans, RubberBandStretcher::Option (RubberBandStretcher::OptionProcessOffline | RubberBandStretcher::OptionTransientsCrisp), ratio, 1.0);
+	off.setExpectedInputDuration (len);
+	off.setMaxProcessSize (16384);
+
+	t0 = PBD::get_microseconds ();
+
+	for (samplecnt_t pos = 0; pos < len; pos += 16384) {
+		const samplecnt_t n = std::min<samplecnt_t> (16384, len - pos);
+		for (uint32_t c = 0; c < nchans; ++c) {
+			in[c] = &data[c][pos];
+		}
+		off.study (&in[0], n, pos + n >= len);
+	}
+
+	samplecnt_t rendered = 0;
+
+	for (samplecnt_t pos = 0; pos < len; pos += 16384) {
+		const samplecnt_t n = std::min<samplecnt_t> (16384, len - pos);
+		for (uint32_t c = 0; c < nchans; ++c) {
+			in[c] = &data[c][pos];
+		}
+		off.process (&in[0], n, pos + n >= len);
+		int avail;
+		while ((avail = off.available ()) > 0) {
+			avail = std::min<samplecnt_t> (avail, out[0].size () - rendered);
+			for (uint32_t c = 0; c < nchans; ++c) {
+				outp[c] = &out[c][rendered];
+			}
+			off.retrieve (&outp[0], avail);
+			rendered += avail;
+		}
+	}
+
+	t1 = PBD::get_microseconds ();
+
+	const double render_ms = (t1 - t0) / 1000.;
+
+	/* playing the pre-stretched data */
+
+	worst  = 0;
+	cycles = 0;
+	t0 = PBD::get_microseconds ();
+
+	for (samplecnt_t pos = 0; pos + n_samples <= rendered; pos += n_samples) {
+		PBD::microseconds_t c0 = PBD::get_microseconds ();
+		for (uint32_t c = 0; c < nchans; ++c) {
+			mix_buffers_no_gain (&mix[c][0], &out[c][pos], n_samples);
+		}
+		worst = std::max (worst, PBD::get_microseconds () - c0);
+		++cycles;
+	}
+
+	t1 = PBD::get_microseconds ();
+
+	const double pre_avg   = cycles ? (t1 - t0) / (double) cycles : 0;
+	const double pre_worst = worst;
+	const double period    = 1e6 * n_samples / sr;
+
+	printf ("%.1f sec, %u channel(s), ratio %.3f, %u samples/cycle (%.0f us)\n", seconds, nchans, ratio, n_samples, period);
+	printf ("realtime stretch: %8.2f us/cycle avg (%5.2f%% DSP), %8.2f us worst\n", rt_avg, 100. * rt_avg / period, rt_worst);
+	printf ("pre-stretched:    %8.2f us/cycle avg (%5.2f%% DSP), %8.2f us worst\n", pre_avg, 100. * pre_avg / period, pre_worst);
+	printf ("offline render:   %8.1f ms in the background (%.2fx realtime)\n", render_ms, render_ms / (1000. * seconds * ratio));
+
+	ARDOUR::cleanup ();
+	return 0;
+}
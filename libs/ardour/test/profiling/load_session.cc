@@ -4,6 +4,8 @@
 #include "ardour/ardour.h"
 #include "ardour/audioengine.h"
 #include "ardour/session.h"
+#include "ardour/uri_map.h"
+#include "pbd/microseconds.h"
 #include <iostream>
 #include <cstdlib>
 
@@ -25,6 +27,8 @@ int main (int argc, char* argv[])
 
 	Session* s = 0;
 
+	PBD::microseconds_t t0 = PBD::get_microseconds ();
+
 	try {
 		s = load_session (argv[1], argv[2]);
 	} catch (failed_constructor& e) {
@@ -41,6 +45,10 @@ int main (int argc, char* argv[])
 		exit (EXIT_FAILURE);
 	}
 
+	cout << "Loaded session in " << (PBD::get_microseconds () - t0) / 1000.0 << " ms\n";
+	cout << "URIMap: " << URIMap::instance ().size () << " URIs, "
+	     << URIMap::instance ().n_contended () << " contended inserts\n";
+
 	AudioEngine::instance()->remove_session ();
 	delete s;
 	AudioEngine::instance()->stop ();
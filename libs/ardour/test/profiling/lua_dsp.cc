@@ -0,0 +1,162 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "pbd/microseconds.h"
+
+#include "lua/luastate.h"
+#include "LuaBridge/LuaBridge.h"
+
+#include "ardour/ardour.h"
+#include "ardour/luabindings.h"
+
+using namespace ARDOUR;
+
+static const char* localedir = LOCALEDIR;
+
+/* Each benchmark is implemented twice: a per-sample loop in Lua, as
+ * commonly found in scripted DSP, and using ARDOUR.DSP vector functions.
+ */
+static const char* script =
+	"local n = 1024\n"
+	"local shm = ARDOUR.DSP.DspShm (4 * n)\n"
+	"local x, y, e, c = shm:to_float (0), shm:to_float (n), shm:to_float (2 * n), shm:to_float (3 * n)\n"
+	"local xa, ya, ea, ca = x:array (), y:array (), e:array (), c:array ()\n"
+	"for i = 1, n do xa[i] = math.sin (i * .01) ya[i] = math.cos (i * .02) ca[i] = 1 / i end\n"
+	"\n"
+	"local env = ARDOUR.DSP.EnvelopeFollower (48000, 10, 100)\n"
+	"local fir = ARDOUR.DSP.FIRFilter (16)\n"
+	"fir:set_coefficients (c, 16)\n"
+	"local att, rel, z = 1 - math.exp (-1000 / (10 * 48000)), 1 - math.exp (-1000 / (100 * 48000)), 0\n"
+	"local hist, hpos = {}, 0\n"
+	"for i = 1, 16 do hist[i] = 0 end\n"
+	"\n"
+	"function lua_amp ()\n"
+	"  for i = 1, n do ya[i] = ya[i] * .999 end\n"
+	"end\n"
+	"function dsp_amp ()\n"
+	"  ARDOUR.DSP.apply_gain_to_buffer (y, n, .999)\n"
+	"end\n"
+	"\n"
+	"function lua_mix ()\n"
+	"  for i = 1, n do ya[i] = ya[i] * .5 + xa[i] * .5 end\n"
+	"end\n"
+	"function dsp_mix ()\n"
+	"  ARDOUR.DSP.apply_gain_to_buffer (y, n, .5)\n"
+	"  ARDOUR.DSP.mix_buffers_with_gain (y, x, n, .5)\n"
+	"end\n"
+	"\n"
+	"function lua_ring_mod ()\n"
+	"  for i = 1, n do ya[i] = ya[i] * xa[i] end\n"
+	"end\n"
+	"function dsp_ring_mod ()\n"
+	"  ARDOUR.DSP.mmult (y, x, n)\n"
+	"end\n"
+	"\n"
+	"function lua_env ()\n"
+	"  for i = 1, n do\n"
+	"    local v = math.abs (xa[i])\n"
+	"    if v > z then z = z + att * (v - z) else z = z + rel * (v - z) end\n"
+	"    ea[i] = z\n"
+	"  end\n"
+	"end\n"
+	"function dsp_env ()\n"
+	"  env:run (x, e, n)\n"
+	"end\n"
+	"\n"
+	"function lua_fir ()\n"
+	"  for i = 1, n do\n"
+	"    hpos = hpos % 16 + 1\n"
+	"    hist[hpos] = xa[i]\n"
+	"    local acc, p = 0, hpos\n"
+	"    for k = 1, 16 do\n"
+	"      acc = acc + ca[k] * hist[p]\n"
+	"      p = p == 1 and 16 or p - 1\n"
+	"    end\n"
+	"    ya[i] = acc\n"
+	"  end\n"
+	"end\n"
+	"function dsp_fir ()\n"
+	"  ARDOUR.DSP.copy_vector (y, x, n)\n"
+	"  fir:run (y, n)\n"
+	"end\n"
+	"\n"
+	"function lua_rms ()\n"
+	"  local s = 0\n"
+	"  for i = 1, n do s = s + xa[i] * xa[i] end\n"
+	"  return math.sqrt (s / n)\n"
+	"end\n"
+	"function dsp_rms ()\n"
+	"  return ARDOUR.DSP.rms (x, n)\n"
+	"end\n"
+	"\n"
+	"function lua_clip ()\n"
+	"  for i = 1, n do\n"
+	"    local v = ya[i] * 2 - .1\n"
+	"    if v > .5 then v = .5 elseif v < -.5 then v = -.5 end\n"
+	"    ya[i] = v\n"
+	"  end\n"
+	"end\n"
+	"function dsp_clip ()\n"
+	"  ARDOUR.DSP.scale_offset (y, 2, -.1, n)\n"
+	"  ARDOUR.DSP.clamp (y, -.5, .5, n)\n"
+	"end";
+
+static double
+run (lua_State* L, std::string const& fn, uint32_t n_cycles)
+{
+	luabridge::LuaRef f = luabridge::getGlobal (L, fn.c_str ());
+	PBD::microseconds_t t0 = PBD::get_microseconds ();
+	for (uint32_t n = 0; n < n_cycles; ++n) {
+		f ();
+	}
+	return (PBD::get_microseconds () - t0) / (double) n_cycles;
+}
+
+/* Compare per-sample processing in Lua with ARDOUR.DSP vector functions,
+ * processing 1024 samples per cycle.
+ *
+ * usage: lua_dsp [n_cycles]
+ */
+int
+main (int argc, char* argv[])
+{
+	const uint32_t n_cycles = argc > 1 ? atoi (argv[1]) : 2000;
+
+	if (n_cycles < 1) {
+		fprintf (stderr, "usage: %s [n_cycles]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	ARDOUR::init (true, localedir);
+
+	LuaState   lua (true, true);
+	lua_State* L = lua.getState ();
+	LuaBindings::stddef (L);
+	LuaBindings::common (L);
+	LuaBindings::dsp (L);
+
+	if (lua.do_command (script)) {
+		fprintf (stderr, "Failed to load benchmark script\n");
+		return EXIT_FAILURE;
+	}
+
+	const char* names[] = { "amp", "mix", "ring_mod", "env", "fir", "rms", "clip" };
+
+	printf ("%-10s %12s %12s %8s\n", "", "Lua [us]", "DSP [us]", "speedup");
+
+	try {
+		for (size_t i = 0; i < sizeof (names) / sizeof (names[0]); ++i) {
+			const double tl = run (L, std::string ("lua_") + names[i], n_cycles);
+			const double td = run (L, std::string ("dsp_") + names[i], n_cycles);
+			printf ("%-10s %12.2f %12.2f %7.1fx\n", names[i], tl, td, td > 0 ? tl / td : 0);
+		}
+	} catch (luabridge::LuaException const& e) {
+		fprintf (stderr, "Lua Error: %s\n", e.what ());
+		return EXIT_FAILURE;
+	}
+
+	lua.collect_garbage ();
+	ARDOUR::cleanup ();
+	return 0;
+}
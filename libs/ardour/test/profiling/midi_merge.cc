@@ -0,0 +1,94 @@
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "pbd/microseconds.h"
+
+#include "ardour/ardour.h"
+#include "ardour/midi_buffer.h"
+
+using namespace ARDOUR;
+
+static const char* localedir = LOCALEDIR;
+
+/* Compare merging many MIDI buffers (e.g. MPE controllers or sends
+ * to a MIDI bus) one at a time, by inserting events individually, and
+ * using a single k-way merge.
+ *
+ * usage: midi_merge [n_sources [events_per_source [n_cycles]]]
+ */
+int
+main (int argc, char* argv[])
+{
+	const uint32_t n_sources = argc > 1 ? atoi (argv[1]) : 32;
+	const uint32_t n_events  = argc > 2 ? atoi (argv[2]) : 64;
+	const uint32_t n_cycles  = argc > 3 ? atoi (argv[3]) : 1000;
+	const uint32_t n_samples = 1024;
+
+	if (n_sources < 1 || n_events < 1 || n_cycles < 1) {
+		fprintf (stderr, "usage: %s [n_sources [events_per_source [n_cycles]]]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	ARDOUR::init (true, localedir);
+
+	const size_t capacity = (n_sources + 1) * n_events * 32;
+
+	std::vector<MidiBuffer*>       sources;
+	std::vector<MidiBuffer const*> src;
+
+	for (uint32_t i = 0; i < n_sources; ++i) {
+		MidiBuffer* mb = new MidiBuffer (capacity);
+		/* one MPE member channel per source: pitch-bend, pressure, CC */
+		const uint8_t status[] = { 0xe0, 0xd0, 0xb0 };
+		for (uint32_t e = 0; e < n_events; ++e) {
+			uint8_t        msg[3] = { (uint8_t)(status[e % 3] | ((i % 15) + 1)), (uint8_t)(rand () & 0x7f), (uint8_t)(rand () & 0x7f) };
+			const uint32_t size   = (msg[0] & 0xf0) == 0xd0 ? 2 : 3;
+			mb->push_back ((e * n_samples) / n_events, Evoral::LIVE_MIDI_EVENT, size, msg);
+		}
+		sources.push_back (mb);
+		src.push_back (mb);
+	}
+
+	MidiBuffer dst (capacity);
+
+	/* insert event by event */
+	PBD::microseconds_t t0 = PBD::get_microseconds ();
+	for (uint32_t n = 0; n < n_cycles; ++n) {
+		dst.clear ();
+		for (auto const& mb : sources) {
+			for (MidiBuffer::const_iterator e = mb->begin (); e != mb->end (); ++e) {
+				dst.insert_event (*e);
+			}
+		}
+	}
+
+	/* merge one buffer at a time */
+	PBD::microseconds_t t1 = PBD::get_microseconds ();
+	for (uint32_t n = 0; n < n_cycles; ++n) {
+		dst.clear ();
+		for (auto const& mb : sources) {
+			dst.merge_in_place (*mb);
+		}
+	}
+
+	/* k-way merge */
+	PBD::microseconds_t t2 = PBD::get_microseconds ();
+	for (uint32_t n = 0; n < n_cycles; ++n) {
+		dst.clear ();
+		dst.merge_in_place (&src[0], src.size ());
+	}
+	PBD::microseconds_t t3 = PBD::get_microseconds ();
+
+	printf ("%u sources, %u events each\n", n_sources, n_events);
+	printf ("insert_event:   %8.3f us/cycle\n", (t1 - t0) / (double) n_cycles);
+	printf ("pairwise merge: %8.3f us/cycle\n", (t2 - t1) / (double) n_cycles);
+	printf ("k-way merge:    %8.3f us/cycle\n", (t3 - t2) / (double) n_cycles);
+
+	for (auto const& mb : sources) {
+		delete mb;
+	}
+
+	ARDOUR::cleanup ();
+	return 0;
+}
@@ -0,0 +1,128 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "pbd/compose.h"
+#include "pbd/microseconds.h"
+
+#include "ardour/ardour.h"
+#include "ardour/audioengine.h"
+#include "ardour/port_engine_shared.h"
+
+using namespace ARDOUR;
+
+static const char* localedir = LOCALEDIR;
+
+static const pframes_t n_samples = 1024;
+
+/* previous implementation of BackendPort::get_buffer for audio input ports,
+ * for comparison: walk the connection set, copy and sum using a scalar loop.
+ */
+static void
+legacy_get_buffer (BackendPortPtr const& port, Sample* buf)
+{
+	const std::set<BackendPortPtr>& connections = port->get_connections ();
+	std::set<BackendPortPtr>::const_iterator it = connections.begin ();
+	if (it == connections.end ()) {
+		memset (buf, 0, n_samples * sizeof (Sample));
+		return;
+	}
+	BackendPortPtr source = std::dynamic_pointer_cast<BackendPort> (*it);
+	memcpy (buf, source->get_buffer (n_samples), n_samples * sizeof (Sample));
+	while (++it != connections.end ()) {
+		source = std::dynamic_pointer_cast<BackendPort> (*it);
+		Sample*       dst = buf;
+		const Sample* src = (const Sample*) source->get_buffer (n_samples);
+		for (uint32_t s = 0; s < n_samples; ++s, ++dst, ++src) {
+			*dst += *src;
+		}
+	}
+}
+
+/* Measure the cost of collecting data of audio input ports,
+ * using the Dummy backend's internal port connections.
+ *
+ * usage: port_routing [n_inputs [fan_in [n_cycles]]]
+ *
+ * Requires ARDOUR_BACKEND_PATH to include the Dummy backend.
+ */
+int
+main (int argc, char* argv[])
+{
+	const uint32_t n_inputs = argc > 1 ? atoi (argv[1]) : 256;
+	const uint32_t fan_in   = argc > 2 ? atoi (argv[2]) : 1;
+	const uint32_t n_cycles = argc > 3 ? atoi (argv[3]) : 2000;
+
+	if (n_inputs < 1 || fan_in < 1 || n_cycles < 1) {
+		fprintf (stderr, "usage: %s [n_inputs [fan_in [n_cycles]]]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	ARDOUR::init (true, localedir);
+
+	AudioEngine* engine = AudioEngine::create ();
+	if (!engine->set_backend ("None (Dummy)", "Profiling", "") || engine->start () != 0) {
+		fprintf (stderr, "Cannot start Dummy backend\n");
+		return EXIT_FAILURE;
+	}
+
+	PortEngine& pe = engine->port_engine ();
+
+	std::vector<PortEngine::PortPtr> outputs;
+	std::vector<PortEngine::PortPtr> inputs;
+	std::vector<BackendPortPtr>      backend_inputs;
+	std::vector<Sample>              buf (n_samples);
+
+	for (uint32_t i = 0; i < fan_in; ++i) {
+		outputs.push_back (pe.register_port (string_compose ("out-%1", i), DataType::AUDIO, IsOutput));
+		Sample* data = (Sample*) pe.get_buffer (outputs.back (), n_samples);
+		for (uint32_t s = 0; s < n_samples; ++s) {
+			data[s] = (rand () / (float) RAND_MAX) - .5f;
+		}
+	}
+
+	for (uint32_t i = 0; i < n_inputs; ++i) {
+		inputs.push_back (pe.register_port (string_compose ("in-%1", i), DataType::AUDIO, IsInput));
+		backend_inputs.push_back (std::dynamic_pointer_cast<BackendPort> (inputs.back ()));
+		for (uint32_t c = 0; c < fan_in; ++c) {
+			pe.connect (outputs[c], pe.get_port_name (inputs.back ()));
+		}
+	}
+
+	volatile Sample sink = 0;
+
+	PBD::microseconds_t t0 = PBD::get_microseconds ();
+	for (uint32_t n = 0; n < n_cycles; ++n) {
+		for (uint32_t i = 0; i < n_inputs; ++i) {
+			sink = ((Sample*) pe.get_buffer (inputs[i], n_samples))[n_samples - 1];
+		}
+	}
+	PBD::microseconds_t t1 = PBD::get_microseconds ();
+	for (uint32_t n = 0; n < n_cycles; ++n) {
+		for (uint32_t i = 0; i < n_inputs; ++i) {
+			legacy_get_buffer (backend_inputs[i], &buf[0]);
+			sink = buf[n_samples - 1];
+		}
+	}
+	PBD::microseconds_t t2 = PBD::get_microseconds ();
+
+	(void) sink;
+
+	printf ("%u inputs, %u source(s) each, %u samples/cycle\n", n_inputs, fan_in, n_samples);
+	printf ("connection table: %8.3f us/cycle\n", (t1 - t0) / (double) n_cycles);
+	printf ("legacy:           %8.3f us/cycle\n", (t2 - t1) / (double) n_cycles);
+
+	backend_inputs.clear ();
+	for (auto const& p : inputs) {
+		pe.unregister_port (p);
+	}
+	for (auto const& p : outputs) {
+		pe.unregister_port (p);
+	}
+
+	engine->stop ();
+	AudioEngine::destroy ();
+	ARDOUR::cleanup ();
+	return 0;
+}
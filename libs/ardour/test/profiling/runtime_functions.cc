@@ -0,0 +1,101 @@
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "pbd/microseconds.h"
+
+#include "ardour/ardour.h"
+#include "ardour/mix.h"
+#include "ardour/runtime_functions.h"
+
+using namespace ARDOUR;
+
+static const char* localedir = LOCALEDIR;
+
+static std::vector<float>   src;
+static std::vector<float>   dst;
+static std::vector<int16_t> s16;
+static std::vector<int32_t> s24;
+static volatile float       sink;
+
+static const uint32_t n_samples  = 1024;
+static const uint32_t n_channels = 2;
+
+static void
+report (const char* name, PBD::microseconds_t opt, PBD::microseconds_t generic, uint32_t n_cycles)
+{
+	const double per_cycle = 1.0 / n_cycles;
+	printf ("%-24s %8.3f us %8.3f us  x%.2f\n", name, opt * per_cycle, generic * per_cycle, opt > 0 ? generic / (double) opt : 0);
+}
+
+#define TIME(NAME, OPT, GENERIC)                                       \
+	{                                                                  \
+		PBD::microseconds_t t0 = PBD::get_microseconds ();             \
+		for (uint32_t n = 0; n < n_cycles; ++n) { OPT; }               \
+		PBD::microseconds_t t1 = PBD::get_microseconds ();             \
+		for (uint32_t n = 0; n < n_cycles; ++n) { GENERIC; }           \
+		PBD::microseconds_t t2 = PBD::get_microseconds ();             \
+		report (NAME, t1 - t0, t2 - t1, n_cycles);                     \
+	}
+
+/* Compare the H/W optimized runtime functions selected by
+ * ARDOUR::init() to the generic implementation.
+ *
+ * usage: runtime_functions [n_cycles]
+ */
+int
+main (int argc, char* argv[])
+{
+	const uint32_t n_cycles = argc > 1 ? atoi (argv[1]) : 100000;
+
+	if (n_cycles < 1) {
+		fprintf (stderr, "usage: %s [n_cycles]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	ARDOUR::init (true, localedir);
+
+	src.resize (n_samples * n_channels);
+	dst.resize (n_samples * n_channels);
+	s16.resize (n_samples * n_channels);
+	s24.resize (n_samples * n_channels);
+
+	for (uint32_t i = 0; i < n_samples * n_channels; ++i) {
+		src[i] = dst[i] = (rand () / (float) RAND_MAX) - .5f;
+	}
+
+	const float a = 156.825f / 48000.f;
+
+	printf ("%u samples/cycle, %u cycles      optimized    generic\n", n_samples, n_cycles);
+
+	TIME ("apply_gain_ramp",
+	      sink = apply_gain_ramp (&dst[0], n_samples, 1.f, .5f, a),
+	      sink = default_apply_gain_ramp (&dst[0], n_samples, 1.f, .5f, a));
+
+	TIME ("mix_buffers_with_ramp",
+	      mix_buffers_with_ramp (&dst[0], &src[0], n_samples, .5f, .2f),
+	      default_mix_buffers_with_ramp (&dst[0], &src[0], n_samples, .5f, .2f));
+
+	TIME ("interleave (stereo)",
+	      for (uint32_t c = 0; c < n_channels; ++c) { interleave (&dst[c], &src[c * n_samples], n_samples, n_channels); },
+	      for (uint32_t c = 0; c < n_channels; ++c) { default_interleave (&dst[c], &src[c * n_samples], n_samples, n_channels); });
+
+	TIME ("deinterleave (stereo)",
+	      for (uint32_t c = 0; c < n_channels; ++c) { deinterleave (&dst[c * n_samples], &src[c], n_samples, n_channels); },
+	      for (uint32_t c = 0; c < n_channels; ++c) { default_deinterleave (&dst[c * n_samples], &src[c], n_samples, n_channels); });
+
+	TIME ("float_to_s16",
+	      float_to_s16 (&s16[0], &src[0], n_samples * n_channels),
+	      default_float_to_s16 (&s16[0], &src[0], n_samples * n_channels));
+
+	TIME ("float_to_s24",
+	      float_to_s24 (&s24[0], &src[0], n_samples * n_channels),
+	      default_float_to_s24 (&s24[0], &src[0], n_samples * n_channels));
+
+	TIME ("sum_of_squares",
+	      sink = sum_of_squares (&src[0], n_samples),
+	      sink = default_sum_of_squares (&src[0], n_samples));
+
+	ARDOUR::cleanup ();
+	return 0;
+}
@@ -0,0 +1,125 @@
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <glibmm/threads.h>
+
+#include "pbd/compose.h"
+#include "pbd/microseconds.h"
+
+#include "ardour/ardour.h"
+#include "ardour/uri_map.h"
+
+using namespace ARDOUR;
+
+static const char* localedir = LOCALEDIR;
+
+/* previous implementation, for comparison: a mutex protected std::map */
+class LegacyURIMap
+{
+public:
+	LegacyURIMap () : n_contended (0) {}
+
+	uint32_t uri_to_id (const char* uri)
+	{
+		Glib::Threads::Mutex::Lock lm (_lock, Glib::Threads::TRY_LOCK);
+		if (!lm.locked ()) {
+			++n_contended; // protected by the lock, once acquired
+			lm.acquire ();
+		}
+		const std::string urimm (uri);
+		std::map<const std::string, uint32_t>::const_iterator i = _map.find (urimm);
+		if (i != _map.end ()) {
+			return i->second;
+		}
+		const uint32_t id = _map.size () + 1;
+		_map.insert (std::make_pair (urimm, id));
+		return id;
+	}
+
+	uint64_t n_contended;
+
+private:
+	std::map<const std::string, uint32_t> _map;
+	Glib::Threads::Mutex                  _lock;
+};
+
+static std::vector<std::string> uris;
+
+static uint32_t n_plugins = 500;
+
+/* Simulate plugin instantiation: map the same set of URIs for every
+ * plugin, most of which are already known, plus a few that are specific
+ * to some plugins.
+ */
+template <typename T>
+static void
+map_uris (T* map, uint32_t thread_id)
+{
+	volatile uint32_t sink = 0;
+	for (uint32_t p = 0; p < n_plugins; ++p) {
+		for (std::vector<std::string>::const_iterator i = uris.begin (); i != uris.end (); ++i) {
+			sink = map->uri_to_id (i->c_str ());
+		}
+		if (p % 10 == 0) {
+			sink = map->uri_to_id (string_compose ("urn:plugin:%1-%2#state", thread_id, p).c_str ());
+		}
+	}
+	(void) sink;
+}
+
+template <typename T>
+static double
+run (T* map, uint32_t n_threads)
+{
+	std::vector<Glib::Threads::Thread*> threads;
+	PBD::microseconds_t t0 = PBD::get_microseconds ();
+	for (uint32_t t = 0; t < n_threads; ++t) {
+		threads.push_back (Glib::Threads::Thread::create (sigc::bind (sigc::ptr_fun (&map_uris<T>), map, t)));
+	}
+	for (std::vector<Glib::Threads::Thread*>::const_iterator i = threads.begin (); i != threads.end (); ++i) {
+		(*i)->join ();
+	}
+	return (PBD::get_microseconds () - t0) / 1000.0;
+}
+
+/* Compare mapping URIs from many threads concurrently, counting how
+ * often a thread had to wait for the lock.
+ *
+ * usage: uri_map [n_threads [n_plugins]]
+ */
+int
+main (int argc, char* argv[])
+{
+	const uint32_t n_threads = argc > 1 ? atoi (argv[1]) : 8;
+	n_plugins                = argc > 2 ? atoi (argv[2]) : 500;
+
+	if (n_threads < 1 || n_plugins < 1) {
+		fprintf (stderr, "usage: %s [n_threads [n_plugins]]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	ARDOUR::init (true, localedir);
+
+	const char* ns[] = { "atom", "midi", "time", "patch", "state", "options", "buf-size", "parameters", "log", "worker" };
+	for (size_t n = 0; n < sizeof (ns) / sizeof (ns[0]); ++n) {
+		for (uint32_t i = 0; i < 8; ++i) {
+			uris.push_back (string_compose ("http://lv2plug.in/ns/ext/%1#uri%2", ns[n], i));
+		}
+	}
+
+	LegacyURIMap legacy;
+	const double tl = run (&legacy, n_threads);
+
+	URIMap& map = URIMap::instance ();
+	const double tm = run (&map, n_threads);
+
+	printf ("%u threads, %u plugins each, %u URIs per plugin\n", n_threads, n_plugins, (uint32_t) uris.size ());
+	printf ("mutex + std::map: %8.2f ms, %8llu contended\n", tl, (unsigned long long) legacy.n_contended);
+	printf ("URIMap:           %8.2f ms, %8llu contended\n", tm, (unsigned long long) map.n_contended ());
+
+	ARDOUR::cleanup ();
+	return 0;
+}
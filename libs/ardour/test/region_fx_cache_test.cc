@@ -0,0 +1,271 @@
+#include <glibmm/fileutils.h>
+#include <glibmm/miscutils.h>
+
+#include "ardour/audio_buffer.h"
+#include "ardour/buffer_set.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/region_fx_cache.h"
+
+#include "region_fx_cache_test.h"
+#include "test_util.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (RegionFxCacheTest);
+
+using namespace ARDOUR;
+
+static void
+fill (BufferSet& bufs, samplepos_t start, samplecnt_t cnt)
+{
+	for (uint32_t c = 0; c < bufs.count ().n_audio (); ++c) {
+		Sample* d = bufs.get_audio (c).data ();
+		for (samplecnt_t i = 0; i < cnt; ++i) {
+			d[i] = (start + i) * (c + 1);
+		}
+	}
+}
+
+static bool
+check (BufferSet const& bufs, samplepos_t start, samplecnt_t cnt)
+{
+	for (uint32_t c = 0; c < bufs.count ().n_audio (); ++c) {
+		Sample const* d = bufs.get_audio (c).data ();
+		for (samplecnt_t i = 0; i < cnt; ++i) {
+			if (d[i] != (start + i) * (c + 1)) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+void
+RegionFxCacheTest::setUp ()
+{
+	_spill_path = Glib::build_filename (new_test_output_dir ("region_fx_cache"), "test.raw");
+	_memory     = Config->get_region_fx_cache_memory ();
+	_disk       = Config->get_region_fx_cache_disk ();
+}
+
+void
+RegionFxCacheTest::tearDown ()
+{
+	Config->set_region_fx_cache_memory (_memory);
+	Config->set_region_fx_cache_disk (_disk);
+}
+
+/* data is returned as written, across chunk boundaries */
+void
+RegionFxCacheTest::readWriteTest ()
+{
+	samplecnt_t const cs = RegionFxCache::chunk_size ();
+	samplecnt_t const n  = 1000;
+
+	BufferSet bufs;
+	bufs.ensure_buffers (ChanCount (DataType::AUDIO, 2), 3 * cs);
+
+	RegionFxCache cache (_spill_path, 2);
+
+	CPPUNIT_ASSERT (!cache.read (bufs, 0, n));
+
+	for (samplepos_t pos = 0; pos < 3 * cs; pos += n) {
+		fill (bufs, pos, n);
+		cache.write (bufs, pos, n);
+	}
+
+	CPPUNIT_ASSERT (cache.read (bufs, 0, n));
+	CPPUNIT_ASSERT (check (bufs, 0, n));
+
+	CPPUNIT_ASSERT (cache.read (bufs, cs - 10, 2 * cs));
+	CPPUNIT_ASSERT (check (bufs, cs - 10, 2 * cs));
+
+	/* the last write ended after 3 * cs */
+	CPPUNIT_ASSERT (cache.read (bufs, 2 * cs, cs));
+	CPPUNIT_ASSERT (!cache.read (bufs, 3 * cs + n, n));
+
+	CPPUNIT_ASSERT_EQUAL (uint64_t (3), cache.local_stats ().hits);
+	CPPUNIT_ASSERT_EQUAL (uint64_t (2), cache.local_stats ().misses);
+
+	cache.clear ();
+	CPPUNIT_ASSERT (!cache.read (bufs, 0, n));
+}
+
+/* chunks are only filled from the start */
+void
+RegionFxCacheTest::contiguousTest ()
+{
+	samplecnt_t const cs = RegionFxCache::chunk_size ();
+
+	BufferSet bufs;
+	bufs.ensure_buffers (ChanCount (DataType::AUDIO, 1), cs);
+
+	RegionFxCache cache (_spill_path, 1);
+
+	/* starts in the middle of a chunk */
+	fill (bufs, 100, 200);
+	cache.write (bufs, 100, 200);
+	CPPUNIT_ASSERT (!cache.read (bufs, 100, 200));
+
+	fill (bufs, 0, 100);
+	cache.write (bufs, 0, 100);
+	CPPUNIT_ASSERT (cache.read (bufs, 0, 100));
+	CPPUNIT_ASSERT (!cache.read (bufs, 0, 101));
+
+	/* leaves a gap */
+	fill (bufs, 200, 100);
+	cache.write (bufs, 200, 100);
+	CPPUNIT_ASSERT (!cache.read (bufs, 200, 100));
+
+	fill (bufs, 100, 200);
+	cache.write (bufs, 100, 200);
+	CPPUNIT_ASSERT (cache.read (bufs, 0, 300));
+	CPPUNIT_ASSERT (check (bufs, 0, 300));
+}
+
+/* a range is only reported as cached without gaps, lookups are not counted */
+void
+RegionFxCacheTest::cachedTest ()
+{
+	samplecnt_t const cs = RegionFxCache::chunk_size ();
+
+	BufferSet bufs;
+	bufs.ensure_buffers (ChanCount (DataType::AUDIO, 1), cs);
+
+	RegionFxCache cache (_spill_path, 1);
+
+	CPPUNIT_ASSERT (!cache.cached (0, 1));
+
+	fill (bufs, 0, cs);
+	cache.write (bufs, 0, cs);
+	fill (bufs, 2 * cs, cs);
+	cache.write (bufs, 2 * cs, cs);
+
+	CPPUNIT_ASSERT (cache.cached (0, cs));
+	CPPUNIT_ASSERT (cache.cached (2 * cs, cs));
+	CPPUNIT_ASSERT (!cache.cached (0, 3 * cs));
+	CPPUNIT_ASSERT (!cache.cached (cs - 1, 2));
+	CPPUNIT_ASSERT (!cache.cached (2 * cs, cs + 1));
+
+	fill (bufs, cs, cs);
+	cache.write (bufs, cs, cs);
+	CPPUNIT_ASSERT (cache.cached (0, 3 * cs));
+	CPPUNIT_ASSERT (cache.cached (cs - 1, 2));
+
+	CPPUNIT_ASSERT_EQUAL (uint64_t (0), cache.local_stats ().hits);
+	CPPUNIT_ASSERT_EQUAL (uint64_t (0), cache.local_stats ().misses);
+}
+
+/* data that exceeds the memory limit is written to disk and read back */
+void
+RegionFxCacheTest::spillTest ()
+{
+	samplecnt_t const cs = RegionFxCache::chunk_size ();
+	/* 2 channels, 64 chunks: 8 MB */
+	samplecnt_t const len = 64 * cs;
+
+	Config->set_region_fx_cache_memory (1);
+	Config->set_region_fx_cache_disk (16);
+
+	RegionFxCache::Stats const s0 (RegionFxCache::stats ());
+
+	BufferSet bufs;
+	bufs.ensure_buffers (ChanCount (DataType::AUDIO, 2), cs);
+
+	{
+		RegionFxCache cache (_spill_path, 2);
+
+		for (samplepos_t pos = 0; pos < len; pos += cs) {
+			fill (bufs, pos, cs);
+			cache.write (bufs, pos, cs);
+		}
+
+		CPPUNIT_ASSERT (RegionFxCache::stats ().memory_bytes <= 1048576);
+		CPPUNIT_ASSERT (RegionFxCache::stats ().disk_bytes > s0.disk_bytes);
+		CPPUNIT_ASSERT (Glib::file_test (_spill_path, Glib::FILE_TEST_EXISTS));
+
+		for (samplepos_t pos = 0; pos < len; pos += cs) {
+			CPPUNIT_ASSERT (cache.read (bufs, pos, cs));
+			CPPUNIT_ASSERT (check (bufs, pos, cs));
+		}
+
+		CPPUNIT_ASSERT (cache.local_stats ().spills > 0);
+		CPPUNIT_ASSERT (cache.local_stats ().reloads > 0);
+		CPPUNIT_ASSERT (RegionFxCache::stats ().memory_bytes <= 1048576);
+	}
+
+	CPPUNIT_ASSERT (!Glib::file_test (_spill_path, Glib::FILE_TEST_EXISTS));
+	CPPUNIT_ASSERT_EQUAL (s0.memory_bytes, RegionFxCache::stats ().memory_bytes);
+	CPPUNIT_ASSERT_EQUAL (s0.disk_bytes, RegionFxCache::stats ().disk_bytes);
+}
+
+/* without disk space, least recently used data is dropped */
+void
+RegionFxCacheTest::dropTest ()
+{
+	samplecnt_t const cs = RegionFxCache::chunk_size ();
+	samplecnt_t const len = 64 * cs;
+
+	Config->set_region_fx_cache_memory (1);
+	Config->set_region_fx_cache_disk (0);
+
+	BufferSet bufs;
+	bufs.ensure_buffers (ChanCount (DataType::AUDIO, 2), cs);
+
+	RegionFxCache cache (_spill_path, 2);
+
+	for (samplepos_t pos = 0; pos < len; pos += cs) {
+		fill (bufs, pos, cs);
+		cache.write (bufs, pos, cs);
+	}
+
+	CPPUNIT_ASSERT (!Glib::file_test (_spill_path, Glib::FILE_TEST_EXISTS));
+	CPPUNIT_ASSERT (!cache.read (bufs, 0, cs));
+	CPPUNIT_ASSERT (cache.read (bufs, len - cs, cs));
+	CPPUNIT_ASSERT (check (bufs, len - cs, cs));
+}
+
+/* the memory limit is shared, the least recently used data of any cache is spilled */
+void
+RegionFxCacheTest::sharedLimitTest ()
+{
+	samplecnt_t const cs = RegionFxCache::chunk_size ();
+	/* 2 channels, 16 chunks: 2 MB */
+	samplecnt_t const len = 16 * cs;
+
+	Config->set_region_fx_cache_memory (1);
+	Config->set_region_fx_cache_disk (16);
+
+	BufferSet bufs;
+	bufs.ensure_buffers (ChanCount (DataType::AUDIO, 2), cs);
+
+	RegionFxCache a (_spill_path, 2);
+	RegionFxCache b (_spill_path + ".b", 2);
+
+	for (samplepos_t pos = 0; pos < len; pos += cs) {
+		fill (bufs, pos, cs);
+		a.write (bufs, pos, cs);
+	}
+
+	uint64_t const spilled = a.local_stats ().spills;
+	CPPUNIT_ASSERT (spilled > 0);
+
+	/* b takes over the memory that a used */
+	for (samplepos_t pos = 0; pos < len / 4; pos += cs) {
+		fill (bufs, pos, cs);
+		b.write (bufs, pos, cs);
+	}
+
+	CPPUNIT_ASSERT (RegionFxCache::stats ().memory_bytes <= 1048576);
+	CPPUNIT_ASSERT_EQUAL (uint64_t (0), b.local_stats ().spills);
+	CPPUNIT_ASSERT_EQUAL (spilled + 4, a.local_stats ().spills);
+
+	for (samplepos_t pos = 0; pos < len / 4; pos += cs) {
+		CPPUNIT_ASSERT (b.read (bufs, pos, cs));
+		CPPUNIT_ASSERT (check (bufs, pos, cs));
+	}
+	CPPUNIT_ASSERT_EQUAL (uint64_t (0), b.local_stats ().reloads);
+
+	for (samplepos_t pos = 0; pos < len; pos += cs) {
+		CPPUNIT_ASSERT (a.read (bufs, pos, cs));
+		CPPUNIT_ASSERT (check (bufs, pos, cs));
+	}
+}
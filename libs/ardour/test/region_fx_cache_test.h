@@ -0,0 +1,32 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <string>
+
+class RegionFxCacheTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (RegionFxCacheTest);
+	CPPUNIT_TEST (readWriteTest);
+	CPPUNIT_TEST (contiguousTest);
+	CPPUNIT_TEST (cachedTest);
+	CPPUNIT_TEST (spillTest);
+	CPPUNIT_TEST (dropTest);
+	CPPUNIT_TEST (sharedLimitTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp ();
+	void tearDown ();
+
+	void readWriteTest ();
+	void contiguousTest ();
+	void cachedTest ();
+	void spillTest ();
+	void dropTest ();
+	void sharedLimitTest ();
+
+private:
+	std::string _spill_path;
+	uint32_t    _memory;
+	uint32_t    _disk;
+};
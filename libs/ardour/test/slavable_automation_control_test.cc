@@ -0,0 +1,134 @@
+#include "ardour/automation_list.h"
+#include "ardour/gain_control.h"
+#include "ardour/mute_control.h"
+#include "ardour/session.h"
+#include "ardour/vca.h"
+#include "ardour/vca_manager.h"
+
+#include "slavable_automation_control_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (SlavableAutomationControlTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+/* create VCAs v[0] <- v[1] <- v[2], where v[0] is slaved to v[1],
+ * which is in turn slaved to v[2].
+ */
+static vector<std::shared_ptr<VCA> >
+nested_vcas (Session* session)
+{
+	VCAList vl = session->vca_manager ().create_vca (3, "VCA");
+	vector<std::shared_ptr<VCA> > v (vl.begin (), vl.end ());
+	CPPUNIT_ASSERT_EQUAL (size_t (3), v.size ());
+
+	v[0]->assign (v[1]);
+	v[1]->assign (v[2]);
+
+	CPPUNIT_ASSERT (v[0]->gain_control ()->slaved_to (v[1]->gain_control ()));
+	CPPUNIT_ASSERT (v[1]->gain_control ()->slaved_to (v[2]->gain_control ()));
+	return v;
+}
+
+void
+SlavableAutomationControlTest::nestedGainTest ()
+{
+	vector<std::shared_ptr<VCA> > v = nested_vcas (_session);
+
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (1.0, v[0]->gain_control ()->get_masters_value (), 1e-6);
+
+	v[1]->gain_control ()->set_value_unchecked (0.5);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.5, v[0]->gain_control ()->get_masters_value (), 1e-6);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.5, v[0]->gain_control ()->get_value (), 1e-6);
+
+	/* change of the top-level master propagates through the chain */
+	v[2]->gain_control ()->set_value_unchecked (0.25);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.25, v[1]->gain_control ()->get_masters_value (), 1e-6);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.125, v[0]->gain_control ()->get_masters_value (), 1e-6);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.125, v[0]->gain_control ()->get_value (), 1e-6);
+
+	/* a slave's own value is relative to its masters */
+	v[0]->gain_control ()->set_value_unchecked (0.0625);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.0625, v[0]->gain_control ()->get_value (), 1e-6);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.5, v[0]->gain_control ()->get_double (), 1e-6);
+
+	/* unassign applies the master value permanently */
+	v[0]->unassign (v[1]);
+	CPPUNIT_ASSERT (!v[0]->gain_control ()->slaved ());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (1.0, v[0]->gain_control ()->get_masters_value (), 1e-6);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.0625, v[0]->gain_control ()->get_value (), 1e-6);
+
+	/* no longer follows */
+	v[2]->gain_control ()->set_value_unchecked (1.0);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.0625, v[0]->gain_control ()->get_value (), 1e-6);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.5, v[1]->gain_control ()->get_value (), 1e-6);
+}
+
+void
+SlavableAutomationControlTest::nestedMuteTest ()
+{
+	vector<std::shared_ptr<VCA> > v = nested_vcas (_session);
+
+	CPPUNIT_ASSERT_EQUAL (0.0, v[0]->mute_control ()->get_masters_value ());
+
+	v[2]->mute_control ()->set_value_unchecked (1.0);
+	CPPUNIT_ASSERT_EQUAL (1.0, v[1]->mute_control ()->get_masters_value ());
+	CPPUNIT_ASSERT_EQUAL (1.0, v[0]->mute_control ()->get_masters_value ());
+	CPPUNIT_ASSERT (v[0]->mute_control ()->muted_by_masters ());
+	CPPUNIT_ASSERT (!v[0]->mute_control ()->muted_by_self ());
+
+	v[2]->mute_control ()->set_value_unchecked (0.0);
+	CPPUNIT_ASSERT_EQUAL (0.0, v[0]->mute_control ()->get_masters_value ());
+	CPPUNIT_ASSERT (!v[0]->mute_control ()->muted_by_masters ());
+
+	/* logical OR of masters */
+	v[1]->mute_control ()->set_value_unchecked (1.0);
+	CPPUNIT_ASSERT_EQUAL (1.0, v[0]->mute_control ()->get_masters_value ());
+	CPPUNIT_ASSERT_EQUAL (0.0, v[1]->mute_control ()->get_masters_value ());
+}
+
+void
+SlavableAutomationControlTest::masterAutomationTest ()
+{
+	vector<std::shared_ptr<VCA> > v = nested_vcas (_session);
+
+	std::shared_ptr<GainControl>    gc = v[2]->gain_control ();
+	std::shared_ptr<AutomationList> al = gc->alist ();
+	CPPUNIT_ASSERT (al);
+
+	al->fast_simple_add (timepos_t (0), 0.5);
+	al->fast_simple_add (timepos_t (1000), 0.5);
+	al->fast_simple_add (timepos_t (1001), 0.25);
+	al->fast_simple_add (timepos_t (2000), 0.25);
+	gc->set_automation_state (Play);
+
+	v[1]->gain_control ()->set_value_unchecked (0.5);
+
+	/* as done by Automatable::automation_run in the process thread */
+	gc->automation_run (100, 64);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.5, gc->get_value (), 1e-6);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.25, v[0]->gain_control ()->get_masters_value (), 1e-6);
+
+	gc->automation_run (1500, 64);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.25, gc->get_value (), 1e-6);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.125, v[0]->gain_control ()->get_masters_value (), 1e-6);
+
+	/* automation of an intermediate VCA is scaled by its masters */
+	std::shared_ptr<GainControl> gc1 = v[1]->gain_control ();
+	gc1->alist ()->fast_simple_add (timepos_t (0), 0.5);
+	gc1->alist ()->fast_simple_add (timepos_t (2000), 0.5);
+	gc1->set_automation_state (Play);
+
+	gc1->automation_run (1500, 64);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.125, v[0]->gain_control ()->get_masters_value (), 1e-6);
+
+	/* slaves follow when a master's automation state changes, without
+	 * the master emitting Changed. Writing automation takes the master's
+	 * fader value as-is (0.5), no longer scaled by its own master (0.25).
+	 */
+	gc1->set_automation_state (Write);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.5, v[0]->gain_control ()->get_masters_value (), 1e-6);
+
+	gc1->set_automation_state (Play);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.125, v[0]->gain_control ()->get_masters_value (), 1e-6);
+}
@@ -0,0 +1,18 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "test_needing_session.h"
+
+class SlavableAutomationControlTest : public TestNeedingSession
+{
+	CPPUNIT_TEST_SUITE (SlavableAutomationControlTest);
+	CPPUNIT_TEST (nestedGainTest);
+	CPPUNIT_TEST (nestedMuteTest);
+	CPPUNIT_TEST (masterAutomationTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void nestedGainTest ();
+	void nestedMuteTest ();
+	void masterAutomationTest ();
+};
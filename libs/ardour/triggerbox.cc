@@ -17,6 +17,7 @@
  */
 
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <fstream>
 #include <cstdlib>
@@ -1347,6 +1348,9 @@ Trigger::start_and_roll_to (samplepos_t start_pos, samplepos_t end_position, Tri
 
 AudioTrigger::AudioData::~AudioData ()
 {
+	if (shared) {
+		return;
+	}
 	for (auto & s : *this) {
 		delete [] s;
 	}
@@ -1356,6 +1360,7 @@ void
 AudioTrigger::AudioData::alloc (samplecnt_t cnt, uint32_t nchans)
 {
 	clear ();
+	shared.reset ();
 	reserve (nchans);
 	for (uint32_t n = 0; n < nchans; ++n) {
 		push_back (new Sample[cnt]);
@@ -1380,10 +1385,300 @@ AudioTrigger::AudioData::append (Sample const * src, samplecnt_t cnt, uint32_t c
 	return to_copy;
 }
 
+/* Ring-buffer for the part of a clip that is not held in memory.
+ *
+ * Positions are offsets from the start of the clip data, sample `pos`
+ * is stored at buf[chn][pos % size]. The process thread consumes
+ * [read_pos, write_pos), the TriggerBoxThread fills data up to
+ * read_pos + size.
+ *
+ * Only the process thread modifies read_pos. It repositions the stream
+ * by setting read_pos and then seek_pos, which the TriggerBoxThread
+ * acknowledges by setting write_pos and resetting seek_pos to -1.
+ */
+struct AudioTrigger::Stream {
+	Stream (uint32_t nchans, samplecnt_t sz);
+	~Stream ();
+
+	bool seek (samplepos_t pos);
+	bool read (samplepos_t pos, samplecnt_t cnt, bool& need_refill);
+
+	size_t memory_usage () const {
+		return (size + scratch_size) * buf.size () * sizeof (Sample);
+	}
+
+	std::vector<Sample*> buf;
+	std::vector<Sample*> scratch; /* data returned by ::read () */
+	samplecnt_t          size;
+
+	std::atomic<samplepos_t> read_pos;
+	std::atomic<samplepos_t> write_pos;
+	std::atomic<samplepos_t> seek_pos;
+	std::atomic<bool>        refill_pending;
+	std::atomic<uint32_t>    underruns;
+
+	static const samplecnt_t scratch_size = 8192;
+	static const samplecnt_t read_chunk   = 65536;
+};
+
+const samplecnt_t AudioTrigger::Stream::scratch_size;
+const samplecnt_t AudioTrigger::Stream::read_chunk;
+
+AudioTrigger::Stream::Stream (uint32_t nchans, samplecnt_t sz)
+	: size (sz)
+	, read_pos (0)
+	, write_pos (0)
+	, seek_pos (-1)
+	, refill_pending (false)
+	, underruns (0)
+{
+	for (uint32_t n = 0; n < nchans; ++n) {
+		buf.push_back (new Sample[size]);
+		scratch.push_back (new Sample[scratch_size]);
+	}
+}
+
+AudioTrigger::Stream::~Stream ()
+{
+	for (auto & b : buf) {
+		delete [] b;
+	}
+	for (auto & b : scratch) {
+		delete [] b;
+	}
+}
+
+/** Reposition the stream to continue reading at @a pos. Realtime safe.
+ * @return true if the stream needs to be refilled
+ */
+bool
+AudioTrigger::Stream::seek (samplepos_t pos)
+{
+	const samplepos_t pending = seek_pos.load ();
+
+	if (pending == pos || (pending < 0 && read_pos.load () == pos)) {
+		/* already there, or on the way */
+		return false;
+	}
+
+	read_pos.store (pos);
+	seek_pos.store (pos);
+	return true;
+}
+
+/** Copy @a cnt samples starting at @a pos to the scratch buffers.
+ * Realtime safe, to be called from the process thread only.
+ *
+ * If the data is not yet available, the scratch buffers are silenced.
+ * When reading is too far ahead of the data, or going backwards, the
+ * stream is repositioned after the requested range.
+ *
+ * @return false on underrun
+ */
+bool
+AudioTrigger::Stream::read (samplepos_t pos, samplecnt_t cnt, bool& need_refill)
+{
+	assert (cnt <= scratch_size);
+
+	need_refill = false;
+
+	const samplepos_t pending = seek_pos.load ();
+	const samplepos_t w       = write_pos.load ();
+
+	if (pending >= 0 || pos < read_pos.load () || pos + cnt > w) {
+
+		for (auto & s : scratch) {
+			memset (s, 0, sizeof (Sample) * cnt);
+		}
+
+		/* where valid data will continue */
+		const samplepos_t from = pending >= 0 ? pending : w;
+
+		if (pos < read_pos.load () || pos + cnt > from + size / 2) {
+			need_refill = seek (pos + cnt);
+		} else if (pending < 0) {
+			/* disk is lagging behind, keep going */
+			read_pos.store (pos + cnt);
+			need_refill = true;
+		}
+
+		if (pending < 0) {
+			underruns.fetch_add (1);
+		}
+		return false;
+	}
+
+	const samplecnt_t off = pos % size;
+	const samplecnt_t n0  = std::min (cnt, size - off);
+
+	for (uint32_t n = 0; n < buf.size (); ++n) {
+		memcpy (scratch[n], buf[n] + off, sizeof (Sample) * n0);
+		if (n0 < cnt) {
+			memcpy (scratch[n] + n0, buf[n], sizeof (Sample) * (cnt - n0));
+		}
+	}
+
+	read_pos.store (pos + cnt);
+
+	need_refill = (w - (pos + cnt)) < size / 2;
+	return true;
+}
+
+/* Clip data, time-stretched at a given ratio */
+struct AudioTrigger::Render {
+	Render (uint32_t nchans, samplecnt_t cnt, double r, Trigger::StretchMode m)
+		: length (0)
+		, capacity (cnt)
+		, ratio (r)
+		, mode (m)
+	{
+		for (uint32_t n = 0; n < nchans; ++n) {
+			data.push_back (new Sample[capacity]);
+		}
+	}
+
+	~Render ()
+	{
+		for (auto & d : data) {
+			delete [] d;
+		}
+	}
+
+	bool matches (double r, Trigger::StretchMode m) const {
+		return mode == m && fabs (ratio - r) <= 1e-6 * r;
+	}
+
+	std::vector<Sample*> data;
+	samplecnt_t          length;
+	samplecnt_t          capacity;
+	double               ratio;
+	Trigger::StretchMode mode;
+};
+
+/* Offline time-stretch of the complete clip, processed by the
+ * TriggerBoxThread in chunks, so that other requests (notably
+ * refilling streams) are not delayed.
+ *
+ * The job holds a reference to the clip's data and only touches the
+ * trigger itself when it is created and when the result is installed.
+ */
+struct AudioTrigger::PreStretch {
+	PreStretch (AudioTrigger&, double ratio);
+	~PreStretch ();
+
+	/* @return true when done */
+	bool run ();
+
+	AudioTrigger&                    trigger;
+	double                           ratio;
+	Trigger::StretchMode             mode;
+	ClipDataCache::EntryPtr          src;
+	RubberBand::RubberBandStretcher* rb;
+	Render*                          out;
+	std::vector<Sample*>             scratch;
+	samplepos_t                      studied;
+	samplepos_t                      processed;
+
+	static const samplecnt_t chunk = 16384;
+};
+
+const samplecnt_t AudioTrigger::PreStretch::chunk;
+
+AudioTrigger::PreStretch::PreStretch (AudioTrigger& t, double r)
+	: trigger (t)
+	, ratio (r)
+	, mode (t._stretch_mode)
+	, src (t.data.shared)
+	, rb (0)
+	, out (0)
+	, studied (0)
+	, processed (0)
+{
+	using namespace RubberBand;
+
+	RubberBandStretcher::Option ro = RubberBandStretcher::Option (0);
+	switch (mode) {
+		case Trigger::Crisp  : ro = RubberBandStretcher::OptionTransientsCrisp; break;
+		case Trigger::Mixed  : ro = RubberBandStretcher::OptionTransientsMixed; break;
+		case Trigger::Smooth : ro = RubberBandStretcher::OptionTransientsSmooth; break;
+	}
+
+	const uint32_t nchans = src->data.size ();
+
+	rb = new RubberBandStretcher (t._box.session().sample_rate(), nchans, RubberBandStretcher::Option (RubberBandStretcher::OptionProcessOffline | ro), ratio, 1.0);
+	rb->setExpectedInputDuration (src->length);
+	rb->setMaxProcessSize (chunk);
+
+	out = new Render (nchans, ceil (src->length * ratio) + chunk, ratio, mode);
+
+	for (uint32_t n = 0; n < nchans; ++n) {
+		scratch.push_back (new Sample[chunk]);
+	}
+}
+
+AudioTrigger::PreStretch::~PreStretch ()
+{
+	delete rb;
+	delete out;
+	for (auto & s : scratch) {
+		delete [] s;
+	}
+}
+
+bool
+AudioTrigger::PreStretch::run ()
+{
+	const uint32_t    nchans = src->data.size ();
+	const samplecnt_t len    = src->length;
+
+	float const** in = (float const**) alloca (nchans * sizeof (float*));
+
+	if (studied < len) {
+		const samplecnt_t n = std::min (chunk, len - studied);
+		for (uint32_t c = 0; c < nchans; ++c) {
+			in[c] = src->data[c] + studied;
+		}
+		studied += n;
+		rb->study (in, n, studied == len);
+		return false;
+	}
+
+	if (processed < len) {
+		const samplecnt_t n = std::min (chunk, len - processed);
+		for (uint32_t c = 0; c < nchans; ++c) {
+			in[c] = src->data[c] + processed;
+		}
+		processed += n;
+		rb->process (in, n, processed == len);
+	}
+
+	int avail;
+
+	while ((avail = rb->available ()) > 0) {
+		const samplecnt_t n = std::min<samplecnt_t> (avail, chunk);
+		const samplecnt_t room = std::min (n, out->capacity - out->length);
+		rb->retrieve (&scratch[0], n);
+		for (uint32_t c = 0; c < nchans; ++c) {
+			memcpy (out->data[c] + out->length, scratch[c], sizeof (Sample) * room);
+		}
+		out->length += room;
+	}
+
+	/* available () returns -1 once all output has been retrieved */
+	return processed == len && avail < 0;
+}
+
 AudioTrigger::AudioTrigger (uint32_t n, TriggerBox& b)
 	: Trigger (n, b)
+	, _stream (0)
 	, _stretcher (0)
 	, _start_offset (0)
+	, _render (0)
+	, _render_in_use (0)
+	, _prestretch_requested (false)
+	, _playing (0)
+	, _render_pos (0)
+	, _check_render (false)
 	, read_index (0)
 	, last_readable_sample (0)
 	, _legato_offset (0)
@@ -1400,6 +1695,222 @@ AudioTrigger::~AudioTrigger ()
 	delete _stretcher;
 }
 
+bool
+AudioTrigger::streaming () const
+{
+	return _stream && data.capacity < data.length;
+}
+
+size_t
+AudioTrigger::memory_usage () const
+{
+	size_t rv = data.size () * data.capacity * sizeof (Sample);
+
+	if (data.shared) {
+		/* our share, the cache holds one reference */
+		rv /= std::max<long> (1, data.shared.use_count () - 1);
+	}
+
+	if (_stream) {
+		rv += _stream->memory_usage ();
+	}
+
+	return rv;
+}
+
+/** Set @a src to point to the data of each channel at @a pos.
+ * Realtime safe.
+ *
+ * For streamed clips this may be less than the requested @a cnt samples,
+ * when the data is not in memory, it is copied from the stream.
+ *
+ * @return number of samples that can be read from @a src
+ */
+samplecnt_t
+AudioTrigger::data_at (samplepos_t pos, samplecnt_t cnt, Sample const** src)
+{
+	if (!streaming () || cnt == 0 || pos + cnt <= data.capacity) {
+		for (uint32_t n = 0; n < data.size (); ++n) {
+			src[n] = data[n] + pos;
+		}
+		return cnt;
+	}
+
+	if (pos < data.capacity) {
+		/* up to the end of the data in memory */
+		for (uint32_t n = 0; n < data.size (); ++n) {
+			src[n] = data[n] + pos;
+		}
+		return data.capacity - pos;
+	}
+
+	bool need_refill;
+
+	cnt = std::min (cnt, Stream::scratch_size);
+
+	if (!_stream->read (pos, cnt, need_refill)) {
+		DEBUG_TRACE (DEBUG::Triggers, string_compose ("%1 stream underrun at %2\n", name (), pos));
+	}
+
+	if (need_refill && !_stream->refill_pending.exchange (true)) {
+		TriggerBox::worker->request_stream_refill (this);
+	}
+
+	for (uint32_t n = 0; n < data.size (); ++n) {
+		src[n] = _stream->scratch[n];
+	}
+
+	return cnt;
+}
+
+/** Prepare rendering the clip at the given stretch ratio,
+ * called in the TriggerBoxThread.
+ */
+AudioTrigger::PreStretch*
+AudioTrigger::create_prestretch (double ratio)
+{
+	_prestretch_requested = false;
+
+	if (!data.shared || streaming () || ratio <= 0) {
+		/* only for clips that are completely in memory */
+		return 0;
+	}
+
+	Render* r = _render.load ();
+
+	if (r && r->matches (ratio, _stretch_mode)) {
+		return 0;
+	}
+
+	try {
+		return new PreStretch (*this, ratio);
+	} catch (...) {
+		return 0;
+	}
+}
+
+/** Publish the result of a completed PreStretch job,
+ * called in the TriggerBoxThread.
+ */
+void
+AudioTrigger::install_prestretch (PreStretch& job)
+{
+	DEBUG_TRACE (DEBUG::Triggers, string_compose ("%1 pre-stretched %2 samples at ratio %3\n", name (), job.out->length, job.ratio));
+
+	Render* old = _render.exchange (job.out);
+	job.out = 0;
+	_prestretch_requested = false;
+
+	if (old) {
+		_retired_renders.push_back (old);
+	}
+
+	/* free renders that the process thread is not using */
+	for (auto i = _retired_renders.begin (); i != _retired_renders.end ();) {
+		if (*i != _render_in_use.load ()) {
+			delete *i;
+			i = _retired_renders.erase (i);
+		} else {
+			++i;
+		}
+	}
+}
+
+/** Decide if the pre-stretched data can be used, called by the
+ * process thread before a pass through the clip.
+ */
+void
+AudioTrigger::use_render (double ratio)
+{
+	Render* r = _render.load ();
+
+	/* announce it before use, then check that it was not replaced
+	 * (and possibly freed) in the meantime.
+	 */
+	_render_in_use.store (r);
+
+	if (r && r == _render.load () && r->matches (ratio, _stretch_mode)) {
+		_playing    = r;
+		_render_pos = llrint (read_index * r->ratio);
+		return;
+	}
+
+	_playing = 0;
+	_render_in_use.store (0);
+
+	if (Config->get_prestretch_clips () && data.shared && !streaming () && !_prestretch_requested.exchange (true)) {
+		TriggerBox::worker->request_prestretch (this, ratio);
+	}
+}
+
+void
+AudioTrigger::drop_renders ()
+{
+	if (TriggerBox::worker) {
+		TriggerBox::worker->cancel_prestretch (this);
+	}
+
+	_playing = 0;
+	_render_in_use.store (0);
+	delete _render.exchange (0);
+
+	for (auto & r : _retired_renders) {
+		delete r;
+	}
+	_retired_renders.clear ();
+	_prestretch_requested = false;
+}
+
+/** Read data into the stream buffer, called in the TriggerBoxThread */
+void
+AudioTrigger::refill_stream ()
+{
+	if (!_stream) {
+		return;
+	}
+
+	Stream& s (*_stream);
+	s.refill_pending = false;
+
+	std::shared_ptr<AudioRegion> ar = std::dynamic_pointer_cast<AudioRegion> (_region);
+
+	if (!ar) {
+		return;
+	}
+
+	while (true) {
+
+		samplepos_t seek = s.seek_pos.load ();
+
+		if (seek >= 0) {
+			s.write_pos.store (seek);
+			if (!s.seek_pos.compare_exchange_strong (seek, -1)) {
+				/* repositioned again in the meantime */
+				continue;
+			}
+		}
+
+		const samplepos_t w   = s.write_pos.load ();
+		const samplepos_t end = std::min (data.length, s.read_pos.load () + s.size);
+
+		if (w >= end) {
+			break;
+		}
+
+		const samplecnt_t off = w % s.size;
+		const samplecnt_t cnt = std::min (std::min (end - w, Stream::read_chunk), s.size - off);
+
+		for (uint32_t n = 0; n < s.buf.size (); ++n) {
+			const samplecnt_t got = ar->read (s.buf[n] + off, w, cnt, n);
+			if (got < cnt) {
+				memset (s.buf[n] + off + std::max<samplecnt_t> (0, got), 0, sizeof (Sample) * (cnt - std::max<samplecnt_t> (0, got)));
+			}
+		}
+
+		s.write_pos.store (w + cnt);
+	}
+}
+
 Sample const *
 AudioTrigger::audio_data (size_t n) const
 {
@@ -1841,7 +2352,8 @@ AudioTrigger::estimate_tempo ()
 
 			breakfastquay::MiniBPM mbpm (_box.session().sample_rate());
 
-			_estimated_tempo = mbpm.estimateTempoOfSamples (data[0], data.length);
+			/* only the head of streamed clips is available */
+			_estimated_tempo = mbpm.estimateTempoOfSamples (data[0], std::min (data.length, data.capacity));
 
 			//cerr << name() << "MiniBPM Estimated: " << _estimated_tempo << " bpm from " << (double) data.length / _box.session().sample_rate() << " seconds\n";
 		}
@@ -1961,10 +2473,22 @@ AudioTrigger::setup_stretcher ()
 void
 AudioTrigger::drop_data ()
 {
-	for (auto& d : data) {
-		delete [] d;
+	drop_renders ();
+
+	if (data.shared) {
+		data.shared.reset ();
+		ClipDataCache::instance ().evict (Config->get_clip_cache_size () * 1048576);
+	} else {
+		for (auto& d : data) {
+			delete [] d;
+		}
 	}
 	data.clear ();
+	data.length = 0;
+	data.capacity = 0;
+
+	delete _stream;
+	_stream = 0;
 }
 
 void
@@ -1977,6 +2501,8 @@ AudioTrigger::captured (SlotArmInfo& ai, BufferSet&)
 	}
 
 	data.clear ();
+	/* realtime safe, the data is not freed while the cache references it */
+	data.shared.reset ();
 
 	data.length = ai.audio_buf.length;
 	data.capacity = ai.audio_buf.capacity;
@@ -2023,17 +2549,42 @@ AudioTrigger::load_data (std::shared_ptr<AudioRegion> ar)
 	drop_data ();
 
 	try {
-		samplecnt_t len = ar->length_samples();
+		const samplecnt_t len       = ar->length_samples();
+		const samplecnt_t sr        = _box.session().sample_rate();
+		const samplecnt_t threshold = Config->get_clip_streaming_threshold () * sr;
 
-		data.alloc (len, nchans);
+		/* For long clips only the head is read into memory, the rest
+		 * is streamed from disk. The head needs to cover the time it
+		 * takes to refill the stream after a relaunch.
+		 */
+		samplecnt_t head = len;
 
-		for (uint32_t n = 0; n < nchans; ++n) {
-			ar->read (data[n], 0, len, n);
+		if (threshold > 0 && len > threshold) {
+			head = std::min<samplecnt_t> (len, std::max<samplecnt_t> (4 * rb_blocksize, Config->get_audio_playback_buffer_seconds () * sr));
 		}
 
-		data.length = len;
+		/* clips using the same part of the same sources share the data */
+		ClipDataCache::EntryPtr e = ClipDataCache::instance ().get (ar, head);
+
+		if (!e) {
+			return -1;
+		}
+
+		data.assign (e->data.begin (), e->data.end ());
+		data.shared   = e;
+		data.length   = len;
+		data.capacity = e->capacity;
 		set_name (ar->name());
 
+		if (data.capacity < len) {
+			_stream = new Stream (nchans, data.capacity);
+			/* preroll, so that the first launch is seamless */
+			_stream->seek (data.capacity);
+			refill_stream ();
+
+			DEBUG_TRACE (DEBUG::Triggers, string_compose ("%1 streaming %2 samples after %3\n", name(), len - data.capacity, data.capacity));
+		}
+
 	} catch (...) {
 		drop_data ();
 		return -1;
@@ -2053,6 +2604,17 @@ AudioTrigger::retrigger ()
 	read_index = _start_offset + _legato_offset;
 	retrieved = 0;
 	_legato_offset = 0; /* used one time only */
+	_check_render = true;
+
+	if (streaming ()) {
+		/* make the stream continue where the data in memory ends. If the
+		 * clip is retriggered at stop, this happens long before the next
+		 * launch, otherwise the head covers the time it takes to refill.
+		 */
+		if (_stream->seek (std::max (read_index, data.capacity)) && !_stream->refill_pending.exchange (true)) {
+			TriggerBox::worker->request_stream_refill (this);
+		}
+	}
 
 	DEBUG_TRACE (DEBUG::Triggers, string_compose ("%1 retriggered to %2\n", _index, read_index));
 }
@@ -2072,6 +2634,7 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 	BufferSet* scratch;
 	std::unique_ptr<BufferSet> scratchp;
 	std::vector<Sample*> bufp(nchans);
+	Sample const** data_src = (Sample const**) alloca (std::max<size_t> (1, data.size ()) * sizeof (Sample const*));
 	const bool do_stretch = stretching() && _segment_tempo > 1;
 
 	quantize_offset = 0;
@@ -2119,9 +2682,28 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 		bufp[chn] = scratch->get_audio (chn).data();
 	}
 
+	if (do_stretch && !_playout) {
+
+		const double stretch = _segment_tempo / bpm;
+
+		if (_check_render) {
+			/* start of a pass through the clip */
+			_check_render = false;
+			use_render (stretch);
+		} else if (_playing && !_playing->matches (stretch, _stretch_mode)) {
+			/* tempo changed, continue using the stretcher from here */
+			DEBUG_TRACE (DEBUG::Triggers, string_compose ("%1 ratio changed to %2, stop using pre-stretched data\n", name(), stretch));
+			_playing = 0;
+			_render_in_use.store (0);
+		}
+	} else if (!do_stretch && _playing) {
+		_playing = 0;
+		_render_in_use.store (0);
+	}
+
 	/* tell the stretcher what we are doing for this ::run() call */
 
-	if (do_stretch && !_playout) {
+	if (do_stretch && !_playing && !_playout) {
 
 		const double stretch = _segment_tempo / bpm;
 		_stretcher->setTimeRatio (stretch);
@@ -2180,7 +2762,28 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 
 		if (do_stretch) {
 
-			if (read_index < last_readable_sample) {
+			if (_playing) {
+
+				/* pre-stretched data, positions are scaled by the ratio */
+				const samplepos_t render_end = std::min<samplepos_t> (_playing->length, llrint (last_readable_sample * _playing->ratio));
+
+				from_stretcher = (pframes_t) std::min<samplecnt_t> (nframes, std::max<samplecnt_t> (0, render_end - _render_pos));
+
+				for (uint32_t chn = 0; chn < data.size (); ++chn) {
+					data_src[chn] = _playing->data[chn] + _render_pos;
+				}
+
+				_render_pos += from_stretcher;
+				retrieved   += from_stretcher;
+				avail        = 0;
+
+				if (_render_pos >= render_end) {
+					read_index = last_readable_sample;
+				} else {
+					read_index = std::min<samplepos_t> (last_readable_sample, _render_pos / _playing->ratio);
+				}
+
+			} else if (read_index < last_readable_sample) {
 
 				/* still have data to push into the stretcher */
 
@@ -2189,15 +2792,19 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 					to_stretcher = (pframes_t) std::min (samplecnt_t (rb_blocksize), (last_readable_sample - read_index));
 					bool at_end = (to_stretcher < rb_blocksize);
 
+					/* streamed clips may provide less */
+					to_stretcher = data_at (read_index, to_stretcher, data_src);
+					at_end = at_end && (read_index + to_stretcher >= last_readable_sample);
+
 					/* keep feeding the stretcher in chunks of "to_stretcher",
 					 * until there's nframes of data available, or we reach
 					 * the end of the region
 					 */
 
-					float** in = (float**)alloca(nchans * sizeof (float*));
+					float const** in = (float const**)alloca(nchans * sizeof (float*));
 
 					for (uint32_t chn = 0; chn < nchans; ++chn) {
-						in[chn] = data[chn % data.size ()] + read_index;
+						in[chn] = data_src[chn % data.size ()];
 					}
 
 					/* Note: RubberBandStretcher's process() and retrieve() API's accepts Sample**
@@ -2236,7 +2843,9 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 
 			/* fetch the stretch */
 
-			retrieved += _stretcher->retrieve (&bufp[0], from_stretcher);
+			if (!_playing) {
+				retrieved += _stretcher->retrieve (&bufp[0], from_stretcher);
+			}
 
 			if (read_index >= last_readable_sample) {
 
@@ -2273,6 +2882,8 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 			/* no stretch */
 			assert (last_readable_sample >= read_index);
 			from_stretcher = std::min<samplecnt_t> (nframes, last_readable_sample - read_index);
+			/* streamed clips may provide less, deliver the rest in the next iteration */
+			from_stretcher = data_at (read_index, from_stretcher, data_src);
 			// cerr << "FS#3 from lrs " << last_readable_sample <<  " - " << read_index << " = " << from_stretcher << endl;
 
 		}
@@ -2287,7 +2898,7 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 
 				uint32_t channel = chn %  data.size();
 				AudioBuffer& buf (bufs.get_audio (chn));
-				Sample* src = do_stretch ? bufp[channel] : (data[channel] + read_index);
+				Sample const* src = (do_stretch && !_playing) ? bufp[channel] : data_src[channel];
 
 				gain_t gain;
 
@@ -2317,7 +2928,7 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 		}
 
 		nframes -= from_stretcher;
-		avail = _stretcher->available ();
+		avail = _playing ? 0 : _stretcher->available ();
 		dest_offset += from_stretcher;
 
 		if (read_index >= last_readable_sample && (!do_stretch || avail <= 0)) {
@@ -2383,6 +2994,13 @@ AudioTrigger::reload (BufferSet&, void*)
 
 /*--------------------*/
 
+size_t
+MIDITrigger::memory_usage () const
+{
+	RTMidiBufferBeats const* rtmb = rt_midibuffer.load ();
+	return rtmb ? rtmb->size () * sizeof (RTMidiBufferBeats::Item) : 0;
+}
+
 MIDITrigger::MIDITrigger (uint32_t n, TriggerBox& b)
 	: Trigger (n, b)
 	, data_length (Temporal::Beats())
@@ -5677,6 +6295,41 @@ TriggerBox::dump (std::ostream & ostr) const
 	for (auto const & t : all_triggers) {
 		ostr << "\tTrigger " << t->index() << " state " << enum_2_string (t->state()) << std::endl;
 	}
+	memory_report (ostr);
+}
+
+size_t
+TriggerBox::memory_usage () const
+{
+	Glib::Threads::RWLock::ReaderLock lm (trigger_lock);
+	size_t rv = 0;
+	for (auto const & t : all_triggers) {
+		rv += t->memory_usage ();
+	}
+	return rv;
+}
+
+void
+TriggerBox::memory_report (std::ostream & ostr) const
+{
+	Glib::Threads::RWLock::ReaderLock lm (trigger_lock);
+	size_t total = 0;
+
+	ostr << "TriggerBox " << order() << std::endl;
+	for (auto const & t : all_triggers) {
+		if (!t->the_region ()) {
+			continue;
+		}
+		const size_t bytes = t->memory_usage ();
+		ostr << "\tTrigger " << t->index() << " '" << t->name () << "' " << (bytes / 1024) << " kB" << (t->streaming () ? " (streamed)" : "") << std::endl;
+		total += bytes;
+	}
+	ostr << "\tTotal " << (total / 1024) << " kB" << std::endl;
+
+	ClipDataCache::Stats const cs (ClipDataCache::instance ().stats ());
+	ostr << "Clip data cache: " << cs.entries << " entries (" << cs.unused << " unused), "
+	     << (cs.bytes / 1024) << " kB (" << (cs.unused_bytes / 1024) << " kB unused), "
+	     << cs.hits << " hits, " << cs.misses << " misses, " << cs.evictions << " evictions" << std::endl;
 }
 
 /* Thread */
@@ -5714,13 +6367,22 @@ TriggerBoxThread::thread_work ()
 	while (true) {
 
 		char msg;
+		bool busy;
 
-		if (_xthread.receive (msg, true) >= 0) {
+		{
+			Glib::Threads::Mutex::Lock lm (_prestretch_lock);
+			busy = !_prestretch.empty ();
+		}
 
-			if (msg == (char) Quit) {
-				return (void *) 0;
-				abort(); /*NOTREACHED*/
-			}
+		/* do not wait for requests while there is pre-stretching to do */
+		const bool got_msg = _xthread.receive (msg, !busy) >= 0;
+
+		if (got_msg && msg == (char) Quit) {
+			return (void *) 0;
+			abort(); /*NOTREACHED*/
+		}
+
+		if (got_msg || busy) {
 
 			Temporal::TempoMap::fetch ();
 
@@ -5737,11 +6399,21 @@ TriggerBoxThread::thread_work ()
 				case BuildSourceAndRegion:
 					build_source (req->trigger, req->duration);
 					break;
+				case RefillStream:
+					static_cast<AudioTrigger*> (req->trigger)->refill_stream ();
+					break;
+				case PreStretchClip:
+					prestretch (static_cast<AudioTrigger*> (req->trigger), req->ratio);
+					break;
 				default:
 					break;
 				}
 				delete req; /* back to pool */
 			}
+
+			if (busy) {
+				run_prestretch ();
+			}
 		}
 	}
 
@@ -5813,6 +6485,88 @@ TriggerBoxThread::request_build_source (Trigger* t, Temporal::timecnt_t const &
 	queue_request (req);
 }
 
+/* called from the process thread */
+void
+TriggerBoxThread::request_stream_refill (AudioTrigger* t)
+{
+	TriggerBoxThread::Request* req = new TriggerBoxThread::Request (RefillStream);
+	req->trigger  = t;
+	queue_request (req);
+}
+
+/* called from the process thread */
+void
+TriggerBoxThread::request_prestretch (AudioTrigger* t, double ratio)
+{
+	TriggerBoxThread::Request* req = new TriggerBoxThread::Request (PreStretchClip);
+	req->trigger = t;
+	req->ratio   = ratio;
+	queue_request (req);
+}
+
+/* Drop any pending pre-stretch of the given trigger. Once this returns,
+ * the trigger will not be touched by a pre-stretch job.
+ */
+void
+TriggerBoxThread::cancel_prestretch (AudioTrigger* t)
+{
+	Glib::Threads::Mutex::Lock lm (_prestretch_lock);
+
+	for (auto i = _prestretch.begin (); i != _prestretch.end ();) {
+		if (&(*i)->trigger == t) {
+			delete *i;
+			i = _prestretch.erase (i);
+		} else {
+			++i;
+		}
+	}
+}
+
+void
+TriggerBoxThread::prestretch (AudioTrigger* t, double ratio)
+{
+	Glib::Threads::Mutex::Lock lm (_prestretch_lock);
+
+	for (auto i = _prestretch.begin (); i != _prestretch.end (); ++i) {
+		if (&(*i)->trigger != t) {
+			continue;
+		}
+		if ((*i)->ratio == ratio && (*i)->mode == t->stretch_mode ()) {
+			/* already in progress */
+			return;
+		}
+		/* the tempo changed again, e.g. during a ramp */
+		delete *i;
+		_prestretch.erase (i);
+		break;
+	}
+
+	AudioTrigger::PreStretch* job = t->create_prestretch (ratio);
+
+	if (job) {
+		_prestretch.push_back (job);
+	}
+}
+
+/* process a chunk of the oldest pre-stretch job */
+void
+TriggerBoxThread::run_prestretch ()
+{
+	Glib::Threads::Mutex::Lock lm (_prestretch_lock);
+
+	if (_prestretch.empty ()) {
+		return;
+	}
+
+	AudioTrigger::PreStretch* job = _prestretch.front ();
+
+	if (job->run ()) {
+		job->trigger.install_prestretch (*job);
+		_prestretch.pop_front ();
+		delete job;
+	}
+}
+
 void
 TriggerBoxThread::delete_trigger (Trigger* t)
 {
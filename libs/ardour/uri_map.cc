@@ -132,7 +132,24 @@ c_urid_unmap(LV2_URID_Unmap_Handle handle,
 	return me->id_to_uri(urid);
 }
 
+URIMap::Slots::Slots(uint32_t n)
+	: size(n)
+	, slots(new std::atomic<const Entry*>[n])
+{
+	for (uint32_t i = 0; i < n; ++i) {
+		slots[i].store(NULL, std::memory_order_relaxed);
+	}
+}
+
+URIMap::Slots::~Slots()
+{
+	delete [] slots;
+}
+
 URIMap::URIMap()
+	: _map(new Slots(1024))
+	, _unmap(new Slots(512))
+	, _n_contended(0)
 {
 	_urid_map_feature_data.map    = c_urid_map;
 	_urid_map_feature_data.handle = this;
@@ -147,30 +164,135 @@ URIMap::URIMap()
 	urids.init(*this);
 }
 
+URIMap::~URIMap()
+{
+	delete _map.load();
+	delete _unmap.load();
+	for (std::vector<Slots*>::iterator i = _retired.begin(); i != _retired.end(); ++i) {
+		delete *i;
+	}
+	for (std::vector<Entry*>::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+		delete *i;
+	}
+}
+
+uint32_t
+URIMap::hash(const char* uri)
+{
+	/* FNV-1a */
+	uint32_t h = 2166136261u;
+	for (const unsigned char* c = (const unsigned char*)uri; *c; ++c) {
+		h = (h ^ *c) * 16777619u;
+	}
+	return h;
+}
+
+uint32_t
+URIMap::lookup(const Slots* map, const char* uri, const uint32_t hash)
+{
+	const uint32_t mask = map->size - 1;
+	for (uint32_t i = hash & mask;; i = (i + 1) & mask) {
+		const Entry* e = map->slots[i].load(std::memory_order_acquire);
+		if (!e) {
+			return 0;
+		}
+		if (e->hash == hash && e->uri == uri) {
+			return e->id;
+		}
+	}
+}
+
+void
+URIMap::place(Slots* map, const Entry* e)
+{
+	const uint32_t mask = map->size - 1;
+	for (uint32_t i = e->hash & mask;; i = (i + 1) & mask) {
+		if (!map->slots[i].load(std::memory_order_relaxed)) {
+			map->slots[i].store(e, std::memory_order_release);
+			return;
+		}
+	}
+}
+
 uint32_t
 URIMap::uri_to_id(const char* uri)
 {
-	Glib::Threads::Mutex::Lock lm (_lock);
+	const uint32_t h  = hash(uri);
+	const uint32_t id = lookup(_map.load(std::memory_order_acquire), uri, h);
+	if (id) {
+		return id;
+	}
+
+	Glib::Threads::Mutex::Lock lm (_lock, Glib::Threads::TRY_LOCK);
+	if (!lm.locked()) {
+		_n_contended.fetch_add(1, std::memory_order_relaxed);
+		lm.acquire();
+	}
+
+	return insert(uri, h);
+}
+
+uint32_t
+URIMap::insert(const char* uri, const uint32_t h)
+{
+	/* another thread may have added it meanwhile */
+	Slots* map = _map.load(std::memory_order_relaxed);
+	if (const uint32_t id = lookup(map, uri, h)) {
+		return id;
+	}
+
+	const uint32_t id = _entries.size() + 1;
+	Entry* e = new Entry(uri, h, id);
+	_entries.push_back(e);
+
+	/* Tables are replaced when they grow. Concurrent readers may still
+	 * use the previous one, so those are kept until the map is destroyed.
+	 */
+	Slots* unmap = _unmap.load(std::memory_order_relaxed);
+	if (id > unmap->size) {
+		Slots* n = new Slots(unmap->size * 2);
+		for (uint32_t i = 0; i < unmap->size; ++i) {
+			n->slots[i].store(unmap->slots[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+		}
+		_unmap.store(n, std::memory_order_release);
+		_retired.push_back(unmap);
+		unmap = n;
+	}
+	unmap->slots[id - 1].store(e, std::memory_order_release);
 
-	const std::string urimm(uri);
-	const Map::const_iterator i = _map.find(urimm);
-	if (i != _map.end()) {
-		return i->second;
+	/* keep the hash-table at most half full */
+	if (2 * id > map->size) {
+		Slots* n = new Slots(map->size * 2);
+		for (std::vector<Entry*>::const_iterator i = _entries.begin(); i != _entries.end(); ++i) {
+			if (*i != e) {
+				place(n, *i);
+			}
+		}
+		_map.store(n, std::memory_order_release);
+		_retired.push_back(map);
+		map = n;
 	}
-	const uint32_t id = _map.size() + 1;
-	_map.insert(std::make_pair(urimm, id));
-	_unmap.insert(std::make_pair(id, urimm));
+	place(map, e);
+
 	return id;
 }
 
 const char*
 URIMap::id_to_uri(const uint32_t id) const
 {
-	Glib::Threads::Mutex::Lock lm (_lock);
+	const Slots* unmap = _unmap.load(std::memory_order_acquire);
+	if (id == 0 || id > unmap->size) {
+		return NULL;
+	}
+	const Entry* e = unmap->slots[id - 1].load(std::memory_order_acquire);
+	return e ? e->uri.c_str() : NULL;
+}
 
-	const Unmap::const_iterator i = _unmap.find(id);
-	return (i != _unmap.end()) ? i->second.c_str() : NULL;
+uint32_t
+URIMap::size() const
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	return _entries.size();
 }
 
 } // namespace ARDOUR
-
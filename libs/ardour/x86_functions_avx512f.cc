@@ -22,6 +22,9 @@
 
 #include <immintrin.h>
 
+#include <algorithm>
+#include <cmath>
+
 #define IS_ALIGNED_TO(ptr, bytes) \
 	(reinterpret_cast<uintptr_t>(ptr) % (bytes) == 0)
 
@@ -1146,4 +1149,433 @@ x86_avx512f_copy_vector(float *dst, const float *src, uint32_t nframes)
 	_mm256_zeroupper(); // zeros the upper portion of YMM register
 }
 
+/**
+ * @brief x86-64 AVX-512F multi-channel biquad cascade, processes 16 channels in parallel
+ *
+ * Remaining channels are processed using masked loads and stores.
+ *
+ * @param[in,out] buf interleaved audio data
+ * @param n_channels number of interleaved channels
+ * @param nframes number of frames to process
+ * @param n_stages number of biquad sections
+ * @param coeff filter coefficients, see default_biquad_cascade()
+ * @param[in,out] state filter state, see default_biquad_cascade()
+ */
+void
+x86_avx512f_biquad_cascade(float *buf, uint32_t n_channels, uint32_t nframes, uint32_t n_stages, const float *coeff, float *state)
+{
+	for (uint32_t s = 0; s < n_stages; ++s) {
+		const float *c = &coeff[s * 5 * n_channels];
+		float       *z = &state[s * 2 * n_channels];
+
+		for (uint32_t l = 0; l < n_channels; l += 16) {
+			const uint32_t  n_lanes = std::min<uint32_t>(16, n_channels - l);
+			const __mmask16 m       = (__mmask16)((1u << n_lanes) - 1);
+
+			const __m512 b0 = _mm512_maskz_loadu_ps(m, &c[0 * n_channels + l]);
+			const __m512 b1 = _mm512_maskz_loadu_ps(m, &c[1 * n_channels + l]);
+			const __m512 b2 = _mm512_maskz_loadu_ps(m, &c[2 * n_channels + l]);
+			const __m512 a1 = _mm512_maskz_loadu_ps(m, &c[3 * n_channels + l]);
+			const __m512 a2 = _mm512_maskz_loadu_ps(m, &c[4 * n_channels + l]);
+
+			__m512 z1 = _mm512_maskz_loadu_ps(m, &z[l]);
+			__m512 z2 = _mm512_maskz_loadu_ps(m, &z[n_channels + l]);
+
+			float *d = &buf[l];
+			for (uint32_t i = 0; i < nframes; ++i, d += n_channels) {
+				const __m512 x = _mm512_maskz_loadu_ps(m, d);
+				const __m512 y = _mm512_fmadd_ps(b0, x, z1);
+				z1 = _mm512_fnmadd_ps(a1, y, _mm512_fmadd_ps(b1, x, z2));
+				z2 = _mm512_fnmadd_ps(a2, y, _mm512_mul_ps(b2, x));
+				_mm512_mask_storeu_ps(d, m, y);
+			}
+
+			_mm512_mask_storeu_ps(&z[l], m, z1);
+			_mm512_mask_storeu_ps(&z[n_channels + l], m, z2);
+		}
+	}
+
+	// There's a penalty going from AVX mode to SSE mode. This can
+	// be avoided by ensuring the CPU that rest of the routine is no
+	// longer interested in the upper portion of the YMM register.
+
+	_mm256_zeroupper(); // zeros the upper portion of YMM register
+}
+
+/**
+ * @brief x86-64 AVX-512F one-pole gain ramp (declick), processes 16 samples in parallel
+ *
+ * Uses the closed form g[i] = target + (initial - target) * (1 - coeff)^i
+ *
+ * @return gain after the last sample
+ */
+float
+x86_avx512f_apply_gain_ramp(float *buf, uint32_t nframes, float initial, float target, float coeff)
+{
+	float p[16];
+	p[0] = 1.f;
+	for (int k = 1; k < 16; ++k) {
+		p[k] = p[k - 1] * (1.f - coeff);
+	}
+
+	const __m512 t = _mm512_set1_ps(target);
+	const __m512 r = _mm512_set1_ps(p[15] * (1.f - coeff));
+	__m512       d = _mm512_mul_ps(_mm512_set1_ps(initial - target), _mm512_loadu_ps(p));
+
+	while (nframes >= 16) {
+		const __m512 x = _mm512_loadu_ps(buf);
+		_mm512_storeu_ps(buf, _mm512_mul_ps(x, _mm512_add_ps(t, d)));
+		d = _mm512_mul_ps(d, r);
+		buf += 16;
+		nframes -= 16;
+	}
+
+	/* the remaining samples and the returned gain (that of the next
+	 * sample) use the same closed form as the vectorized loop */
+	float dv[16];
+	_mm512_storeu_ps(dv, d);
+
+	_mm256_zeroupper(); // zeros the upper portion of YMM register
+
+	for (uint32_t i = 0; i < nframes; ++i) {
+		buf[i] *= target + dv[i];
+	}
+	return target + dv[nframes];
+}
+
+/**
+ * @brief x86-64 AVX-512F mix buffers with a linear gain ramp from initial to target
+ */
+void
+x86_avx512f_mix_buffers_with_ramp(float *dst, const float *src, uint32_t nframes, float initial, float target)
+{
+	const float  delta   = (target - initial) / nframes;
+	const __m512 g0      = _mm512_set1_ps(initial);
+	const __m512 dv      = _mm512_set1_ps(delta);
+	const __m512 sixteen = _mm512_set1_ps(16.f);
+	__m512       idx     = _mm512_set_ps(15.f, 14.f, 13.f, 12.f, 11.f, 10.f, 9.f, 8.f,
+	                                     7.f, 6.f, 5.f, 4.f, 3.f, 2.f, 1.f, 0.f);
+
+	uint32_t i = 0;
+	for (; i + 16 <= nframes; i += 16) {
+		const __m512 g = _mm512_fmadd_ps(dv, idx, g0);
+		_mm512_storeu_ps(&dst[i], _mm512_fmadd_ps(_mm512_loadu_ps(&src[i]), g, _mm512_loadu_ps(&dst[i])));
+		idx = _mm512_add_ps(idx, sixteen);
+	}
+
+	_mm256_zeroupper(); // zeros the upper portion of YMM register
+
+	for (; i < nframes; ++i) {
+		dst[i] = dst[i] + src[i] * (initial + delta * (float)i);
+	}
+}
+
+/**
+ * @brief x86-64 AVX-512F interleave a single channel, using scatter stores
+ */
+void
+x86_avx512f_interleave(float *dst, const float *src, uint32_t nframes, uint32_t stride)
+{
+	if (stride == 1) {
+		x86_avx512f_copy_vector(dst, src, nframes);
+		return;
+	}
+
+	const __m512i vidx = _mm512_mullo_epi32(_mm512_set_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0),
+	                                        _mm512_set1_epi32(stride));
+
+	while (nframes >= 16) {
+		_mm512_i32scatter_ps(dst, vidx, _mm512_loadu_ps(src), 4);
+		src += 16;
+		dst += 16 * stride;
+		nframes -= 16;
+	}
+
+	_mm256_zeroupper(); // zeros the upper portion of YMM register
+
+	default_interleave(dst, src, nframes, stride);
+}
+
+/**
+ * @brief x86-64 AVX-512F de-interleave a single channel, using gather loads
+ */
+void
+x86_avx512f_deinterleave(float *dst, const float *src, uint32_t nframes, uint32_t stride)
+{
+	if (stride == 1) {
+		x86_avx512f_copy_vector(dst, src, nframes);
+		return;
+	}
+
+	const __m512i vidx = _mm512_mullo_epi32(_mm512_set_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0),
+	                                        _mm512_set1_epi32(stride));
+
+	while (nframes >= 16) {
+		_mm512_storeu_ps(dst, _mm512_i32gather_ps(vidx, src, 4));
+		src += 16 * stride;
+		dst += 16;
+		nframes -= 16;
+	}
+
+	_mm256_zeroupper(); // zeros the upper portion of YMM register
+
+	default_deinterleave(dst, src, nframes, stride);
+}
+
+/**
+ * @brief x86-64 AVX-512F convert float to signed 16 bit integer (round to nearest, clamp)
+ */
+void
+x86_avx512f_float_to_s16(int16_t *dst, const float *src, uint32_t nframes)
+{
+	const __m512 scale = _mm512_set1_ps(32768.f);
+	const __m512 vmin  = _mm512_set1_ps(-32768.f);
+	const __m512 vmax  = _mm512_set1_ps(32767.f);
+
+	while (nframes >= 16) {
+		__m512 x = _mm512_mul_ps(_mm512_loadu_ps(src), scale);
+		x = _mm512_min_ps(_mm512_max_ps(x, vmin), vmax);
+		_mm256_storeu_si256((__m256i *)dst, _mm512_cvtsepi32_epi16(_mm512_cvtps_epi32(x)));
+		src += 16;
+		dst += 16;
+		nframes -= 16;
+	}
+
+	_mm256_zeroupper(); // zeros the upper portion of YMM register
+
+	default_float_to_s16(dst, src, nframes);
+}
+
+/**
+ * @brief x86-64 AVX-512F convert float to signed 24 bit in the upper 24 bits of a 32 bit word
+ */
+void
+x86_avx512f_float_to_s24(int32_t *dst, const float *src, uint32_t nframes)
+{
+	const __m512 scale = _mm512_set1_ps(8388608.f);
+	const __m512 vmin  = _mm512_set1_ps(-8388608.f);
+	const __m512 vmax  = _mm512_set1_ps(8388607.f);
+
+	while (nframes >= 16) {
+		__m512 x = _mm512_mul_ps(_mm512_loadu_ps(src), scale);
+		x = _mm512_min_ps(_mm512_max_ps(x, vmin), vmax);
+		_mm512_storeu_si512(dst, _mm512_slli_epi32(_mm512_cvtps_epi32(x), 8));
+		src += 16;
+		dst += 16;
+		nframes -= 16;
+	}
+
+	_mm256_zeroupper(); // zeros the upper portion of YMM register
+
+	default_float_to_s24(dst, src, nframes);
+}
+
+/**
+ * @brief x86-64 AVX-512F sum of squares
+ */
+float
+x86_avx512f_sum_of_squares(const float *buf, uint32_t nframes)
+{
+	__m512 acc0 = _mm512_setzero_ps();
+	__m512 acc1 = _mm512_setzero_ps();
+
+	while (nframes >= 32) {
+		const __m512 x0 = _mm512_loadu_ps(buf);
+		const __m512 x1 = _mm512_loadu_ps(buf + 16);
+		acc0 = _mm512_fmadd_ps(x0, x0, acc0);
+		acc1 = _mm512_fmadd_ps(x1, x1, acc1);
+		buf += 32;
+		nframes -= 32;
+	}
+
+	float sum = _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+
+	_mm256_zeroupper(); // zeros the upper portion of YMM register
+
+	while (nframes > 0) {
+		sum += *buf * *buf;
+		++buf;
+		--nframes;
+	}
+	return sum;
+}
+
+/**
+ * @brief x86-64 AVX-512F subtract buffers, dst[i] -= src[i]
+ */
+void
+x86_avx512f_subtract_buffers(float *dst, const float *src, uint32_t nframes)
+{
+	uint32_t i = 0;
+	for (; i + 16 <= nframes; i += 16) {
+		_mm512_storeu_ps(&dst[i], _mm512_sub_ps(_mm512_loadu_ps(&dst[i]), _mm512_loadu_ps(&src[i])));
+	}
+
+	_mm256_zeroupper(); // zeros the upper portion of YMM register
+
+	for (; i < nframes; ++i) {
+		dst[i] -= src[i];
+	}
+}
+
+/**
+ * @brief x86-64 AVX-512F multiply and accumulate, dst[i] += a[i] * b[i]
+ */
+void
+x86_avx512f_multiply_add_buffers(float *dst, const float *a, const float *b, uint32_t nframes)
+{
+	uint32_t i = 0;
+	for (; i + 16 <= nframes; i += 16) {
+		const __m512 x = _mm512_fmadd_ps(_mm512_loadu_ps(&a[i]), _mm512_loadu_ps(&b[i]), _mm512_loadu_ps(&dst[i]));
+		_mm512_storeu_ps(&dst[i], x);
+	}
+
+	_mm256_zeroupper(); // zeros the upper portion of YMM register
+
+	for (; i < nframes; ++i) {
+		dst[i] += a[i] * b[i];
+	}
+}
+
+/**
+ * @brief x86-64 AVX-512F scale and offset, buf[i] = buf[i] * gain + offset
+ */
+void
+x86_avx512f_scale_offset_buffer(float *buf, uint32_t nframes, float gain, float offset)
+{
+	const __m512 g = _mm512_set1_ps(gain);
+	const __m512 o = _mm512_set1_ps(offset);
+
+	uint32_t i = 0;
+	for (; i + 16 <= nframes; i += 16) {
+		_mm512_storeu_ps(&buf[i], _mm512_fmadd_ps(_mm512_loadu_ps(&buf[i]), g, o));
+	}
+
+	_mm256_zeroupper(); // zeros the upper portion of YMM register
+
+	for (; i < nframes; ++i) {
+		buf[i] = buf[i] * gain + offset;
+	}
+}
+
+/**
+ * @brief x86-64 AVX-512F limit samples to [min, max]
+ */
+void
+x86_avx512f_clamp_buffer(float *buf, uint32_t nframes, float min, float max)
+{
+	const __m512 lo = _mm512_set1_ps(min);
+	const __m512 hi = _mm512_set1_ps(max);
+
+	uint32_t i = 0;
+	for (; i + 16 <= nframes; i += 16) {
+		_mm512_storeu_ps(&buf[i], _mm512_min_ps(_mm512_max_ps(_mm512_loadu_ps(&buf[i]), lo), hi));
+	}
+
+	_mm256_zeroupper(); // zeros the upper portion of YMM register
+
+	for (; i < nframes; ++i) {
+		buf[i] = std::min(max, std::max(min, buf[i]));
+	}
+}
+
+/**
+ * @brief x86-64 AVX-512F absolute value, buf[i] = fabsf (buf[i])
+ */
+void
+x86_avx512f_rectify_buffer(float *buf, uint32_t nframes)
+{
+	uint32_t i = 0;
+	for (; i + 16 <= nframes; i += 16) {
+		_mm512_storeu_ps(&buf[i], _mm512_abs_ps(_mm512_loadu_ps(&buf[i])));
+	}
+
+	_mm256_zeroupper(); // zeros the upper portion of YMM register
+
+	for (; i < nframes; ++i) {
+		buf[i] = fabsf(buf[i]);
+	}
+}
+
+/**
+ * @brief x86-64 AVX-512F dot product, sum of a[i] * b[i]
+ */
+float
+x86_avx512f_dot_product(const float *a, const float *b, uint32_t n)
+{
+	__m512 acc0 = _mm512_setzero_ps();
+	__m512 acc1 = _mm512_setzero_ps();
+
+	while (n >= 32) {
+		acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a), _mm512_loadu_ps(b), acc0);
+		acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(a + 16), _mm512_loadu_ps(b + 16), acc1);
+		a += 32;
+		b += 32;
+		n -= 32;
+	}
+
+	float sum = _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+
+	_mm256_zeroupper(); // zeros the upper portion of YMM register
+
+	while (n > 0) {
+		sum += *a * *b;
+		++a;
+		++b;
+		--n;
+	}
+	return sum;
+}
+
+/**
+ * @brief x86-64 AVX-512F linear interpolation
+ *
+ * Positions and fractions are computed eight at a time in double precision,
+ * only the (bounds-checked) source reads are done one by one.
+ */
+double
+x86_avx512f_interpolate_buffer(float *dst, const float *src, uint32_t src_len, double pos, double step, uint32_t nframes)
+{
+	const __m512d p0    = _mm512_set1_pd(pos);
+	const __m512d dp    = _mm512_set1_pd(step);
+	const __m512d eight = _mm512_set1_pd(8.0);
+	__m512d       idx   = _mm512_set_pd(7.0, 6.0, 5.0, 4.0, 3.0, 2.0, 1.0, 0.0);
+
+	double fl[8];
+	float  va[8];
+	float  vb[8];
+
+	uint32_t i = 0;
+	for (; i + 8 <= nframes; i += 8) {
+		const __m512d p = _mm512_add_pd(p0, _mm512_mul_pd(idx, dp));
+		const __m512d f = _mm512_roundscale_pd(p, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+		_mm512_storeu_pd(fl, f);
+
+		for (int k = 0; k < 8; ++k) {
+			const int64_t x = (int64_t)fl[k];
+			va[k] = (x >= 0 && x < src_len) ? src[x] : 0.f;
+			vb[k] = (x + 1 >= 0 && x + 1 < src_len) ? src[x + 1] : 0.f;
+		}
+
+		const __m256 fr = _mm512_cvtpd_ps(_mm512_sub_pd(p, f));
+		const __m256 a  = _mm256_loadu_ps(va);
+		const __m256 b  = _mm256_loadu_ps(vb);
+		_mm256_storeu_ps(&dst[i], _mm256_add_ps(a, _mm256_mul_ps(fr, _mm256_sub_ps(b, a))));
+		idx = _mm512_add_pd(idx, eight);
+	}
+
+	_mm256_zeroupper(); // zeros the upper portion of YMM register
+
+	for (; i < nframes; ++i) {
+		const double  p = pos + (double)i * step;
+		const double  f = floor(p);
+		const int64_t x = (int64_t)f;
+		const float   r = (float)(p - f);
+		const float   a = (x >= 0 && x < src_len) ? src[x] : 0.f;
+		const float   b = (x + 1 >= 0 && x + 1 < src_len) ? src[x + 1] : 0.f;
+		dst[i] = a + r * (b - a);
+	}
+	return pos + (double)nframes * step;
+}
+
 #endif // FPU_AVX512F_SUPPORT
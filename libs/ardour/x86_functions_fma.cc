@@ -24,6 +24,9 @@
 #include <immintrin.h>
 #include <xmmintrin.h>
 
+#include <algorithm>
+#include <cmath>
+
 #define IS_ALIGNED_TO(ptr, bytes) (((uintptr_t)ptr) % (bytes) == 0)
 
 /**
@@ -138,4 +141,405 @@ x86_fma_mix_buffers_with_gain(
 	} while (0);
 }
 
+/**
+ * @brief x86-64 AVX/FMA multi-channel biquad cascade, processes 8 channels in parallel
+ *
+ * @param[in,out] buf interleaved audio data
+ * @param n_channels number of interleaved channels
+ * @param nframes number of frames to process
+ * @param n_stages number of biquad sections
+ * @param coeff filter coefficients, see default_biquad_cascade()
+ * @param[in,out] state filter state, see default_biquad_cascade()
+ */
+void
+x86_fma_biquad_cascade(
+    float       *buf,
+    uint32_t     n_channels,
+    uint32_t     nframes,
+    uint32_t     n_stages,
+    const float *coeff,
+    float       *state)
+{
+	const uint32_t n_vec = n_channels & ~7;
+
+	for (uint32_t s = 0; s < n_stages; ++s) {
+		const float *c = &coeff[s * 5 * n_channels];
+		float       *z = &state[s * 2 * n_channels];
+
+		for (uint32_t l = 0; l < n_vec; l += 8) {
+			const __m256 b0 = _mm256_loadu_ps(&c[0 * n_channels + l]);
+			const __m256 b1 = _mm256_loadu_ps(&c[1 * n_channels + l]);
+			const __m256 b2 = _mm256_loadu_ps(&c[2 * n_channels + l]);
+			const __m256 a1 = _mm256_loadu_ps(&c[3 * n_channels + l]);
+			const __m256 a2 = _mm256_loadu_ps(&c[4 * n_channels + l]);
+
+			__m256 z1 = _mm256_loadu_ps(&z[l]);
+			__m256 z2 = _mm256_loadu_ps(&z[n_channels + l]);
+
+			float *d = &buf[l];
+			for (uint32_t i = 0; i < nframes; ++i, d += n_channels) {
+				const __m256 x = _mm256_loadu_ps(d);
+				const __m256 y = _mm256_fmadd_ps(b0, x, z1);
+				z1 = _mm256_fnmadd_ps(a1, y, _mm256_fmadd_ps(b1, x, z2));
+				z2 = _mm256_fnmadd_ps(a2, y, _mm256_mul_ps(b2, x));
+				_mm256_storeu_ps(d, y);
+			}
+
+			_mm256_storeu_ps(&z[l], z1);
+			_mm256_storeu_ps(&z[n_channels + l], z2);
+		}
+	}
+
+	// There's a penalty going from AVX mode to SSE mode. This can
+	// be avoided by ensuring the CPU that rest of the routine is no
+	// longer interested in the upper portion of the YMM register.
+
+	_mm256_zeroupper(); // zeros the upper portion of YMM register
+
+	// Process the remaining < 8 channels
+	if (n_vec < n_channels) {
+		default_biquad_cascade_lanes(buf, n_channels, nframes, n_stages, coeff, state, n_vec, n_channels);
+	}
+}
+
+/**
+ * @brief x86-64 AVX/FMA one-pole gain ramp (declick), processes 8 samples in parallel
+ *
+ * Uses the closed form g[i] = target + (initial - target) * (1 - coeff)^i
+ *
+ * @return gain after the last sample
+ */
+float
+x86_fma_apply_gain_ramp(float *buf, uint32_t nframes, float initial, float target, float coeff)
+{
+	float p[8];
+	p[0] = 1.f;
+	for (int k = 1; k < 8; ++k) {
+		p[k] = p[k - 1] * (1.f - coeff);
+	}
+
+	const __m256 t = _mm256_set1_ps(target);
+	const __m256 r = _mm256_set1_ps(p[7] * (1.f - coeff));
+	__m256       d = _mm256_mul_ps(_mm256_set1_ps(initial - target), _mm256_loadu_ps(p));
+
+	while (nframes >= 8) {
+		const __m256 x = _mm256_loadu_ps(buf);
+		_mm256_storeu_ps(buf, _mm256_mul_ps(x, _mm256_add_ps(t, d)));
+		d = _mm256_mul_ps(d, r);
+		buf += 8;
+		nframes -= 8;
+	}
+
+	/* the remaining samples and the returned gain (that of the next
+	 * sample) use the same closed form as the vectorized loop */
+	float dv[8];
+	_mm256_storeu_ps(dv, d);
+
+	_mm256_zeroupper(); // zeros the upper portion of YMM register
+
+	for (uint32_t i = 0; i < nframes; ++i) {
+		buf[i] *= target + dv[i];
+	}
+	return target + dv[nframes];
+}
+
+/**
+ * @brief x86-64 AVX/FMA mix buffers with a linear gain ramp from initial to target
+ */
+void
+x86_fma_mix_buffers_with_ramp(float *dst, const float *src, uint32_t nframes, float initial, float target)
+{
+	const float  delta = (target - initial) / nframes;
+	const __m256 g0    = _mm256_set1_ps(initial);
+	const __m256 dv    = _mm256_set1_ps(delta);
+	const __m256 eight = _mm256_set1_ps(8.f);
+	__m256       idx   = _mm256_set_ps(7.f, 6.f, 5.f, 4.f, 3.f, 2.f, 1.f, 0.f);
+
+	uint32_t i = 0;
+	for (; i + 8 <= nframes; i += 8) {
+		const __m256 g = _mm256_fmadd_ps(dv, idx, g0);
+		_mm256_storeu_ps(&dst[i], _mm256_fmadd_ps(_mm256_loadu_ps(&src[i]), g, _mm256_loadu_ps(&dst[i])));
+		idx = _mm256_add_ps(idx, eight);
+	}
+
+	_mm256_zeroupper(); // zeros the upper portion of YMM register
+
+	for (; i < nframes; ++i) {
+		dst[i] = dst[i] + src[i] * (initial + delta * (float)i);
+	}
+}
+
+/**
+ * @brief x86-64 AVX convert float to signed 16 bit integer (round to nearest, clamp)
+ */
+void
+x86_fma_float_to_s16(int16_t *dst, const float *src, uint32_t nframes)
+{
+	const __m256 scale = _mm256_set1_ps(32768.f);
+	const __m256 vmin  = _mm256_set1_ps(-32768.f);
+	const __m256 vmax  = _mm256_set1_ps(32767.f);
+
+	while (nframes >= 8) {
+		__m256 x = _mm256_mul_ps(_mm256_loadu_ps(src), scale);
+		x = _mm256_min_ps(_mm256_max_ps(x, vmin), vmax);
+		const __m256i v = _mm256_cvtps_epi32(x);
+		const __m128i p = _mm_packs_epi32(_mm256_castsi256_si128(v), _mm256_extractf128_si256(v, 1));
+		_mm_storeu_si128((__m128i *)dst, p);
+		src += 8;
+		dst += 8;
+		nframes -= 8;
+	}
+
+	_mm256_zeroupper(); // zeros the upper portion of YMM register
+
+	default_float_to_s16(dst, src, nframes);
+}
+
+/**
+ * @brief x86-64 AVX convert float to signed 24 bit in the upper 24 bits of a 32 bit word
+ */
+void
+x86_fma_float_to_s24(int32_t *dst, const float *src, uint32_t nframes)
+{
+	const __m256 scale = _mm256_set1_ps(8388608.f);
+	const __m256 vmin  = _mm256_set1_ps(-8388608.f);
+	const __m256 vmax  = _mm256_set1_ps(8388607.f);
+	const __m256 shift = _mm256_set1_ps(256.f);
+
+	while (nframes >= 8) {
+		__m256 x = _mm256_mul_ps(_mm256_loadu_ps(src), scale);
+		x = _mm256_min_ps(_mm256_max_ps(x, vmin), vmax);
+		// round first, then scale to the upper 24 bit (exact)
+		x = _mm256_round_ps(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+		_mm256_storeu_si256((__m256i *)dst, _mm256_cvtps_epi32(_mm256_mul_ps(x, shift)));
+		src += 8;
+		dst += 8;
+		nframes -= 8;
+	}
+
+	_mm256_zeroupper(); // zeros the upper portion of YMM register
+
+	default_float_to_s24(dst, src, nframes);
+}
+
+/**
+ * @brief x86-64 AVX/FMA sum of squares
+ */
+float
+x86_fma_sum_of_squares(const float *buf, uint32_t nframes)
+{
+	__m256 acc0 = _mm256_setzero_ps();
+	__m256 acc1 = _mm256_setzero_ps();
+
+	while (nframes >= 16) {
+		const __m256 x0 = _mm256_loadu_ps(buf);
+		const __m256 x1 = _mm256_loadu_ps(buf + 8);
+		acc0 = _mm256_fmadd_ps(x0, x0, acc0);
+		acc1 = _mm256_fmadd_ps(x1, x1, acc1);
+		buf += 16;
+		nframes -= 16;
+	}
+
+	acc0 = _mm256_add_ps(acc0, acc1);
+	__m128 s = _mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1));
+	s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+	s = _mm_add_ss(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 1, 1, 1)));
+
+	float sum = _mm_cvtss_f32(s);
+
+	_mm256_zeroupper(); // zeros the upper portion of YMM register
+
+	while (nframes > 0) {
+		sum += *buf * *buf;
+		++buf;
+		--nframes;
+	}
+	return sum;
+}
+
+/**
+ * @brief x86-64 AVX subtract buffers, dst[i] -= src[i]
+ */
+void
+x86_fma_subtract_buffers(float *dst, const float *src, uint32_t nframes)
+{
+	uint32_t i = 0;
+	for (; i + 8 <= nframes; i += 8) {
+		_mm256_storeu_ps(&dst[i], _mm256_sub_ps(_mm256_loadu_ps(&dst[i]), _mm256_loadu_ps(&src[i])));
+	}
+
+	_mm256_zeroupper(); // zeros the upper portion of YMM register
+
+	for (; i < nframes; ++i) {
+		dst[i] -= src[i];
+	}
+}
+
+/**
+ * @brief x86-64 AVX/FMA multiply and accumulate, dst[i] += a[i] * b[i]
+ */
+void
+x86_fma_multiply_add_buffers(float *dst, const float *a, const float *b, uint32_t nframes)
+{
+	uint32_t i = 0;
+	for (; i + 8 <= nframes; i += 8) {
+		const __m256 x = _mm256_fmadd_ps(_mm256_loadu_ps(&a[i]), _mm256_loadu_ps(&b[i]), _mm256_loadu_ps(&dst[i]));
+		_mm256_storeu_ps(&dst[i], x);
+	}
+
+	_mm256_zeroupper(); // zeros the upper portion of YMM register
+
+	for (; i < nframes; ++i) {
+		dst[i] += a[i] * b[i];
+	}
+}
+
+/**
+ * @brief x86-64 AVX/FMA scale and offset, buf[i] = buf[i] * gain + offset
+ */
+void
+x86_fma_scale_offset_buffer(float *buf, uint32_t nframes, float gain, float offset)
+{
+	const __m256 g = _mm256_set1_ps(gain);
+	const __m256 o = _mm256_set1_ps(offset);
+
+	uint32_t i = 0;
+	for (; i + 8 <= nframes; i += 8) {
+		_mm256_storeu_ps(&buf[i], _mm256_fmadd_ps(_mm256_loadu_ps(&buf[i]), g, o));
+	}
+
+	_mm256_zeroupper(); // zeros the upper portion of YMM register
+
+	for (; i < nframes; ++i) {
+		buf[i] = buf[i] * gain + offset;
+	}
+}
+
+/**
+ * @brief x86-64 AVX limit samples to [min, max]
+ */
+void
+x86_fma_clamp_buffer(float *buf, uint32_t nframes, float min, float max)
+{
+	const __m256 lo = _mm256_set1_ps(min);
+	const __m256 hi = _mm256_set1_ps(max);
+
+	uint32_t i = 0;
+	for (; i + 8 <= nframes; i += 8) {
+		_mm256_storeu_ps(&buf[i], _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(&buf[i]), lo), hi));
+	}
+
+	_mm256_zeroupper(); // zeros the upper portion of YMM register
+
+	for (; i < nframes; ++i) {
+		buf[i] = std::min(max, std::max(min, buf[i]));
+	}
+}
+
+/**
+ * @brief x86-64 AVX absolute value, buf[i] = fabsf (buf[i])
+ */
+void
+x86_fma_rectify_buffer(float *buf, uint32_t nframes)
+{
+	const __m256 sign = _mm256_set1_ps(-0.f);
+
+	uint32_t i = 0;
+	for (; i + 8 <= nframes; i += 8) {
+		_mm256_storeu_ps(&buf[i], _mm256_andnot_ps(sign, _mm256_loadu_ps(&buf[i])));
+	}
+
+	_mm256_zeroupper(); // zeros the upper portion of YMM register
+
+	for (; i < nframes; ++i) {
+		buf[i] = fabsf(buf[i]);
+	}
+}
+
+/**
+ * @brief x86-64 AVX/FMA dot product, sum of a[i] * b[i]
+ */
+float
+x86_fma_dot_product(const float *a, const float *b, uint32_t n)
+{
+	__m256 acc0 = _mm256_setzero_ps();
+	__m256 acc1 = _mm256_setzero_ps();
+
+	while (n >= 16) {
+		acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a), _mm256_loadu_ps(b), acc0);
+		acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + 8), _mm256_loadu_ps(b + 8), acc1);
+		a += 16;
+		b += 16;
+		n -= 16;
+	}
+
+	acc0 = _mm256_add_ps(acc0, acc1);
+	__m128 s = _mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1));
+	s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+	s = _mm_add_ss(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 1, 1, 1)));
+
+	float sum = _mm_cvtss_f32(s);
+
+	_mm256_zeroupper(); // zeros the upper portion of YMM register
+
+	while (n > 0) {
+		sum += *a * *b;
+		++a;
+		++b;
+		--n;
+	}
+	return sum;
+}
+
+/**
+ * @brief x86-64 AVX/FMA linear interpolation
+ *
+ * Positions and fractions are computed four at a time in double precision,
+ * only the (bounds-checked) source reads are done one by one.
+ */
+double
+x86_fma_interpolate_buffer(float *dst, const float *src, uint32_t src_len, double pos, double step, uint32_t nframes)
+{
+	const __m256d p0   = _mm256_set1_pd(pos);
+	const __m256d dp   = _mm256_set1_pd(step);
+	const __m256d four = _mm256_set1_pd(4.0);
+	__m256d       idx  = _mm256_set_pd(3.0, 2.0, 1.0, 0.0);
+
+	double fl[4];
+	float  va[4];
+	float  vb[4];
+
+	uint32_t i = 0;
+	for (; i + 4 <= nframes; i += 4) {
+		const __m256d p = _mm256_add_pd(p0, _mm256_mul_pd(idx, dp));
+		const __m256d f = _mm256_floor_pd(p);
+		_mm256_storeu_pd(fl, f);
+
+		for (int k = 0; k < 4; ++k) {
+			const int64_t x = (int64_t)fl[k];
+			va[k] = (x >= 0 && x < src_len) ? src[x] : 0.f;
+			vb[k] = (x + 1 >= 0 && x + 1 < src_len) ? src[x + 1] : 0.f;
+		}
+
+		const __m128 fr = _mm256_cvtpd_ps(_mm256_sub_pd(p, f));
+		const __m128 a  = _mm_loadu_ps(va);
+		const __m128 b  = _mm_loadu_ps(vb);
+		_mm_storeu_ps(&dst[i], _mm_add_ps(a, _mm_mul_ps(fr, _mm_sub_ps(b, a))));
+		idx = _mm256_add_pd(idx, four);
+	}
+
+	_mm256_zeroupper(); // zeros the upper portion of YMM register
+
+	for (; i < nframes; ++i) {
+		const double  p = pos + (double)i * step;
+		const double  f = floor(p);
+		const int64_t x = (int64_t)f;
+		const float   r = (float)(p - f);
+		const float   a = (x >= 0 && x < src_len) ? src[x] : 0.f;
+		const float   b = (x + 1 >= 0 && x + 1 < src_len) ? src[x + 1] : 0.f;
+		dst[i] = a + r * (b - a);
+	}
+	return pos + (double)nframes * step;
+}
+
 #endif // FPU_AVX_FMA_SUPPORT
@@ -6,6 +6,7 @@
 #include "audiographer/source.h"
 #include "audiographer/sink.h"
 #include "audiographer/exception.h"
+#include "audiographer/routines.h"
 #include "audiographer/utils/identity_vertex.h"
 
 #include <vector>
@@ -77,9 +78,7 @@ class /*LIBAUDIOGRAPHER_API*/ DeInterleaver
 		for (typename std::vector<OutputPtr>::iterator it = outputs.begin(); it != outputs.end(); ++it, ++channel) {
 			if (!*it) { continue; }
 
-			for (unsigned int i = 0; i < samples_per_channel; ++i) {
-				buffer[i] = data[channel + (channels * i)];
-			}
+			deinterleave (buffer, &data[channel], samples_per_channel, channels);
 
 			ProcessContext<T> c_out (c, buffer, samples_per_channel, 1);
 			(*it)->process (c_out);
@@ -90,6 +89,19 @@ class /*LIBAUDIOGRAPHER_API*/ DeInterleaver
 
   private:
 
+	static void deinterleave (float * dst, float const * src, samplecnt_t samples, unsigned int stride)
+	{
+		Routines::deinterleave (dst, src, samples, stride);
+	}
+
+	template<typename U>
+	static void deinterleave (U * dst, U const * src, samplecnt_t samples, unsigned int stride)
+	{
+		for (samplecnt_t i = 0; i < samples; ++i) {
+			dst[i] = src[stride * i];
+		}
+	}
+
 	void reset ()
 	{
 		outputs.clear();
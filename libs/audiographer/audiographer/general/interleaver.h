@@ -5,6 +5,7 @@
 #include "audiographer/types.h"
 #include "audiographer/sink.h"
 #include "audiographer/exception.h"
+#include "audiographer/routines.h"
 #include "audiographer/throwing.h"
 #include "audiographer/utils/listed_source.h"
 
@@ -105,6 +106,19 @@ class /*LIBAUDIOGRAPHER_API*/ Interleaver
 
 	}
 
+	static void interleave (float * dst, float const * src, samplecnt_t samples, unsigned int stride)
+	{
+		Routines::interleave (dst, src, samples, stride);
+	}
+
+	template<typename U>
+	static void interleave (U * dst, U const * src, samplecnt_t samples, unsigned int stride)
+	{
+		for (samplecnt_t i = 0; i < samples; ++i) {
+			dst[stride * i] = src[i];
+		}
+	}
+
 	void write_channel (ProcessContext<T> const & c, unsigned int channel)
 	{
 		if (throw_level (ThrowProcess) && c.samples() > max_samples) {
@@ -112,9 +126,7 @@ class /*LIBAUDIOGRAPHER_API*/ Interleaver
 			throw Exception (*this, "Too many samples given to an input");
 		}
 
-		for (unsigned int i = 0; i < c.samples(); ++i) {
-			buffer[channel + (channels * i)] = c.data()[i];
-		}
+		interleave (&buffer[channel], c.data(), c.samples(), channels);
 
 		samplecnt_t const ready_samples = ready_to_output();
 		if (ready_samples) {
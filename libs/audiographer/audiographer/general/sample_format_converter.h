@@ -63,6 +63,7 @@ class LIBAUDIOGRAPHER_API SampleFormatConverter
 	TOut *       data_out;
 
 	bool         clip_floats;
+	bool         plain_conversion; // no dither, full width: convert all channels at once
 
 };
 
@@ -18,9 +18,17 @@ class LIBAUDIOGRAPHER_API Routines
 
 	typedef float (*compute_peak_t)          (float const *, uint_type, float);
 	typedef void  (*apply_gain_to_buffer_t)  (float *, uint_type, float);
+	typedef void  (*interleave_t)            (float *, float const *, uint_type, uint_type);
+	typedef void  (*deinterleave_t)          (float *, float const *, uint_type, uint_type);
+	typedef void  (*float_to_s16_t)          (int16_t *, float const *, uint_type);
+	typedef void  (*float_to_s24_t)          (int32_t *, float const *, uint_type);
 
 	static void override_compute_peak         (compute_peak_t func)         { _compute_peak = func; }
 	static void override_apply_gain_to_buffer (apply_gain_to_buffer_t func) { _apply_gain_to_buffer = func; }
+	static void override_interleave           (interleave_t func)           { _interleave = func; }
+	static void override_deinterleave         (deinterleave_t func)         { _deinterleave = func; }
+	static void override_float_to_s16         (float_to_s16_t func)         { _float_to_s16 = func; }
+	static void override_float_to_s24         (float_to_s24_t func)         { _float_to_s24 = func; }
 
 	/** Computes peak in float buffer
 	  * \n RT safe
@@ -45,6 +53,47 @@ class LIBAUDIOGRAPHER_API Routines
 		(*_apply_gain_to_buffer) (data, samples, gain);
 	}
 
+	/** Copies a single channel into an interleaved buffer
+	 * \n RT safe
+	 * \param dst first sample of the channel in the interleaved buffer
+	 * \param src non-interleaved channel data
+	 * \param samples number of samples (per channel) to copy
+	 * \param stride number of channels in \a dst
+	 */
+	static inline void interleave (float * dst, float const * src, uint_type samples, uint_type stride)
+	{
+		(*_interleave) (dst, src, samples, stride);
+	}
+
+	/** Copies a single channel out of an interleaved buffer
+	 * \n RT safe
+	 * \param dst non-interleaved channel data
+	 * \param src first sample of the channel in the interleaved buffer
+	 * \param samples number of samples (per channel) to copy
+	 * \param stride number of channels in \a src
+	 */
+	static inline void deinterleave (float * dst, float const * src, uint_type samples, uint_type stride)
+	{
+		(*_deinterleave) (dst, src, samples, stride);
+	}
+
+	/** Converts float to signed 16 bit integer, rounding to nearest and clipping
+	 * \n RT safe
+	 */
+	static inline void float_to_s16 (int16_t * dst, float const * src, uint_type samples)
+	{
+		(*_float_to_s16) (dst, src, samples);
+	}
+
+	/** Converts float to signed 24 bit integer stored in the upper 24 bits of a 32 bit word,
+	 * rounding to nearest and clipping
+	 * \n RT safe
+	 */
+	static inline void float_to_s24 (int32_t * dst, float const * src, uint_type samples)
+	{
+		(*_float_to_s24) (dst, src, samples);
+	}
+
   private:
 	static inline float default_compute_peak (float const * data, uint_type samples, float current_peak)
 	{
@@ -62,8 +111,44 @@ class LIBAUDIOGRAPHER_API Routines
 		}
 	}
 
+	static inline void default_interleave (float * dst, float const * src, uint_type samples, uint_type stride)
+	{
+		for (uint_type i = 0; i < samples; ++i) {
+			dst[i * stride] = src[i];
+		}
+	}
+
+	static inline void default_deinterleave (float * dst, float const * src, uint_type samples, uint_type stride)
+	{
+		for (uint_type i = 0; i < samples; ++i) {
+			dst[i] = src[i * stride];
+		}
+	}
+
+	static inline void default_float_to_s16 (int16_t * dst, float const * src, uint_type samples)
+	{
+		for (uint_type i = 0; i < samples; ++i) {
+			long v = lrintf (src[i] * 32768.f);
+			if (v > 32767) { v = 32767; } else if (v < -32768) { v = -32768; }
+			dst[i] = (int16_t) v;
+		}
+	}
+
+	static inline void default_float_to_s24 (int32_t * dst, float const * src, uint_type samples)
+	{
+		for (uint_type i = 0; i < samples; ++i) {
+			long v = lrintf (src[i] * 8388608.f);
+			if (v > 8388607) { v = 8388607; } else if (v < -8388608) { v = -8388608; }
+			dst[i] = (int32_t) v * 256;
+		}
+	}
+
 	static compute_peak_t          _compute_peak;
 	static apply_gain_to_buffer_t  _apply_gain_to_buffer;
+	static interleave_t            _interleave;
+	static deinterleave_t          _deinterleave;
+	static float_to_s16_t          _float_to_s16;
+	static float_to_s24_t          _float_to_s24;
 };
 
 } // namespace
@@ -19,11 +19,14 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <cassert>
+
 #include "pbd/compose.h"
 
 #include "audiographer/general/sample_format_converter.h"
 
 #include "audiographer/exception.h"
+#include "audiographer/routines.h"
 #include "audiographer/type_utils.h"
 #include "private/gdither/gdither.h"
 
@@ -36,10 +39,33 @@ SampleFormatConverter<TOut>::SampleFormatConverter (ChannelCount channels) :
   dither (0),
   data_out_size (0),
   data_out (0),
-  clip_floats (false)
+  clip_floats (false),
+  plain_conversion (false)
 {
 }
 
+/* Undithered conversion does not depend on the channel layout,
+ * (interleaved) data can be converted in one go by the optimized routines.
+ */
+static inline void
+convert_plain (int16_t * out, float const * in, samplecnt_t samples)
+{
+	Routines::float_to_s16 (out, in, samples);
+}
+
+static inline void
+convert_plain (int32_t * out, float const * in, samplecnt_t samples)
+{
+	Routines::float_to_s24 (out, in, samples);
+}
+
+template <typename TOut>
+static inline void
+convert_plain (TOut *, float const *, samplecnt_t)
+{
+	assert (0);
+}
+
 template <>
 void
 SampleFormatConverter<float>::init (samplecnt_t max_samples, int /* type */, int data_width)
@@ -65,6 +91,7 @@ SampleFormatConverter<int32_t>::init (samplecnt_t max_samples, int type, int dat
 
 	init_common (max_samples);
 	dither = gdither_new ((GDitherType) type, channels, GDither32bit, data_width);
+	plain_conversion = (type == GDitherNone && data_width == 24);
 }
 
 template <>
@@ -78,6 +105,7 @@ SampleFormatConverter<int16_t>::init (samplecnt_t max_samples, int type, int dat
 	}
 	init_common (max_samples);
 	dither = gdither_new ((GDitherType) type, channels, GDither16bit, data_width);
+	plain_conversion = (type == GDitherNone && data_width == 16);
 }
 
 template <>
@@ -127,6 +155,7 @@ SampleFormatConverter<TOut>::reset()
 	data_out = 0;
 
 	clip_floats = false;
+	plain_conversion = false;
 }
 
 /* Basic const version of process() */
@@ -140,8 +169,12 @@ SampleFormatConverter<TOut>::process (ProcessContext<float> const & c_in)
 
 	/* Do conversion */
 
-	for (uint32_t chn = 0; chn < c_in.channels(); ++chn) {
-		gdither_runf (dither, chn, c_in.samples_per_channel (), data, data_out);
+	if (plain_conversion) {
+		convert_plain (data_out, data, c_in.samples ());
+	} else {
+		for (uint32_t chn = 0; chn < c_in.channels(); ++chn) {
+			gdither_runf (dither, chn, c_in.samples_per_channel (), data, data_out);
+		}
 	}
 
 	/* Write forward */
@@ -1420,11 +1420,6 @@ CoreAudioBackend::process_callback (const uint32_t n_samples, const uint64_t hos
 		_pcmio->get_capture_channel (i, (float*)(*it)->get_buffer(n_samples), n_samples);
 	}
 
-	/* clear output buffers */
-	for (std::vector<BackendPortPtr>::const_iterator it = _system_outputs.begin (); it != _system_outputs.end (); ++it) {
-		memset ((*it)->get_buffer (n_samples), 0, n_samples * sizeof (Sample));
-	}
-
 	if (engine.process_callback (n_samples)) {
 		fprintf(stderr, "ENGINE PROCESS ERROR\n");
 		//_pcmio->pcm_stop ();
@@ -1607,24 +1602,7 @@ void*
 CoreAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		std::set<BackendPortPtr>::const_iterator it = connections.begin ();
-		if (it == connections.end ()) {
-			memset (_buffer, 0, n_samples * sizeof (Sample));
-		} else {
-			std::shared_ptr<const CoreAudioPort> source = std::dynamic_pointer_cast<const CoreAudioPort>(*it);
-			assert (source && source->is_output ());
-			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != connections.end ()) {
-				source = std::dynamic_pointer_cast<const CoreAudioPort>(*it);
-				assert (source && source->is_output ());
-				Sample* dst = buffer ();
-				const Sample* src = source->const_buffer ();
-				for (uint32_t s = 0; s < n_samples; ++s, ++dst, ++src) {
-					*dst += *src;
-				}
-			}
-		}
+		return mix_connections (_buffer, n_samples);
 	}
 	return _buffer;
 }
@@ -1590,15 +1590,6 @@ PortAudioBackend::blocking_process_main(const float* interleaved_input_data,
 
 	process_incoming_midi ();
 
-	/* clear output buffers */
-	for (std::vector<BackendPortPtr>::const_iterator it = _system_outputs.begin();
-	     it != _system_outputs.end();
-	     ++it) {
-		memset((*it)->get_buffer(_samples_per_period),
-		       0,
-		       _samples_per_period * sizeof(Sample));
-	}
-
 	_last_cycle_start = _cycle_timer.get_start();
 	_cycle_timer.reset_start(PBD::get_microseconds());
 	_cycle_count++;
@@ -1872,23 +1863,7 @@ PortAudioPort::~PortAudioPort () { }
 void* PortAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		std::set<BackendPortPtr>::const_iterator it = get_connections ().begin ();
-		if (it == get_connections ().end ()) {
-			memset (_buffer, 0, n_samples * sizeof (Sample));
-		} else {
-			std::shared_ptr<const PortAudioPort> source = std::dynamic_pointer_cast<const PortAudioPort>(*it);
-			assert (source && source->is_output ());
-			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != get_connections ().end ()) {
-				source = std::dynamic_pointer_cast<const PortAudioPort>(*it);
-				assert (source && source->is_output ());
-				Sample* dst = buffer ();
-				const Sample* src = source->const_buffer ();
-				for (uint32_t s = 0; s < n_samples; ++s, ++dst, ++src) {
-					*dst += *src;
-				}
-			}
-		}
+		return mix_connections (_buffer, n_samples);
 	}
 	return _buffer;
 }
@@ -1163,25 +1163,7 @@ void*
 PulseAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		const std::set<BackendPortPtr>&          connections = get_connections ();
-		std::set<BackendPortPtr>::const_iterator it          = connections.begin ();
-
-		if (it == connections.end ()) {
-			memset (_buffer, 0, n_samples * sizeof (Sample));
-		} else {
-			std::shared_ptr<PulseAudioPort> source = std::dynamic_pointer_cast<PulseAudioPort> (*it);
-			assert (source && source->is_output ());
-			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != connections.end ()) {
-				source = std::dynamic_pointer_cast<PulseAudioPort> (*it);
-				assert (source && source->is_output ());
-				Sample*       dst = _buffer;
-				const Sample* src = source->const_buffer ();
-				for (uint32_t s = 0; s < n_samples; ++s, ++dst, ++src) {
-					*dst += *src;
-				}
-			}
-		}
+		return mix_connections (_buffer, n_samples);
 	}
 	return _buffer;
 }
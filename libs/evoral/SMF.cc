@@ -38,6 +38,8 @@
 
 #include "evoral/Event.h"
 #include "evoral/SMF.h"
+#include "evoral/SMFReader.h"
+#include "evoral/SMFWriter.h"
 #include "evoral/midi_util.h"
 
 #ifdef COMPILER_MSVC
@@ -52,6 +54,13 @@ SMF::SMF()
 	: _smf (nullptr)
 	, _smf_track (0)
 	, _empty (true)
+	, _deferred (false)
+	, _deferred_track (0)
+	, _deferred_format (0)
+	, _deferred_num_tracks (0)
+	, _deferred_ppqn (0)
+	, _deferred_length (0)
+	, _deferred_length_is_explicit (false)
 	, _n_note_on_events (0)
 	, _has_pgm_change (false)
 	, _num_channels (0)
@@ -62,9 +71,105 @@ SMF::~SMF()
 	close ();
 }
 
+/** Load the file with libsmf, if open() did not do so.
+ * Must be called with _smf_lock held.
+ * \return true if the file is loaded
+ */
+bool
+SMF::load_deferred () const
+{
+	if (!_deferred) {
+		return _smf != 0;
+	}
+
+	_deferred = false;
+
+	FILE* f = g_fopen (smf_path ().c_str (), "r");
+	if (f == 0) {
+		return false;
+	}
+
+	_smf = smf_load (f);
+	fclose (f);
+
+	if (!_smf) {
+		return false;
+	}
+
+	/* same state as after open () */
+	if ((_smf_track = smf_get_track_by_number (_smf, _deferred_track)) != 0) {
+		_smf_track->next_event_number = std::min (_smf_track->number_of_events, (size_t)1);
+	}
+
+	return true;
+}
+
+/** Scan a file using SMFReader, and defer loading it with libsmf.
+ * Must be called with _smf_lock held.
+ * \return 0 on success, -1 if SMFReader cannot read the file,
+ * -2 if the track does not exist
+ */
+int
+SMF::scan_mapped (std::string const& path, int track, bool scan)
+{
+	SMFReader reader;
+
+	if (reader.open (path)) {
+		return -1;
+	}
+
+	if (track > reader.num_tracks ()) {
+		return -2;
+	}
+
+	_deferred_path               = path;
+	_deferred_track              = track;
+	_deferred_format             = reader.format ();
+	_deferred_num_tracks         = reader.num_tracks ();
+	_deferred_ppqn               = reader.ppqn ();
+	_deferred_length             = 0;
+	_deferred_length_is_explicit = false;
+
+	_empty = reader.track (track).empty ();
+
+	for (int i = 1; i <= reader.num_tracks (); ++i) {
+		SMFReader::Summary const s (reader.scan (i));
+
+		if (s.length_pulses > _deferred_length) {
+			_deferred_length             = s.length_pulses;
+			_deferred_length_is_explicit = s.length_is_explicit;
+		}
+
+		if (scan && !_empty) {
+			_used_channels    |= s.used_channels;
+			_n_note_on_events += s.n_note_on_events;
+			_has_pgm_change   |= s.has_pgm_change;
+			_num_channels     += _used_channels.count ();
+		}
+	}
+
+	_deferred_tempos.clear ();
+	for (auto const& tc : reader.tempos ()) {
+		Tempo t;
+		t.time_pulses                   = tc.time_pulses;
+		t.microseconds_per_quarter_note = tc.microseconds_per_quarter_note;
+		t.numerator                     = tc.numerator;
+		t.denominator                   = tc.denominator;
+		t.clocks_per_click              = tc.clocks_per_click;
+		t.notes_per_note                = tc.notes_per_note;
+		_deferred_tempos.push_back (t);
+	}
+
+	_deferred = true;
+	return 0;
+}
+
 int
 SMF::smf_format () const
 {
+	if (_deferred) {
+		return _deferred_format;
+	}
 	return _smf ? _smf->format : 0;
 }
 
@@ -72,6 +177,9 @@ uint16_t
 SMF::num_tracks() const
 {
 	Glib::Threads::Mutex::Lock lm (_smf_lock);
+	if (_deferred) {
+		return _deferred_num_tracks;
+	}
 	return (uint16_t) (_smf ? _smf->number_of_tracks : 0);
 }
 
@@ -79,6 +187,9 @@ uint16_t
 SMF::ppqn() const
 {
 	Glib::Threads::Mutex::Lock lm (_smf_lock);
+	if (_deferred) {
+		return _deferred_ppqn;
+	}
 	return _smf->ppqn;
 }
 
@@ -89,6 +200,9 @@ int
 SMF::seek_to_track(int track)
 {
 	Glib::Threads::Mutex::Lock lm (_smf_lock);
+	if (!load_deferred ()) {
+		return -1;
+	}
 	_smf_track = smf_get_track_by_number(_smf, track);
 	if (_smf_track != NULL) {
 		_smf_track->next_event_number = (_smf_track->number_of_events == 0) ? 0 : 1;
@@ -106,6 +220,11 @@ SMF::seek_to_track(int track)
 bool
 SMF::test(const std::string& path)
 {
+	SMFReader reader;
+	if (reader.open (path) == 0) {
+		return true;
+	}
+
 	FILE* f = g_fopen(path.c_str(), "r");
 	if (f == 0) {
 		return false;
@@ -142,8 +261,20 @@ SMF::open(const std::string& path, int track, bool scan)
 	assert(track >= 1);
 	if (_smf) {
 		smf_delete(_smf);
+		_smf = 0;
+		_smf_track = 0;
 	}
 
+	_deferred = false;
+	_writer.reset ();
+
+	int const rv = scan_mapped (path, track, scan);
+	if (rv != -1) {
+		return rv;
+	}
+
+	/* not handled by SMFReader (e.g. SMPTE timing), use libsmf */
+
 	FILE* f = g_fopen(path.c_str(), "r");
 	if (f == 0) {
 		return -1;
@@ -236,6 +367,9 @@ SMF::create(const std::string& path, int track, uint16_t ppqn)
 		smf_delete(_smf);
 	}
 
+	_deferred = false;
+	_writer.reset ();
+
 	_smf = smf_new();
 
 	if (_smf == nullptr) {
@@ -286,6 +420,9 @@ SMF::close()
 {
 	Glib::Threads::Mutex::Lock lm (_smf_lock);
 
+	_deferred = false;
+	_writer.reset ();
+
 	if (_smf) {
 		smf_delete(_smf);
 		_smf = 0;
@@ -298,6 +435,10 @@ void
 SMF::seek_to_start() const
 {
 	Glib::Threads::Mutex::Lock lm (_smf_lock);
+	if (_deferred) {
+		/* loading the file starts at the beginning */
+		return;
+	}
 	if (_smf_track) {
 		_smf_track->next_event_number = std::min(_smf_track->number_of_events, (size_t)1);
 	} else {
@@ -334,6 +475,10 @@ SMF::read_event(uint32_t* delta_t, uint32_t* size, uint8_t** buf, event_id_t* no
 	assert(buf);
 	assert(note_id);
 
+	if (!load_deferred () || !_smf_track) {
+		return -1;
+	}
+
 	if ((event = smf_track_get_next_event(_smf_track)) != NULL) {
 
 		*delta_t = event->delta_time_pulses;
@@ -405,6 +550,10 @@ SMF::append_event_delta(uint32_t delta_t, uint32_t size, const uint8_t* buf, eve
 		return;
 	}
 
+	if (!_writer) {
+		load_deferred ();
+	}
+
 	/* printf("SMF::append_event_delta @ %u:", delta_t);
 	   for (size_t i = 0; i < size; ++i) {
 	   printf("%X ", buf[i]);
@@ -449,6 +598,28 @@ SMF::append_event_delta(uint32_t delta_t, uint32_t size, const uint8_t* buf, eve
 		(c == MIDI_CMD_CONTROL && (buf[1] == MIDI_CTL_MSB_BANK || buf[1] == MIDI_CTL_LSB_BANK))
 	                       );
 
+	if (_writer) {
+		if (store_id && note_id >= 0) {
+			uint8_t meta[36];
+			uint8_t idbuf[16];
+
+			int const idlen  = smf_format_vlq (idbuf, sizeof(idbuf), note_id);
+			int const lenlen = smf_format_vlq (&meta[2], 16, idlen+2);
+
+			meta[0] = 0xff; // Meta-event
+			meta[1] = 0x7f; // Sequencer-specific
+			meta[2+lenlen] = 0x99; // Evoral type ID
+			meta[3+lenlen] = 0x1;  // Evoral type Note ID
+			memcpy (&meta[4+lenlen], idbuf, idlen);
+
+			_writer->append (0, 4 + lenlen + idlen, meta);
+		}
+
+		_writer->append (delta_t, size, buf);
+		_empty = false;
+		return;
+	}
+
 	if (store_id && note_id >= 0) {
 		int idlen;
 		int lenlen;
@@ -497,6 +668,8 @@ SMF::begin_write()
 {
 	Glib::Threads::Mutex::Lock lm (_smf_lock);
 
+	load_deferred ();
+
 	assert(_smf_track);
 	smf_track_delete(_smf_track);
 
@@ -507,12 +680,98 @@ SMF::begin_write()
 	assert(_smf->number_of_tracks == 1);
 }
 
+/** Start writing events directly to a file, replacing the current track.
+ * Unlike begin_write(), this does not keep events in memory, and the cost
+ * of writing does not grow with the size of the file. The file is completed
+ * by end_write(), see SMFWriter::recover() for files that were not.
+ *
+ * \return 0 on success, -1 if the file can not be written
+ */
+int
+SMF::begin_append (std::string const& path)
+{
+	Glib::Threads::Mutex::Lock lm (_smf_lock);
+
+	uint16_t ppqn;
+
+	if (_deferred) {
+		ppqn = _deferred_ppqn;
+	} else if (_smf) {
+		ppqn = _smf->ppqn;
+	} else {
+		return -1;
+	}
+
+	std::unique_ptr<SMFWriter> writer (new SMFWriter);
+
+	if (writer->open (path, ppqn)) {
+		return -1;
+	}
+
+	/* the file now has an empty track, so does libsmf */
+
+	if (_smf) {
+		smf_delete (_smf);
+	}
+
+	_deferred = false;
+	_smf      = smf_new ();
+	smf_set_ppqn (_smf, ppqn);
+	_smf_track = smf_track_new ();
+	smf_add_track (_smf, _smf_track);
+
+	_writer = std::move (writer);
+	_empty  = true;
+
+	return 0;
+}
+
+void
+SMF::flush ()
+{
+	Glib::Threads::Mutex::Lock lm (_smf_lock);
+
+	if (_writer) {
+		_writer->flush ();
+	}
+}
+
 void
 SMF::end_write (string const & path)
 {
 	Glib::Threads::Mutex::Lock lm (_smf_lock);
 
-	if (!_smf) {
+	if (_writer) {
+		Temporal::Beats b = duration();
+		uint32_t eot_delta = 0;
+
+		if (b != std::numeric_limits<Temporal::Beats>::max()) {
+			int64_t their_pulses = b.to_ticks (_smf->ppqn);
+			if (their_pulses > (int64_t) _writer->time ()) {
+				eot_delta = their_pulses - _writer->time ();
+			}
+		}
+
+		int const rv = _writer->close (eot_delta);
+		_writer.reset ();
+
+		if (rv) {
+			throw FileError (path);
+		}
+
+		/* read the file when needed, like a file that was opened */
+
+		smf_delete (_smf);
+		_smf       = 0;
+		_smf_track = 0;
+
+		if (scan_mapped (path, 1, false)) {
+			throw FileError (path);
+		}
+		return;
+	}
+
+	if (!load_deferred ()) {
 		return;
 	}
 
@@ -544,6 +803,10 @@ SMF::end_write (string const & path)
 Temporal::Beats
 SMF::file_duration () const
 {
+	if (_deferred) {
+		return Temporal::Beats::ticks_at_rate (_deferred_length, _deferred_ppqn);
+	}
+
 	if (!_smf) {
 		return Temporal::Beats();
 	}
@@ -554,6 +817,10 @@ SMF::file_duration () const
 bool
 SMF::duration_is_explicit () const
 {
+	if (_deferred) {
+		return _deferred_length_is_explicit;
+	}
+
 	if (!_smf) {
 		return false;
 	}
@@ -577,14 +844,14 @@ static bool invalid_char (unsigned char c)
 void
 SMF::track_names(vector<string>& names) const
 {
-	if (!_smf) {
+	Glib::Threads::Mutex::Lock lm (_smf_lock);
+
+	if (!load_deferred ()) {
 		return;
 	}
 
 	names.clear ();
 
-	Glib::Threads::Mutex::Lock lm (_smf_lock);
-
 	for (uint16_t n = 0; n < _smf->number_of_tracks; ++n) {
 		smf_track_t* trk = smf_get_track_by_number (_smf, n+1);
 		if (!trk) {
@@ -606,14 +873,14 @@ SMF::track_names(vector<string>& names) const
 void
 SMF::instrument_names(vector<string>& names) const
 {
-	if (!_smf) {
+	Glib::Threads::Mutex::Lock lm (_smf_lock);
+
+	if (!load_deferred ()) {
 		return;
 	}
 
 	names.clear ();
 
-	Glib::Threads::Mutex::Lock lm (_smf_lock);
-
 	for (uint16_t n = 0; n < _smf->number_of_tracks; ++n) {
 		smf_track_t* trk = smf_get_track_by_number (_smf, n+1);
 		if (!trk) {
@@ -645,14 +912,26 @@ SMF::Tempo::Tempo (smf_tempo_t* smft)
 int
 SMF::num_tempos () const
 {
-	assert (_smf);
+	Glib::Threads::Mutex::Lock lm (_smf_lock);
+	if (_deferred) {
+		return _deferred_tempos.size ();
+	}
+	if (!_smf) {
+		return 0;
+	}
 	return smf_get_tempo_count (_smf);
 }
 
 SMF::Tempo*
 SMF::nth_tempo (size_t n) const
 {
-	assert (_smf);
+	Glib::Threads::Mutex::Lock lm (_smf_lock);
+	if (_deferred) {
+		return n < _deferred_tempos.size () ? new Tempo (_deferred_tempos[n]) : 0;
+	}
+	if (!_smf) {
+		return 0;
+	}
 
 	smf_tempo_t* t = smf_get_tempo_by_number (_smf, n);
 	if (!t) {
@@ -665,12 +944,10 @@ SMF::nth_tempo (size_t n) const
 void
 SMF::load_markers ()
 {
-	if (!_smf_track) {
-		return;
-	}
-
 	Glib::Threads::Mutex::Lock lm (_smf_lock);
 
+	load_deferred ();
+
 	if (_smf_track) {
 		_smf_track->next_event_number = std::min(_smf_track->number_of_events, (size_t)1);
 	}
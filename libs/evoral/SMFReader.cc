@@ -0,0 +1,355 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <glib.h>
+
+#include "evoral/SMFReader.h"
+#include "evoral/midi_events.h"
+#include "evoral/midi_util.h"
+
+using namespace Evoral;
+
+static uint32_t
+read_be (const uint8_t* p, int n)
+{
+	uint32_t v = 0;
+	for (int i = 0; i < n; ++i) {
+		v = (v << 8) | p[i];
+	}
+	return v;
+}
+
+/** Parse a variable-length quantity, advancing @a p */
+static bool
+read_vlq (const uint8_t*& p, const uint8_t* end, uint32_t& val)
+{
+	val = 0;
+	for (int i = 0; i < 4 && p < end; ++i) {
+		uint8_t const c = *p++;
+		val = (val << 7) | (c & 0x7f);
+		if (!(c & 0x80)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+SMFReader::SMFReader ()
+	: _map (0)
+	, _format (0)
+	, _ppqn (0)
+{
+}
+
+SMFReader::~SMFReader ()
+{
+	close ();
+}
+
+int
+SMFReader::open (std::string const& path)
+{
+	close ();
+
+	_map = g_mapped_file_new (path.c_str (), false, NULL);
+	if (!_map) {
+		return -1;
+	}
+
+	const uint8_t* data = (const uint8_t*) g_mapped_file_get_contents (_map);
+	size_t const   size = g_mapped_file_get_length (_map);
+
+	if (!data || size < 14 || memcmp (data, "MThd", 4)) {
+		close ();
+		return -1;
+	}
+
+	size_t const hlen = read_be (data + 4, 4);
+
+	_format = read_be (data + 8, 2);
+	uint16_t const n_tracks = read_be (data + 10, 2);
+
+	/* like libsmf: no format 2, and only tempo-based time */
+	if (hlen < 6 || hlen > size - 8 || _format > 1 || n_tracks == 0 || (data[12] & 0x80)) {
+		close ();
+		return -1;
+	}
+
+	_ppqn = read_be (data + 12, 2);
+
+	size_t pos = 8 + hlen;
+
+	while (pos + 8 <= size && _tracks.size () < n_tracks) {
+		size_t const len   = read_be (data + pos + 4, 4);
+		size_t const avail = std::min (len, size - pos - 8);
+
+		/* ignore unknown chunks */
+		if (!memcmp (data + pos, "MTrk", 4)) {
+			_tracks.push_back (Chunk (data + pos + 8, avail));
+		}
+
+		pos += 8 + avail;
+	}
+
+	if (_tracks.empty ()) {
+		close ();
+		return -1;
+	}
+
+	return 0;
+}
+
+void
+SMFReader::close ()
+{
+	_tracks.clear ();
+	if (_map) {
+		g_mapped_file_unref (_map);
+		_map = 0;
+	}
+}
+
+SMFReader::Track
+SMFReader::track (int track) const
+{
+	if (track < 1 || (size_t) track > _tracks.size ()) {
+		return Track ();
+	}
+	return Track (_tracks[track - 1].data, _tracks[track - 1].size);
+}
+
+SMFReader::Summary
+SMFReader::scan (int track) const
+{
+	Summary s;
+	Track   t (SMFReader::track (track));
+	Event   ev;
+
+	while (t.next (ev)) {
+		s.length_pulses      = ev.time;
+		s.length_is_explicit = ev.delta != 0;
+
+		uint8_t const type = ev.buf[0] & 0xf0;
+		uint8_t const chan = ev.buf[0] & 0x0f;
+
+		if (type < 0x80 || type > 0xe0) {
+			continue;
+		}
+
+		s.used_channels.set (chan);
+
+		switch (type) {
+			case MIDI_CMD_NOTE_ON:
+				++s.n_note_on_events;
+				break;
+			case MIDI_CMD_PGM_CHANGE:
+				s.has_pgm_change = true;
+				break;
+			default:
+				break;
+		}
+	}
+
+	return s;
+}
+
+std::vector<SMFReader::TempoChange>
+SMFReader::tempos () const
+{
+	struct Meta {
+		Meta (uint64_t t, uint8_t ty, const uint8_t* d, size_t n) : time (t), type (ty) { memcpy (data, d, std::min (n, sizeof (data))); }
+		uint64_t time;
+		uint8_t  type;
+		uint8_t  data[4];
+	};
+
+	std::vector<Meta> metas;
+
+	for (int i = 1; i <= num_tracks (); ++i) {
+		Track t (track (i));
+		Event ev;
+		while (t.next (ev)) {
+			if (!ev.is_meta ()) {
+				continue;
+			}
+			/* 0xff <type> <length> <data>, lengths are always a single byte here */
+			if (ev.buf[1] == 0x51 && ev.size >= 6) {
+				metas.push_back (Meta (ev.time, 0x51, ev.buf + 3, 3));
+			} else if (ev.buf[1] == 0x58 && ev.size >= 7) {
+				metas.push_back (Meta (ev.time, 0x58, ev.buf + 3, 4));
+			}
+		}
+	}
+
+	/* libsmf reads tracks in parallel, taking the first track on ties */
+	std::stable_sort (metas.begin (), metas.end (), [] (Meta const& a, Meta const& b) { return a.time < b.time; });
+
+	std::vector<TempoChange> rv (1);
+
+	for (auto const& m : metas) {
+		TempoChange tc (rv.back ());
+		tc.time_pulses = m.time;
+
+		if (m.type == 0x51) {
+			int const usecs = (m.data[0] << 16) | (m.data[1] << 8) | m.data[2];
+			if (usecs <= 0) {
+				continue;
+			}
+			tc.microseconds_per_quarter_note = usecs;
+		} else {
+			tc.numerator        = m.data[0];
+			tc.denominator      = (int) pow (2.0, m.data[1]);
+			tc.clocks_per_click = m.data[2];
+			tc.notes_per_note   = m.data[3];
+		}
+
+		if (rv.back ().time_pulses == m.time) {
+			rv.back () = tc;
+		} else {
+			rv.push_back (tc);
+		}
+	}
+
+	return rv;
+}
+
+bool
+SMFReader::Track::next (Event& ev)
+{
+	uint32_t delta;
+
+	if (_pos >= _end || !read_vlq (_pos, _end, delta) || _pos >= _end) {
+		_pos = _end;
+		return false;
+	}
+
+	_time += delta;
+
+	ev.time    = _time;
+	ev.delta   = delta;
+	ev.note_id = -1;
+	ev.mapped  = true;
+
+	const uint8_t* const start  = _pos;
+	uint8_t              status = *_pos;
+
+	if (status == 0xff) {
+		/* meta-event: 0xff <type> <length> <data> */
+		uint32_t len;
+		if (_end - _pos < 2) {
+			_pos = _end;
+			return false;
+		}
+		_pos += 2;
+		if (!read_vlq (_pos, _end, len) || len > (size_t) (_end - _pos)) {
+			_pos = _end;
+			return false;
+		}
+
+		const uint8_t* const data = _pos;
+		_pos += len;
+
+		ev.buf  = start;
+		ev.size = _pos - start;
+
+		if (start[1] == 0x7f && len > 2 && data[0] == 0x99 && data[1] == 0x01) {
+			/* Sequencer-specific, Evoral Note ID */
+			const uint8_t* p = data + 2;
+			uint32_t       id;
+			if (read_vlq (p, _pos, id)) {
+				ev.note_id = id;
+			}
+		} else if (start[1] == 0x2f) {
+			/* End Of Track */
+			_pos = _end;
+		}
+		return true;
+	}
+
+	if (status == MIDI_CMD_COMMON_SYSEX || status == MIDI_CMD_COMMON_SYSEX_END) {
+		/* SysEx: 0xf0 <length> <data>, escaped events: 0xf7 <length> <data> */
+		uint32_t len;
+		++_pos;
+		if (!read_vlq (_pos, _end, len) || len > (size_t) (_end - _pos) || (status == MIDI_CMD_COMMON_SYSEX_END && len == 0)) {
+			_pos = _end;
+			return false;
+		}
+
+		if (status == MIDI_CMD_COMMON_SYSEX) {
+			_sysex.resize (len + 1);
+			_sysex[0] = status;
+			memcpy (&_sysex[1], _pos, len);
+			ev.buf    = &_sysex[0];
+			ev.size   = len + 1;
+			ev.mapped = false;
+		} else {
+			ev.buf  = _pos;
+			ev.size = len;
+		}
+
+		_pos   += len;
+		_status = 0;
+		return true;
+	}
+
+	bool running = false;
+
+	if (status & 0x80) {
+		++_pos;
+		if (status < 0xf0) {
+			_status = status;
+		}
+	} else if (_status) {
+		status  = _status;
+		running = true;
+	} else {
+		_pos = _end;
+		return false;
+	}
+
+	int const n = midi_event_size (status);
+
+	if (n < 1 || (size_t) (n - 1) > (size_t) (_end - _pos)) {
+		_pos = _end;
+		return false;
+	}
+
+	bool const note_off = (status & 0xf0) == MIDI_CMD_NOTE_ON && n == 3 && _pos[1] == 0;
+
+	if (running || note_off) {
+		_scratch[0] = status;
+		memcpy (&_scratch[1], _pos, n - 1);
+		if (note_off) {
+			/* normalize note on with velocity 0 to proper note off */
+			_scratch[0] = MIDI_CMD_NOTE_OFF | (status & 0x0f);
+			_scratch[2] = 0x40;
+		}
+		ev.buf    = _scratch;
+		ev.mapped = false;
+	} else {
+		ev.buf = start;
+	}
+
+	ev.size = n;
+	_pos   += n - 1;
+	return true;
+}
@@ -0,0 +1,271 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef COMPILER_MSVC
+#include <unistd.h>
+#endif
+#include <fcntl.h>
+#include <cstring>
+
+#include <glib.h>
+#include <glib/gstdio.h>
+
+#include "evoral/SMFReader.h"
+#include "evoral/SMFWriter.h"
+#include "evoral/midi_events.h"
+
+using namespace Evoral;
+
+/* file header, and the header of the track chunk */
+static const size_t   header_size    = 22;
+static const size_t   length_offset  = 18;
+static const uint32_t unknown_length = 0xffffffff;
+
+static void
+write_be32 (uint8_t* p, uint32_t v)
+{
+	p[0] = v >> 24;
+	p[1] = v >> 16;
+	p[2] = v >> 8;
+	p[3] = v;
+}
+
+static void
+append_vlq (std::vector<uint8_t>& buf, uint32_t val)
+{
+	uint8_t tmp[5];
+	int     n = 0;
+
+	tmp[n++] = val & 0x7f;
+	while (val >>= 7) {
+		tmp[n++] = 0x80 | (val & 0x7f);
+	}
+	while (n > 0) {
+		buf.push_back (tmp[--n]);
+	}
+}
+
+static bool
+write_all (int fd, const uint8_t* data, size_t size)
+{
+	while (size > 0) {
+		ssize_t const n = ::write (fd, data, size);
+		if (n <= 0) {
+			return false;
+		}
+		data += n;
+		size -= n;
+	}
+	return true;
+}
+
+SMFWriter::SMFWriter ()
+	: _fd (-1)
+	, _written (0)
+	, _time (0)
+	, _failed (false)
+{
+}
+
+SMFWriter::~SMFWriter ()
+{
+	if (_fd >= 0) {
+		write_buffer ();
+		::close (_fd);
+	}
+}
+
+int
+SMFWriter::open (std::string const& path, uint16_t ppqn)
+{
+	if (_fd >= 0) {
+		::close (_fd);
+	}
+
+	_buf.clear ();
+	_written = 0;
+	_time    = 0;
+	_failed  = false;
+
+	_fd = g_open (path.c_str (), O_CREAT | O_WRONLY | O_TRUNC, 0644);
+	if (_fd < 0) {
+		return -1;
+	}
+
+	uint8_t header[header_size] = {
+		'M', 'T', 'h', 'd', 0, 0, 0, 6,
+		0, 0,                          /* format 0 */
+		0, 1,                          /* 1 track */
+		(uint8_t) (ppqn >> 8), (uint8_t) ppqn,
+		'M', 'T', 'r', 'k', 0, 0, 0, 0
+	};
+
+	write_be32 (header + length_offset, unknown_length);
+
+	if (!write_all (_fd, header, header_size)) {
+		::close (_fd);
+		_fd = -1;
+		return -1;
+	}
+
+	_buf.reserve (chunk_size ());
+	return 0;
+}
+
+void
+SMFWriter::append (uint32_t delta_t, uint32_t size, const uint8_t* buf)
+{
+	if (_fd < 0 || size == 0) {
+		return;
+	}
+
+	append_vlq (_buf, delta_t);
+
+	if (buf[0] == MIDI_CMD_COMMON_SYSEX) {
+		/* length does not include the status byte */
+		_buf.push_back (MIDI_CMD_COMMON_SYSEX);
+		append_vlq (_buf, size - 1);
+		_buf.insert (_buf.end (), buf + 1, buf + size);
+	} else {
+		_buf.insert (_buf.end (), buf, buf + size);
+	}
+
+	_time += delta_t;
+
+	if (_buf.size () >= chunk_size ()) {
+		write_buffer ();
+	}
+}
+
+int
+SMFWriter::write_buffer ()
+{
+	if (_failed) {
+		return -1;
+	}
+
+	if (!write_all (_fd, _buf.data (), _buf.size ())) {
+		/* do not write events after a gap */
+		_failed = true;
+		return -1;
+	}
+
+	_written += _buf.size ();
+	_buf.clear ();
+	return 0;
+}
+
+int
+SMFWriter::flush ()
+{
+	if (_fd < 0) {
+		return -1;
+	}
+	return write_buffer ();
+}
+
+int
+SMFWriter::close (uint32_t eot_delta_t)
+{
+	if (_fd < 0) {
+		return -1;
+	}
+
+	append_vlq (_buf, eot_delta_t);
+	_buf.push_back (0xff);
+	_buf.push_back (0x2f);
+	_buf.push_back (0x00);
+
+	int rv = write_buffer ();
+
+	if (rv == 0) {
+		uint8_t len[4];
+		write_be32 (len, _written);
+		if (lseek (_fd, length_offset, SEEK_SET) != (off_t) length_offset || !write_all (_fd, len, 4)) {
+			rv = -1;
+		}
+	}
+
+	::close (_fd);
+	_fd = -1;
+	return rv;
+}
+
+int
+SMFWriter::recover (std::string const& path)
+{
+	uint8_t header[header_size];
+
+	int fd = g_open (path.c_str (), O_RDONLY, 0444);
+	if (fd < 0) {
+		return -1;
+	}
+	ssize_t const n = ::read (fd, header, header_size);
+	::close (fd);
+
+	if (n != (ssize_t) header_size || memcmp (header, "MThd", 4) || memcmp (header + 14, "MTrk", 4)) {
+		return -1;
+	}
+
+	if (memcmp (header + length_offset, "\xff\xff\xff\xff", 4)) {
+		/* closed by SMFWriter, or not written by it */
+		return 0;
+	}
+
+	/* find the end of the last complete event */
+	size_t good     = 0;
+	bool   have_eot = false;
+	{
+		SMFReader reader;
+		if (reader.open (path) || reader.num_tracks () != 1) {
+			return -1;
+		}
+
+		SMFReader::Track t (reader.track (1));
+		SMFReader::Event ev;
+
+		while (t.next (ev)) {
+			good = t.offset ();
+			if (ev.is_meta () && ev.buf[1] == 0x2f) {
+				have_eot = true;
+			}
+		}
+	}
+
+	fd = g_open (path.c_str (), O_WRONLY, 0644);
+	if (fd < 0) {
+		return -1;
+	}
+
+	bool ok = ftruncate (fd, header_size + good) == 0;
+
+	if (ok && !have_eot) {
+		static const uint8_t eot[4] = { 0x00, 0xff, 0x2f, 0x00 };
+		ok    = lseek (fd, header_size + good, SEEK_SET) == (off_t) (header_size + good) && write_all (fd, eot, 4);
+		good += 4;
+	}
+
+	if (ok) {
+		uint8_t len[4];
+		write_be32 (len, good);
+		ok = lseek (fd, length_offset, SEEK_SET) == (off_t) length_offset && write_all (fd, len, 4);
+	}
+
+	::close (fd);
+	return ok ? 1 : -1;
+}
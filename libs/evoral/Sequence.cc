@@ -483,6 +483,8 @@ Sequence<Time>::Sequence(const TypeMap& type_map)
 	, _lowest_note(127)
 	, _highest_note(0)
 	, _channels_present (0)
+	, _max_note_length (Time())
+	, _max_note_length_stale (false)
 	, _explicit_duration (false)
 {
 	DEBUG_TRACE (DEBUG::Sequence, string_compose ("Sequence constructed: %1\n", this));
@@ -505,13 +507,16 @@ Sequence<Time>::Sequence(const Sequence<Time>& other)
 	, _end_iter(*this, std::numeric_limits<Time>::max(), false, std::set<Evoral::Parameter> ())
 	, _lowest_note(other._lowest_note)
 	, _highest_note(other._highest_note)
-	, _channels_present (0)
+	, _channels_present (other._channels_present)
+	, _max_note_length (other._max_note_length)
+	, _max_note_length_stale (other._max_note_length_stale)
 	, _duration (other._duration)
 	, _explicit_duration (other._explicit_duration)
 {
 	for (typename Notes::const_iterator i = other._notes.begin(); i != other._notes.end(); ++i) {
 		NotePtr n (new Note<Time> (**i));
-		_notes.insert (n);
+		_notes.insert (_notes.end(), n);
+		_pitches[n->channel()].insert (n);
 	}
 
 	for (typename SysExes::const_iterator i = other._sysexes.begin(); i != other._sysexes.end(); ++i) {
@@ -627,6 +632,12 @@ Sequence<Time>::clear()
 {
 	WriteLock lock(write_lock());
 	_notes.clear();
+	for (int i = 0; i < 16; ++i) {
+		_pitches[i].clear ();
+	}
+	update_note_range_unlocked ();
+	_max_note_length = Time();
+	_max_note_length_stale = false;
 	_sysexes.clear ();
 	_patch_changes.clear ();
 	for (Controls::iterator li = _controls.begin(); li != _controls.end(); ++li)
@@ -679,12 +690,14 @@ Sequence<Time>::end_write (StuckNoteOption option, Time when)
 				break;
 			case DeleteStuckNotes:
 				cerr << "WARNING: Stuck note lost (end was " << when << "): " << (**n) << endl;
+				erase_pitch_unlocked (*n);
 				_notes.erase(n);
 				break;
 			case ResolveStuckNotes:
 				if (when <= (*n)->time()) {
 					cerr << "WARNING: Stuck note resolution - end time @ "
 					     << when << " is before note on: " << (**n) << endl;
+					erase_pitch_unlocked (*n);
 					_notes.erase (n);
 				} else {
 					(*n)->set_length (when - (*n)->time());
@@ -702,6 +715,10 @@ Sequence<Time>::end_write (StuckNoteOption option, Time when)
 	}
 
 	_writing = false;
+
+	/* lengths of notes were set while writing */
+	update_note_range_unlocked ();
+	update_max_note_length_unlocked ();
 }
 
 
@@ -735,6 +752,7 @@ Sequence<Time>::add_note_unlocked(const NotePtr note, void* arg)
 	_notes.insert (note);
 	_pitches[note->channel()].insert (note);
 
+	note_length_changed_unlocked (note);
 	update_duration_unlocked (note->time());
 
 	_edited = true;
@@ -767,28 +785,6 @@ Sequence<Time>::remove_note_unlocked(const constNotePtr note)
 			DEBUG_TRACE (DEBUG::Sequence, string_compose ("%1\terasing note #%2 %3 @ %4\n", this, (*i)->id(), (int)(*i)->note(), (*i)->time()));
 			_notes.erase (i);
 
-			if (note->note() == _lowest_note || note->note() == _highest_note) {
-
-				_lowest_note = 127;
-				_highest_note = 0;
-				_channels_present = 0;
-
-				for (auto const & nt : _notes) {
-					if (nt->note() < _lowest_note) {
-						_lowest_note = nt->note();
-					}
-					if (nt->note() > _highest_note) {
-						_highest_note = nt->note();
-					}
-					_channels_present = _channels_present | (1 << nt->channel());
-				}
-			} else {
-				_channels_present = 0;
-				for (auto const & nt : _notes) {
-					_channels_present = _channels_present | (1 << nt->channel());
-				}
-			}
-
 			erased = true;
 			break;
 		}
@@ -816,28 +812,6 @@ Sequence<Time>::remove_note_unlocked(const constNotePtr note)
 				DEBUG_TRACE (DEBUG::Sequence, string_compose ("%1\tID-based pass, erasing note #%2 %3 @ %4\n", this, (*i)->id(), (int)(*i)->note(), (*i)->time()));
 				_notes.erase (i);
 
-				if (note->note() == _lowest_note || note->note() == _highest_note) {
-
-					_lowest_note = 127;
-					_highest_note = 0;
-					_channels_present = 0;
-
-					for (auto const & nt : _notes) {
-						if (nt->note() < _lowest_note) {
-							_lowest_note = nt->note();
-						}
-						if (nt->note() > _highest_note) {
-							_highest_note = nt->note();
-						}
-						_channels_present = _channels_present | (1 << nt->channel());
-					}
-				} else {
-					_channels_present = 0;
-					for (auto const & nt : _notes) {
-						_channels_present = _channels_present | (1 << nt->channel());
-					}
-				}
-
 				erased = true;
 				id_matched = true;
 				break;
@@ -849,7 +823,7 @@ Sequence<Time>::remove_note_unlocked(const constNotePtr note)
 
 		Pitches& p (pitches (note->channel()));
 
-		typename Pitches::iterator j;
+		bool found = false;
 
 		/* if we had to ID-match above, we can't expect to find it in
 		 * pitches via note comparison either. so do another linear
@@ -859,36 +833,44 @@ Sequence<Time>::remove_note_unlocked(const constNotePtr note)
 
 		if (id_matched) {
 
-			for (j = p.begin(); j != p.end(); ++j) {
+			for (typename Pitches::iterator j = p.begin(); j != p.end(); ++j) {
 				if ((*j)->id() == note->id()) {
 					p.erase (j);
+					found = true;
 					break;
 				}
 			}
 
 		} else {
 
-			/* Now find the same note in the "pitches" list (which indexes
-			 * notes by channel+time. We care only about its note number
-			 * so the search_note has all other properties unset.
+			/* Now find the same note in the "pitches" list, which
+			 * indexes notes by note number and time.
 			 */
 
-			NotePtr search_note (new Note<Time>(0, Time(), Time(), note->note(), 0));
-
-			for (j = p.lower_bound (search_note); j != p.end() && (*j)->note() == note->note(); ++j) {
+			for (typename Pitches::iterator j = p.lower_bound (PitchKey (note->note(), note->time()));
+			     j != p.end() && (*j)->note() == note->note() && (*j)->time() == note->time(); ++j) {
 
 				if ((*j) == note) {
 					DEBUG_TRACE (DEBUG::Sequence, string_compose ("%1\terasing pitch %2 @ %3\n", this, (int)(*j)->note(), (*j)->time()));
 					p.erase (j);
+					found = true;
 					break;
 				}
 			}
 		}
 
-		if (j == p.end()) {
+		if (!found) {
 			warning << string_compose ("erased note %1 not found in pitches for channel %2", *note, (int) note->channel()) << endmsg;
 		}
 
+		if (note->note() == _lowest_note || note->note() == _highest_note || p.empty()) {
+			update_note_range_unlocked ();
+		}
+
+		if (note->length() >= _max_note_length) {
+			_max_note_length_stale = true;
+		}
+
 		_edited = true;
 
 	} else {
@@ -896,6 +878,152 @@ Sequence<Time>::remove_note_unlocked(const constNotePtr note)
 	}
 }
 
+/** Remove @a note from the pitch index, used when it is removed from _notes
+ * without remove_note_unlocked()
+ */
+template<typename Time>
+void
+Sequence<Time>::erase_pitch_unlocked (constNotePtr const & note)
+{
+	Pitches& p (pitches (note->channel()));
+
+	for (typename Pitches::iterator j = p.lower_bound (PitchKey (note->note(), note->time()));
+	     j != p.end() && (*j)->note() == note->note() && (*j)->time() == note->time(); ++j) {
+		if (*j == note) {
+			p.erase (j);
+			return;
+		}
+	}
+}
+
+/** Compute the note range and the channels that are used from the pitch index.
+ * Each index is sorted by note number, so this only looks at both ends of them.
+ */
+template<typename Time>
+void
+Sequence<Time>::update_note_range_unlocked ()
+{
+	_lowest_note = 127;
+	_highest_note = 0;
+	_channels_present = 0;
+
+	for (int c = 0; c < 16; ++c) {
+		if (_pitches[c].empty()) {
+			continue;
+		}
+		_lowest_note = std::min (_lowest_note, (*_pitches[c].begin())->note());
+		_highest_note = std::max (_highest_note, (*_pitches[c].rbegin())->note());
+		_channels_present |= (1 << c);
+	}
+}
+
+template<typename Time>
+void
+Sequence<Time>::update_max_note_length_unlocked () const
+{
+	_max_note_length = Time();
+	_max_note_length_stale = false;
+
+	for (auto const & n : _notes) {
+		if (n->length() > _max_note_length) {
+			_max_note_length = n->length();
+		}
+	}
+}
+
+template<typename Time>
+void
+Sequence<Time>::note_length_changed_unlocked (constNotePtr const & note)
+{
+	/* notes that are being written have no length yet,
+	 * end_write() takes care of them.
+	 */
+	if (_writing) {
+		return;
+	}
+
+	if (note->length() > _max_note_length) {
+		_max_note_length = note->length();
+	} else if (note->length() < _max_note_length) {
+		/* the previous length is not known, this may have been the longest note */
+		_max_note_length_stale = true;
+	}
+}
+
+/** Return the length of the longest note, scanning the notes again only if
+ * the longest one may have been removed or shortened since the last scan.
+ */
+template<typename Time>
+Time
+Sequence<Time>::max_note_length_unlocked () const
+{
+	if (_max_note_length_stale) {
+		update_max_note_length_unlocked ();
+	}
+	return _max_note_length;
+}
+
+template<typename Time>
+void
+Sequence<Time>::reindex_notes_unlocked ()
+{
+	std::vector<NotePtr> v (_notes.begin(), _notes.end());
+
+	/* stable, so that notes at the same time keep their order */
+	std::stable_sort (v.begin(), v.end(), EarlierNoteComparator());
+
+	/* inserting sorted notes at the end takes constant time */
+	_notes.clear ();
+	for (auto const & n : v) {
+		_notes.insert (_notes.end(), n);
+	}
+
+	std::stable_sort (v.begin(), v.end(), [] (NotePtr const & a, NotePtr const & b) {
+		return a->channel() < b->channel() || (a->channel() == b->channel() && NoteNumberComparator() (a, b));
+	});
+
+	for (int i = 0; i < 16; ++i) {
+		_pitches[i].clear ();
+	}
+	for (auto const & n : v) {
+		_pitches[n->channel()].insert (_pitches[n->channel()].end(), n);
+	}
+
+	update_note_range_unlocked ();
+	update_max_note_length_unlocked ();
+
+	if (!_notes.empty()) {
+		update_duration_unlocked ((*_notes.rbegin())->time());
+	}
+
+	_edited = true;
+}
+
+/** Return the first note with the given channel and note number that may
+ * overlap a note starting at @a start, i.e. that ends at or after @a start.
+ * Only notes that start before the longest note in the sequence have to be
+ * considered, so this is a lookup instead of a scan of all notes with this
+ * note number.
+ */
+template<typename Time>
+typename Sequence<Time>::Pitches::const_iterator
+Sequence<Time>::overlap_lower_bound (uint8_t chan, uint8_t note, Time const & start) const
+{
+	const Pitches& p (pitches (chan));
+
+	if (_writing) {
+		return p.lower_bound (PitchKey (note));
+	}
+
+	const Time max_length (max_note_length_unlocked ());
+
+	if (start < std::numeric_limits<Time>::lowest() + max_length) {
+		return p.lower_bound (PitchKey (note));
+	}
+
+	return p.lower_bound (PitchKey (note, start - max_length));
+}
+
 template<typename Time>
 void
 Sequence<Time>::remove_patch_change_unlocked (const constPatchChangePtr p)
@@ -1221,10 +1349,9 @@ bool
 Sequence<Time>::contains_unlocked (const NotePtr& note) const
 {
 	const Pitches& p (pitches (note->channel()));
-	NotePtr search_note(new Note<Time>(0, Time(), Time(), note->note()));
 
-	for (typename Pitches::const_iterator i = p.lower_bound (search_note);
-	     i != p.end() && (*i)->note() == note->note(); ++i) {
+	for (typename Pitches::const_iterator i = p.lower_bound (PitchKey (note->note(), note->time()));
+	     i != p.end() && (*i)->note() == note->note() && (*i)->time() == note->time(); ++i) {
 
 		if (**i == *note) {
 			return true;
@@ -1239,6 +1366,16 @@ void
 Sequence<Time>::set_notes (const typename Sequence<Time>::Notes& n)
 {
 	_notes = n;
+
+	for (int i = 0; i < 16; ++i) {
+		_pitches[i].clear ();
+	}
+	for (auto const & note : _notes) {
+		_pitches[note->channel()].insert (note);
+	}
+
+	update_note_range_unlocked ();
+	update_max_note_length_unlocked ();
 }
 
 // CONST iterator implementations (x3)
@@ -1248,8 +1385,7 @@ template<typename Time>
 typename Sequence<Time>::Notes::const_iterator
 Sequence<Time>::note_lower_bound (Time t) const
 {
-	NotePtr search_note(new Note<Time>(0, t, Time(), 0, 0));
-	typename Sequence<Time>::Notes::const_iterator i = _notes.lower_bound(search_note);
+	typename Sequence<Time>::Notes::const_iterator i = _notes.lower_bound(t);
 	assert(i == _notes.end() || (*i)->time() >= t);
 	return i;
 }
@@ -1283,8 +1419,7 @@ template<typename Time>
 typename Sequence<Time>::Notes::iterator
 Sequence<Time>::note_lower_bound (Time t)
 {
-	NotePtr search_note(new Note<Time>(0, t, Time(), 0, 0));
-	typename Sequence<Time>::Notes::iterator i = _notes.lower_bound(search_note);
+	typename Sequence<Time>::Notes::iterator i = _notes.lower_bound(t);
 	assert(i == _notes.end() || (*i)->time() >= t);
 	return i;
 }
@@ -1345,36 +1480,30 @@ Sequence<Time>::get_notes_by_pitch (Notes& n, NoteOperator op, uint8_t val, int
 		}
 
 		const Pitches& p (pitches (c));
-		NotePtr search_note(new Note<Time>(0, Time(), Time(), val, 0));
 		typename Pitches::const_iterator i;
 		switch (op) {
 		case PitchEqual:
-			i = p.lower_bound (search_note);
-			while (i != p.end() && (*i)->note() == val) {
+			for (i = p.lower_bound (PitchKey (val)); i != p.end() && (*i)->note() == val; ++i) {
 				n.insert (*i);
 			}
 			break;
 		case PitchLessThan:
-			i = p.upper_bound (search_note);
-			while (i != p.end() && (*i)->note() < val) {
+			for (i = p.begin(); i != p.end() && (*i)->note() < val; ++i) {
 				n.insert (*i);
 			}
 			break;
 		case PitchLessThanOrEqual:
-			i = p.upper_bound (search_note);
-			while (i != p.end() && (*i)->note() <= val) {
+			for (i = p.begin(); i != p.end() && (*i)->note() <= val; ++i) {
 				n.insert (*i);
 			}
 			break;
 		case PitchGreater:
-			i = p.lower_bound (search_note);
-			while (i != p.end() && (*i)->note() > val) {
+			for (i = p.upper_bound (PitchKey (val, std::numeric_limits<Time>::max())); i != p.end(); ++i) {
 				n.insert (*i);
 			}
 			break;
 		case PitchGreaterThanOrEqual:
-			i = p.lower_bound (search_note);
-			while (i != p.end() && (*i)->note() >= val) {
+			for (i = p.lower_bound (PitchKey (val)); i != p.end(); ++i) {
 				n.insert (*i);
 			}
 			break;
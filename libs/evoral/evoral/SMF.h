@@ -45,6 +45,8 @@ namespace Temporal {
 
 namespace Evoral {
 
+class SMFWriter;
+
 /** Standard Midi File.
  * Currently only tempo-based time of a given PPQN is supported.
  *
@@ -89,10 +91,12 @@ public:
 	bool     is_empty()   const { return _empty; }
 
 	void begin_write();
+	int  begin_append (std::string const& path);
+	bool appending () const { return _writer.get () != 0; }
 	void append_event_delta(uint32_t delta_t, uint32_t size, const uint8_t* buf, event_id_t note_id);
 	void end_write(std::string const &);
 
-	void flush() {};
+	void flush();
 	void set_length (Temporal::Beats const &);
 
 	double round_to_file_precision (double val) const;
@@ -152,10 +156,40 @@ public:
 
 	std::shared_ptr<Temporal::TempoMap> tempo_map (bool& provided) const;
 
+  protected:
+	/** true if the file was opened, but its events were not loaded yet */
+	bool deferred () const { return _deferred; }
+	int  deferred_track () const { return _deferred_track; }
+
+	/** the file to load when needed, derived classes that move the file override this */
+	virtual std::string smf_path () const { return _deferred_path; }
+
   private:
-	smf_t*       _smf;
-	smf_track_t* _smf_track;
-	bool         _empty; ///< true iff file contains(non-empty) events
+	bool load_deferred () const;
+	int  scan_mapped (std::string const& path, int track, bool scan);
+
+	mutable smf_t*       _smf;
+	mutable smf_track_t* _smf_track;
+	bool                 _empty; ///< true iff file contains(non-empty) events
+
+	/* open() only scans the file using SMFReader. The file is loaded by
+	 * libsmf when events are read or written, or meta-data is needed that
+	 * is not known from the scan.
+	 */
+	mutable bool _deferred;
+	std::string  _deferred_path;
+	int          _deferred_track;
+	int          _deferred_format;
+	uint16_t     _deferred_num_tracks;
+	uint16_t     _deferred_ppqn;
+	uint64_t     _deferred_length;
+	bool         _deferred_length_is_explicit;
+	std::vector<Tempo> _deferred_tempos;
+
+	/* set between begin_append() and end_write(), events are written to
+	 * the file instead of being added to libsmf's track.
+	 */
+	std::unique_ptr<SMFWriter> _writer;
 
 	mutable Glib::Threads::Mutex _smf_lock;
 
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EVORAL_SMF_READER_HPP
+#define EVORAL_SMF_READER_HPP
+
+#include <bitset>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+#include "evoral/visibility.h"
+#include "evoral/types.h"
+
+struct _GMappedFile;
+
+namespace Evoral {
+
+/** Read-only Standard MIDI File.
+ *
+ * Unlike SMF, which has libsmf load the whole file into per-event heap
+ * objects, SMFReader maps the file into memory and parses events while
+ * iterating over a track. Events point into the mapped file, unless they
+ * have to be rewritten (running status, note-on with velocity 0 and
+ * SysEx).
+ *
+ * Events are presented as Evoral::SMF::read_event does: meta-events
+ * include the 0xff status byte, SysEx messages start with 0xf0, and
+ * note-on events with velocity 0 are turned into note-off events.
+ */
+class LIBEVORAL_API SMFReader {
+public:
+	struct Event {
+		uint64_t       time;    ///< absolute time in pulses
+		uint32_t       delta;   ///< time since the previous event, in pulses
+		const uint8_t* buf;     ///< valid until the next event of the same track is read
+		uint32_t       size;
+		event_id_t     note_id; ///< Evoral note ID of a sequencer-specific meta-event, or -1
+		bool           mapped;  ///< buf points into the file, and is valid while it is open
+
+		bool is_meta () const { return size > 1 && buf[0] == 0xff; }
+	};
+
+	typedef std::bitset<16> UsedChannels;
+
+	/** Information about the events of a track */
+	struct Summary {
+		Summary () : n_note_on_events (0), has_pgm_change (false), length_pulses (0), length_is_explicit (false) {}
+
+		UsedChannels used_channels;
+		uint64_t     n_note_on_events;
+		bool         has_pgm_change;
+		uint64_t     length_pulses;      ///< time of the last event, usually End Of Track
+		bool         length_is_explicit; ///< the last event has a non-zero delta-time
+	};
+
+	/** Tempo and meter, with the same fields and defaults as libsmf's smf_tempo_t */
+	struct TempoChange {
+		TempoChange () : time_pulses (0), microseconds_per_quarter_note (500000), numerator (4), denominator (4), clocks_per_click (24), notes_per_note (8) {}
+
+		uint64_t time_pulses;
+		int      microseconds_per_quarter_note;
+		int      numerator;
+		int      denominator;
+		int      clocks_per_click;
+		int      notes_per_note;
+	};
+
+	class LIBEVORAL_API Track {
+	public:
+		Track () : _begin (0), _pos (0), _end (0), _time (0), _status (0) {}
+
+		/** Parse the next event.
+		 * @return false at the end of the track, or if the rest of the
+		 * track cannot be parsed.
+		 */
+		bool next (Event&);
+
+		bool empty () const { return _pos == _end; }
+
+		/** @return number of bytes of the track that were parsed */
+		size_t offset () const { return _pos - _begin; }
+
+	private:
+		friend class SMFReader;
+
+		Track (const uint8_t* data, size_t size)
+			: _begin (data), _pos (data), _end (data + size), _time (0), _status (0) {}
+
+		const uint8_t*       _begin;
+		const uint8_t*       _pos;
+		const uint8_t*       _end;
+		uint64_t             _time;
+		uint8_t              _status; ///< running status
+		uint8_t              _scratch[3];
+		std::vector<uint8_t> _sysex;
+	};
+
+	SMFReader ();
+	~SMFReader ();
+
+	/** Map a file and find its tracks.
+	 * @return 0 on success, -1 if the file cannot be read or is not a SMF
+	 */
+	int  open (std::string const& path);
+	void close ();
+
+	bool     is_open ()    const { return _map != 0; }
+	int      format ()     const { return _format; }
+	uint16_t ppqn ()       const { return _ppqn; }
+	uint16_t num_tracks () const { return _tracks.size (); }
+
+	/** @param track 1-based track number
+	 * @return a reader for the track, which is empty if the track does not exist.
+	 * Tracks are independent, several can be read at the same time.
+	 * It must not be used after the file was closed.
+	 */
+	Track track (int track) const;
+
+	/** Read all events of the given track */
+	Summary scan (int track) const;
+
+	/** Collect tempo and time signature meta-events of all tracks, the way
+	 * libsmf builds its tempo map: there is always an initial entry at 0,
+	 * and changes at the same time are merged.
+	 */
+	std::vector<TempoChange> tempos () const;
+
+private:
+	SMFReader (SMFReader const&);
+
+	struct Chunk {
+		Chunk (const uint8_t* d, size_t s) : data (d), size (s) {}
+		const uint8_t* data;
+		size_t         size;
+	};
+
+	_GMappedFile*      _map;
+	std::vector<Chunk> _tracks;
+	int                _format;
+	uint16_t           _ppqn;
+};
+
+} /* namespace Evoral */
+
+#endif /* EVORAL_SMF_READER_HPP */
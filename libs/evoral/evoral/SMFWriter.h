@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EVORAL_SMF_WRITER_HPP
+#define EVORAL_SMF_WRITER_HPP
+
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+#include "evoral/visibility.h"
+
+namespace Evoral {
+
+/** Append-only writer for a Standard MIDI File with a single track.
+ *
+ * Events are encoded into a buffer, which is written to the file when it
+ * exceeds chunk_size() or is flushed, so the cost of adding an event does
+ * not depend on the amount of data that was written before.
+ *
+ * The length of the track is written when the file is closed. Until then,
+ * the track chunk has an unknown length, which is what is left on disk if
+ * writing is interrupted. recover() turns such a file into a valid SMF.
+ */
+class LIBEVORAL_API SMFWriter {
+public:
+	SMFWriter ();
+
+	/** Closes the file without completing it */
+	~SMFWriter ();
+
+	/** Create or truncate @a path, and write the file header.
+	 * @return 0 on success, -1 on error
+	 */
+	int open (std::string const& path, uint16_t ppqn);
+
+	/** Add an event, as passed to SMF::append_event_delta.
+	 * Meta-events must include their length, SysEx messages start with 0xf0.
+	 */
+	void append (uint32_t delta_t, uint32_t size, const uint8_t* buf);
+
+	/** Write all buffered events to the file.
+	 * @return 0 on success, -1 if the file could not be written
+	 */
+	int flush ();
+
+	/** Add End Of Track, write the length of the track and close the file.
+	 * @return 0 on success, -1 if the file could not be written
+	 */
+	int close (uint32_t eot_delta_t);
+
+	bool     is_open () const { return _fd >= 0; }
+	uint64_t time ()    const { return _time; } ///< in pulses
+
+	static size_t chunk_size () { return 65536; }
+
+	/** Complete a file that was not closed by SMFWriter: remove a partially
+	 * written event, add End Of Track and write the length of the track.
+	 * @return 0 if the file is complete, 1 if it was recovered, -1 if it
+	 * could not be read or written.
+	 */
+	static int recover (std::string const& path);
+
+private:
+	SMFWriter (SMFWriter const&);
+
+	int write_buffer ();
+
+	int                  _fd;
+	std::vector<uint8_t> _buf;
+	uint64_t             _written; ///< bytes of track data in the file
+	uint64_t             _time;
+	bool                 _failed;
+};
+
+} /* namespace Evoral */
+
+#endif /* EVORAL_SMF_WRITER_HPP */
@@ -23,6 +23,7 @@
 #ifndef EVORAL_SEQUENCE_HPP
 #define EVORAL_SEQUENCE_HPP
 
+#include <limits>
 #include <list>
 #include <memory>
 #include <queue>
@@ -122,18 +123,52 @@ public:
 		return a->time() < b->time();
 	}
 
+	/* The comparators below take pointers by reference, so that comparing
+	 * notes does not copy shared pointers (and change their reference count).
+	 * Those used for containers also accept keys, which allows to look up
+	 * notes without allocating a Note to compare with.
+	 */
+
+	/** Note number and time of a note, to look up notes in Pitches */
+	struct PitchKey {
+		PitchKey (uint8_t n, Time const & t = std::numeric_limits<Time>::lowest()) : note (n), time (t) {}
+		uint8_t note;
+		Time    time;
+	};
+
+	/** Orders notes by note number, and notes with the same number by time */
 	struct NoteNumberComparator {
-		inline bool operator()(const std::shared_ptr< const Note<Time> > a,
-		                       const std::shared_ptr< const Note<Time> > b) const {
-			return a->note() < b->note();
+		typedef void is_transparent;
+
+		inline bool operator()(NotePtr const & a, NotePtr const & b) const {
+			return a->note() < b->note() || (a->note() == b->note() && a->time() < b->time());
+		}
+		inline bool operator()(constNotePtr const & a, constNotePtr const & b) const {
+			return a->note() < b->note() || (a->note() == b->note() && a->time() < b->time());
+		}
+		inline bool operator()(NotePtr const & a, PitchKey const & b) const {
+			return a->note() < b.note || (a->note() == b.note && a->time() < b.time);
+		}
+		inline bool operator()(PitchKey const & a, NotePtr const & b) const {
+			return a.note < b->note() || (a.note == b->note() && a.time < b->time());
 		}
 	};
 
 	struct EarlierNoteComparator {
-		inline bool operator()(const std::shared_ptr< const Note<Time> > a,
-		                       const std::shared_ptr< const Note<Time> > b) const {
+		typedef void is_transparent;
+
+		inline bool operator()(NotePtr const & a, NotePtr const & b) const {
+			return a->time() < b->time();
+		}
+		inline bool operator()(constNotePtr const & a, constNotePtr const & b) const {
 			return a->time() < b->time();
 		}
+		inline bool operator()(NotePtr const & a, Time const & b) const {
+			return a->time() < b;
+		}
+		inline bool operator()(Time const & a, NotePtr const & b) const {
+			return a < b->time();
+		}
 	};
 
 #if 0 // NOT USED
@@ -148,8 +183,10 @@ public:
 
 	struct LaterNoteEndComparator {
 		typedef const Note<Time>* value_type;
-		inline bool operator()(const std::shared_ptr< const Note<Time> > a,
-		                       const std::shared_ptr< const Note<Time> > b) const {
+		inline bool operator()(NotePtr const & a, NotePtr const & b) const {
+			return a->end_time() > b->end_time();
+		}
+		inline bool operator()(constNotePtr const & a, constNotePtr const & b) const {
 			return a->end_time() > b->end_time();
 		}
 	};
@@ -305,6 +342,15 @@ public:
 	bool add_note_unlocked (const NotePtr note, void* arg = 0);
 	void remove_note_unlocked(const constNotePtr note);
 
+	/** Must be called when the length of a note in the sequence was changed */
+	void note_length_changed_unlocked (constNotePtr const & note);
+
+	/** Sort the notes again after the time, note number or channel of notes
+	 * in the sequence were changed in place. When many notes changed, this is
+	 * faster than removing and adding each of them.
+	 */
+	void reindex_notes_unlocked ();
+
 	void add_patch_change_unlocked (const PatchChangePtr);
 	void remove_patch_change_unlocked (const constPatchChangePtr);
 
@@ -336,6 +382,8 @@ protected:
 	inline       Pitches& pitches(uint8_t chan)       { return _pitches[chan&0xf]; }
 	inline const Pitches& pitches(uint8_t chan) const { return _pitches[chan&0xf]; }
 
+	typename Pitches::const_iterator overlap_lower_bound (uint8_t chan, uint8_t note, Time const & start) const;
+
 	virtual void control_list_marked_dirty ();
 
 private:
@@ -352,6 +400,11 @@ private:
 	void get_notes_by_pitch (Notes&, NoteOperator, uint8_t val, int chan_mask = 0) const;
 	void get_notes_by_velocity (Notes&, NoteOperator, uint8_t val, int chan_mask = 0) const;
 
+	void erase_pitch_unlocked (constNotePtr const &);
+	void update_note_range_unlocked ();
+	void update_max_note_length_unlocked () const;
+	Time max_note_length_unlocked () const;
+
 	const TypeMap& _type_map;
 
 	Notes        _notes;       // notes indexed by time
@@ -375,6 +428,14 @@ private:
 	uint8_t _highest_note;
 	uint16_t _channels_present;
 
+	/** No note in the sequence is longer than this (except during a write),
+	 * which limits the notes to check for overlaps. When the longest note
+	 * may have been removed or shortened, it is marked stale and computed
+	 * again the next time it is needed.
+	 */
+	mutable Time _max_note_length;
+	mutable bool _max_note_length_stale;
+
 	Time    _duration;
 	bool    _explicit_duration;
 
@@ -1,9 +1,15 @@
 #include "SMFTest.h"
 
+#include <cstring>
+
 #include <glibmm/fileutils.h>
 #include <glibmm/miscutils.h>
 
 #include "pbd/file_utils.h"
+#include "pbd/gstdio_compat.h"
+
+#include "evoral/SMFReader.h"
+#include "evoral/SMFWriter.h"
 
 using namespace std;
 
@@ -116,3 +122,221 @@ SMFTest::writeTest ()
 
 	// TODO: Check files are actually equivalent
 }
+
+void
+SMFTest::readerTest ()
+{
+	TestSMF smf;
+	string  testdata_path;
+	CPPUNIT_ASSERT (find_file (test_search_path (), "TakeFive.mid", testdata_path));
+
+	SMFReader reader;
+	CPPUNIT_ASSERT_EQUAL (0, reader.open (testdata_path));
+
+	smf.open(testdata_path);
+	CPPUNIT_ASSERT_EQUAL (smf.num_tracks(), reader.num_tracks ());
+	CPPUNIT_ASSERT_EQUAL (smf.ppqn(), reader.ppqn ());
+
+	/* scanned, but not loaded yet */
+	const Temporal::Beats duration = smf.file_duration ();
+	const int             ntempos  = smf.num_tempos ();
+
+	SMFReader::Track t (reader.track (1));
+	SMFReader::Event ev;
+
+	uint32_t delta_t = 0;
+	uint32_t size    = 0;
+	uint8_t* buf     = NULL;
+	uint64_t time    = 0;
+	size_t   n       = 0;
+	int      ret;
+
+	while ((ret = smf.read_event(&delta_t, &size, &buf)) >= 0) {
+		time += delta_t;
+		CPPUNIT_ASSERT (t.next (ev));
+		CPPUNIT_ASSERT_EQUAL (time, ev.time);
+		CPPUNIT_ASSERT_EQUAL (ret == 0, ev.is_meta ());
+		if (ret > 0) {
+			CPPUNIT_ASSERT_EQUAL (size, ev.size);
+			CPPUNIT_ASSERT (!memcmp (buf, ev.buf, size));
+		}
+		++n;
+	}
+
+	CPPUNIT_ASSERT (n > 0);
+	CPPUNIT_ASSERT (!t.next (ev));
+
+	/* now loaded by libsmf */
+	CPPUNIT_ASSERT_EQUAL (duration, smf.file_duration ());
+	CPPUNIT_ASSERT_EQUAL (ntempos, smf.num_tempos ());
+
+	free (buf);
+}
+
+void
+SMFTest::loadBenchmark ()
+{
+	const string output_dir_path = PBD::tmp_writable_directory (PACKAGE, "loadBenchmark");
+	const string path            = Glib::build_filename (output_dir_path, "Large.mid");
+	const size_t n_notes         = 250000;
+
+	{
+		TestSMF out;
+		CPPUNIT_ASSERT_EQUAL (0, out.create(path, 1, 1920));
+		out.begin_write();
+		for (size_t i = 0; i < n_notes; ++i) {
+			uint8_t on[3]  = { (uint8_t) (0x90 | (i % 16)), (uint8_t) (36 + i % 64), 100 };
+			uint8_t off[3] = { (uint8_t) (0x80 | (i % 16)), (uint8_t) (36 + i % 64), 64 };
+			out.append_event_delta(i ? 240 : 0, 3, on, 0);
+			out.append_event_delta(120, 3, off, 0);
+		}
+		out.end_write(path);
+	}
+
+	/* libsmf */
+	gint64 start = g_get_monotonic_time ();
+	size_t n_smf = 0;
+	{
+		TestSMF smf;
+		CPPUNIT_ASSERT_EQUAL (0, smf.open(path));
+		CPPUNIT_ASSERT_EQUAL (0, smf.seek_to_track(1));
+
+		uint32_t delta_t = 0;
+		uint32_t size    = 0;
+		uint8_t* buf     = NULL;
+		int      ret;
+		while ((ret = smf.read_event(&delta_t, &size, &buf)) >= 0) {
+			if (ret > 0) {
+				++n_smf;
+			}
+		}
+		free (buf);
+	}
+	const gint64 smf_usec = g_get_monotonic_time () - start;
+
+	/* memory-mapped */
+	start = g_get_monotonic_time ();
+	size_t n_mapped = 0;
+	{
+		SMFReader reader;
+		CPPUNIT_ASSERT_EQUAL (0, reader.open (path));
+
+		SMFReader::Track t (reader.track (1));
+		SMFReader::Event ev;
+		while (t.next (ev)) {
+			if (!ev.is_meta ()) {
+				++n_mapped;
+			}
+		}
+	}
+	const gint64 mapped_usec = g_get_monotonic_time () - start;
+
+	CPPUNIT_ASSERT_EQUAL (2 * n_notes, n_smf);
+	CPPUNIT_ASSERT_EQUAL (n_smf, n_mapped);
+
+	cerr << endl << "SMF load of " << n_smf << " events: libsmf " << smf_usec << " usec, mapped " << mapped_usec << " usec" << endl;
+
+	::g_unlink (path.c_str ());
+}
+
+void
+SMFTest::appendTest ()
+{
+	TestSMF smf;
+	string  testdata_path;
+	CPPUNIT_ASSERT (find_file (test_search_path (), "TakeFive.mid", testdata_path));
+	smf.open(testdata_path);
+
+	TestSMF out;
+	const string output_dir_path = PBD::tmp_writable_directory (PACKAGE, "appendTest");
+	const string new_file_path   = Glib::build_filename (output_dir_path, "TakeFiveAppended.mid");
+	CPPUNIT_ASSERT_EQUAL (0, out.create(new_file_path, 1, 1920));
+	CPPUNIT_ASSERT_EQUAL (0, out.begin_append(new_file_path));
+	CPPUNIT_ASSERT (out.appending());
+
+	uint32_t delta_t = 0;
+	uint32_t size    = 0;
+	uint8_t* buf     = NULL;
+	size_t   n       = 0;
+	int      ret;
+	while ((ret = smf.read_event(&delta_t, &size, &buf)) >= 0) {
+		if (ret > 0) {
+			out.append_event_delta(delta_t, size, buf, n);
+			++n;
+		}
+		if (n % 1000 == 0) {
+			out.flush();
+		}
+	}
+
+	out.end_write(new_file_path);
+	CPPUNIT_ASSERT (!out.appending());
+	CPPUNIT_ASSERT (!out.is_empty());
+	CPPUNIT_ASSERT_EQUAL (0, Evoral::SMFWriter::recover (new_file_path));
+
+	/* read back with libsmf */
+	TestSMF in;
+	CPPUNIT_ASSERT_EQUAL (0, in.open(new_file_path));
+	CPPUNIT_ASSERT_EQUAL (0, in.seek_to_track(1));
+
+	size_t n_in = 0;
+	while ((ret = in.read_event(&delta_t, &size, &buf)) >= 0) {
+		if (ret > 0) {
+			++n_in;
+		}
+	}
+	CPPUNIT_ASSERT_EQUAL (n, n_in);
+
+	free (buf);
+}
+
+void
+SMFTest::recoverTest ()
+{
+	const string output_dir_path = PBD::tmp_writable_directory (PACKAGE, "recoverTest");
+	const string path            = Glib::build_filename (output_dir_path, "Interrupted.mid");
+
+	{
+		Evoral::SMFWriter writer;
+		CPPUNIT_ASSERT_EQUAL (0, writer.open (path, 1920));
+		for (int i = 0; i < 100; ++i) {
+			uint8_t on[3]  = { 0x90, (uint8_t) (36 + i % 64), 100 };
+			uint8_t off[3] = { 0x80, (uint8_t) (36 + i % 64), 64 };
+			writer.append (240, 3, on);
+			writer.append (120, 3, off);
+		}
+		CPPUNIT_ASSERT_EQUAL (0, writer.flush ());
+		/* not closed */
+	}
+
+	/* a partially written event */
+	FILE* f = g_fopen (path.c_str (), "ab");
+	CPPUNIT_ASSERT (f);
+	fputc (0x10, f);
+	fputc (0x90, f);
+	fputc (0x40, f);
+	fclose (f);
+
+	CPPUNIT_ASSERT_EQUAL (1, Evoral::SMFWriter::recover (path));
+	CPPUNIT_ASSERT_EQUAL (0, Evoral::SMFWriter::recover (path));
+
+	TestSMF smf;
+	CPPUNIT_ASSERT_EQUAL (0, smf.open(path));
+	CPPUNIT_ASSERT_EQUAL (0, smf.seek_to_track(1));
+
+	uint32_t delta_t = 0;
+	uint32_t size    = 0;
+	uint8_t* buf     = NULL;
+	size_t   n       = 0;
+	int      ret;
+	while ((ret = smf.read_event(&delta_t, &size, &buf)) >= 0) {
+		if (ret > 0) {
+			++n;
+		}
+	}
+	CPPUNIT_ASSERT_EQUAL (size_t (200), n);
+	CPPUNIT_ASSERT_EQUAL (Temporal::Beats::ticks_at_rate (100 * 360, 1920), smf.file_duration ());
+
+	free (buf);
+	::g_unlink (path.c_str ());
+}
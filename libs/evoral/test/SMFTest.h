@@ -58,6 +58,10 @@ class SMFTest : public CppUnit::TestFixture
 	CPPUNIT_TEST(createNewFileTest);
 	CPPUNIT_TEST(takeFiveTest);
 	CPPUNIT_TEST(writeTest);
+	CPPUNIT_TEST(readerTest);
+	CPPUNIT_TEST(loadBenchmark);
+	CPPUNIT_TEST(appendTest);
+	CPPUNIT_TEST(recoverTest);
 	CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -79,6 +83,10 @@ public:
 	void createNewFileTest();
 	void takeFiveTest();
 	void writeTest();
+	void readerTest();
+	void loadBenchmark();
+	void appendTest();
+	void recoverTest();
 
 private:
 	DummyTypeMap*     type_map;
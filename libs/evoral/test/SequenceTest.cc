@@ -1,5 +1,7 @@
 #include "SequenceTest.h"
 #include <cassert>
+#include <iostream>
+#include <glib.h>
 
 CPPUNIT_TEST_SUITE_REGISTRATION(SequenceTest);
 
@@ -195,3 +197,213 @@ SequenceTest::controlInterpolationTest ()
 		last_value = i->second;
 	}
 }
+
+void
+SequenceTest::notesByPitchTest ()
+{
+	for (Notes::const_iterator i = test_notes.begin(); i != test_notes.end(); ++i) {
+		seq->add_note_unlocked (*i);
+	}
+
+	/* test notes are 64 .. 75 */
+	Sequence<Time>::Notes n;
+	seq->get_notes (n, Sequence<Time>::PitchEqual, 70, 0);
+	CPPUNIT_ASSERT_EQUAL (size_t(1), n.size());
+	CPPUNIT_ASSERT_EQUAL (uint8_t(70), (*n.begin())->note());
+
+	n.clear ();
+	seq->get_notes (n, Sequence<Time>::PitchLessThan, 70, 0);
+	CPPUNIT_ASSERT_EQUAL (size_t(6), n.size());
+
+	n.clear ();
+	seq->get_notes (n, Sequence<Time>::PitchLessThanOrEqual, 70, 0);
+	CPPUNIT_ASSERT_EQUAL (size_t(7), n.size());
+
+	n.clear ();
+	seq->get_notes (n, Sequence<Time>::PitchGreater, 70, 0);
+	CPPUNIT_ASSERT_EQUAL (size_t(5), n.size());
+
+	n.clear ();
+	seq->get_notes (n, Sequence<Time>::PitchGreaterThanOrEqual, 70, 0);
+	CPPUNIT_ASSERT_EQUAL (size_t(6), n.size());
+
+	/* channel 1 only */
+	n.clear ();
+	seq->get_notes (n, Sequence<Time>::PitchGreaterThanOrEqual, 0, 2);
+	CPPUNIT_ASSERT_EQUAL (size_t(0), n.size());
+
+	CPPUNIT_ASSERT (seq->contains (test_notes[3]));
+	std::shared_ptr<Note<Time> > other (new Note<Time> (*test_notes[3]));
+	other->set_velocity (100);
+	CPPUNIT_ASSERT (!seq->contains (other));
+}
+
+void
+SequenceTest::noteRangeTest ()
+{
+	for (Notes::const_iterator i = test_notes.begin(); i != test_notes.end(); ++i) {
+		seq->add_note_unlocked (*i);
+	}
+	std::shared_ptr<Note<Time> > ch5 (new Note<Time> (5, Time::from_double (50), Time::from_double (10), 40, 64));
+	seq->add_note_unlocked (ch5);
+
+	CPPUNIT_ASSERT_EQUAL (uint8_t(40), seq->lowest_note());
+	CPPUNIT_ASSERT_EQUAL (uint8_t(75), seq->highest_note());
+	CPPUNIT_ASSERT_EQUAL (uint16_t(0x21), seq->channels_present());
+
+	/* the copy has the same indexes */
+	MySequence<Time> copy (*seq);
+	CPPUNIT_ASSERT_EQUAL (size_t(12), copy.pitches(0).size());
+	CPPUNIT_ASSERT_EQUAL (size_t(1), copy.pitches(5).size());
+	CPPUNIT_ASSERT_EQUAL (uint16_t(0x21), copy.channels_present());
+
+	seq->remove_note_unlocked (ch5);
+	CPPUNIT_ASSERT_EQUAL (uint8_t(64), seq->lowest_note());
+	CPPUNIT_ASSERT_EQUAL (uint16_t(0x01), seq->channels_present());
+	CPPUNIT_ASSERT (seq->pitches(5).empty());
+
+	seq->remove_note_unlocked (test_notes.back());
+	CPPUNIT_ASSERT_EQUAL (uint8_t(74), seq->highest_note());
+	CPPUNIT_ASSERT_EQUAL (size_t(11), seq->pitches(0).size());
+
+	seq->clear ();
+	CPPUNIT_ASSERT (seq->pitches(0).empty());
+	CPPUNIT_ASSERT_EQUAL (uint16_t(0), seq->channels_present());
+}
+
+void
+SequenceTest::overlapBoundTest ()
+{
+	typedef std::shared_ptr<Note<Time> > NotePtr;
+
+	/* one long note, and many short ones with the same pitch */
+	seq->add_note_unlocked (NotePtr (new Note<Time> (0, Time::from_double (0), Time::from_double (1000), 60, 64)));
+	for (int i = 0; i < 100; ++i) {
+		seq->add_note_unlocked (NotePtr (new Note<Time> (0, Time::from_double (i * 10), Time::from_double (5), 60, 64)));
+	}
+
+	/* the long note overlaps everything */
+	const MySequence<Time>::Pitches& p (seq->pitches (0));
+	MySequence<Time>::Pitches::const_iterator i = seq->overlap_lower_bound (0, 60, Time::from_double (500));
+	CPPUNIT_ASSERT (i == p.begin());
+
+	/* without it, only notes that start up to 5 beats earlier have to be checked */
+	seq->clear ();
+	for (int i = 0; i < 100; ++i) {
+		seq->add_note_unlocked (NotePtr (new Note<Time> (0, Time::from_double (i * 10), Time::from_double (5), 60, 64)));
+	}
+	i = seq->overlap_lower_bound (0, 60, Time::from_double (500));
+	CPPUNIT_ASSERT (i != p.end());
+	CPPUNIT_ASSERT_EQUAL (Time::from_double (500), (*i)->time());
+
+	/* the bound narrows again when the longest note is removed */
+	NotePtr longest (new Note<Time> (0, Time::from_double (0), Time::from_double (1000), 62, 64));
+	seq->add_note_unlocked (longest);
+	i = seq->overlap_lower_bound (0, 60, Time::from_double (500));
+	CPPUNIT_ASSERT (i == p.begin());
+
+	seq->remove_note_unlocked (longest);
+	i = seq->overlap_lower_bound (0, 60, Time::from_double (500));
+	CPPUNIT_ASSERT (i != p.end());
+	CPPUNIT_ASSERT_EQUAL (Time::from_double (500), (*i)->time());
+
+	/* ..and when it is shortened */
+	seq->add_note_unlocked (longest);
+	longest->set_length (Time::from_double (5));
+	seq->note_length_changed_unlocked (longest);
+	i = seq->overlap_lower_bound (0, 60, Time::from_double (500));
+	CPPUNIT_ASSERT (i != p.end());
+	CPPUNIT_ASSERT_EQUAL (Time::from_double (500), (*i)->time());
+}
+
+void
+SequenceTest::reindexTest ()
+{
+	typedef std::shared_ptr<Note<Time> > NotePtr;
+
+	std::vector<NotePtr> notes;
+	for (int i = 0; i < 100; ++i) {
+		notes.push_back (NotePtr (new Note<Time> (0, Time::from_double (i), Time::from_double (1), 40 + i % 10, 64)));
+		seq->add_note_unlocked (notes.back());
+	}
+
+	/* reverse the order of the notes, and move some to another channel and pitch */
+	for (int i = 0; i < 100; ++i) {
+		notes[i]->set_time (Time::from_double (200 - i));
+		if (i % 4 == 0) {
+			notes[i]->set_channel (1);
+			notes[i]->set_note (80);
+		}
+	}
+	notes[50]->set_length (Time::from_double (20));
+
+	seq->reindex_notes_unlocked ();
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) 100, seq->notes().size());
+	CPPUNIT_ASSERT (*seq->notes().begin() == notes[99]);
+	CPPUNIT_ASSERT (*seq->notes().rbegin() == notes[0]);
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) 75, seq->pitches (0).size());
+	CPPUNIT_ASSERT_EQUAL ((size_t) 25, seq->pitches (1).size());
+	CPPUNIT_ASSERT_EQUAL ((uint8_t) 40, seq->lowest_note());
+	CPPUNIT_ASSERT_EQUAL ((uint8_t) 80, seq->highest_note());
+
+	/* the longer note is still found when looking for overlaps */
+	MySequence<Time>::Pitches::const_iterator i = seq->overlap_lower_bound (0, 40, Time::from_double (160));
+	CPPUNIT_ASSERT (i != seq->pitches (0).end());
+	CPPUNIT_ASSERT (*i == notes[50]);
+
+	/* notes are found, and can be removed */
+	for (int i = 0; i < 100; ++i) {
+		seq->remove_note_unlocked (notes[i]);
+	}
+	CPPUNIT_ASSERT (seq->notes().empty());
+	CPPUNIT_ASSERT (seq->pitches (0).empty());
+	CPPUNIT_ASSERT (seq->pitches (1).empty());
+}
+
+void
+SequenceTest::editBenchmark ()
+{
+	typedef std::shared_ptr<Note<Time> > NotePtr;
+
+	const int n_notes = 200000;
+	std::vector<NotePtr> notes;
+
+	for (int i = 0; i < n_notes; ++i) {
+		notes.push_back (NotePtr (new Note<Time> (i % 4, Time::ticks ((i * 7919) % (n_notes * 100)), Time::ticks (1 + i % 2000), 30 + i % 60, 64)));
+	}
+
+	gint64 start = g_get_monotonic_time ();
+	for (std::vector<NotePtr>::const_iterator i = notes.begin(); i != notes.end(); ++i) {
+		seq->add_note_unlocked (*i);
+	}
+	const gint64 add_usec = g_get_monotonic_time () - start;
+
+	start = g_get_monotonic_time ();
+	size_t found = 0;
+	for (std::vector<NotePtr>::const_iterator i = notes.begin(); i != notes.end(); ++i) {
+		found += seq->note_lower_bound ((*i)->time()) != seq->notes().end();
+	}
+	const gint64 lookup_usec = g_get_monotonic_time () - start;
+	CPPUNIT_ASSERT_EQUAL ((size_t) n_notes, found);
+
+	start = g_get_monotonic_time ();
+	for (std::vector<NotePtr>::const_iterator i = notes.begin(); i != notes.end(); i += 2) {
+		seq->remove_note_unlocked (*i);
+	}
+	const gint64 remove_usec = g_get_monotonic_time () - start;
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) n_notes / 2, seq->notes().size());
+	size_t indexed = 0;
+	for (uint8_t c = 0; c < 16; ++c) {
+		indexed += seq->pitches (c).size();
+	}
+	CPPUNIT_ASSERT_EQUAL ((size_t) n_notes / 2, indexed);
+
+	std::cerr << std::endl
+	          << n_notes << " notes: add " << add_usec / 1000 << " ms"
+	          << ", lookup " << lookup_usec / 1000 << " ms"
+	          << ", remove half " << remove_usec / 1000 << " ms"
+	          << std::endl;
+}
@@ -59,6 +59,10 @@ public:
 
 	virtual bool find_next_event(double start, double end, ControlEvent& ev, bool only_active) const { return false; }
 
+	using typename Sequence<Time>::Pitches;
+	using Sequence<Time>::pitches;
+	using Sequence<Time>::overlap_lower_bound;
+
 	std::shared_ptr<Control> control_factory(const Parameter& param) {
 		Evoral::ParameterDescriptor desc;
 		desc.upper = 127;
@@ -121,6 +125,11 @@ class SequenceTest : public CppUnit::TestFixture
 	CPPUNIT_TEST (preserveEventOrderingTest);
 	CPPUNIT_TEST (iteratorSeekTest);
 	CPPUNIT_TEST (controlInterpolationTest);
+	CPPUNIT_TEST (notesByPitchTest);
+	CPPUNIT_TEST (noteRangeTest);
+	CPPUNIT_TEST (overlapBoundTest);
+	CPPUNIT_TEST (reindexTest);
+	CPPUNIT_TEST (editBenchmark);
 	CPPUNIT_TEST_SUITE_END ();
 
 public:
@@ -151,6 +160,11 @@ public:
 	void preserveEventOrderingTest ();
 	void iteratorSeekTest ();
 	void controlInterpolationTest ();
+	void notesByPitchTest ();
+	void noteRangeTest ();
+	void overlapBoundTest ();
+	void reindexTest ();
+	void editBenchmark ();
 
 private:
 	DummyTypeMap*       type_map;
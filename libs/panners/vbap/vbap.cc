@@ -328,7 +328,7 @@ VBAPanner::distribute_one (AudioBuffer& srcbuf, BufferSet& obufs, gain_t gain_co
 			 */
 
 			AudioBuffer& buf (obufs.get_audio (output));
-			buf.accumulate_with_ramped_gain_from (srcbuf.data (), nframes, signal->gains[output], pan, 0);
+			buf.accumulate_with_ramped_gain_from (srcbuf, nframes, signal->gains[output], pan, 0);
 			signal->gains[output] = pan;
 
 		} else {
@@ -345,7 +345,7 @@ VBAPanner::distribute_one (AudioBuffer& srcbuf, BufferSet& obufs, gain_t gain_co
 		if (outputs[o] == 1) {
 			/* take signal and deliver with a rapid fade out */
 			AudioBuffer& buf (obufs.get_audio (o));
-			buf.accumulate_with_ramped_gain_from (srcbuf.data (), nframes, signal->gains[o], 0.0, 0);
+			buf.accumulate_with_ramped_gain_from (srcbuf, nframes, signal->gains[o], 0.0, 0);
 			signal->gains[o] = 0.0;
 		}
 	}
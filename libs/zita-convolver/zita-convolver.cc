@@ -229,6 +229,101 @@ Convproc::impdata_clear (uint32_t inp, uint32_t out)
 	return 0;
 }
 
+int
+Convproc::impdata_share (Convproc const& src)
+{
+	uint32_t k;
+
+	if (_state != ST_STOP || src._state < ST_STOP) {
+		return Converror::BAD_STATE;
+	}
+	if ((_ninp != src._ninp) || (_nout != src._nout) || (_options != src._options) || (_nlevels != src._nlevels)) {
+		return Converror::BAD_PARAM;
+	}
+	for (k = 0; k < _nlevels; k++) {
+		Convlevel const* L = src._convlev[k];
+		if ((_convlev[k]->_offs != L->_offs) || (_convlev[k]->_npar != L->_npar) || (_convlev[k]->_parsize != L->_parsize)) {
+			return Converror::BAD_PARAM;
+		}
+	}
+
+	try {
+		for (k = 0; k < _nlevels; k++) {
+			_convlev[k]->impdata_share (src._convlev[k]);
+		}
+	} catch (...) {
+		cleanup ();
+		return Converror::MEM_ALLOC;
+	}
+	return 0;
+}
+
+static const uint32_t impdata_magic   = 0x5243495a; // "ZICR"
+static const uint32_t impdata_version = 1;
+
+int
+Convproc::impdata_save (FILE* F) const
+{
+	uint32_t k;
+
+	if (_state < ST_STOP) {
+		return Converror::BAD_STATE;
+	}
+
+	uint32_t hdr[7] = { impdata_magic, impdata_version, (uint32_t)sizeof (fftwf_complex), _ninp, _nout, _options, _nlevels };
+
+	if (fwrite (hdr, sizeof (hdr), 1, F) != 1) {
+		return Converror::FILE_IO;
+	}
+	for (k = 0; k < _nlevels; k++) {
+		if (!_convlev[k]->impdata_save (F)) {
+			return Converror::FILE_IO;
+		}
+	}
+	return 0;
+}
+
+int
+Convproc::impdata_load (FILE* F)
+{
+	uint32_t k;
+
+	if (_state != ST_STOP) {
+		return Converror::BAD_STATE;
+	}
+
+	uint32_t hdr[7];
+
+	if (fread (hdr, sizeof (hdr), 1, F) != 1) {
+		cleanup ();
+		return Converror::FILE_IO;
+	}
+	if (   (hdr[0] != impdata_magic)
+	    || (hdr[1] != impdata_version)
+	    || (hdr[2] != sizeof (fftwf_complex))
+	    || (hdr[3] != _ninp)
+	    || (hdr[4] != _nout)
+	    || (hdr[5] != _options)
+	    || (hdr[6] != _nlevels)) {
+		cleanup ();
+		return Converror::BAD_PARAM;
+	}
+
+	try {
+		for (k = 0; k < _nlevels; k++) {
+			if (!_convlev[k]->impdata_load (F, _ninp, _nout)) {
+				/* partially loaded data is useless */
+				cleanup ();
+				return Converror::FILE_IO;
+			}
+		}
+	} catch (...) {
+		cleanup ();
+		return Converror::MEM_ALLOC;
+	}
+	return 0;
+}
+
 int
 Convproc::reset (void)
 {
@@ -561,6 +656,117 @@ Convlevel::impdata_clear (uint32_t inp, uint32_t out)
 	}
 }
 
+void
+Convlevel::impdata_share (Convlevel const* src)
+{
+	Outnode* Y;
+	Macnode* S;
+	Macnode* M;
+
+	for (Y = src->_out_list; Y; Y = Y->_next) {
+		for (S = Y->_list; S; S = S->_next) {
+			if (S->_fftb == 0 && S->_link == 0) {
+				continue;
+			}
+			M = findmacnode (S->_inpn->_inp, Y->_out, true);
+			M->_link = S->_link ? S->_link : S;
+		}
+	}
+}
+
+bool
+Convlevel::impdata_save (FILE* F) const
+{
+	uint32_t j, n;
+	Outnode* Y;
+	Macnode* M;
+
+	n = 0;
+	for (Y = _out_list; Y; Y = Y->_next) {
+		for (M = Y->_list; M; M = M->_next) {
+			if (M->_link || M->_fftb) {
+				++n;
+			}
+		}
+	}
+
+	uint32_t hdr[4] = { _offs, _npar, _parsize, n };
+	if (fwrite (hdr, sizeof (hdr), 1, F) != 1) {
+		return false;
+	}
+
+	for (Y = _out_list; Y; Y = Y->_next) {
+		for (M = Y->_list; M; M = M->_next) {
+			fftwf_complex** fftb = M->_link ? M->_link->_fftb : M->_fftb;
+			if (fftb == 0) {
+				continue;
+			}
+			uint32_t io[2] = { M->_inpn->_inp, Y->_out };
+			if (fwrite (io, sizeof (io), 1, F) != 1) {
+				return false;
+			}
+			for (j = 0; j < _npar; j++) {
+				uint8_t used = fftb[j] ? 1 : 0;
+				if (fwrite (&used, 1, 1, F) != 1) {
+					return false;
+				}
+				if (used && fwrite (fftb[j], sizeof (fftwf_complex), _parsize + 1, F) != _parsize + 1) {
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+bool
+Convlevel::impdata_load (FILE* F, uint32_t ninp, uint32_t nout)
+{
+	uint32_t i, j;
+	Macnode* M;
+
+	uint32_t hdr[4];
+	if (fread (hdr, sizeof (hdr), 1, F) != 1) {
+		return false;
+	}
+	if ((hdr[0] != _offs) || (hdr[1] != _npar) || (hdr[2] != _parsize)) {
+		return false;
+	}
+
+	for (i = 0; i < hdr[3]; i++) {
+		uint32_t io[2];
+		if (fread (io, sizeof (io), 1, F) != 1) {
+			return false;
+		}
+		if ((io[0] >= ninp) || (io[1] >= nout)) {
+			return false;
+		}
+		M = findmacnode (io[0], io[1], true);
+		if (M == 0 || M->_link) {
+			return false;
+		}
+		if (M->_fftb == 0) {
+			M->alloc_fftb (_npar);
+		}
+		for (j = 0; j < _npar; j++) {
+			uint8_t used;
+			if (fread (&used, 1, 1, F) != 1) {
+				return false;
+			}
+			if (!used) {
+				continue;
+			}
+			if (M->_fftb[j] == 0) {
+				M->_fftb[j] = calloc_complex (_parsize + 1);
+			}
+			if (fread (M->_fftb[j], sizeof (fftwf_complex), _parsize + 1, F) != _parsize + 1) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
 void
 Convlevel::reset (uint32_t inpsize,
                   uint32_t outsize,
@@ -24,6 +24,7 @@
 #include <fftw3.h>
 #include <pthread.h>
 #include <stdint.h>
+#include <stdio.h>
 
 #include "zita-convolver/zconvolver_visibility.h"
 
@@ -218,7 +219,8 @@ public:
 	enum {
 		BAD_STATE = -1,
 		BAD_PARAM = -2,
-		MEM_ALLOC = -3
+		MEM_ALLOC = -3,
+		FILE_IO   = -4
 	};
 
 	Converror (int error) : _error (error) {}
@@ -264,6 +266,11 @@ private:
 	void impdata_clear (uint32_t inp,
 	                    uint32_t out);
 
+	void impdata_share (Convlevel const* src);
+
+	bool impdata_save (FILE* F) const;
+	bool impdata_load (FILE* F, uint32_t ninp, uint32_t nout);
+
 	void reset (uint32_t inpsize,
 	            uint32_t outsize,
 	            float**  inpbuff,
@@ -388,6 +395,19 @@ public:
 	int impdata_clear (uint32_t inp,
 	                   uint32_t out);
 
+	/* Use the impulse responses of another Convproc instance, which was
+	 * configured with identical parameters. The data is not copied,
+	 * @src must not be modified, and must outlive this instance.
+	 */
+	int impdata_share (Convproc const& src);
+
+	/* Store or retrieve the (frequency domain) impulse response data,
+	 * for an instance that is configured with identical parameters.
+	 * If loading fails, the instance is cleaned up.
+	 */
+	int impdata_save (FILE* F) const;
+	int impdata_load (FILE* F);
+
 	void set_options (uint32_t options);
 
 	int reset (void);
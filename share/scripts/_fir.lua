@@ -1,4 +1,4 @@
-ardour { ["type"] = "dsp", name = "Lua FIR Convolver", license = "MIT", author = "Ardour Team", description = [[Another simple DSP example]] }
+ardour { ["type"] = "dsp", name = "Lua FIR Filter", license = "MIT", author = "Ardour Team", description = [[Another simple DSP example]] }
 
 function dsp_ioconfig () return
 	{
@@ -6,31 +6,20 @@ function dsp_ioconfig () return
 	}
 end
 
-local conv
+local fir
 
-function dsp_configure (ins, outs)
-	conv = ARDOUR.DSP.Convolution (Session, ins:n_audio (), outs:n_audio ())
+function dsp_init (rate)
+	fir = ARDOUR.DSP.FIRFilter (3)
 
-	local cmem = ARDOUR.DSP.DspShm (4)
-	cmem:clear ()
-	local d = cmem:to_float (0):array()
-	d[1] = .5
-	d[2] = .5
-	local ar = ARDOUR.AudioRom.new_rom (cmem:to_float (0), 4)
-	conv:add_impdata (0, 0, ar, 1.0, 0, 0, 0, 0)
-
-	cmem:to_float (0):set_table({1, -1, 0, 0}, 4)
-	ar = ARDOUR.AudioRom.new_rom (cmem:to_float (0), 3)
-	conv:add_impdata (0, 0, ar, 1.0, 0, 0, 0, 0)
-
-	conv:restart ()
+	local cmem = ARDOUR.DSP.DspShm (3)
+	cmem:to_float (0):set_table({1.5, -.5, 0}, 3)
+	fir:set_coefficients (cmem:to_float (0), 3)
 	collectgarbage ()
 end
 
-function dsp_latency ()
-	return conv:latency()
-end
-
-function dsp_runmap (bufs, in_map, out_map, n_samples, offset)
-	conv:run (bufs, in_map, out_map, n_samples, offset)
+function dsp_run (ins, outs, n_samples)
+	if ins[1] ~= outs[1] then
+		ARDOUR.DSP.copy_vector (outs[1], ins[1], n_samples)
+	end
+	fir:run (outs[1], n_samples)
 end
@@ -86,7 +86,7 @@ function dsp_run (ins, outs, n_samples)
 	elseif (m < 8) then
 		-- to Mid/Side
 		ARDOUR.DSP.copy_vector (cmem:to_float(0), ins[1], n_samples)
-		ARDOUR.DSP.mix_buffers_with_gain (cmem:to_float(0), ins[2], n_samples, -1) -- (L - R)
+		ARDOUR.DSP.subtract (cmem:to_float(0), ins[2], n_samples) -- (L - R)
 		if ins[1] ~= outs[1] then
 			ARDOUR.DSP.copy_vector (outs[1], ins[1], n_samples)
 		end
@@ -97,7 +97,7 @@ function dsp_run (ins, outs, n_samples)
 	else
 		-- from Mid/Side
 		ARDOUR.DSP.copy_vector (cmem:to_float(0), ins[1], n_samples)
-		ARDOUR.DSP.mix_buffers_with_gain (cmem:to_float(0), ins[2], n_samples, -1) -- (L - R)
+		ARDOUR.DSP.subtract (cmem:to_float(0), ins[2], n_samples) -- (L - R)
 		if ins[1] ~= outs[1] then
 			ARDOUR.DSP.copy_vector (outs[1], ins[1], n_samples)
 		end